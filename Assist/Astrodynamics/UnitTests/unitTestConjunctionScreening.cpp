@@ -0,0 +1,292 @@
+/*
+ *    Copyright (c) 2010-2014, Delft University of Technology
+ *    Copyright (c) 2010-2014, K. Kumar (me@kartikkumar.com)
+ *    All rights reserved.
+ *    See http://bit.ly/1jern3m for license details.
+ */
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include <TudatCore/Mathematics/BasicMathematics/mathematicalConstants.h>
+
+#include "Assist/Astrodynamics/conjunctionScreening.h"
+#include "Assist/Basics/commonTypedefs.h"
+
+namespace assist
+{
+namespace unit_tests
+{
+
+using tudat::basic_mathematics::Vector6d;
+
+namespace
+{
+
+//! Radius of circular orbits [m].
+const double orbitalRadius = 7.0e6;
+
+//! Angular velocity on circular orbits [rad s^-1].
+const double angularVelocity = std::sqrt( 3.986004418e14 / ( 7.0e6 * 7.0e6 * 7.0e6 ) );
+
+//! Compute state on circular orbit with given radius offset and inclination.
+Vector6d computeOrbitState( const double epoch, const double radiusOffset,
+                            const double inclination )
+{
+    const double radius = orbitalRadius + radiusOffset;
+    const double angle = angularVelocity * epoch;
+    Vector6d state;
+    state << radius * std::cos( angle ),
+            radius * std::sin( angle ) * std::cos( inclination ),
+            radius * std::sin( angle ) * std::sin( inclination ),
+            -radius * angularVelocity * std::sin( angle ),
+            radius * angularVelocity * std::cos( angle ) * std::cos( inclination ),
+            radius * angularVelocity * std::cos( angle ) * std::sin( inclination );
+    return state;
+}
+
+//! Sample state history on circular orbit, over a little more than two periods.
+basics::DoubleKeyVector6dValueMap sampleOrbit( const double startEpoch, const double step,
+                                               const double radiusOffset,
+                                               const double inclination )
+{
+    using tudat::basic_mathematics::mathematical_constants::PI;
+
+    basics::DoubleKeyVector6dValueMap stateHistory;
+    for ( double epoch = startEpoch; epoch <= 4.2 * PI / angularVelocity; epoch += step )
+    {
+        stateHistory[ epoch ] = computeOrbitState( epoch, radiusOffset, inclination );
+    }
+
+    return stateHistory;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE( test_conjunction_screening )
+
+//! Test screening of objects in linear motion, sampled at different epochs.
+BOOST_AUTO_TEST_CASE( testScreenConjunctionsLinearMotion )
+{
+    // Set relative motion with closest approach at 1234.5 s, with a miss distance of about
+    // 760 m.
+    const Eigen::Vector3d relativeVelocity( 7000.0, -3000.0, 0.1 );
+    const Eigen::Vector3d initialRelativePosition
+            = Eigen::Vector3d( 300.0, 700.0, 0.0 ) - 1234.5 * relativeVelocity;
+
+    // Sample state histories of reference object in linear motion and of object relative to it,
+    // at different, coarse epochs.
+    basics::DoubleKeyVector6dValueMap firstStateHistory;
+    basics::DoubleKeyVector6dValueMap secondStateHistory;
+    for ( double epoch = 0.0; epoch <= 3000.0; epoch += 60.0 )
+    {
+        Vector6d state;
+        state << 1.0e7, 7500.0 * epoch, 0.0, 0.0, 7500.0, 0.0;
+        firstStateHistory[ epoch ] = state;
+    }
+
+    for ( double epoch = 10.0; epoch <= 3100.0; epoch += 77.0 )
+    {
+        Vector6d state;
+        state << 1.0e7, 7500.0 * epoch, 0.0, 0.0, 7500.0, 0.0;
+        state.segment< 3 >( 0 ) += initialRelativePosition + relativeVelocity * epoch;
+        state.segment< 3 >( 3 ) += relativeVelocity;
+        secondStateHistory[ epoch ] = state;
+    }
+
+    // Set expected time of closest approach and miss distance.
+    const double expectedTimeOfClosestApproach
+            = -initialRelativePosition.dot( relativeVelocity ) / relativeVelocity.squaredNorm( );
+    const double expectedMissDistance
+            = ( initialRelativePosition
+                + expectedTimeOfClosestApproach * relativeVelocity ).norm( );
+
+    // Screen state histories.
+    const std::vector< astrodynamics::Conjunction > conjunctions
+            = astrodynamics::screenConjunctions( firstStateHistory, secondStateHistory, 1.0e4 );
+
+    // Check that the conjunction is found.
+    BOOST_REQUIRE_EQUAL( conjunctions.size( ), 1 );
+    BOOST_CHECK_EQUAL( conjunctions[ 0 ].firstObject, 0 );
+    BOOST_CHECK_EQUAL( conjunctions[ 0 ].secondObject, 1 );
+    BOOST_CHECK_CLOSE_FRACTION( conjunctions[ 0 ].timeOfClosestApproach,
+                                expectedTimeOfClosestApproach, 1.0e-9 );
+    BOOST_CHECK_CLOSE_FRACTION( conjunctions[ 0 ].missDistance, expectedMissDistance, 1.0e-6 );
+
+    // Check that no conjunction is found if the screening distance is less than the miss
+    // distance.
+    BOOST_CHECK( astrodynamics::screenConjunctions(
+                     firstStateHistory, secondStateHistory,
+                     0.99 * expectedMissDistance ).empty( ) );
+}
+
+//! Test screening of objects on crossing circular orbits.
+BOOST_AUTO_TEST_CASE( testScreenConjunctionsCircularOrbits )
+{
+    using tudat::basic_mathematics::mathematical_constants::PI;
+
+    // Sample orbits with a radius difference of 500 m and a relative inclination of 45 degrees,
+    // which approach each other to 500 m at every half orbit, at different epochs.
+    const basics::DoubleKeyVector6dValueMap firstStateHistory = sampleOrbit( 0.0, 60.0, 0.0, 0.0 );
+    const basics::DoubleKeyVector6dValueMap secondStateHistory
+            = sampleOrbit( 5.0, 45.0, 500.0, 0.25 * PI );
+
+    // Screen state histories.
+    const std::vector< astrodynamics::Conjunction > conjunctions
+            = astrodynamics::screenConjunctions( firstStateHistory, secondStateHistory, 1.0e4 );
+
+    // Check that the four conjunctions in the common time span are found.
+    BOOST_REQUIRE_EQUAL( conjunctions.size( ), 4 );
+    for ( std::size_t i = 0; i < conjunctions.size( ); i++ )
+    {
+        BOOST_CHECK_SMALL( conjunctions[ i ].timeOfClosestApproach
+                           - static_cast< double >( i + 1 ) * PI / angularVelocity, 1.0e-2 );
+        BOOST_CHECK_SMALL( conjunctions[ i ].missDistance - 500.0, 1.0 );
+    }
+}
+
+//! Test screening of two close approaches between the same two epochs.
+BOOST_AUTO_TEST_CASE( testScreenConjunctionsCloseApproachesInOneStep )
+{
+    // Set relative motion x( s ) = 1000 ( s - 0.52 ) ( s - 0.6 ) ( s - 2 ), y = 100, with
+    // normalized time s = ( t - 1000 ) / 100, so that the distance has minima of 100 m at 1052 s
+    // and 1060 s, with a maximum in between. The relative position is cubic, so that it is
+    // interpolated exactly from the states at 1000 s and 1100 s.
+    basics::DoubleKeyVector6dValueMap firstStateHistory;
+    basics::DoubleKeyVector6dValueMap secondStateHistory;
+    for ( int k = 0; k < 2; k++ )
+    {
+        const double s = k;
+        const double x = 1000.0 * ( s - 0.52 ) * ( s - 0.6 ) * ( s - 2.0 );
+        const double xDot = 10.0 * ( ( s - 0.6 ) * ( s - 2.0 ) + ( s - 0.52 ) * ( s - 2.0 )
+                                     + ( s - 0.52 ) * ( s - 0.6 ) );
+        firstStateHistory[ 1000.0 + 100.0 * s ] = Vector6d::Zero( );
+        Vector6d state;
+        state << x, 100.0, 0.0, xDot, 0.0, 0.0;
+        secondStateHistory[ 1000.0 + 100.0 * s ] = state;
+    }
+
+    // Check that both close approaches are found.
+    const std::vector< astrodynamics::Conjunction > conjunctions
+            = astrodynamics::screenConjunctions( firstStateHistory, secondStateHistory, 200.0 );
+
+    BOOST_REQUIRE_EQUAL( conjunctions.size( ), 2 );
+    BOOST_CHECK_CLOSE_FRACTION( conjunctions[ 0 ].timeOfClosestApproach, 1052.0, 1.0e-12 );
+    BOOST_CHECK_CLOSE_FRACTION( conjunctions[ 0 ].missDistance, 100.0, 1.0e-12 );
+    BOOST_CHECK_CLOSE_FRACTION( conjunctions[ 1 ].timeOfClosestApproach, 1060.0, 1.0e-12 );
+    BOOST_CHECK_CLOSE_FRACTION( conjunctions[ 1 ].missDistance, 100.0, 1.0e-12 );
+}
+
+//! Test screening of pairs of objects in parallel.
+BOOST_AUTO_TEST_CASE( testScreenConjunctionsPairs )
+{
+    using tudat::basic_mathematics::mathematical_constants::PI;
+
+    std::vector< basics::DoubleKeyVector6dValueMap > stateHistories;
+    stateHistories.push_back( sampleOrbit( 0.0, 60.0, 0.0, 0.0 ) );
+    stateHistories.push_back( sampleOrbit( 5.0, 45.0, 500.0, 0.25 * PI ) );
+    stateHistories.push_back( sampleOrbit( 0.0, 50.0, -2000.0, 0.5 * PI ) );
+    stateHistories.push_back( sampleOrbit( 0.0, 50.0, 1.0e5, 0.0 ) );
+
+    std::vector< astrodynamics::BodyIndexPair > objectPairs;
+    for ( std::size_t i = 0; i < stateHistories.size( ); i++ )
+    {
+        for ( std::size_t j = i + 1; j < stateHistories.size( ); j++ )
+        {
+            objectPairs.push_back( astrodynamics::BodyIndexPair( i, j ) );
+        }
+    }
+
+    // Screen pairs with one and multiple threads.
+    const std::vector< astrodynamics::Conjunction > conjunctions
+            = astrodynamics::screenConjunctions( stateHistories, objectPairs, 1.0e4 );
+    const std::vector< astrodynamics::Conjunction > conjunctionsInParallel
+            = astrodynamics::screenConjunctions( stateHistories, objectPairs, 1.0e4, 3 );
+
+    // Check that the results are identical, and match screening of each pair.
+    BOOST_REQUIRE_EQUAL( conjunctionsInParallel.size( ), conjunctions.size( ) );
+
+    std::size_t numberOfConjunctions = 0;
+    for ( std::size_t p = 0; p < objectPairs.size( ); p++ )
+    {
+        const std::vector< astrodynamics::Conjunction > pairConjunctions
+                = astrodynamics::screenConjunctions( stateHistories[ objectPairs[ p ].first ],
+                                                     stateHistories[ objectPairs[ p ].second ],
+                                                     1.0e4 );
+
+        for ( std::size_t i = 0; i < pairConjunctions.size( ); i++ )
+        {
+            const std::size_t index = numberOfConjunctions + i;
+            BOOST_REQUIRE_LT( index, conjunctions.size( ) );
+            BOOST_CHECK_EQUAL( conjunctions[ index ].firstObject, objectPairs[ p ].first );
+            BOOST_CHECK_EQUAL( conjunctions[ index ].secondObject, objectPairs[ p ].second );
+            BOOST_CHECK_EQUAL( conjunctions[ index ].timeOfClosestApproach,
+                               pairConjunctions[ i ].timeOfClosestApproach );
+            BOOST_CHECK_EQUAL( conjunctions[ index ].missDistance,
+                               pairConjunctions[ i ].missDistance );
+            BOOST_CHECK_EQUAL( conjunctionsInParallel[ index ].timeOfClosestApproach,
+                               pairConjunctions[ i ].timeOfClosestApproach );
+            BOOST_CHECK_EQUAL( conjunctionsInParallel[ index ].missDistance,
+                               pairConjunctions[ i ].missDistance );
+        }
+
+        numberOfConjunctions += pairConjunctions.size( );
+    }
+
+    // Check that conjunctions are found for the three objects that cross each other (three
+    // pairs, with four conjunctions each), and none for the object on the outer orbit.
+    BOOST_CHECK_EQUAL( numberOfConjunctions, conjunctions.size( ) );
+    BOOST_CHECK_EQUAL( conjunctions.size( ), 12 );
+}
+
+//! Test that run-time errors are thrown for invalid input.
+BOOST_AUTO_TEST_CASE( testScreenConjunctionsErrors )
+{
+    // Declare error flags.
+    bool isErrorThrownForScreeningDistance = false;
+    bool isErrorThrownForIndex = false;
+
+    std::vector< basics::DoubleKeyVector6dValueMap > stateHistories;
+    stateHistories.push_back( sampleOrbit( 0.0, 60.0, 0.0, 0.0 ) );
+    stateHistories.push_back( sampleOrbit( 0.0, 60.0, 500.0, 1.0 ) );
+
+    // Try to screen with zero screening distance.
+    try
+    {
+        astrodynamics::screenConjunctions( stateHistories[ 0 ], stateHistories[ 1 ], 0.0 );
+    }
+
+    catch ( std::runtime_error& )
+    {
+        isErrorThrownForScreeningDistance = true;
+    }
+
+    // Try to screen pair with index out of range.
+    try
+    {
+        astrodynamics::screenConjunctions(
+                    stateHistories,
+                    std::vector< astrodynamics::BodyIndexPair >(
+                        1, astrodynamics::BodyIndexPair( 0, 2 ) ), 1.0e4 );
+    }
+
+    catch ( std::runtime_error& )
+    {
+        isErrorThrownForIndex = true;
+    }
+
+    // Check that errors were thrown.
+    BOOST_CHECK( isErrorThrownForScreeningDistance );
+    BOOST_CHECK( isErrorThrownForIndex );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace assist
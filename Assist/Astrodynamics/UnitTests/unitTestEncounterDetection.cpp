@@ -0,0 +1,163 @@
+/*
+ *    Copyright (c) 2010-2014, Delft University of Technology
+ *    Copyright (c) 2010-2014, K. Kumar (me@kartikkumar.com)
+ *    All rights reserved.
+ *    See http://bit.ly/1jern3m for license details.
+ */
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_real_distribution.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include "Assist/Astrodynamics/encounterDetection.h"
+#include "Assist/Astrodynamics/hillSphereEngine.h"
+
+namespace assist
+{
+namespace unit_tests
+{
+
+BOOST_AUTO_TEST_SUITE( test_encounter_detection )
+
+//! Test detection of encounters for hand-made configuration.
+BOOST_AUTO_TEST_CASE( testDetectEncountersHandMade )
+{
+    using astrodynamics::BodyIndexPair;
+
+    // Set positions and Hill radii: bodies 0 and 2 are within 3 Hill radii of body 2, bodies 1
+    // and 3 are only within 3 Hill radii of body 3 (the largest of the two), and body 4 is
+    // isolated. Body 0 is exactly at the encounter distance of body 1, which does not count.
+    Eigen::MatrixX3d positions( 5, 3 );
+    positions << 0.0, 0.0, 0.0,
+            30.0, 0.0, 0.0,
+            -1.0, 2.0, 2.0,
+            70.0, 0.0, 0.0,
+            -1000.0, 500.0, 200.0;
+
+    Eigen::ArrayXd hillRadii( 5 );
+    hillRadii << 1.0, 10.0, 1.5, 15.0, 5.0;
+
+    std::vector< BodyIndexPair > expectedEncounters;
+    expectedEncounters.push_back( BodyIndexPair( 0, 2 ) );
+    expectedEncounters.push_back( BodyIndexPair( 1, 3 ) );
+
+    // Detect encounters with both methods.
+    const std::vector< BodyIndexPair > encountersWithGrid
+            = astrodynamics::detectEncounters( positions, hillRadii, 3.0 );
+    const std::vector< BodyIndexPair > encountersBruteForce
+            = astrodynamics::detectEncounters( positions, hillRadii, 3.0,
+                                               astrodynamics::bruteForceEncounterDetection );
+
+    // Check that expected encounters are detected.
+    BOOST_CHECK( encountersWithGrid == expectedEncounters );
+    BOOST_CHECK( encountersBruteForce == expectedEncounters );
+}
+
+//! Test that uniform grid and brute-force detection agree for random population.
+BOOST_AUTO_TEST_CASE( testDetectEncountersGridAgainstBruteForce )
+{
+    using astrodynamics::BodyIndexPair;
+
+    // Set population of bodies in a thin disk between 1 and 3 AU, with gravitational parameters
+    // spread over eight orders of magnitude, and compute their Hill radii.
+    const int numberOfBodies = 3000;
+    const double centralBodyGravitationalParameter = 1.32712440018e20;
+
+    boost::random::mt19937 randomNumberGenerator( 1234 );
+    boost::random::uniform_real_distribution< > radiusDistribution( 1.5e11, 4.5e11 );
+    boost::random::uniform_real_distribution< > angleDistribution( 0.0, 6.283185307179586 );
+    boost::random::uniform_real_distribution< > heightDistribution( -1.0e9, 1.0e9 );
+    boost::random::uniform_real_distribution< > logarithmDistribution( 6.0, 14.0 );
+
+    Eigen::MatrixX3d positions( numberOfBodies, 3 );
+    Eigen::ArrayXd gravitationalParameters( numberOfBodies );
+    for ( int i = 0; i < numberOfBodies; i++ )
+    {
+        const double radius = radiusDistribution( randomNumberGenerator );
+        const double angle = angleDistribution( randomNumberGenerator );
+        positions( i, 0 ) = radius * std::cos( angle );
+        positions( i, 1 ) = radius * std::sin( angle );
+        positions( i, 2 ) = heightDistribution( randomNumberGenerator );
+        gravitationalParameters( i )
+                = std::pow( 10.0, logarithmDistribution( randomNumberGenerator ) );
+    }
+
+    const astrodynamics::HillSphereEngine hillSphereEngine(
+                centralBodyGravitationalParameter, gravitationalParameters,
+                positions.rowwise( ).norm( ).array( ) );
+    const Eigen::ArrayXd hillRadii = hillSphereEngine.getHillRadii( );
+
+    // Set number of Hill radii such that the largest bodies encounter several others.
+    const double numberOfHillRadii = 10.0;
+
+    // Detect encounters with both methods, and different numbers of threads.
+    const std::vector< BodyIndexPair > encountersBruteForce
+            = astrodynamics::detectEncounters( positions, hillRadii, numberOfHillRadii,
+                                               astrodynamics::bruteForceEncounterDetection );
+    const std::vector< BodyIndexPair > encountersWithGrid
+            = astrodynamics::detectEncounters( positions, hillRadii, numberOfHillRadii );
+    const std::vector< BodyIndexPair > encountersWithGridInParallel
+            = astrodynamics::detectEncounters( positions, hillRadii, numberOfHillRadii,
+                                               astrodynamics::uniformGridEncounterDetection, 4 );
+    const std::vector< BodyIndexPair > encountersBruteForceInParallel
+            = astrodynamics::detectEncounters( positions, hillRadii, numberOfHillRadii,
+                                               astrodynamics::bruteForceEncounterDetection, 4 );
+
+    // Check that encounters are detected, and that all results are identical.
+    BOOST_CHECK_GT( encountersBruteForce.size( ), 10 );
+    BOOST_CHECK( encountersWithGrid == encountersBruteForce );
+    BOOST_CHECK( encountersWithGridInParallel == encountersBruteForce );
+    BOOST_CHECK( encountersBruteForceInParallel == encountersBruteForce );
+}
+
+//! Test detection of encounters for degenerate populations.
+BOOST_AUTO_TEST_CASE( testDetectEncountersDegenerate )
+{
+    // Check that no encounters are detected for a single body.
+    BOOST_CHECK( astrodynamics::detectEncounters(
+                     Eigen::MatrixX3d::Zero( 1, 3 ), Eigen::ArrayXd::Ones( 1 ), 3.0 ).empty( ) );
+
+    // Check that no encounters are detected for bodies with zero Hill radii, even if they
+    // coincide.
+    BOOST_CHECK( astrodynamics::detectEncounters(
+                     Eigen::MatrixX3d::Zero( 4, 3 ), Eigen::ArrayXd::Zero( 4 ), 3.0 ).empty( ) );
+
+    // Check that all pairs are detected for coinciding bodies with positive Hill radii.
+    BOOST_CHECK_EQUAL( astrodynamics::detectEncounters(
+                           Eigen::MatrixX3d::Zero( 4, 3 ), Eigen::ArrayXd::Ones( 4 ),
+                           3.0 ).size( ), 6 );
+}
+
+//! Test that run-time error is thrown if number of Hill radii does not match positions.
+BOOST_AUTO_TEST_CASE( testDetectEncountersSizeMismatch )
+{
+    // Declare error flag.
+    bool isErrorThrown = false;
+
+    // Try to detect encounters with mismatching sizes.
+    try
+    {
+        astrodynamics::detectEncounters( Eigen::MatrixX3d::Zero( 4, 3 ),
+                                         Eigen::ArrayXd::Ones( 3 ), 3.0 );
+    }
+
+    // Catch expected run-time error.
+    catch ( std::runtime_error& )
+    {
+        isErrorThrown = true;
+    }
+
+    // Check that error was thrown.
+    BOOST_CHECK( isErrorThrown );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace assist
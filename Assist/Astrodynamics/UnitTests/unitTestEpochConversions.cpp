@@ -0,0 +1,123 @@
+/*
+ *    Copyright (c) 2010-2014, Delft University of Technology
+ *    Copyright (c) 2010-2014, K. Kumar (me@kartikkumar.com)
+ *    All rights reserved.
+ *    See http://bit.ly/1jern3m for license details.
+ */
+
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include "Assist/Astrodynamics/epochConversions.h"
+#include "Assist/Astrodynamics/unitConversions.h"
+#include "Assist/Basics/commonTypedefs.h"
+
+namespace assist
+{
+namespace unit_tests
+{
+
+BOOST_AUTO_TEST_SUITE( test_epoch_conversions )
+
+//! Test rescaling of epochs stored in contiguous arrays.
+BOOST_AUTO_TEST_CASE( testRescaleEpochsOfArrays )
+{
+    // Rescale epochs stored as Eigen array.
+    Eigen::ArrayXd epochs = Eigen::ArrayXd::LinSpaced( 1001, 0.0, 1.0e7 );
+    const Eigen::ArrayXd originalEpochs = epochs;
+    astrodynamics::convertEpochs< astrodynamics::units::Second,
+            astrodynamics::units::JulianDay >( epochs );
+
+    for ( int i = 0; i < epochs.size( ); i++ )
+    {
+        BOOST_CHECK_EQUAL( epochs( i ),
+                           astrodynamics::convertSecondsToJulianDays( originalEpochs( i ) ) );
+    }
+
+    // Rescale epochs stored as vector.
+    std::vector< double > epochVector( 3, 86400.0 );
+    epochVector[ 1 ] = 0.0;
+    astrodynamics::convertEpochs< astrodynamics::units::Second,
+            astrodynamics::units::JulianDay >( epochVector );
+    BOOST_CHECK_EQUAL( epochVector[ 0 ], 1.0 );
+    BOOST_CHECK_EQUAL( epochVector[ 1 ], 0.0 );
+    BOOST_CHECK_EQUAL( epochVector[ 2 ], 1.0 );
+
+    std::vector< double > emptyEpochVector;
+    astrodynamics::rescaleEpochs( emptyEpochVector, 2.0 );
+    BOOST_CHECK( emptyEpochVector.empty( ) );
+
+    // Rescale epoch column of flat series, leaving other columns untouched.
+    Eigen::MatrixXd series = Eigen::MatrixXd::Ones( 4, 3 );
+    series.col( 1 ) << 0.0, 1.0, 2.0, 3.0;
+    astrodynamics::rescaleEpochs( series, 10.0, 1 );
+    BOOST_CHECK_EQUAL( series( 3, 1 ), 30.0 );
+    BOOST_CHECK_EQUAL( series( 3, 0 ), 1.0 );
+    BOOST_CHECK_EQUAL( series( 3, 2 ), 1.0 );
+}
+
+//! Test rescaling of epochs of series stored as maps.
+BOOST_AUTO_TEST_CASE( testRescaleEpochsOfMaps )
+{
+    // Set step-function map and state history with epochs in seconds.
+    basics::DoubleKeyDoubleValueMap stepFunction;
+    basics::DoubleKeyVector6dValueMap stateHistory;
+    for ( int i = 0; i < 1000; i++ )
+    {
+        stepFunction[ i * 3600.0 ] = i;
+        stateHistory[ i * 3600.0 ] = tudat::basic_mathematics::Vector6d::Constant( i );
+    }
+
+    // Convert epochs to Julian years, and check that values are unchanged.
+    astrodynamics::convertEpochs< astrodynamics::units::Second,
+            astrodynamics::units::JulianYear >( stepFunction );
+    astrodynamics::convertEpochs< astrodynamics::units::Second,
+            astrodynamics::units::JulianYear >( stateHistory );
+    BOOST_REQUIRE_EQUAL( stepFunction.size( ), 1000 );
+    BOOST_REQUIRE_EQUAL( stateHistory.size( ), 1000 );
+
+    basics::DoubleKeyVector6dValueMap::const_iterator iteratorState = stateHistory.begin( );
+    int i = 0;
+    for ( basics::DoubleKeyDoubleValueMap::const_iterator iteratorStep = stepFunction.begin( );
+          iteratorStep != stepFunction.end( ); iteratorStep++, iteratorState++, i++ )
+    {
+        BOOST_CHECK_EQUAL( iteratorStep->first,
+                           astrodynamics::convertSecondsToJulianYears( i * 3600.0 ) );
+        BOOST_CHECK_EQUAL( iteratorStep->second, i );
+        BOOST_CHECK_EQUAL( iteratorState->first, iteratorStep->first );
+        BOOST_CHECK( iteratorState->second == tudat::basic_mathematics::Vector6d::Constant( i ) );
+    }
+
+    // Rescale with negative scale factor, which reverses the order of the epochs.
+    astrodynamics::rescaleEpochs( stepFunction, -1.0 );
+    BOOST_CHECK_EQUAL( stepFunction.size( ), 1000 );
+    BOOST_CHECK_EQUAL( stepFunction.begin( )->second, 999.0 );
+    BOOST_CHECK_EQUAL( stepFunction.rbegin( )->first, 0.0 );
+
+    // Check that a run-time error is thrown for a scale factor of zero.
+    bool isErrorThrown = false;
+
+    try
+    {
+        astrodynamics::rescaleEpochs( stepFunction, 0.0 );
+    }
+
+    catch ( std::runtime_error& error )
+    {
+        isErrorThrown = true;
+    }
+
+    BOOST_CHECK( isErrorThrown );
+    BOOST_CHECK_EQUAL( stepFunction.size( ), 1000 );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace assist
@@ -5,22 +5,50 @@
  *    See http://bit.ly/1jern3m for license details.
  */
 
+#include <cmath>
+#include <limits>
+
 #include <boost/test/floating_point_comparison.hpp>
 #include <boost/test/unit_test.hpp> 
 
+#include "Assist/Astrodynamics/hillSphere.h"
+
 namespace assist
 {
 namespace unit_tests
 {
 
+BOOST_AUTO_TEST_SUITE( test_hill_sphere )
+
 //! Test implementation of function to convert Hill radii to meters.
 BOOST_AUTO_TEST_CASE( testConvertHillRadiiToMetersFunction )
 { 
+    // Set gravitational parameters of Sun and Earth [m^3 s^-2], and semi-major axis of Earth [m].
+    const double sunGravitationalParameter = 1.32712440018e20;
+    const double earthGravitationalParameter = 3.986004418e14;
+    const double earthSemiMajorAxis = 1.495978707e11;
+
+    // Set expected Hill radius of Earth [m], given by a * ( mu / ( 3 M ) )^( 1/3 ).
+    const double expectedHillRadius = earthSemiMajorAxis
+            * std::pow( earthGravitationalParameter / ( 3.0 * sunGravitationalParameter ),
+                        1.0 / 3.0 );
+
+    // Convert Hill radii to meters.
+    astrodynamics::ConvertHillRadiiToMeters convertHillRadiiToMeters(
+                sunGravitationalParameter, earthGravitationalParameter, earthSemiMajorAxis );
+
+    // Check that the Hill radius of the Earth is approximately 1.5 million km.
+    BOOST_CHECK_CLOSE_FRACTION( convertHillRadiiToMeters( 1.0 ), 1.4966e9, 1.0e-4 );
+
+    // Check that computed distances match expected values.
+    BOOST_CHECK_CLOSE_FRACTION( convertHillRadiiToMeters( 1.0 ), expectedHillRadius,
+                                std::numeric_limits< double >::epsilon( ) );
+    BOOST_CHECK_CLOSE_FRACTION( convertHillRadiiToMeters( 3.5 ), 3.5 * expectedHillRadius,
+                                std::numeric_limits< double >::epsilon( ) );
+    BOOST_CHECK_EQUAL( convertHillRadiiToMeters( 0.0 ), 0.0 );
 }
 
+BOOST_AUTO_TEST_SUITE_END( )
+
 } // namespace unit_tests
 } // namespace assist
-
-/*
- *    Unit tests need to be added.
- */
\ No newline at end of file
@@ -0,0 +1,218 @@
+/*
+ *    Copyright (c) 2010-2014, Delft University of Technology
+ *    Copyright (c) 2010-2014, K. Kumar (me@kartikkumar.com)
+ *    All rights reserved.
+ *    See http://bit.ly/1jern3m for license details.
+ */
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include <boost/math/special_functions/cbrt.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include "Assist/Astrodynamics/hillSphere.h"
+#include "Assist/Astrodynamics/hillSphereEngine.h"
+
+namespace assist
+{
+namespace unit_tests
+{
+
+BOOST_AUTO_TEST_SUITE( test_hill_sphere_engine )
+
+//! Test implementation of function to compute cube roots of array of values.
+BOOST_AUTO_TEST_CASE( testComputeCubeRootsFunction )
+{
+    // Set values including zero, exact cubes, 1e-300 and 1e300, and exponentials spanning about
+    // 1e-130 to 1e130.
+    Eigen::ArrayXd values( 7 + 601 );
+    values << 0.0, 1.0, 8.0, 27.0, 1.0e-300, 1.0e300, 0.001,
+            Eigen::ArrayXd::LinSpaced( 601, -300.0, 300.0 ).exp( );
+
+    // Compute cube roots.
+    Eigen::ArrayXd cubeRoots;
+    astrodynamics::computeCubeRoots( values, cubeRoots );
+    BOOST_REQUIRE_EQUAL( cubeRoots.size( ), values.size( ) );
+
+    // Check that zero maps to zero.
+    BOOST_CHECK_EQUAL( cubeRoots( 0 ), 0.0 );
+
+    // Check that cube roots match reference values to within a few ulp.
+    for ( int i = 1; i < values.size( ); i++ )
+    {
+        BOOST_CHECK_CLOSE_FRACTION( cubeRoots( i ), boost::math::cbrt( values( i ) ),
+                                    4.0 * std::numeric_limits< double >::epsilon( ) );
+    }
+}
+
+//! Test that Hill radii of engine match scalar reference.
+BOOST_AUTO_TEST_CASE( testHillSphereEngineAgainstScalarReference )
+{
+    // Set gravitational parameters log-uniformly over 15 orders of magnitude, and semi-major
+    // axes uniformly between 50 and 0.5 AU, around the Sun.
+    const double centralBodyGravitationalParameter = 1.32712440018e20;
+    const int numberOfBodies = 10000;
+    const Eigen::ArrayXd orbitingBodyGravitationalParameters
+            = ( std::log( 10.0 ) * Eigen::ArrayXd::LinSpaced( numberOfBodies, 0.0, 15.0 ) ).exp( );
+    const Eigen::ArrayXd semiMajorAxes
+            = Eigen::ArrayXd::LinSpaced( numberOfBodies, 7.5e12, 7.5e10 );
+
+    // Set up engine.
+    const astrodynamics::HillSphereEngine hillSphereEngine(
+                centralBodyGravitationalParameter, orbitingBodyGravitationalParameters,
+                semiMajorAxes );
+    BOOST_REQUIRE_EQUAL( hillSphereEngine.getNumberOfBodies( ), numberOfBodies );
+
+    // Convert 2.5 Hill radii to meters for all bodies.
+    Eigen::ArrayXd distances;
+    hillSphereEngine.convertHillRadiiToMeters( 2.5, distances );
+    BOOST_REQUIRE_EQUAL( distances.size( ), numberOfBodies );
+
+    // Check that Hill radii and converted distances match scalar reference.
+    for ( int i = 0; i < numberOfBodies; i++ )
+    {
+        astrodynamics::ConvertHillRadiiToMeters convertHillRadiiToMeters(
+                    centralBodyGravitationalParameter, orbitingBodyGravitationalParameters( i ),
+                    semiMajorAxes( i ) );
+
+        BOOST_CHECK_CLOSE_FRACTION( hillSphereEngine.getHillRadii( )( i ),
+                                    convertHillRadiiToMeters( 1.0 ),
+                                    8.0 * std::numeric_limits< double >::epsilon( ) );
+        BOOST_CHECK_CLOSE_FRACTION( distances( i ), convertHillRadiiToMeters( 2.5 ),
+                                    8.0 * std::numeric_limits< double >::epsilon( ) );
+        BOOST_CHECK_EQUAL( hillSphereEngine.convertHillRadiiToMeters( i, 2.5 ), distances( i ) );
+    }
+}
+
+//! Test that engine updates Hill radii when semi-major axes are set.
+BOOST_AUTO_TEST_CASE( testHillSphereEngineSetSemiMajorAxes )
+{
+    // Set population of orbiting bodies around the Sun.
+    const double centralBodyGravitationalParameter = 1.32712440018e20;
+    const int numberOfBodies = 10000;
+    const Eigen::ArrayXd orbitingBodyGravitationalParameters
+            = ( std::log( 10.0 ) * Eigen::ArrayXd::LinSpaced( numberOfBodies, 0.0, 15.0 ) ).exp( );
+    const Eigen::ArrayXd semiMajorAxes
+            = Eigen::ArrayXd::LinSpaced( numberOfBodies, 7.5e12, 7.5e10 );
+
+    // Set up engine.
+    astrodynamics::HillSphereEngine hillSphereEngine(
+                centralBodyGravitationalParameter, orbitingBodyGravitationalParameters,
+                semiMajorAxes );
+    const Eigen::ArrayXd hillRadiusFactors = hillSphereEngine.getHillRadiusFactors( );
+
+    // Set new semi-major axes, and check that Hill radius factors are unchanged, while Hill
+    // radii scale with the semi-major axes.
+    const Eigen::ArrayXd newSemiMajorAxes = 1.5 * semiMajorAxes;
+    hillSphereEngine.setSemiMajorAxes( newSemiMajorAxes );
+
+    for ( int i = 0; i < numberOfBodies; i++ )
+    {
+        BOOST_CHECK_EQUAL( hillSphereEngine.getHillRadiusFactors( )( i ),
+                           hillRadiusFactors( i ) );
+        BOOST_CHECK_EQUAL( hillSphereEngine.getHillRadii( )( i ),
+                           hillRadiusFactors( i ) * newSemiMajorAxes( i ) );
+    }
+
+    // Check that a run-time error is thrown if the number of semi-major axes is incorrect.
+    bool isErrorThrown = false;
+
+    try
+    {
+        hillSphereEngine.setSemiMajorAxes( Eigen::ArrayXd::Ones( numberOfBodies - 1 ) );
+    }
+
+    catch ( std::runtime_error& error )
+    {
+        isErrorThrown = true;
+    }
+
+    BOOST_CHECK( isErrorThrown );
+}
+
+//! Test that results of engine do not depend on number of threads.
+BOOST_AUTO_TEST_CASE( testHillSphereEngineNumberOfThreads )
+{
+    // Set population of orbiting bodies around the Sun.
+    const double centralBodyGravitationalParameter = 1.32712440018e20;
+    const int numberOfBodies = 10000;
+    const Eigen::ArrayXd orbitingBodyGravitationalParameters
+            = ( std::log( 10.0 ) * Eigen::ArrayXd::LinSpaced( numberOfBodies, 0.0, 15.0 ) ).exp( );
+    const Eigen::ArrayXd semiMajorAxes
+            = Eigen::ArrayXd::LinSpaced( numberOfBodies, 7.5e12, 7.5e10 );
+
+    // Set up engine with one thread, and with multiple threads.
+    astrodynamics::HillSphereEngine serialHillSphereEngine(
+                centralBodyGravitationalParameter, orbitingBodyGravitationalParameters,
+                semiMajorAxes, 1 );
+    astrodynamics::HillSphereEngine parallelHillSphereEngine(
+                centralBodyGravitationalParameter, orbitingBodyGravitationalParameters,
+                semiMajorAxes, 4 );
+
+    // Check that Hill radii are identical.
+    BOOST_CHECK( ( serialHillSphereEngine.getHillRadii( )
+                   == parallelHillSphereEngine.getHillRadii( ) ).all( ) );
+
+    // Check that converted distances are identical.
+    Eigen::ArrayXd serialDistances;
+    Eigen::ArrayXd parallelDistances;
+    serialHillSphereEngine.convertHillRadiiToMeters( 0.3, serialDistances );
+    parallelHillSphereEngine.convertHillRadiiToMeters( 0.3, parallelDistances );
+    BOOST_CHECK( ( serialDistances == parallelDistances ).all( ) );
+}
+
+//! Test that engine throws run-time errors for invalid input.
+BOOST_AUTO_TEST_CASE( testHillSphereEngineInvalidInput )
+{
+    // Set small population of orbiting bodies.
+    const double centralBodyGravitationalParameter = 1.32712440018e20;
+    const int numberOfBodies = 3;
+    const Eigen::ArrayXd orbitingBodyGravitationalParameters
+            = Eigen::ArrayXd::Constant( numberOfBodies, 1.0e10 );
+    const Eigen::ArrayXd semiMajorAxes
+            = Eigen::ArrayXd::LinSpaced( numberOfBodies, 1.0e11, 3.0e11 );
+
+    // Check that a run-time error is thrown if the central body gravitational parameter is not
+    // positive.
+    bool isErrorThrown = false;
+
+    try
+    {
+        astrodynamics::HillSphereEngine hillSphereEngine(
+                    0.0, orbitingBodyGravitationalParameters, semiMajorAxes );
+    }
+
+    catch ( std::runtime_error& error )
+    {
+        isErrorThrown = true;
+    }
+
+    BOOST_CHECK( isErrorThrown );
+
+    // Check that a run-time error is thrown if the sizes of the arrays do not match.
+    isErrorThrown = false;
+
+    try
+    {
+        astrodynamics::HillSphereEngine hillSphereEngine(
+                    centralBodyGravitationalParameter, orbitingBodyGravitationalParameters,
+                    semiMajorAxes.head( numberOfBodies - 1 ) );
+    }
+
+    catch ( std::runtime_error& error )
+    {
+        isErrorThrown = true;
+    }
+
+    BOOST_CHECK( isErrorThrown );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace assist
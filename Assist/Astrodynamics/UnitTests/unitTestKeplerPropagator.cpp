@@ -0,0 +1,304 @@
+/*
+ *    Copyright (c) 2010-2014, Delft University of Technology
+ *    Copyright (c) 2010-2014, K. Kumar (me@kartikkumar.com)
+ *    All rights reserved.
+ *    See http://bit.ly/1jern3m for license details.
+ */
+
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+#include <TudatCore/Mathematics/BasicMathematics/mathematicalConstants.h>
+
+#include "Assist/Astrodynamics/keplerPropagator.h"
+#include "Assist/Basics/commonTypedefs.h"
+
+namespace assist
+{
+namespace unit_tests
+{
+
+namespace
+{
+
+//! Solve Kepler's equation with Newton-Raphson iterations until convergence (scalar reference).
+double solveKeplersEquationWithNewtonRaphson( const double meanAnomaly,
+                                              const double eccentricity )
+{
+    using tudat::basic_mathematics::mathematical_constants::PI;
+
+    const double reducedMeanAnomaly = meanAnomaly - 2.0 * PI * std::floor(
+                ( meanAnomaly + PI ) / ( 2.0 * PI ) );
+
+    double eccentricAnomaly = eccentricity > 0.8 ? PI * ( reducedMeanAnomaly < 0.0 ? -1 : 1 )
+                                                 : reducedMeanAnomaly;
+    for ( unsigned int i = 0; i < 100; i++ )
+    {
+        const double correction
+                = ( eccentricAnomaly - eccentricity * std::sin( eccentricAnomaly )
+                    - reducedMeanAnomaly ) / ( 1.0 - eccentricity * std::cos( eccentricAnomaly ) );
+        eccentricAnomaly -= correction;
+
+        if ( std::fabs( correction ) < 1.0e-15 )
+        {
+            break;
+        }
+    }
+
+    return eccentricAnomaly;
+}
+
+//! Convert Keplerian elements to Cartesian state with rotation matrices (scalar reference).
+tudat::basic_mathematics::Vector6d convertKeplerianToCartesianElements(
+        const double gravitationalParameter, const double semiMajorAxis,
+        const double eccentricity, const double inclination, const double argumentOfPeriapsis,
+        const double longitudeOfAscendingNode, const double meanAnomaly )
+{
+    // Compute true anomaly and radius.
+    const double eccentricAnomaly
+            = solveKeplersEquationWithNewtonRaphson( meanAnomaly, eccentricity );
+    const double trueAnomaly = 2.0 * std::atan2(
+                std::sqrt( 1.0 + eccentricity ) * std::sin( eccentricAnomaly / 2.0 ),
+                std::sqrt( 1.0 - eccentricity ) * std::cos( eccentricAnomaly / 2.0 ) );
+    const double semiLatusRectum = semiMajorAxis * ( 1.0 - eccentricity * eccentricity );
+    const double radius = semiLatusRectum / ( 1.0 + eccentricity * std::cos( trueAnomaly ) );
+
+    // Compute position and velocity in perifocal frame.
+    const Eigen::Vector3d position( radius * std::cos( trueAnomaly ),
+                                    radius * std::sin( trueAnomaly ), 0.0 );
+    const double velocityScale = std::sqrt( gravitationalParameter / semiLatusRectum );
+    const Eigen::Vector3d velocity( -velocityScale * std::sin( trueAnomaly ),
+                                    velocityScale * ( eccentricity + std::cos( trueAnomaly ) ),
+                                    0.0 );
+
+    // Rotate to inertial frame.
+    const Eigen::Matrix3d rotation
+            = ( Eigen::AngleAxisd( longitudeOfAscendingNode, Eigen::Vector3d::UnitZ( ) )
+                * Eigen::AngleAxisd( inclination, Eigen::Vector3d::UnitX( ) )
+                * Eigen::AngleAxisd( argumentOfPeriapsis, Eigen::Vector3d::UnitZ( ) ) )
+            .toRotationMatrix( );
+
+    tudat::basic_mathematics::Vector6d state;
+    state << rotation * position, rotation * velocity;
+    return state;
+}
+
+//! Compute fractional parts of multiples of given number, i.e., a quasi-random sequence.
+Eigen::ArrayXd computeFractionalParts( const int numberOfElements, const double number )
+{
+    const Eigen::ArrayXd multiples
+            = number * Eigen::ArrayXd::LinSpaced( numberOfElements, 0.0, numberOfElements - 1.0 );
+    return multiples - multiples.floor( );
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE( test_kepler_propagator )
+
+//! Test implementation of function to solve Kepler's equation.
+BOOST_AUTO_TEST_CASE( testSolveKeplersEquationFunction )
+{
+    // Set grid of mean anomalies, including large and negative values, and eccentricities up to
+    // 0.9999.
+    const int numberOfMeanAnomalies = 401;
+    const int numberOfEccentricities = 101;
+    Eigen::ArrayXd meanAnomalies( numberOfMeanAnomalies * numberOfEccentricities );
+    Eigen::ArrayXd eccentricities( meanAnomalies.size( ) );
+    for ( int i = 0; i < numberOfMeanAnomalies; i++ )
+    {
+        for ( int j = 0; j < numberOfEccentricities; j++ )
+        {
+            meanAnomalies( i * numberOfEccentricities + j ) = -20.0 + 0.1 * i;
+            eccentricities( i * numberOfEccentricities + j )
+                    = 0.9999 * ( 1.0 - std::pow( 1.0 - j / 100.0, 3.0 ) );
+        }
+    }
+
+    // Solve Kepler's equation.
+    Eigen::ArrayXd eccentricAnomalies;
+    astrodynamics::solveKeplersEquation( meanAnomalies, eccentricities, eccentricAnomalies );
+    BOOST_REQUIRE_EQUAL( eccentricAnomalies.size( ), meanAnomalies.size( ) );
+
+    // Check that solutions match scalar reference, and satisfy Kepler's equation.
+    for ( int i = 0; i < meanAnomalies.size( ); i++ )
+    {
+        const double expectedEccentricAnomaly = solveKeplersEquationWithNewtonRaphson(
+                    meanAnomalies( i ), eccentricities( i ) );
+        BOOST_CHECK_SMALL( eccentricAnomalies( i ) - expectedEccentricAnomaly, 1.0e-12 );
+        BOOST_CHECK_SMALL( std::sin( eccentricAnomalies( i ) - meanAnomalies( i ) )
+                           - std::sin( eccentricities( i )
+                                       * std::sin( eccentricAnomalies( i ) ) ), 1.0e-13 );
+    }
+}
+
+//! Test that Cartesian states of catalog match scalar reference.
+BOOST_AUTO_TEST_CASE( testComputeCartesianStatesAgainstScalarReference )
+{
+    using tudat::basic_mathematics::mathematical_constants::PI;
+
+    // Set catalog of orbiting bodies around Earth, with elements spread quasi-randomly over
+    // their ranges.
+    const double earthGravitationalParameter = 3.986004418e14;
+    const int numberOfBodies = 3000;
+    astrodynamics::KeplerianElementArrays keplerianElements;
+    keplerianElements.semiMajorAxes
+            = 7.0e6 + 3.5e7 * computeFractionalParts( numberOfBodies, 0.618033988749895 );
+    keplerianElements.eccentricities
+            = 0.99 * computeFractionalParts( numberOfBodies, 0.414213562373095 );
+    keplerianElements.inclinations
+            = PI * computeFractionalParts( numberOfBodies, 0.732050807568877 );
+    keplerianElements.argumentsOfPeriapsis
+            = 2.0 * PI * computeFractionalParts( numberOfBodies, 0.236067977499790 );
+    keplerianElements.longitudesOfAscendingNode
+            = 2.0 * PI * computeFractionalParts( numberOfBodies, 0.645751311064591 );
+    keplerianElements.meanAnomalies
+            = 2.0 * PI * computeFractionalParts( numberOfBodies, 0.316624790355400 );
+
+    const double epochOfElements = 1000.0;
+    const double epoch = epochOfElements + 86400.0 * 3.3;
+
+    const astrodynamics::KeplerPropagator propagator(
+                earthGravitationalParameter, keplerianElements, epochOfElements );
+    BOOST_REQUIRE_EQUAL( propagator.getNumberOfBodies( ), numberOfBodies );
+
+    Eigen::MatrixXd cartesianStates;
+    propagator.computeCartesianStates( epoch, cartesianStates );
+    BOOST_REQUIRE_EQUAL( cartesianStates.rows( ), numberOfBodies );
+    BOOST_REQUIRE_EQUAL( cartesianStates.cols( ), 6 );
+
+    for ( int i = 0; i < numberOfBodies; i++ )
+    {
+        const double meanMotion = std::sqrt( earthGravitationalParameter
+                                             / std::pow( keplerianElements.semiMajorAxes( i ),
+                                                         3.0 ) );
+        const tudat::basic_mathematics::Vector6d expectedState
+                = convertKeplerianToCartesianElements(
+                    earthGravitationalParameter, keplerianElements.semiMajorAxes( i ),
+                    keplerianElements.eccentricities( i ), keplerianElements.inclinations( i ),
+                    keplerianElements.argumentsOfPeriapsis( i ),
+                    keplerianElements.longitudesOfAscendingNode( i ),
+                    keplerianElements.meanAnomalies( i )
+                    + meanMotion * ( epoch - epochOfElements ) );
+
+        // Errors in the mean anomaly after many revolutions are amplified for high
+        // eccentricities, so the tolerance is relative to the size of the position and velocity.
+        BOOST_CHECK_SMALL( ( cartesianStates.row( i ).head( 3 ).transpose( )
+                             - expectedState.head( 3 ) ).norm( )
+                           / expectedState.head( 3 ).norm( ), 1.0e-9 );
+        BOOST_CHECK_SMALL( ( cartesianStates.row( i ).tail( 3 ).transpose( )
+                             - expectedState.tail( 3 ) ).norm( )
+                           / expectedState.tail( 3 ).norm( ), 1.0e-9 );
+    }
+}
+
+//! Test that propagation stores state histories, independent of number of threads.
+BOOST_AUTO_TEST_CASE( testPropagate )
+{
+    using tudat::basic_mathematics::mathematical_constants::PI;
+
+    // Set catalog of orbiting bodies around Earth, with elements spread quasi-randomly over
+    // their ranges.
+    const double earthGravitationalParameter = 3.986004418e14;
+    const int numberOfBodies = 3000;
+    astrodynamics::KeplerianElementArrays keplerianElements;
+    keplerianElements.semiMajorAxes
+            = 7.0e6 + 3.5e7 * computeFractionalParts( numberOfBodies, 0.618033988749895 );
+    keplerianElements.eccentricities
+            = 0.99 * computeFractionalParts( numberOfBodies, 0.414213562373095 );
+    keplerianElements.inclinations
+            = PI * computeFractionalParts( numberOfBodies, 0.732050807568877 );
+    keplerianElements.argumentsOfPeriapsis
+            = 2.0 * PI * computeFractionalParts( numberOfBodies, 0.236067977499790 );
+    keplerianElements.longitudesOfAscendingNode
+            = 2.0 * PI * computeFractionalParts( numberOfBodies, 0.645751311064591 );
+    keplerianElements.meanAnomalies
+            = 2.0 * PI * computeFractionalParts( numberOfBodies, 0.316624790355400 );
+
+    // Set epochs.
+    std::vector< double > epochs;
+    for ( unsigned int i = 0; i < 10; i++ )
+    {
+        epochs.push_back( i * 600.0 );
+    }
+
+    // Propagate catalog on one thread and on multiple threads.
+    const astrodynamics::KeplerPropagator serialPropagator(
+                earthGravitationalParameter, keplerianElements, 0.0, 1 );
+    const astrodynamics::KeplerPropagator parallelPropagator(
+                earthGravitationalParameter, keplerianElements, 0.0, 3 );
+
+    std::vector< basics::DoubleKeyVector6dValueMap > serialStateHistories;
+    serialPropagator.propagate( epochs, serialStateHistories );
+
+    std::vector< basics::DoubleKeyVector6dValueMap > parallelStateHistories;
+    parallelPropagator.propagate( epochs, parallelStateHistories );
+
+    BOOST_REQUIRE_EQUAL( serialStateHistories.size( ), numberOfBodies );
+    BOOST_REQUIRE_EQUAL( parallelStateHistories.size( ), numberOfBodies );
+
+    // Check that state histories are identical, and match states computed per epoch.
+    Eigen::MatrixXd lastStates;
+    serialPropagator.computeCartesianStates( epochs.back( ), lastStates );
+
+    for ( int i = 0; i < numberOfBodies; i++ )
+    {
+        BOOST_REQUIRE_EQUAL( serialStateHistories.at( i ).size( ), epochs.size( ) );
+        BOOST_CHECK( serialStateHistories.at( i ) == parallelStateHistories.at( i ) );
+        BOOST_CHECK( serialStateHistories.at( i ).rbegin( )->second
+                     == lastStates.row( i ).transpose( ) );
+    }
+
+    // Check that the states conserve the specific orbital energy.
+    for ( basics::DoubleKeyVector6dValueMap::const_iterator iteratorState
+          = serialStateHistories.at( 0 ).begin( );
+          iteratorState != serialStateHistories.at( 0 ).end( ); iteratorState++ )
+    {
+        const double energy = 0.5 * iteratorState->second.tail( 3 ).squaredNorm( )
+                - earthGravitationalParameter / iteratorState->second.head( 3 ).norm( );
+        BOOST_CHECK_CLOSE_FRACTION( energy, -earthGravitationalParameter
+                                    / ( 2.0 * keplerianElements.semiMajorAxes( 0 ) ), 1.0e-12 );
+    }
+}
+
+//! Test that propagator throws run-time error for non-elliptical orbits.
+BOOST_AUTO_TEST_CASE( testKeplerPropagatorInvalidInput )
+{
+    // Set catalog with one hyperbolic orbit.
+    const double earthGravitationalParameter = 3.986004418e14;
+    astrodynamics::KeplerianElementArrays keplerianElements;
+    keplerianElements.semiMajorAxes = Eigen::ArrayXd::Constant( 3, 7.0e6 );
+    keplerianElements.eccentricities = Eigen::ArrayXd::Constant( 3, 0.1 );
+    keplerianElements.eccentricities( 1 ) = 1.2;
+    keplerianElements.inclinations = Eigen::ArrayXd::Zero( 3 );
+    keplerianElements.argumentsOfPeriapsis = Eigen::ArrayXd::Zero( 3 );
+    keplerianElements.longitudesOfAscendingNode = Eigen::ArrayXd::Zero( 3 );
+    keplerianElements.meanAnomalies = Eigen::ArrayXd::Zero( 3 );
+
+    bool isErrorThrown = false;
+
+    try
+    {
+        astrodynamics::KeplerPropagator propagator( earthGravitationalParameter,
+                                                    keplerianElements );
+    }
+
+    catch ( std::runtime_error& error )
+    {
+        isErrorThrown = true;
+    }
+
+    BOOST_CHECK( isErrorThrown );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace assist
@@ -0,0 +1,245 @@
+/*
+ *    Copyright (c) 2010-2014, Delft University of Technology
+ *    Copyright (c) 2010-2014, K. Kumar (me@kartikkumar.com)
+ *    All rights reserved.
+ *    See http://bit.ly/1jern3m for license details.
+ */
+
+#include <cmath>
+#include <stdexcept>
+
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include "Assist/Astrodynamics/astrodynamicsBasics.h"
+#include "Assist/Astrodynamics/nBodyAccelerations.h"
+
+namespace assist
+{
+namespace unit_tests
+{
+
+namespace
+{
+
+//! Compute accelerations with scalar reference implementation.
+Eigen::MatrixX3d computeReferenceAccelerations( const Eigen::MatrixX3d& positions,
+                                                const Eigen::ArrayXd& gravitationalParameters,
+                                                const double softeningLength )
+{
+    const int numberOfBodies = static_cast< int >( positions.rows( ) );
+    Eigen::MatrixX3d accelerations = Eigen::MatrixX3d::Zero( numberOfBodies, 3 );
+    for ( int i = 0; i < numberOfBodies; i++ )
+    {
+        for ( int j = 0; j < numberOfBodies; j++ )
+        {
+            if ( j != i )
+            {
+                const Eigen::RowVector3d relativePosition
+                        = positions.row( j ) - positions.row( i );
+                const double distance = std::sqrt( relativePosition.squaredNorm( )
+                                                   + softeningLength * softeningLength );
+                accelerations.row( i ) += gravitationalParameters( j ) * relativePosition
+                        / ( distance * distance * distance );
+            }
+        }
+    }
+
+    return accelerations;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE( test_n_body_accelerations )
+
+//! Test direct summation against scalar reference.
+BOOST_AUTO_TEST_CASE( testDirectSumAccelerations )
+{
+    // Set cloud of bodies, with a dense core and a sparse halo, with coordinates and masses
+    // spread quasi-randomly (fractional parts of multiples of irrational numbers).
+    const int numberOfBodies = 1500;
+    const double multipliers[ 4 ] = { 0.414213562373095, 0.732050807568877, 0.236067977499790,
+                                      0.316624790355400 };
+    Eigen::MatrixX3d positions( numberOfBodies, 3 );
+    Eigen::ArrayXd gravitationalParameters( numberOfBodies );
+    for ( int i = 0; i < numberOfBodies; i++ )
+    {
+        const double scale = i % 3 == 0 ? 1.0e5 : 1.0e3;
+        for ( int k = 0; k < 3; k++ )
+        {
+            positions( i, k ) = scale * ( 2.0 * std::fmod( multipliers[ k ] * i, 1.0 ) - 1.0 );
+        }
+
+        gravitationalParameters( i ) = astrodynamics::computeGravitationalParameter(
+                    1.0e3 + 9.99e5 * std::fmod( multipliers[ 3 ] * i, 1.0 ) );
+    }
+
+    const double softeningLengths[ 2 ] = { 0.0, 10.0 };
+
+    for ( int s = 0; s < 2; s++ )
+    {
+        const Eigen::MatrixX3d expectedAccelerations = computeReferenceAccelerations(
+                    positions, gravitationalParameters, softeningLengths[ s ] );
+
+        // Compute accelerations with one and multiple threads.
+        Eigen::MatrixX3d accelerations;
+        Eigen::MatrixX3d accelerationsInParallel;
+        astrodynamics::computeDirectSumAccelerations(
+                    positions, gravitationalParameters, accelerations, softeningLengths[ s ] );
+        astrodynamics::computeDirectSumAccelerations(
+                    positions, gravitationalParameters, accelerationsInParallel,
+                    softeningLengths[ s ], 4 );
+        BOOST_REQUIRE_EQUAL( accelerations.rows( ), numberOfBodies );
+
+        // Check that accelerations match reference.
+        for ( int i = 0; i < numberOfBodies; i++ )
+        {
+            const double expectedNorm = expectedAccelerations.row( i ).norm( );
+            BOOST_CHECK_SMALL( ( accelerations.row( i ) - expectedAccelerations.row( i ) ).norm( )
+                               / expectedNorm, 1.0e-12 );
+            BOOST_CHECK_SMALL( ( accelerationsInParallel.row( i )
+                                 - expectedAccelerations.row( i ) ).norm( ) / expectedNorm,
+                               1.0e-12 );
+        }
+    }
+}
+
+//! Test direct summation for two bodies.
+BOOST_AUTO_TEST_CASE( testDirectSumAccelerationsTwoBodies )
+{
+    Eigen::MatrixX3d twoBodyPositions( 2, 3 );
+    twoBodyPositions << 0.0, 0.0, 0.0,
+            3.0, 4.0, 0.0;
+    Eigen::ArrayXd twoBodyGravitationalParameters( 2 );
+    twoBodyGravitationalParameters << 250.0, 125.0;
+
+    Eigen::MatrixX3d accelerations;
+    astrodynamics::computeDirectSumAccelerations(
+                twoBodyPositions, twoBodyGravitationalParameters, accelerations );
+
+    // Check that accelerations point towards each other, with magnitudes mu / r^2.
+    BOOST_CHECK_SMALL( accelerations( 0, 0 ) - 125.0 / 25.0 * 0.6, 1.0e-14 );
+    BOOST_CHECK_SMALL( accelerations( 0, 1 ) - 125.0 / 25.0 * 0.8, 1.0e-14 );
+    BOOST_CHECK_SMALL( accelerations( 1, 0 ) + 250.0 / 25.0 * 0.6, 1.0e-14 );
+    BOOST_CHECK_SMALL( accelerations( 1, 1 ) + 250.0 / 25.0 * 0.8, 1.0e-14 );
+    BOOST_CHECK_EQUAL( accelerations( 0, 2 ), 0.0 );
+    BOOST_CHECK_EQUAL( accelerations( 1, 2 ), 0.0 );
+}
+
+//! Test Barnes-Hut accelerations against direct summation.
+BOOST_AUTO_TEST_CASE( testBarnesHutAccelerations )
+{
+    // Set cloud of bodies, with a dense core and a sparse halo, with coordinates and masses
+    // spread quasi-randomly (fractional parts of multiples of irrational numbers).
+    const int numberOfBodies = 1500;
+    const double multipliers[ 4 ] = { 0.414213562373095, 0.732050807568877, 0.236067977499790,
+                                      0.316624790355400 };
+    Eigen::MatrixX3d positions( numberOfBodies, 3 );
+    Eigen::ArrayXd gravitationalParameters( numberOfBodies );
+    for ( int i = 0; i < numberOfBodies; i++ )
+    {
+        const double scale = i % 3 == 0 ? 1.0e5 : 1.0e3;
+        for ( int k = 0; k < 3; k++ )
+        {
+            positions( i, k ) = scale * ( 2.0 * std::fmod( multipliers[ k ] * i, 1.0 ) - 1.0 );
+        }
+
+        gravitationalParameters( i ) = astrodynamics::computeGravitationalParameter(
+                    1.0e3 + 9.99e5 * std::fmod( multipliers[ 3 ] * i, 1.0 ) );
+    }
+
+    const Eigen::MatrixX3d expectedAccelerations
+            = computeReferenceAccelerations( positions, gravitationalParameters, 0.0 );
+
+    // Compute accelerations with zero opening angle, which reduces to direct summation, and with
+    // default opening angle, with one and multiple threads.
+    Eigen::MatrixX3d exactAccelerations;
+    Eigen::MatrixX3d accelerations;
+    Eigen::MatrixX3d accelerationsInParallel;
+    astrodynamics::computeBarnesHutAccelerations(
+                positions, gravitationalParameters, exactAccelerations, 0.0 );
+    astrodynamics::computeBarnesHutAccelerations(
+                positions, gravitationalParameters, accelerations );
+    astrodynamics::computeBarnesHutAccelerations(
+                positions, gravitationalParameters, accelerationsInParallel, 0.5, 0.0, 4 );
+
+    double sumOfRelativeErrors = 0.0;
+    for ( int i = 0; i < numberOfBodies; i++ )
+    {
+        const double expectedNorm = expectedAccelerations.row( i ).norm( );
+        BOOST_CHECK_SMALL( ( exactAccelerations.row( i ) - expectedAccelerations.row( i ) ).norm( )
+                           / expectedNorm, 1.0e-12 );
+
+        const double relativeError
+                = ( accelerations.row( i ) - expectedAccelerations.row( i ) ).norm( )
+                / expectedNorm;
+        BOOST_CHECK_SMALL( relativeError, 5.0e-2 );
+        BOOST_CHECK( accelerationsInParallel.row( i ) == accelerations.row( i ) );
+        sumOfRelativeErrors += relativeError;
+    }
+
+    // Check mean relative error.
+    BOOST_CHECK_SMALL( sumOfRelativeErrors / numberOfBodies, 5.0e-3 );
+}
+
+//! Test that run-time errors are thrown for invalid input.
+BOOST_AUTO_TEST_CASE( testNBodyAccelerationsErrors )
+{
+    // Set bodies on a line.
+    Eigen::MatrixX3d positions = Eigen::MatrixX3d::Zero( 20, 3 );
+    positions.col( 0 ) = Eigen::VectorXd::LinSpaced( 20, 0.0, 19.0 );
+    const Eigen::ArrayXd gravitationalParameters = Eigen::ArrayXd::Ones( 20 );
+
+    // Declare error flags.
+    bool isErrorThrownForDirectSum = false;
+    bool isErrorThrownForBarnesHut = false;
+    bool isErrorThrownForOpeningAngle = false;
+
+    Eigen::MatrixX3d accelerations;
+
+    // Try to compute accelerations with mismatching sizes.
+    try
+    {
+        astrodynamics::computeDirectSumAccelerations(
+                    positions, gravitationalParameters.head( 10 ), accelerations );
+    }
+
+    catch ( std::runtime_error& )
+    {
+        isErrorThrownForDirectSum = true;
+    }
+
+    try
+    {
+        astrodynamics::computeBarnesHutAccelerations(
+                    positions, gravitationalParameters.head( 10 ), accelerations );
+    }
+
+    catch ( std::runtime_error& )
+    {
+        isErrorThrownForBarnesHut = true;
+    }
+
+    // Try to compute accelerations with negative opening angle.
+    try
+    {
+        astrodynamics::computeBarnesHutAccelerations(
+                    positions, gravitationalParameters, accelerations, -0.1 );
+    }
+
+    catch ( std::runtime_error& )
+    {
+        isErrorThrownForOpeningAngle = true;
+    }
+
+    // Check that errors were thrown.
+    BOOST_CHECK( isErrorThrownForDirectSum );
+    BOOST_CHECK( isErrorThrownForBarnesHut );
+    BOOST_CHECK( isErrorThrownForOpeningAngle );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace assist
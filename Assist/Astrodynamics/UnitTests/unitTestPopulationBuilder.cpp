@@ -0,0 +1,235 @@
+/*
+ *    Copyright (c) 2010-2014, Delft University of Technology
+ *    Copyright (c) 2010-2014, K. Kumar (me@kartikkumar.com)
+ *    All rights reserved.
+ *    See http://bit.ly/1jern3m for license details.
+ */
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include "Assist/Astrodynamics/astrodynamicsBasics.h"
+#include "Assist/Astrodynamics/populationBuilder.h"
+#include "Assist/Basics/commonTypedefs.h"
+#include "Assist/Mathematics/monteCarloSampler.h"
+
+namespace assist
+{
+namespace unit_tests
+{
+
+BOOST_AUTO_TEST_SUITE( test_population_builder )
+
+//! Test that power-law population is sampled from correct distribution.
+BOOST_AUTO_TEST_CASE( testBuildPopulationWithPowerLawSizeDistribution )
+{
+    // Set size distribution, typical of collisional fragments.
+    const double minimumRadius = 0.1;
+    const double maximumRadius = 100.0;
+    const double powerLawIndex = 3.5;
+    const double bulkDensity = 2000.0;
+    const std::size_t numberOfBodies = 100000;
+
+    const astrodynamics::PowerLawSizeDistribution sizeDistribution(
+                minimumRadius, maximumRadius, powerLawIndex );
+
+    // Check inverse cumulative distribution function at end points. Near the maximum radius,
+    // the steep distribution leaves only a few significant digits to invert.
+    BOOST_CHECK_CLOSE_FRACTION( sizeDistribution.computeRadius( 0.0 ), minimumRadius,
+                                4.0 * std::numeric_limits< double >::epsilon( ) );
+    BOOST_CHECK_CLOSE_FRACTION( sizeDistribution.computeRadius( 1.0 ), maximumRadius, 1.0e-8 );
+
+    // Build population.
+    astrodynamics::Population population;
+    astrodynamics::buildPopulation( sizeDistribution, bulkDensity, numberOfBodies, 12345,
+                                    population );
+    BOOST_REQUIRE_EQUAL( population.radii.size( ), numberOfBodies );
+    BOOST_REQUIRE_EQUAL( population.masses.size( ), numberOfBodies );
+    BOOST_REQUIRE_EQUAL( population.gravitationalParameters.size( ), numberOfBodies );
+
+    // Check that radii are in range, and that masses and gravitational parameters match the
+    // scalar functions.
+    BOOST_CHECK( population.radii.minCoeff( ) >= minimumRadius );
+    BOOST_CHECK( population.radii.maxCoeff( ) <= maximumRadius );
+
+    for ( std::size_t i = 0; i < numberOfBodies; i++ )
+    {
+        BOOST_CHECK_EQUAL( population.masses( i ), astrodynamics::computeMassOfSphere(
+                               population.radii( i ), bulkDensity ) );
+        BOOST_CHECK_EQUAL( population.gravitationalParameters( i ),
+                           astrodynamics::computeGravitationalParameter(
+                               population.masses( i ) ) );
+    }
+
+    // Check empirical cumulative distribution function against expected values.
+    const double radii[ 3 ] = { 0.12, 0.2, 0.5 };
+    for ( unsigned int j = 0; j < 3; j++ )
+    {
+        const double expectedFraction
+                = ( std::pow( radii[ j ], 1.0 - powerLawIndex )
+                    - std::pow( minimumRadius, 1.0 - powerLawIndex ) )
+                / ( std::pow( maximumRadius, 1.0 - powerLawIndex )
+                    - std::pow( minimumRadius, 1.0 - powerLawIndex ) );
+        const double fraction = ( population.radii < radii[ j ] ).cast< double >( ).mean( );
+        BOOST_CHECK_SMALL( fraction - expectedFraction, 0.005 );
+    }
+}
+
+//! Test that log-uniform population is sampled from correct distribution.
+BOOST_AUTO_TEST_CASE( testBuildPopulationWithLogUniformSizeDistribution )
+{
+    // Set size distribution with power-law index of one, i.e., log-uniform radii.
+    const astrodynamics::PowerLawSizeDistribution sizeDistribution( 1.0, 1000.0, 1.0 );
+    BOOST_CHECK_CLOSE_FRACTION( sizeDistribution.computeRadius( 0.5 ), std::sqrt( 1000.0 ),
+                                1.0e-14 );
+
+    // Build population, and check that a third of the radii is in each decade.
+    astrodynamics::Population population;
+    astrodynamics::buildPopulation( sizeDistribution, 1000.0, 30000, 1, population );
+
+    BOOST_CHECK_SMALL( ( population.radii < 10.0 ).cast< double >( ).mean( ) - 1.0 / 3.0,
+                       0.01 );
+    BOOST_CHECK_SMALL( ( population.radii < 100.0 ).cast< double >( ).mean( ) - 2.0 / 3.0,
+                       0.01 );
+}
+
+//! Test that tabulated population is sampled from correct distribution.
+BOOST_AUTO_TEST_CASE( testBuildPopulationWithTabulatedSizeDistribution )
+{
+    // Set table of radius bins, with an empty bin in between; the value of the last key is
+    // ignored.
+    basics::DoubleKeyDoubleValueMap radiusBins;
+    radiusBins[ 1.0 ] = 1.0;
+    radiusBins[ 2.0 ] = 0.0;
+    radiusBins[ 3.0 ] = 3.0;
+    radiusBins[ 5.0 ] = 100.0;
+
+    const astrodynamics::TabulatedSizeDistribution sizeDistribution( radiusBins );
+
+    // Check inverse cumulative distribution function.
+    BOOST_CHECK_EQUAL( sizeDistribution.computeRadius( 0.0 ), 1.0 );
+    BOOST_CHECK_CLOSE_FRACTION( sizeDistribution.computeRadius( 0.125 ), 1.5, 1.0e-15 );
+    BOOST_CHECK_CLOSE_FRACTION( sizeDistribution.computeRadius( 0.25 ), 3.0, 1.0e-15 );
+    BOOST_CHECK_CLOSE_FRACTION( sizeDistribution.computeRadius( 0.625 ), 4.0, 1.0e-15 );
+
+    // Build population, and check fraction of bodies in each bin.
+    astrodynamics::Population population;
+    astrodynamics::buildPopulation( sizeDistribution, 1000.0, 40000, 7, population );
+
+    BOOST_CHECK( population.radii.minCoeff( ) >= 1.0 );
+    BOOST_CHECK( population.radii.maxCoeff( ) < 5.0 );
+    BOOST_CHECK_SMALL( ( population.radii < 2.0 ).cast< double >( ).mean( ) - 0.25, 0.01 );
+    BOOST_CHECK_EQUAL( ( ( population.radii >= 2.0 ) && ( population.radii < 3.0 ) ).count( ),
+                       0 );
+}
+
+//! Test that population does not depend on number of threads, but does depend on seed.
+BOOST_AUTO_TEST_CASE( testBuildPopulationReproducibility )
+{
+    const astrodynamics::PowerLawSizeDistribution sizeDistribution( 1.0, 10.0, 2.5 );
+    const std::size_t numberOfBodies = 50001;
+
+    // Build population with same seed, on different numbers of threads.
+    astrodynamics::Population serialPopulation;
+    astrodynamics::buildPopulation( sizeDistribution, 3000.0, numberOfBodies, 99,
+                                    serialPopulation, 1 );
+
+    astrodynamics::Population parallelPopulation;
+    astrodynamics::buildPopulation( sizeDistribution, 3000.0, numberOfBodies, 99,
+                                    parallelPopulation, 3 );
+
+    BOOST_CHECK( ( serialPopulation.radii == parallelPopulation.radii ).all( ) );
+    BOOST_CHECK( ( serialPopulation.masses == parallelPopulation.masses ).all( ) );
+    BOOST_CHECK( ( serialPopulation.gravitationalParameters
+                   == parallelPopulation.gravitationalParameters ).all( ) );
+
+    // Check that first bodies do not depend on size of population.
+    astrodynamics::Population smallPopulation;
+    astrodynamics::buildPopulation( sizeDistribution, 3000.0, 10, 99, smallPopulation, 2 );
+    BOOST_CHECK( ( smallPopulation.radii == serialPopulation.radii.head( 10 ) ).all( ) );
+
+    // Check that radii are sampled with the uniform samples of the Monte Carlo sampler.
+    Eigen::ArrayXd uniformSamples;
+    mathematics::MonteCarloSampler( 99 ).generateUniformSamples( 10, uniformSamples );
+    for ( int i = 0; i < 10; i++ )
+    {
+        BOOST_CHECK_EQUAL( smallPopulation.radii( i ),
+                           sizeDistribution.computeRadius( uniformSamples( i ) ) );
+    }
+
+    // Build population with different seed.
+    astrodynamics::Population otherPopulation;
+    astrodynamics::buildPopulation( sizeDistribution, 3000.0, numberOfBodies, 100,
+                                    otherPopulation, 1 );
+    BOOST_CHECK( ( serialPopulation.radii != otherPopulation.radii ).any( ) );
+
+    // Recompute derived quantities for given radii with a different bulk density.
+    astrodynamics::computeMassesAndGravitationalParameters( 1500.0, serialPopulation, 4 );
+    BOOST_CHECK( ( 2.0 * serialPopulation.masses - parallelPopulation.masses ).abs( ).maxCoeff( )
+                 <= 1.0e-15 * parallelPopulation.masses.maxCoeff( ) );
+}
+
+//! Test that size distributions throw run-time errors for invalid input.
+BOOST_AUTO_TEST_CASE( testSizeDistributionsInvalidInput )
+{
+    // Check that a run-time error is thrown for an invalid radius range.
+    bool isErrorThrown = false;
+
+    try
+    {
+        astrodynamics::PowerLawSizeDistribution sizeDistribution( 10.0, 1.0, 3.0 );
+    }
+
+    catch ( std::runtime_error& error )
+    {
+        isErrorThrown = true;
+    }
+
+    BOOST_CHECK( isErrorThrown );
+
+    // Check that a run-time error is thrown for a table with only one bin edge.
+    basics::DoubleKeyDoubleValueMap radiusBins;
+    radiusBins[ 1.0 ] = 1.0;
+    isErrorThrown = false;
+
+    try
+    {
+        astrodynamics::TabulatedSizeDistribution sizeDistribution( radiusBins );
+    }
+
+    catch ( std::runtime_error& error )
+    {
+        isErrorThrown = true;
+    }
+
+    BOOST_CHECK( isErrorThrown );
+
+    // Check that a run-time error is thrown for a negative relative number of bodies.
+    radiusBins[ 2.0 ] = 1.0;
+    radiusBins[ 1.0 ] = -1.0;
+    isErrorThrown = false;
+
+    try
+    {
+        astrodynamics::TabulatedSizeDistribution sizeDistribution( radiusBins );
+    }
+
+    catch ( std::runtime_error& error )
+    {
+        isErrorThrown = true;
+    }
+
+    BOOST_CHECK( isErrorThrown );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace assist
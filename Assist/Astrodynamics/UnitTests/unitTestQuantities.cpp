@@ -0,0 +1,130 @@
+/*
+ *    Copyright (c) 2010-2014, Delft University of Technology
+ *    Copyright (c) 2010-2014, K. Kumar (me@kartikkumar.com)
+ *    All rights reserved.
+ *    See http://bit.ly/1jern3m for license details.
+ */
+
+#include <limits>
+
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "Assist/Astrodynamics/quantities.h"
+#include "Assist/Astrodynamics/unitConversions.h"
+
+namespace assist
+{
+namespace unit_tests
+{
+
+//! Compute time span in seconds.
+/*!
+ * Computes time span in seconds, as example of a function at a module boundary that takes
+ * quantities; callers can pass times in any unit.
+ */
+astrodynamics::Seconds computeTimeSpan( const astrodynamics::Seconds startTime,
+                                        const astrodynamics::Seconds endTime )
+{
+    return endTime - startTime;
+}
+
+BOOST_AUTO_TEST_SUITE( test_quantities )
+
+//! Test conversion between time quantities.
+BOOST_AUTO_TEST_CASE( testTimeQuantityConversions )
+{
+    // Convert Julian years to Julian days and seconds.
+    const astrodynamics::JulianYears julianYears( 2.0 );
+    const astrodynamics::JulianDays julianDays = julianYears;
+    const astrodynamics::Seconds seconds = julianYears;
+
+    BOOST_CHECK_CLOSE_FRACTION( julianDays.getValue( ), 730.5,
+                                std::numeric_limits< double >::epsilon( ) );
+    BOOST_CHECK_CLOSE_FRACTION( seconds.getValue( ), 730.5 * 86400.0,
+                                std::numeric_limits< double >::epsilon( ) );
+    BOOST_CHECK_EQUAL( seconds.getValue( ),
+                       astrodynamics::convertJulianYearsToSeconds( 2.0 ) );
+    BOOST_CHECK_EQUAL( julianYears.getValueInBaseUnit( ), seconds.getValue( ) );
+
+    // Convert seconds back to Julian days and Julian years, which matches the scalar functions.
+    const astrodynamics::JulianDays julianDaysFromSeconds = seconds;
+    const astrodynamics::JulianYears julianYearsFromSeconds = seconds;
+
+    BOOST_CHECK_EQUAL( julianDaysFromSeconds.getValue( ),
+                       astrodynamics::convertSecondsToJulianDays( seconds.getValue( ) ) );
+    BOOST_CHECK_EQUAL( julianYearsFromSeconds.getValue( ),
+                       astrodynamics::convertSecondsToJulianYears( seconds.getValue( ) ) );
+    BOOST_CHECK_CLOSE_FRACTION( julianYearsFromSeconds.getValue( ), 2.0,
+                                std::numeric_limits< double >::epsilon( ) );
+
+    // Check that quantities in any time unit can be passed to a function taking seconds.
+    BOOST_CHECK_CLOSE_FRACTION(
+                computeTimeSpan( astrodynamics::JulianDays( 1.0 ),
+                                 astrodynamics::JulianDays( 3.5 ) ).getValue( ),
+                2.5 * 86400.0, std::numeric_limits< double >::epsilon( ) );
+    BOOST_CHECK_CLOSE_FRACTION(
+                computeTimeSpan( astrodynamics::Seconds( 100.0 ),
+                                 astrodynamics::JulianYears( 1.0 ) ).getValue( ),
+                365.25 * 86400.0 - 100.0, std::numeric_limits< double >::epsilon( ) );
+}
+
+//! Test that whole Julian years and days convert exactly from seconds.
+BOOST_AUTO_TEST_CASE( testTimeQuantityConversionsOfWholeYearsAndDays )
+{
+    for ( int i = 1; i <= 100000; i++ )
+    {
+        const astrodynamics::JulianYears julianYears
+                = astrodynamics::Seconds( astrodynamics::convertJulianYearsToSeconds( i ) );
+        const astrodynamics::JulianDays julianDays
+                = astrodynamics::Seconds( astrodynamics::convertJulianDaysToSeconds( i ) );
+        BOOST_REQUIRE_EQUAL( julianYears.getValue( ), i );
+        BOOST_REQUIRE_EQUAL( julianDays.getValue( ), i );
+    }
+}
+
+//! Test conversion between length and gravitational parameter quantities.
+BOOST_AUTO_TEST_CASE( testLengthAndGravitationalParameterQuantityConversions )
+{
+    const astrodynamics::Meters meters = astrodynamics::Kilometers( 6378.137 );
+    BOOST_CHECK_CLOSE_FRACTION( meters.getValue( ), 6378137.0,
+                                std::numeric_limits< double >::epsilon( ) );
+
+    const astrodynamics::GravitationalParameterInKilometers earthGravitationalParameter
+            = astrodynamics::GravitationalParameter( 3.986004418e14 );
+    BOOST_CHECK_CLOSE_FRACTION( earthGravitationalParameter.getValue( ), 3.986004418e5,
+                                std::numeric_limits< double >::epsilon( ) );
+}
+
+//! Test arithmetic and comparison of quantities.
+BOOST_AUTO_TEST_CASE( testQuantityArithmetic )
+{
+    astrodynamics::Seconds time( 10.0 );
+    time += astrodynamics::Seconds( 5.0 );
+    BOOST_CHECK_EQUAL( time.getValue( ), 15.0 );
+
+    time -= astrodynamics::JulianDays( 0.0 );
+    BOOST_CHECK_EQUAL( time.getValue( ), 15.0 );
+
+    BOOST_CHECK_EQUAL( ( 2.0 * time ).getValue( ), 30.0 );
+    BOOST_CHECK_EQUAL( ( time * 2.0 ).getValue( ), 30.0 );
+    BOOST_CHECK_EQUAL( ( time / 3.0 ).getValue( ), 5.0 );
+    BOOST_CHECK_EQUAL( ( -time ).getValue( ), -15.0 );
+    BOOST_CHECK_EQUAL( time / astrodynamics::Seconds( 5.0 ), 3.0 );
+
+    BOOST_CHECK( astrodynamics::Seconds( 1.0 ) < time );
+    BOOST_CHECK( time > astrodynamics::Seconds( 1.0 ) );
+    BOOST_CHECK( time <= astrodynamics::Seconds( 15.0 ) );
+    BOOST_CHECK( time >= astrodynamics::Seconds( 15.0 ) );
+    BOOST_CHECK( time == astrodynamics::Seconds( 15.0 ) );
+    BOOST_CHECK( time != astrodynamics::Seconds( 16.0 ) );
+    BOOST_CHECK_EQUAL( astrodynamics::Seconds( ).getValue( ), 0.0 );
+
+    // Note that conversion between quantities of different dimensions, e.g.,
+    // astrodynamics::Meters meters = astrodynamics::Seconds( 1.0 ), does not compile.
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace assist
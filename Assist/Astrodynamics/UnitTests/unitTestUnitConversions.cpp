@@ -83,6 +83,18 @@ BOOST_AUTO_TEST_CASE( testConvertSecondsToJulianDaysFunction )
                                 std::numeric_limits< double >::epsilon( ) );
 }
 
+//! Test that whole Julian years and days round-trip exactly through seconds.
+BOOST_AUTO_TEST_CASE( testRoundTripOfWholeJulianYearsAndDays )
+{
+    for ( int i = 1; i <= 100000; i++ )
+    {
+        BOOST_REQUIRE_EQUAL( astrodynamics::convertSecondsToJulianYears(
+                                 astrodynamics::convertJulianYearsToSeconds( i ) ), i );
+        BOOST_REQUIRE_EQUAL( astrodynamics::convertSecondsToJulianDays(
+                                 astrodynamics::convertJulianDaysToSeconds( i ) ), i );
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END( )
 
 } // namespace unit_tests
@@ -0,0 +1,425 @@
+/*
+ *    Copyright (c) 2010-2014, Delft University of Technology
+ *    Copyright (c) 2010-2014, K. Kumar (me@kartikkumar.com)
+ *    All rights reserved.
+ *    See http://bit.ly/1jern3m for license details.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include <boost/exception/all.hpp>
+
+#include <Eigen/Core>
+
+#include "Assist/Astrodynamics/conjunctionScreening.h"
+#include "Assist/Basics/parallelLoop.h"
+#include "Assist/Mathematics/stateHistoryInterpolator.h"
+
+namespace assist
+{
+namespace astrodynamics
+{
+
+namespace
+{
+
+//! Maximum depth of subdivision of interval to isolate roots of range-rate.
+const int maximumSubdivisionDepth = 30;
+
+//! Maximum number of iterations to find root of range-rate.
+const int maximumNumberOfIterations = 50;
+
+//! Relative motion in interval, as cubic polynomial in normalized time.
+struct RelativeMotionPolynomial
+{
+    //! Set up cubic Hermite polynomial from relative states at ends of interval.
+    RelativeMotionPolynomial( const Eigen::Vector3d& startPosition,
+                              const Eigen::Vector3d& startVelocity,
+                              const Eigen::Vector3d& endPosition,
+                              const Eigen::Vector3d& endVelocity, const double duration )
+        : c0( startPosition ),
+          c1( duration * startVelocity ),
+          c2( 3.0 * ( endPosition - startPosition )
+              - duration * ( 2.0 * startVelocity + endVelocity ) ),
+          c3( 2.0 * ( startPosition - endPosition ) + duration * ( startVelocity + endVelocity ) )
+    { }
+
+    //! Compute relative position at normalized time.
+    Eigen::Vector3d computePosition( const double s ) const
+    {
+        return c0 + s * ( c1 + s * ( c2 + s * c3 ) );
+    }
+
+    //! Compute derivative of relative position with respect to normalized time.
+    Eigen::Vector3d computeVelocity( const double s ) const
+    {
+        return c1 + s * ( 2.0 * c2 + 3.0 * s * c3 );
+    }
+
+    //! Compute second derivative of relative position with respect to normalized time.
+    Eigen::Vector3d computeAcceleration( const double s ) const
+    {
+        return 2.0 * c2 + 6.0 * s * c3;
+    }
+
+    //! Compute Bernstein coefficients of range-rate scaled by range, i.e., half the derivative of
+    //! the squared range, which is a quintic polynomial.
+    void computeScaledRangeRateCoefficients( double coefficients[ 6 ] ) const
+    {
+        // Compute power-basis coefficients of p( s ) . p'( s ).
+        const double a0 = c0.dot( c1 );
+        const double a1 = 2.0 * c0.dot( c2 ) + c1.squaredNorm( );
+        const double a2 = 3.0 * ( c0.dot( c3 ) + c1.dot( c2 ) );
+        const double a3 = 4.0 * c1.dot( c3 ) + 2.0 * c2.squaredNorm( );
+        const double a4 = 5.0 * c2.dot( c3 );
+        const double a5 = 3.0 * c3.squaredNorm( );
+
+        // Convert to Bernstein basis on [0, 1].
+        coefficients[ 0 ] = a0;
+        coefficients[ 1 ] = a0 + a1 / 5.0;
+        coefficients[ 2 ] = a0 + 2.0 * a1 / 5.0 + a2 / 10.0;
+        coefficients[ 3 ] = a0 + 3.0 * a1 / 5.0 + 3.0 * a2 / 10.0 + a3 / 10.0;
+        coefficients[ 4 ] = a0 + 4.0 * a1 / 5.0 + 6.0 * a2 / 10.0 + 4.0 * a3 / 10.0 + a4 / 5.0;
+        coefficients[ 5 ] = a0 + a1 + a2 + a3 + a4 + a5;
+    }
+
+    //! Compute upper bound on norm of velocity in interval (in normalized time).
+    double computeVelocityBound( ) const
+    {
+        return c1.norm( ) + 2.0 * c2.norm( ) + 3.0 * c3.norm( );
+    }
+
+    //! Coefficients of polynomial [m].
+    Eigen::Vector3d c0, c1, c2, c3;
+};
+
+//! Find root of scaled range-rate in bracket.
+/*!
+ * Finds root of scaled range-rate in bracket [lower, upper], with negative range-rate at lower
+ * bound and non-negative range-rate at upper bound, using Newton's method safeguarded by
+ * bisection.
+ */
+double findClosestApproach( const RelativeMotionPolynomial& relativeMotion, double lower,
+                            double upper )
+{
+    double s = 0.5 * ( lower + upper );
+    for ( int i = 0; i < maximumNumberOfIterations; i++ )
+    {
+        const Eigen::Vector3d position = relativeMotion.computePosition( s );
+        const Eigen::Vector3d velocity = relativeMotion.computeVelocity( s );
+        const double rangeRate = position.dot( velocity );
+
+        if ( rangeRate < 0.0 )
+        {
+            lower = s;
+        }
+
+        else
+        {
+            upper = s;
+        }
+
+        // Take Newton step, or bisect if the step leaves the bracket.
+        const double derivative = velocity.squaredNorm( )
+                + position.dot( relativeMotion.computeAcceleration( s ) );
+        double nextS = s - rangeRate / derivative;
+        if ( !( nextS > lower && nextS < upper ) )
+        {
+            nextS = 0.5 * ( lower + upper );
+        }
+
+        if ( std::fabs( nextS - s ) <= 1.0e-15 )
+        {
+            return nextS;
+        }
+
+        s = nextS;
+    }
+
+    return s;
+}
+
+//! Find closest approaches in part of interval, by subdivision of range-rate polynomial.
+/*!
+ * Finds roots of the scaled range-rate from negative to non-negative in the part [lower, upper]
+ * of the interval, given the Bernstein coefficients of the range-rate on that part, and adds them
+ * to a list in increasing order. The number of roots in the part is at most the number of sign
+ * changes of the coefficients: without sign changes, the part holds no roots; with one, it holds
+ * a single root, which is bracketed by its end points; otherwise, it is split in halves with de
+ * Casteljau's algorithm, so that roots that lie close together are separated. Since both halves
+ * share the coefficient at the split point, a root there is found in one half only.
+ */
+void findClosestApproaches( const RelativeMotionPolynomial& relativeMotion,
+                            const double coefficients[ 6 ], const double lower,
+                            const double upper, const int depth,
+                            std::vector< double >& closestApproaches )
+{
+    // Count sign changes of coefficients, skipping zeros.
+    int numberOfSignChanges = 0;
+    double previousCoefficient = 0.0;
+    for ( int i = 0; i < 6; i++ )
+    {
+        if ( coefficients[ i ] != 0.0 )
+        {
+            if ( previousCoefficient != 0.0
+                 && ( previousCoefficient < 0.0 ) != ( coefficients[ i ] < 0.0 ) )
+            {
+                numberOfSignChanges++;
+            }
+
+            previousCoefficient = coefficients[ i ];
+        }
+    }
+
+    if ( numberOfSignChanges == 0 )
+    {
+        return;
+    }
+
+    // Refine root if it is isolated, or if the part is too small to separate roots.
+    if ( numberOfSignChanges == 1 || depth == maximumSubdivisionDepth )
+    {
+        if ( coefficients[ 0 ] < 0.0 && coefficients[ 5 ] >= 0.0 )
+        {
+            closestApproaches.push_back( findClosestApproach( relativeMotion, lower, upper ) );
+        }
+
+        return;
+    }
+
+    // Split part in halves, and search both.
+    double work[ 6 ];
+    double lowerCoefficients[ 6 ];
+    double upperCoefficients[ 6 ];
+    std::copy( coefficients, coefficients + 6, work );
+    lowerCoefficients[ 0 ] = work[ 0 ];
+    upperCoefficients[ 5 ] = work[ 5 ];
+    for ( int r = 1; r < 6; r++ )
+    {
+        for ( int i = 0; i < 6 - r; i++ )
+        {
+            work[ i ] = 0.5 * ( work[ i ] + work[ i + 1 ] );
+        }
+
+        lowerCoefficients[ r ] = work[ 0 ];
+        upperCoefficients[ 5 - r ] = work[ 5 - r ];
+    }
+
+    const double middle = 0.5 * ( lower + upper );
+    findClosestApproaches( relativeMotion, lowerCoefficients, lower, middle, depth + 1,
+                           closestApproaches );
+    findClosestApproaches( relativeMotion, upperCoefficients, middle, upper, depth + 1,
+                           closestApproaches );
+}
+
+//! Screen pair of state histories for conjunctions, and add them to list.
+void screenStateHistoryPair( const basics::DoubleKeyVector6dValueMap& firstStateHistory,
+                             const basics::DoubleKeyVector6dValueMap& secondStateHistory,
+                             const std::size_t firstObject, const std::size_t secondObject,
+                             const double screeningDistance,
+                             std::vector< Conjunction >& conjunctions )
+{
+    using basics::DoubleKeyVector6dValueMap;
+
+    mathematics::StateHistoryInterpolator firstInterpolator( firstStateHistory );
+    mathematics::StateHistoryInterpolator secondInterpolator( secondStateHistory );
+
+    // Merge epochs of both state histories in common time span.
+    const double startEpoch = std::max( firstStateHistory.begin( )->first,
+                                        secondStateHistory.begin( )->first );
+    const double endEpoch = std::min( firstStateHistory.rbegin( )->first,
+                                      secondStateHistory.rbegin( )->first );
+    if ( !( endEpoch > startEpoch ) )
+    {
+        return;
+    }
+
+    std::vector< double > epochs;
+    epochs.reserve( firstStateHistory.size( ) + secondStateHistory.size( ) );
+
+    DoubleKeyVector6dValueMap::const_iterator iteratorFirst
+            = firstStateHistory.lower_bound( startEpoch );
+    DoubleKeyVector6dValueMap::const_iterator iteratorSecond
+            = secondStateHistory.lower_bound( startEpoch );
+    const DoubleKeyVector6dValueMap::const_iterator iteratorFirstEnd
+            = firstStateHistory.upper_bound( endEpoch );
+    const DoubleKeyVector6dValueMap::const_iterator iteratorSecondEnd
+            = secondStateHistory.upper_bound( endEpoch );
+
+    while ( iteratorFirst != iteratorFirstEnd || iteratorSecond != iteratorSecondEnd )
+    {
+        if ( iteratorSecond == iteratorSecondEnd
+             || ( iteratorFirst != iteratorFirstEnd
+                  && iteratorFirst->first < iteratorSecond->first ) )
+        {
+            epochs.push_back( iteratorFirst->first );
+            iteratorFirst++;
+        }
+
+        else
+        {
+            if ( iteratorFirst != iteratorFirstEnd
+                 && iteratorFirst->first == iteratorSecond->first )
+            {
+                iteratorFirst++;
+            }
+
+            epochs.push_back( iteratorSecond->first );
+            iteratorSecond++;
+        }
+    }
+
+    // Interpolate states at merged epochs, and compute relative states.
+    Eigen::MatrixXd firstStates;
+    Eigen::MatrixXd relativeStates;
+    firstInterpolator.interpolate( epochs, firstStates );
+    secondInterpolator.interpolate( epochs, relativeStates );
+    relativeStates -= firstStates;
+
+    const Eigen::VectorXd ranges = relativeStates.leftCols( 3 ).rowwise( ).norm( );
+
+    std::vector< double > closestApproaches;
+    for ( std::size_t k = 0; k + 1 < epochs.size( ); k++ )
+    {
+        const double duration = epochs[ k + 1 ] - epochs[ k ];
+        const RelativeMotionPolynomial relativeMotion(
+                    relativeStates.block< 1, 3 >( k, 0 ).transpose( ),
+                    relativeStates.block< 1, 3 >( k, 3 ).transpose( ),
+                    relativeStates.block< 1, 3 >( k + 1, 0 ).transpose( ),
+                    relativeStates.block< 1, 3 >( k + 1, 3 ).transpose( ), duration );
+
+        // Prune interval if the distance cannot drop below the screening distance: the distance
+        // in the interval is at least the larger of |r_k| - V s and |r_k+1| - V ( 1 - s ), with
+        // V the bound on the relative velocity, of which the minimum over s is their mean at the
+        // crossing point.
+        const double distanceBound = 0.5 * ( ranges( k ) + ranges( k + 1 )
+                                             - relativeMotion.computeVelocityBound( ) );
+        if ( distanceBound >= screeningDistance )
+        {
+            continue;
+        }
+
+        // Isolate minima of the distance as roots of the range-rate from negative to
+        // non-negative, and refine them. The range-rate at the end of the interval is computed
+        // from the end state, as at the start of the next interval, so that a root at the epoch
+        // is found in one interval only.
+        double coefficients[ 6 ];
+        relativeMotion.computeScaledRangeRateCoefficients( coefficients );
+        coefficients[ 5 ] = duration * relativeStates.block< 1, 3 >( k + 1, 0 ).dot(
+                    relativeStates.block< 1, 3 >( k + 1, 3 ) );
+
+        closestApproaches.clear( );
+        findClosestApproaches( relativeMotion, coefficients, 0.0, 1.0, 0, closestApproaches );
+
+        for ( std::size_t i = 0; i < closestApproaches.size( ); i++ )
+        {
+            const double s = closestApproaches[ i ];
+            const double missDistance = relativeMotion.computePosition( s ).norm( );
+
+            if ( missDistance < screeningDistance )
+            {
+                const Conjunction conjunction
+                        = { firstObject, secondObject, epochs[ k ] + s * duration,
+                            missDistance };
+                conjunctions.push_back( conjunction );
+            }
+        }
+    }
+}
+
+//! Check that screening distance is positive.
+void checkScreeningDistance( const double screeningDistance )
+{
+    if ( !( screeningDistance > 0.0 ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Error: screening distance is not positive." ) ) );
+    }
+}
+
+//! Loop body to screen pairs of state histories.
+struct ScreenObjectPairs
+{
+    //! Screen pairs in range [begin, end).
+    void operator( )( const std::size_t begin, const std::size_t end ) const
+    {
+        for ( std::size_t i = begin; i < end; i++ )
+        {
+            const BodyIndexPair& objectPair = ( *objectPairs )[ i ];
+            screenStateHistoryPair( ( *stateHistories )[ objectPair.first ],
+                                    ( *stateHistories )[ objectPair.second ],
+                                    objectPair.first, objectPair.second, screeningDistance,
+                                    ( *conjunctionsPerPair )[ i ] );
+        }
+    }
+
+    //! State histories of objects.
+    const std::vector< basics::DoubleKeyVector6dValueMap >* stateHistories;
+
+    //! Pairs of indices of objects to screen.
+    const std::vector< BodyIndexPair >* objectPairs;
+
+    //! Screening distance [m].
+    double screeningDistance;
+
+    //! Conjunctions per pair.
+    std::vector< std::vector< Conjunction > >* conjunctionsPerPair;
+};
+
+} // namespace
+
+//! Screen two state histories for conjunctions.
+std::vector< Conjunction > screenConjunctions(
+        const basics::DoubleKeyVector6dValueMap& firstStateHistory,
+        const basics::DoubleKeyVector6dValueMap& secondStateHistory,
+        const double screeningDistance )
+{
+    checkScreeningDistance( screeningDistance );
+
+    std::vector< Conjunction > conjunctions;
+    screenStateHistoryPair( firstStateHistory, secondStateHistory, 0, 1, screeningDistance,
+                            conjunctions );
+    return conjunctions;
+}
+
+//! Screen pairs of state histories for conjunctions.
+std::vector< Conjunction > screenConjunctions(
+        const std::vector< basics::DoubleKeyVector6dValueMap >& stateHistories,
+        const std::vector< BodyIndexPair >& objectPairs, const double screeningDistance,
+        const unsigned int numberOfThreads )
+{
+    checkScreeningDistance( screeningDistance );
+
+    for ( std::size_t i = 0; i < objectPairs.size( ); i++ )
+    {
+        if ( objectPairs[ i ].first >= stateHistories.size( )
+             || objectPairs[ i ].second >= stateHistories.size( ) )
+        {
+            boost::throw_exception(
+                        boost::enable_error_info(
+                            std::runtime_error( "Error: index of object is out of range." ) ) );
+        }
+    }
+
+    // Screen pairs in parallel, storing conjunctions of each pair in a separate buffer.
+    std::vector< std::vector< Conjunction > > conjunctionsPerPair( objectPairs.size( ) );
+    const ScreenObjectPairs loopBody
+            = { &stateHistories, &objectPairs, screeningDistance, &conjunctionsPerPair };
+    basics::executeParallelLoop( objectPairs.size( ), loopBody, numberOfThreads, 1 );
+
+    // Concatenate buffers in order of pairs.
+    std::vector< Conjunction > conjunctions;
+    for ( std::size_t i = 0; i < conjunctionsPerPair.size( ); i++ )
+    {
+        conjunctions.insert( conjunctions.end( ), conjunctionsPerPair[ i ].begin( ),
+                             conjunctionsPerPair[ i ].end( ) );
+    }
+
+    return conjunctions;
+}
+
+} // namespace astrodynamics
+} // namespace assist
@@ -0,0 +1,94 @@
+/*
+ *    Copyright (c) 2010-2014, Delft University of Technology
+ *    Copyright (c) 2010-2014, K. Kumar (me@kartikkumar.com)
+ *    All rights reserved.
+ *    See http://bit.ly/1jern3m for license details.
+ */
+
+#ifndef ASSIST_CONJUNCTION_SCREENING_H
+#define ASSIST_CONJUNCTION_SCREENING_H
+
+#include <cstddef>
+#include <vector>
+
+#include "Assist/Astrodynamics/encounterDetection.h"
+#include "Assist/Basics/commonTypedefs.h"
+
+namespace assist
+{
+namespace astrodynamics
+{
+
+//! Conjunction between two objects.
+struct Conjunction
+{
+    //! Index of first object.
+    std::size_t firstObject;
+
+    //! Index of second object.
+    std::size_t secondObject;
+
+    //! Time of closest approach [s].
+    double timeOfClosestApproach;
+
+    //! Miss distance, i.e., distance at time of closest approach [m].
+    double missDistance;
+};
+
+//! Screen two state histories for conjunctions.
+/*!
+ * Screens two state histories, stored as DoubleKeyVector6dValueMap, for conjunctions, i.e., local
+ * minima of the distance between the objects that are within a given screening distance, in the
+ * time span covered by both state histories. The states are interpolated with cubic Hermite
+ * polynomials (see StateHistoryInterpolator), at the epochs of both state histories, so that the
+ * relative position is a cubic polynomial in each interval between consecutive epochs.
+ *
+ * Screening is coarse-to-fine: for each interval, a conservative lower bound on the distance is
+ * computed from the distances at both ends and a bound on the relative velocity in the interval,
+ * so that most intervals are pruned cheaply. In the remaining intervals, the times of closest
+ * approach are found as roots of the range-rate (scaled by the distance), which is a quintic
+ * polynomial: the roots are isolated by subdividing the interval until the Bernstein coefficients
+ * of the polynomial change sign at most once in each part, so that minima that lie close
+ * together are not missed, and refined using Newton's method safeguarded by bisection. Minima at
+ * the ends of the common time span are not reported, since the time of closest approach is then
+ * not known. Throws a run-time error if the screening distance is not positive, or if a state
+ * history contains fewer than two states.
+ * \param firstStateHistory State history of first object (index 0) [s, m, m s^-1].
+ * \param secondStateHistory State history of second object (index 1) [s, m, m s^-1].
+ * \param screeningDistance Screening distance [m].
+ * \return Conjunctions, in order of increasing time of closest approach.
+ */
+std::vector< Conjunction > screenConjunctions(
+        const basics::DoubleKeyVector6dValueMap& firstStateHistory,
+        const basics::DoubleKeyVector6dValueMap& secondStateHistory,
+        const double screeningDistance );
+
+//! Screen pairs of state histories for conjunctions.
+/*!
+ * Screens given pairs of state histories for conjunctions (see screenConjunctions() for two state
+ * histories), e.g., the pairs found by detectEncounters(). The pairs are screened in parallel,
+ * and the conjunctions of each pair are stored in a separate buffer, so that the result does not
+ * depend on the number of threads. Throws a run-time error if the screening distance is not
+ * positive, if an index is out of range, or if a state history contains fewer than two states.
+ * \param stateHistories State histories of objects [s, m, m s^-1].
+ * \param objectPairs Pairs of indices of objects to screen.
+ * \param screeningDistance Screening distance [m].
+ * \param numberOfThreads Number of threads to use (0 = number of hardware threads; default=1).
+ * \return Conjunctions, in order of given pairs, and of increasing time of closest approach per
+ *          pair.
+ */
+std::vector< Conjunction > screenConjunctions(
+        const std::vector< basics::DoubleKeyVector6dValueMap >& stateHistories,
+        const std::vector< BodyIndexPair >& objectPairs, const double screeningDistance,
+        const unsigned int numberOfThreads = 1 );
+
+} // namespace astrodynamics
+} // namespace assist
+
+#endif // ASSIST_CONJUNCTION_SCREENING_H
+
+/*
+ *    References
+ *      Alfano, S., Negron, D. Determining satellite close approaches, Journal of the
+ *          Astronautical Sciences 41(2), 217-225, 1993.
+ */
@@ -0,0 +1,280 @@
+/*
+ *    Copyright (c) 2010-2014, Delft University of Technology
+ *    Copyright (c) 2010-2014, K. Kumar (me@kartikkumar.com)
+ *    All rights reserved.
+ *    See http://bit.ly/1jern3m for license details.
+ */
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <boost/cstdint.hpp>
+#include <boost/exception/all.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/unordered_map.hpp>
+
+#include "Assist/Astrodynamics/encounterDetection.h"
+#include "Assist/Basics/parallelLoop.h"
+
+namespace assist
+{
+namespace astrodynamics
+{
+
+namespace
+{
+
+//! Number of bits per cell index in cell key.
+const unsigned int numberOfBitsPerCellIndex = 21;
+
+//! Maximum number of grid cells per axis, such that cell indices fit in the cell key.
+const double maximumNumberOfCellsPerAxis = 1048576.0;
+
+//! Typedef for hashed map from cell key to range of bodies (in order sorted by cell).
+typedef boost::unordered_map< boost::uint64_t, std::pair< std::size_t, std::size_t > >
+CellRangeMap;
+
+//! Typedef for pair of cell key and body index.
+typedef std::pair< boost::uint64_t, std::size_t > CellKeyBodyIndexPair;
+
+//! Compute cell key from cell indices.
+inline boost::uint64_t computeCellKey( const boost::uint64_t xIndex, const boost::uint64_t yIndex,
+                                       const boost::uint64_t zIndex )
+{
+    return ( xIndex << ( 2 * numberOfBitsPerCellIndex ) )
+            | ( yIndex << numberOfBitsPerCellIndex ) | zIndex;
+}
+
+//! Collector of encounters, which merges per-thread buffers.
+struct EncounterCollector
+{
+    //! Append buffer of encounters found by one thread.
+    void append( const std::vector< BodyIndexPair >& buffer )
+    {
+        boost::lock_guard< boost::mutex > lock( mutex );
+        encounters.insert( encounters.end( ), buffer.begin( ), buffer.end( ) );
+    }
+
+    //! Mutex that protects encounters.
+    boost::mutex mutex;
+
+    //! Encounters found by all threads.
+    std::vector< BodyIndexPair > encounters;
+};
+
+//! Data shared by all threads during encounter detection.
+struct EncounterData
+{
+    //! Check if bodies encounter each other.
+    bool isEncounter( const std::size_t firstBody, const std::size_t secondBody ) const
+    {
+        const double dx = positions[ firstBody ] - positions[ secondBody ];
+        const double dy = positions[ firstBody + numberOfBodies ]
+                - positions[ secondBody + numberOfBodies ];
+        const double dz = positions[ firstBody + 2 * numberOfBodies ]
+                - positions[ secondBody + 2 * numberOfBodies ];
+        const double encounterDistance
+                = numberOfHillRadii * std::max( hillRadii[ firstBody ], hillRadii[ secondBody ] );
+
+        return dx * dx + dy * dy + dz * dz < encounterDistance * encounterDistance;
+    }
+
+    //! Number of bodies.
+    std::size_t numberOfBodies;
+
+    //! Positions of bodies (column-major, one row per body) [m].
+    const double* positions;
+
+    //! Hill radii of bodies [m].
+    const double* hillRadii;
+
+    //! Number of Hill radii within which bodies encounter each other.
+    double numberOfHillRadii;
+
+    //! Collector of encounters.
+    EncounterCollector* collector;
+};
+
+//! Loop body to detect encounters by checking all pairs.
+struct DetectEncountersBruteForce
+{
+    //! Detect encounters of bodies in range [begin, end) with bodies of higher index.
+    void operator( )( const std::size_t begin, const std::size_t end ) const
+    {
+        std::vector< BodyIndexPair > buffer;
+
+        for ( std::size_t i = begin; i < end; i++ )
+        {
+            for ( std::size_t j = i + 1; j < data->numberOfBodies; j++ )
+            {
+                if ( data->isEncounter( i, j ) )
+                {
+                    buffer.push_back( std::make_pair( i, j ) );
+                }
+            }
+        }
+
+        data->collector->append( buffer );
+    }
+
+    //! Data shared by all threads.
+    const EncounterData* data;
+};
+
+//! Loop body to detect encounters using uniform grid.
+struct DetectEncountersWithGrid
+{
+    //! Detect encounters of bodies in range [begin, end) of sorted bodies.
+    void operator( )( const std::size_t begin, const std::size_t end ) const
+    {
+        const boost::uint64_t cellIndexMask
+                = ( static_cast< boost::uint64_t >( 1 ) << numberOfBitsPerCellIndex ) - 1;
+
+        std::vector< BodyIndexPair > buffer;
+
+        for ( std::size_t s = begin; s < end; s++ )
+        {
+            const boost::uint64_t cellKey = ( *sortedBodies )[ s ].first;
+            const std::size_t i = ( *sortedBodies )[ s ].second;
+            const boost::uint64_t xIndex = cellKey >> ( 2 * numberOfBitsPerCellIndex );
+            const boost::uint64_t yIndex = ( cellKey >> numberOfBitsPerCellIndex )
+                    & cellIndexMask;
+            const boost::uint64_t zIndex = cellKey & cellIndexMask;
+
+            // Check bodies in neighbouring cells (indices are unsigned, so cells below index zero
+            // wrap around to keys that are not in the grid). Each pair is reported once, by the
+            // body with the smaller index.
+            for ( boost::uint64_t dx = 0; dx < 3; dx++ )
+            {
+                for ( boost::uint64_t dy = 0; dy < 3; dy++ )
+                {
+                    for ( boost::uint64_t dz = 0; dz < 3; dz++ )
+                    {
+                        if ( ( xIndex + dx == 0 ) || ( yIndex + dy == 0 )
+                             || ( zIndex + dz == 0 ) )
+                        {
+                            continue;
+                        }
+
+                        const CellRangeMap::const_iterator iteratorCell = cellRanges->find(
+                                    computeCellKey( xIndex + dx - 1, yIndex + dy - 1,
+                                                    zIndex + dz - 1 ) );
+                        if ( iteratorCell == cellRanges->end( ) )
+                        {
+                            continue;
+                        }
+
+                        for ( std::size_t t = iteratorCell->second.first;
+                              t < iteratorCell->second.second; t++ )
+                        {
+                            const std::size_t j = ( *sortedBodies )[ t ].second;
+                            if ( j > i && data->isEncounter( i, j ) )
+                            {
+                                buffer.push_back( std::make_pair( i, j ) );
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        data->collector->append( buffer );
+    }
+
+    //! Data shared by all threads.
+    const EncounterData* data;
+
+    //! Cell keys and indices of bodies, sorted by cell key.
+    const std::vector< CellKeyBodyIndexPair >* sortedBodies;
+
+    //! Ranges of sorted bodies per cell.
+    const CellRangeMap* cellRanges;
+};
+
+} // namespace
+
+//! Detect encounters between bodies within given number of Hill radii.
+std::vector< BodyIndexPair > detectEncounters( const Eigen::MatrixX3d& positions,
+                                               const Eigen::ArrayXd& hillRadii,
+                                               const double numberOfHillRadii,
+                                               const EncounterDetectionMethod method,
+                                               const unsigned int numberOfThreads )
+{
+    if ( positions.rows( ) != hillRadii.size( ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Error: number of Hill radii does not match number "
+                                            "of positions." ) ) );
+    }
+
+    const std::size_t numberOfBodies = static_cast< std::size_t >( positions.rows( ) );
+    EncounterCollector collector;
+
+    if ( numberOfBodies < 2 )
+    {
+        return collector.encounters;
+    }
+
+    const EncounterData data = { numberOfBodies, positions.data( ), hillRadii.data( ),
+                                 numberOfHillRadii, &collector };
+
+    if ( method == bruteForceEncounterDetection )
+    {
+        const DetectEncountersBruteForce loopBody = { &data };
+        basics::executeParallelLoop( numberOfBodies, loopBody, numberOfThreads, 64 );
+    }
+
+    else
+    {
+        // Set cell size to encounter distance of body with largest Hill radius, enlarged if
+        // needed so that the number of cells per axis fits in the cell key. Without a positive
+        // encounter distance, there can be no encounters.
+        const Eigen::RowVector3d minimumCorner = positions.colwise( ).minCoeff( );
+        const double largestExtent
+                = ( positions.colwise( ).maxCoeff( ) - minimumCorner ).maxCoeff( );
+        const double cellSize = std::max( numberOfHillRadii * hillRadii.maxCoeff( ),
+                                          largestExtent / maximumNumberOfCellsPerAxis );
+        if ( !( cellSize > 0.0 ) )
+        {
+            return collector.encounters;
+        }
+
+        // Compute cell keys, and sort bodies by cell.
+        std::vector< CellKeyBodyIndexPair > sortedBodies( numberOfBodies );
+        for ( std::size_t i = 0; i < numberOfBodies; i++ )
+        {
+            const Eigen::RowVector3d cellIndices = ( positions.row( i ) - minimumCorner )
+                    / cellSize;
+            sortedBodies[ i ] = std::make_pair(
+                        computeCellKey( static_cast< boost::uint64_t >( cellIndices( 0 ) ),
+                                        static_cast< boost::uint64_t >( cellIndices( 1 ) ),
+                                        static_cast< boost::uint64_t >( cellIndices( 2 ) ) ), i );
+        }
+
+        std::sort( sortedBodies.begin( ), sortedBodies.end( ) );
+
+        // Store range of sorted bodies per cell.
+        CellRangeMap cellRanges;
+        std::size_t cellBegin = 0;
+        for ( std::size_t s = 1; s <= numberOfBodies; s++ )
+        {
+            if ( s == numberOfBodies || sortedBodies[ s ].first != sortedBodies[ cellBegin ].first )
+            {
+                cellRanges[ sortedBodies[ cellBegin ].first ] = std::make_pair( cellBegin, s );
+                cellBegin = s;
+            }
+        }
+
+        const DetectEncountersWithGrid loopBody = { &data, &sortedBodies, &cellRanges };
+        basics::executeParallelLoop( numberOfBodies, loopBody, numberOfThreads );
+    }
+
+    // Sort merged buffers, so that the result does not depend on the number of threads.
+    std::sort( collector.encounters.begin( ), collector.encounters.end( ) );
+    return collector.encounters;
+}
+
+} // namespace astrodynamics
+} // namespace assist
@@ -0,0 +1,62 @@
+/*
+ *    Copyright (c) 2010-2014, Delft University of Technology
+ *    Copyright (c) 2010-2014, K. Kumar (me@kartikkumar.com)
+ *    All rights reserved.
+ *    See http://bit.ly/1jern3m for license details.
+ */
+
+#ifndef ASSIST_ENCOUNTER_DETECTION_H
+#define ASSIST_ENCOUNTER_DETECTION_H
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <Eigen/Core>
+
+namespace assist
+{
+namespace astrodynamics
+{
+
+//! Encounter detection methods.
+enum EncounterDetectionMethod
+{
+    uniformGridEncounterDetection,
+    bruteForceEncounterDetection
+};
+
+//! Typedef for pair of body indices.
+typedef std::pair< std::size_t, std::size_t > BodyIndexPair;
+
+//! Detect encounters between bodies within given number of Hill radii.
+/*!
+ * Detects all pairs of bodies that are within a given number of Hill radii of each other, i.e.,
+ * of which the distance is less than the given number of Hill radii of the body with the largest
+ * Hill radius of the two (see ConvertHillRadiiToMeters and HillSphereEngine).
+ *
+ * By default, the bodies are binned in a uniform grid with a cell size equal to the given number
+ * of Hill radii of the body with the largest Hill radius, so that only the bodies in the 27
+ * neighbouring cells need to be checked for each body. Binning requires sorting the bodies by
+ * cell, so the cost is O(N log N) for populations that are not strongly clustered. The bodies
+ * are processed in parallel, with each thread collecting candidate pairs in its own buffer; the
+ * buffers are merged at the end. The brute-force method checks all pairs, at O(N^2) cost, and is
+ * intended to cross-check the grid in tests.
+ * \param positions Positions of bodies, one row per body [m].
+ * \param hillRadii Hill radii of bodies [m].
+ * \param numberOfHillRadii Number of Hill radii within which bodies encounter each other.
+ * \param method Encounter detection method (default=uniformGridEncounterDetection).
+ * \param numberOfThreads Number of threads to use (0 = number of hardware threads; default=1).
+ * \return Pairs of indices of bodies that encounter each other, with the smaller index first,
+ *          sorted in increasing order.
+ */
+std::vector< BodyIndexPair > detectEncounters(
+        const Eigen::MatrixX3d& positions, const Eigen::ArrayXd& hillRadii,
+        const double numberOfHillRadii,
+        const EncounterDetectionMethod method = uniformGridEncounterDetection,
+        const unsigned int numberOfThreads = 1 );
+
+} // namespace astrodynamics
+} // namespace assist
+
+#endif // ASSIST_ENCOUNTER_DETECTION_H
@@ -0,0 +1,209 @@
+/*
+ *    Copyright (c) 2010-2014, Delft University of Technology
+ *    Copyright (c) 2010-2014, K. Kumar (me@kartikkumar.com)
+ *    All rights reserved.
+ *    See http://bit.ly/1jern3m for license details.
+ */
+
+#ifndef ASSIST_EPOCH_CONVERSIONS_H
+#define ASSIST_EPOCH_CONVERSIONS_H
+
+#include <map>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <boost/exception/all.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+#include <Eigen/Core>
+
+#include "Assist/Astrodynamics/quantities.h"
+
+namespace assist
+{
+namespace astrodynamics
+{
+
+namespace detail
+{
+
+//! Scale array of epochs in place, by multiplication and division.
+/*!
+ * Scales an array expression of epochs in place, by multiplication with a multiplier and
+ * division by a divisor, in a single (vectorized) pass over memory. The division is skipped for
+ * a divisor of one.
+ */
+template< typename Derived >
+void scaleEpochArray( const Eigen::ArrayBase< Derived >& epochs,
+                      const double multiplier, const double divisor )
+{
+    Eigen::ArrayBase< Derived >& scaledEpochs
+            = const_cast< Eigen::ArrayBase< Derived >& >( epochs );
+
+    if ( divisor == 1.0 )
+    {
+        scaledEpochs *= multiplier;
+    }
+
+    else
+    {
+        scaledEpochs = scaledEpochs * multiplier / divisor;
+    }
+}
+
+//! Scale epochs of array in place (see rescaleEpochs()).
+inline void scaleEpochs( Eigen::ArrayXd& epochs, const double multiplier, const double divisor )
+{
+    scaleEpochArray( epochs, multiplier, divisor );
+}
+
+//! Scale epochs of vector in place (see rescaleEpochs()).
+inline void scaleEpochs( std::vector< double >& epochs,
+                         const double multiplier, const double divisor )
+{
+    if ( !epochs.empty( ) )
+    {
+        scaleEpochArray( Eigen::Map< Eigen::ArrayXd >(
+                             &epochs[ 0 ], static_cast< Eigen::ArrayXd::Index >( epochs.size( ) ) ),
+                         multiplier, divisor );
+    }
+}
+
+//! Scale epoch column of flat series in place (see rescaleEpochs()).
+inline void scaleEpochs( Eigen::MatrixXd& series, const double multiplier, const double divisor,
+                         const int epochColumn = 0 )
+{
+    scaleEpochArray( series.col( epochColumn ).array( ), multiplier, divisor );
+}
+
+//! Scale epochs of series stored as map (see rescaleEpochs()).
+template< typename ValueType, typename Compare, typename Allocator >
+void scaleEpochs( std::map< double, ValueType, Compare, Allocator >& series,
+                  const double multiplier, const double divisor )
+{
+    typedef std::map< double, ValueType, Compare, Allocator > SeriesType;
+
+    if ( multiplier == 0.0 )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Error: scale factor for epochs is zero." ) ) );
+    }
+
+    SeriesType rescaledSeries( series.key_comp( ), series.get_allocator( ) );
+
+    if ( ( multiplier > 0.0 ) == ( divisor > 0.0 ) )
+    {
+        for ( typename SeriesType::const_iterator iteratorEntry = series.begin( );
+              iteratorEntry != series.end( ); iteratorEntry++ )
+        {
+            rescaledSeries.insert( rescaledSeries.end( ),
+                                   std::make_pair( iteratorEntry->first * multiplier / divisor,
+                                                   iteratorEntry->second ) );
+        }
+    }
+
+    else
+    {
+        for ( typename SeriesType::const_iterator iteratorEntry = series.begin( );
+              iteratorEntry != series.end( ); iteratorEntry++ )
+        {
+            rescaledSeries.insert( rescaledSeries.begin( ),
+                                   std::make_pair( iteratorEntry->first * multiplier / divisor,
+                                                   iteratorEntry->second ) );
+        }
+    }
+
+    series.swap( rescaledSeries );
+}
+
+} // namespace detail
+
+//! Rescale epochs in place.
+/*!
+ * Rescales an array of epochs in place, by multiplication with a scale factor, in a single
+ * (vectorized) pass over memory.
+ * \param epochs Epochs to rescale.
+ * \param scaleFactor Scale factor, e.g., 60.0 to convert from minutes to seconds.
+ */
+inline void rescaleEpochs( Eigen::ArrayXd& epochs, const double scaleFactor )
+{
+    detail::scaleEpochs( epochs, scaleFactor, 1.0 );
+}
+
+//! Rescale epochs in place.
+/*!
+ * Rescales a vector of epochs in place, by multiplication with a scale factor, in a single
+ * (vectorized) pass over memory.
+ * \param epochs Epochs to rescale.
+ * \param scaleFactor Scale factor, e.g., 60.0 to convert from minutes to seconds.
+ */
+inline void rescaleEpochs( std::vector< double >& epochs, const double scaleFactor )
+{
+    detail::scaleEpochs( epochs, scaleFactor, 1.0 );
+}
+
+//! Rescale epoch column of flat series in place.
+/*!
+ * Rescales the epoch column of a flat series, e.g., a state history loaded from file as a matrix
+ * with one row per epoch, in place, by multiplication with a scale factor. Since Eigen matrices
+ * are stored column-major, the column is contiguous in memory.
+ * \param series Flat series, with epochs in given column.
+ * \param scaleFactor Scale factor, e.g., 60.0 to convert from minutes to seconds.
+ * \param epochColumn Index of column containing epochs (default=0).
+ */
+inline void rescaleEpochs( Eigen::MatrixXd& series, const double scaleFactor,
+                           const int epochColumn = 0 )
+{
+    detail::scaleEpochs( series, scaleFactor, 1.0, epochColumn );
+}
+
+//! Rescale epochs of series stored as map.
+/*!
+ * Rescales the epochs (keys) of a series stored as a map, e.g., a DoubleKeyDoubleValueMap or
+ * DoubleKeyVector6dValueMap, by multiplication with a scale factor. Since map keys cannot be
+ * modified in place, the map is rebuilt. Multiplication by a positive (negative) scale factor
+ * preserves (reverses) the order of the keys, so each entry is inserted with a hint at the end
+ * (start) of the new map, which makes the rebuild O(N), instead of O(N log N) for unhinted
+ * inserts. Throws a run-time error if the scale factor is zero. Note that distinct epochs that
+ * are rescaled to the same value (e.g., if they only differ in the last bits) are merged, keeping
+ * the first in order.
+ * \param series Series stored as map, of which the epochs are rescaled.
+ * \param scaleFactor Scale factor, e.g., 60.0 to convert from minutes to seconds.
+ */
+template< typename ValueType, typename Compare, typename Allocator >
+void rescaleEpochs( std::map< double, ValueType, Compare, Allocator >& series,
+                    const double scaleFactor )
+{
+    detail::scaleEpochs( series, scaleFactor, 1.0 );
+}
+
+//! Convert epochs between time units.
+/*!
+ * Converts epochs of a series (any type accepted by rescaleEpochs()) between time units (see
+ * quantities.h), e.g., convertEpochs< units::Second, units::JulianDay >( stateHistory ). Like
+ * the conversion of a Quantity, each epoch is multiplied by the scale factor of the unit
+ * converted from and divided by that of the unit converted to, so that the results are identical
+ * to those of the scalar conversion functions, e.g., convertSecondsToJulianDays(). Conversion
+ * between units that are not time units does not compile.
+ * \tparam FromUnit Time unit to convert from.
+ * \tparam ToUnit Time unit to convert to.
+ * \param series Series of which the epochs are converted.
+ */
+template< typename FromUnit, typename ToUnit, typename SeriesType >
+void convertEpochs( SeriesType& series )
+{
+    BOOST_STATIC_ASSERT( ( boost::is_same< typename FromUnit::Dimension,
+                                           units::TimeDimension >::value ) );
+    BOOST_STATIC_ASSERT( ( boost::is_same< typename ToUnit::Dimension,
+                                           units::TimeDimension >::value ) );
+
+    detail::scaleEpochs( series, FromUnit::getScaleToBaseUnit( ), ToUnit::getScaleToBaseUnit( ) );
+}
+
+} // namespace astrodynamics
+} // namespace assist
+
+#endif // ASSIST_EPOCH_CONVERSIONS_H
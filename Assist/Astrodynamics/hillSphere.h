@@ -62,7 +62,3 @@ private:
 } // namespace assist
 
 #endif // ASSIST_HILL_SPHERE_H
-
-/*
- *    The ConvertHillRadiiToMeters needs to be unit tested.
- */
@@ -0,0 +1,215 @@
+/*
+ *    Copyright (c) 2010-2014, Delft University of Technology
+ *    Copyright (c) 2010-2014, K. Kumar (me@kartikkumar.com)
+ *    All rights reserved.
+ *    See http://bit.ly/1jern3m for license details.
+ */
+
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include <boost/cstdint.hpp>
+#include <boost/exception/all.hpp>
+
+#include "Assist/Astrodynamics/hillSphereEngine.h"
+#include "Assist/Basics/parallelLoop.h"
+
+namespace assist
+{
+namespace astrodynamics
+{
+
+namespace
+{
+
+//! Compute cube root of non-negative value, without branches.
+inline double computeCubeRoot( const double value )
+{
+    // Compute initial guess by dividing high word (sign, exponent and leading mantissa bits) by
+    // three, and adding bias to correct exponent (Kahan, 1991).
+    boost::uint64_t bits;
+    std::memcpy( &bits, &value, sizeof( double ) );
+    const boost::uint32_t highWord = static_cast< boost::uint32_t >( bits >> 32 ) / 3
+            + 715094163u;
+    bits = static_cast< boost::uint64_t >( highWord ) << 32;
+
+    double cubeRoot;
+    std::memcpy( &cubeRoot, &bits, sizeof( double ) );
+
+    // Refine initial guess with Halley iterations, each of which triples the number of correct
+    // bits.
+    for ( unsigned int i = 0; i < 3; i++ )
+    {
+        const double cube = cubeRoot * cubeRoot * cubeRoot;
+        cubeRoot *= ( cube + 2.0 * value ) / ( 2.0 * cube + value );
+    }
+
+    return value > 0.0 ? cubeRoot : 0.0;
+}
+
+//! Loop body to compute Hill radius factors and Hill radii.
+struct ComputeHillRadii
+{
+    //! Compute Hill radius factors and Hill radii on range [begin, end).
+    void operator( )( const std::size_t begin, const std::size_t end ) const
+    {
+        for ( std::size_t i = begin; i < end; i++ )
+        {
+            hillRadiusFactors[ i ] = computeCubeRoot( orbitingBodyGravitationalParameters[ i ]
+                                                      * inverseOfThreeCentralBodyMu );
+            hillRadii[ i ] = hillRadiusFactors[ i ] * semiMajorAxes[ i ];
+        }
+    }
+
+    //! Inverse of three times gravitational parameter of central body [m^-3 s^2].
+    double inverseOfThreeCentralBodyMu;
+
+    //! Gravitational parameters of orbiting bodies [m^3 s^-2].
+    const double* orbitingBodyGravitationalParameters;
+
+    //! Semi-major axes of orbiting bodies [m].
+    const double* semiMajorAxes;
+
+    //! Hill radius factors [-].
+    double* hillRadiusFactors;
+
+    //! Hill radii [m].
+    double* hillRadii;
+};
+
+//! Loop body to multiply two arrays elementwise.
+struct MultiplyArrays
+{
+    //! Multiply arrays on range [begin, end).
+    void operator( )( const std::size_t begin, const std::size_t end ) const
+    {
+        for ( std::size_t i = begin; i < end; i++ )
+        {
+            product[ i ] = firstFactor[ i ] * secondFactor[ i ];
+        }
+    }
+
+    //! First factor.
+    const double* firstFactor;
+
+    //! Second factor.
+    const double* secondFactor;
+
+    //! Product.
+    double* product;
+};
+
+//! Loop body to scale array.
+struct ScaleArray
+{
+    //! Scale array on range [begin, end).
+    void operator( )( const std::size_t begin, const std::size_t end ) const
+    {
+        for ( std::size_t i = begin; i < end; i++ )
+        {
+            scaledArray[ i ] = scaleFactor * array[ i ];
+        }
+    }
+
+    //! Scale factor.
+    double scaleFactor;
+
+    //! Array to scale.
+    const double* array;
+
+    //! Scaled array.
+    double* scaledArray;
+};
+
+//! Loop body to compute cube roots.
+struct ComputeCubeRoots
+{
+    //! Compute cube roots on range [begin, end).
+    void operator( )( const std::size_t begin, const std::size_t end ) const
+    {
+        for ( std::size_t i = begin; i < end; i++ )
+        {
+            cubeRoots[ i ] = computeCubeRoot( values[ i ] );
+        }
+    }
+
+    //! Values.
+    const double* values;
+
+    //! Cube roots.
+    double* cubeRoots;
+};
+
+//! Check size of array against number of bodies.
+void checkNumberOfBodies( const Eigen::ArrayXd& array, const std::size_t numberOfBodies,
+                          const std::string& name )
+{
+    if ( static_cast< std::size_t >( array.size( ) ) != numberOfBodies )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Error: number of " + name
+                                            + " does not match number of bodies." ) ) );
+    }
+}
+
+} // namespace
+
+//! Compute cube roots of array of values.
+void computeCubeRoots( const Eigen::ArrayXd& values, Eigen::ArrayXd& cubeRoots )
+{
+    cubeRoots.resize( values.size( ) );
+
+    const ComputeCubeRoots loopBody = { values.data( ), cubeRoots.data( ) };
+    loopBody( 0, static_cast< std::size_t >( values.size( ) ) );
+}
+
+//! Constructor taking parameters of central body and population of orbiting bodies.
+HillSphereEngine::HillSphereEngine( const double aCentralBodyGravitationalParameter,
+                                    const Eigen::ArrayXd& someOrbitingBodyGravitationalParameters,
+                                    const Eigen::ArrayXd& someSemiMajorAxes,
+                                    const unsigned int aNumberOfThreads )
+    : numberOfThreads( aNumberOfThreads ),
+      hillRadiusFactors( someOrbitingBodyGravitationalParameters.size( ) ),
+      hillRadii( someOrbitingBodyGravitationalParameters.size( ) )
+{
+    if ( !( aCentralBodyGravitationalParameter > 0.0 ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Error: gravitational parameter of central body must "
+                                            "be positive." ) ) );
+    }
+
+    checkNumberOfBodies( someSemiMajorAxes, getNumberOfBodies( ), "semi-major axes" );
+
+    const ComputeHillRadii loopBody = { 1.0 / ( 3.0 * aCentralBodyGravitationalParameter ),
+                                        someOrbitingBodyGravitationalParameters.data( ),
+                                        someSemiMajorAxes.data( ),
+                                        hillRadiusFactors.data( ), hillRadii.data( ) };
+    basics::executeParallelLoop( getNumberOfBodies( ), loopBody, numberOfThreads );
+}
+
+//! Set semi-major axes of orbiting bodies.
+void HillSphereEngine::setSemiMajorAxes( const Eigen::ArrayXd& someSemiMajorAxes )
+{
+    checkNumberOfBodies( someSemiMajorAxes, getNumberOfBodies( ), "semi-major axes" );
+
+    const MultiplyArrays loopBody = { hillRadiusFactors.data( ), someSemiMajorAxes.data( ),
+                                      hillRadii.data( ) };
+    basics::executeParallelLoop( getNumberOfBodies( ), loopBody, numberOfThreads );
+}
+
+//! Convert Hill radii to meters for all orbiting bodies.
+void HillSphereEngine::convertHillRadiiToMeters( const double numberOfHillRadii,
+                                                 Eigen::ArrayXd& distances ) const
+{
+    distances.resize( hillRadii.size( ) );
+
+    const ScaleArray loopBody = { numberOfHillRadii, hillRadii.data( ), distances.data( ) };
+    basics::executeParallelLoop( getNumberOfBodies( ), loopBody, numberOfThreads );
+}
+
+} // namespace astrodynamics
+} // namespace assist
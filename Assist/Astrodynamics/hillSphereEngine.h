@@ -0,0 +1,144 @@
+/*
+ *    Copyright (c) 2010-2014, Delft University of Technology
+ *    Copyright (c) 2010-2014, K. Kumar (me@kartikkumar.com)
+ *    All rights reserved.
+ *    See http://bit.ly/1jern3m for license details.
+ */
+
+#ifndef ASSIST_HILL_SPHERE_ENGINE_H
+#define ASSIST_HILL_SPHERE_ENGINE_H
+
+#include <cstddef>
+
+#include <Eigen/Core>
+
+namespace assist
+{
+namespace astrodynamics
+{
+
+//! Compute cube roots of array of values.
+/*!
+ * Computes the cube roots of an array of non-negative values, without branches, so that the loop
+ * can be vectorized by the compiler. An initial guess, accurate to about 5 bits, is obtained by
+ * dividing the exponent and leading mantissa bits by three, and is refined by three Halley
+ * iterations, which yields a result accurate to within a few ulp. Zero maps to zero. The values
+ * are expected to be normal (i.e., not subnormal, infinite or NaN).
+ * \param values Values to compute cube roots of.
+ * \param cubeRoots Cube roots of values (resized if needed).
+ */
+void computeCubeRoots( const Eigen::ArrayXd& values, Eigen::ArrayXd& cubeRoots );
+
+//! Engine to compute Hill radii for populations of orbiting bodies.
+/*!
+ * Engine to compute the Hill radii of a population of bodies orbiting the same central body, such
+ * as asteroids or fragments. The gravitational parameters and semi-major axes of the population
+ * are stored as separate contiguous arrays (structure-of-arrays), and the per-body constant
+ * ( mu_orbiting / ( 3 mu_central ) )^( 1/3 ) is computed once, for the whole population, with a
+ * vectorized cube root (see computeCubeRoots()). Updating the semi-major axes, e.g., every epoch,
+ * and converting Hill radii to meters are then single multiplications per body. Large
+ * populations are processed in parallel. ConvertHillRadiiToMeters (see hillSphere.h) is the
+ * scalar reference for this engine.
+ */
+class HillSphereEngine
+{
+public:
+
+    //! Constructor taking parameters of central body and population of orbiting bodies.
+    /*!
+     * Constructor taking gravitational parameter of central body, and gravitational parameters
+     * and semi-major axes of population of orbiting bodies. Throws a run-time error if the
+     * gravitational parameter of the central body is not positive or if the sizes of the
+     * arrays are not equal.
+     * \param aCentralBodyGravitationalParameter Gravitational parameter of central body
+     *          [m^3 s^-2].
+     * \param someOrbitingBodyGravitationalParameters Gravitational parameters of orbiting bodies
+     *          [m^3 s^-2].
+     * \param someSemiMajorAxes Semi-major axes of orbiting bodies [m].
+     * \param aNumberOfThreads Number of threads to use (0 = number of hardware threads;
+     *          default=1).
+     */
+    HillSphereEngine( const double aCentralBodyGravitationalParameter,
+                      const Eigen::ArrayXd& someOrbitingBodyGravitationalParameters,
+                      const Eigen::ArrayXd& someSemiMajorAxes,
+                      const unsigned int aNumberOfThreads = 1 );
+
+    //! Set semi-major axes of orbiting bodies.
+    /*!
+     * Sets semi-major axes of orbiting bodies and updates their Hill radii, using the cached
+     * per-body constants. Throws a run-time error if the size of the array does not match the
+     * number of bodies.
+     * \param someSemiMajorAxes Semi-major axes of orbiting bodies [m].
+     */
+    void setSemiMajorAxes( const Eigen::ArrayXd& someSemiMajorAxes );
+
+    //! Convert Hill radii to meters for all orbiting bodies.
+    /*!
+     * Converts a given number of Hill radii to meters for all orbiting bodies.
+     * \param numberOfHillRadii Number of Hill radii to be converted to meters.
+     * \param distances Number of Hill radii expressed in meters, per body (resized if needed).
+     */
+    void convertHillRadiiToMeters( const double numberOfHillRadii,
+                                   Eigen::ArrayXd& distances ) const;
+
+    //! Convert Hill radii to meters for given orbiting body.
+    /*!
+     * Converts a given number of Hill radii to meters for a given orbiting body.
+     * \param bodyIndex Index of orbiting body.
+     * \param numberOfHillRadii Number of Hill radii to be converted to meters.
+     * \return Number of Hill radii expressed in meters.
+     */
+    double convertHillRadiiToMeters( const std::size_t bodyIndex,
+                                     const double numberOfHillRadii ) const
+    {
+        return numberOfHillRadii * hillRadii( bodyIndex );
+    }
+
+    //! Get number of orbiting bodies.
+    /*!
+     * Returns number of orbiting bodies in population.
+     * \return Number of orbiting bodies.
+     */
+    std::size_t getNumberOfBodies( ) const
+    {
+        return static_cast< std::size_t >( hillRadii.size( ) );
+    }
+
+    //! Get Hill radius factors.
+    /*!
+     * Returns per-body constants ( mu_orbiting / ( 3 mu_central ) )^( 1/3 ), i.e., the Hill
+     * radii as fraction of the semi-major axes.
+     * \return Hill radius factors [-].
+     */
+    const Eigen::ArrayXd& getHillRadiusFactors( ) const { return hillRadiusFactors; }
+
+    //! Get Hill radii.
+    /*!
+     * Returns Hill radii of orbiting bodies.
+     * \return Hill radii [m].
+     */
+    const Eigen::ArrayXd& getHillRadii( ) const { return hillRadii; }
+
+protected:
+
+private:
+
+    //! Number of threads to use.
+    const unsigned int numberOfThreads;
+
+    //! Hill radius factors, ( mu_orbiting / ( 3 mu_central ) )^( 1/3 ) per body [-].
+    Eigen::ArrayXd hillRadiusFactors;
+
+    //! Hill radii per body [m].
+    Eigen::ArrayXd hillRadii;
+};
+
+} // namespace astrodynamics
+} // namespace assist
+
+#endif // ASSIST_HILL_SPHERE_ENGINE_H
+
+/*
+ *    References
+ *      Kahan, W. Computing a Real Cube Root, University of California, Berkeley, 1991.
+ */
@@ -0,0 +1,332 @@
+/*
+ *    Copyright (c) 2010-2014, Delft University of Technology
+ *    Copyright (c) 2010-2014, K. Kumar (me@kartikkumar.com)
+ *    All rights reserved.
+ *    See http://bit.ly/1jern3m for license details.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <boost/exception/all.hpp>
+
+#include <TudatCore/Mathematics/BasicMathematics/mathematicalConstants.h>
+
+#include "Assist/Astrodynamics/keplerPropagator.h"
+#include "Assist/Basics/parallelLoop.h"
+
+namespace assist
+{
+namespace astrodynamics
+{
+
+namespace
+{
+
+//! Number of bodies per block, sized so that the states of a block stay in the L1 cache.
+const std::size_t blockSize = 256;
+
+//! Number of Halley iterations used to solve Kepler's equation.
+const unsigned int numberOfHalleyIterations = 3;
+
+//! Solve Kepler's equation for elliptical orbit, without data-dependent branches.
+inline double computeEccentricAnomaly( const double meanAnomaly, const double eccentricity )
+{
+    using tudat::basic_mathematics::mathematical_constants::PI;
+
+    // Reduce mean anomaly to [-pi, pi], and solve for its absolute value, using the symmetry
+    // E( -M ) = -E( M ).
+    const double reducedMeanAnomaly = meanAnomaly
+            - 2.0 * PI * std::floor( ( meanAnomaly + PI ) / ( 2.0 * PI ) );
+    const double absoluteMeanAnomaly = std::fabs( reducedMeanAnomaly );
+
+    // Compute starter as blend of series starter, M + e sin M, accurate for small
+    // eccentricities, and cube-root starter, ( 6 M )^( 1/3 ), accurate near periapsis for
+    // eccentricities close to one (Danby, 1988).
+    double eccentricAnomaly
+            = ( 1.0 - eccentricity ) * ( absoluteMeanAnomaly
+                                         + eccentricity * std::sin( absoluteMeanAnomaly ) )
+            + eccentricity * std::min( std::pow( 6.0 * absoluteMeanAnomaly, 1.0 / 3.0 ),
+                                       absoluteMeanAnomaly + eccentricity );
+
+    // Refine with fixed number of Halley iterations.
+    for ( unsigned int i = 0; i < numberOfHalleyIterations; i++ )
+    {
+        const double eSinE = eccentricity * std::sin( eccentricAnomaly );
+        const double function = eccentricAnomaly - eSinE - absoluteMeanAnomaly;
+        const double firstDerivative = 1.0 - eccentricity * std::cos( eccentricAnomaly );
+        eccentricAnomaly -= function / ( firstDerivative
+                                         - 0.5 * function * eSinE / firstDerivative );
+    }
+
+    return reducedMeanAnomaly < 0.0 ? -eccentricAnomaly : eccentricAnomaly;
+}
+
+//! Pointers to per-body constants of catalog.
+struct CatalogData
+{
+    //! Number of bodies in catalog.
+    std::size_t numberOfBodies;
+
+    //! Semi-major axes [m].
+    const double* semiMajorAxes;
+
+    //! Eccentricities [-].
+    const double* eccentricities;
+
+    //! Mean anomalies at epoch of elements [rad].
+    const double* meanAnomaliesAtEpoch;
+
+    //! Mean motions [rad s^-1].
+    const double* meanMotions;
+
+    //! Ratios of semi-minor and semi-major axes [-].
+    const double* semiMinorAxisRatios;
+
+    //! Circular velocities at semi-major axes [m s^-1].
+    const double* circularVelocities;
+
+    //! Unit vectors towards periapsis (column-major, one row per body).
+    const double* periapsisDirections;
+
+    //! Unit vectors perpendicular to periapsis (column-major, one row per body).
+    const double* perpendicularDirections;
+};
+
+//! Compute Cartesian states of range of bodies.
+/*!
+ * Computes Cartesian states of bodies in range [begin, end) at given time since epoch of
+ * elements. Component k of the state of body i is stored in states[ ( i - begin ) + k * stride ].
+ */
+void computeStatesOfRange( const CatalogData& catalog, const std::size_t begin,
+                           const std::size_t end, const double timeSinceEpoch,
+                           double* states, const std::size_t stride )
+{
+    for ( std::size_t i = begin; i < end; i++ )
+    {
+        const double eccentricAnomaly = computeEccentricAnomaly(
+                    catalog.meanAnomaliesAtEpoch[ i ] + catalog.meanMotions[ i ] * timeSinceEpoch,
+                    catalog.eccentricities[ i ] );
+        const double sineOfEccentricAnomaly = std::sin( eccentricAnomaly );
+        const double cosineOfEccentricAnomaly = std::cos( eccentricAnomaly );
+
+        // Compute position and velocity in perifocal frame.
+        const double x = catalog.semiMajorAxes[ i ]
+                * ( cosineOfEccentricAnomaly - catalog.eccentricities[ i ] );
+        const double y = catalog.semiMajorAxes[ i ] * catalog.semiMinorAxisRatios[ i ]
+                * sineOfEccentricAnomaly;
+        const double velocityFactor = catalog.circularVelocities[ i ]
+                / ( 1.0 - catalog.eccentricities[ i ] * cosineOfEccentricAnomaly );
+        const double vx = -velocityFactor * sineOfEccentricAnomaly;
+        const double vy = velocityFactor * catalog.semiMinorAxisRatios[ i ]
+                * cosineOfEccentricAnomaly;
+
+        // Rotate to inertial frame.
+        const std::size_t j = i - begin;
+        for ( std::size_t k = 0; k < 3; k++ )
+        {
+            const double p = catalog.periapsisDirections[ i + k * catalog.numberOfBodies ];
+            const double q = catalog.perpendicularDirections[ i + k * catalog.numberOfBodies ];
+            states[ j + k * stride ] = x * p + y * q;
+            states[ j + ( k + 3 ) * stride ] = vx * p + vy * q;
+        }
+    }
+}
+
+//! Loop body to compute Cartesian states of catalog.
+struct ComputeCartesianStates
+{
+    //! Compute Cartesian states on range [begin, end).
+    void operator( )( const std::size_t begin, const std::size_t end ) const
+    {
+        computeStatesOfRange( *catalog, begin, end, timeSinceEpoch, states + begin,
+                              catalog->numberOfBodies );
+    }
+
+    //! Per-body constants of catalog.
+    const CatalogData* catalog;
+
+    //! Time since epoch of elements [s].
+    double timeSinceEpoch;
+
+    //! Cartesian states (column-major, one row per body).
+    double* states;
+};
+
+//! Loop body to propagate catalog and store state histories.
+struct PropagateCatalog
+{
+    //! Propagate bodies in range [begin, end).
+    void operator( )( const std::size_t begin, const std::size_t end ) const
+    {
+        Eigen::MatrixXd blockStates( blockSize, 6 );
+
+        for ( std::size_t blockBegin = begin; blockBegin < end; blockBegin += blockSize )
+        {
+            const std::size_t blockEnd = std::min( blockBegin + blockSize, end );
+
+            for ( std::size_t e = 0; e < epochs->size( ); e++ )
+            {
+                const double epoch = ( *epochs )[ e ];
+                computeStatesOfRange( *catalog, blockBegin, blockEnd, epoch - epochOfElements,
+                                      blockStates.data( ), blockSize );
+
+                for ( std::size_t i = blockBegin; i < blockEnd; i++ )
+                {
+                    basics::DoubleKeyVector6dValueMap& stateHistory = ( *stateHistories )[ i ];
+                    stateHistory.insert(
+                                stateHistory.end( ),
+                                std::make_pair( epoch, tudat::basic_mathematics::Vector6d(
+                                                    blockStates.row( i - blockBegin )
+                                                    .transpose( ) ) ) );
+                }
+            }
+        }
+    }
+
+    //! Per-body constants of catalog.
+    const CatalogData* catalog;
+
+    //! Epoch of elements [s].
+    double epochOfElements;
+
+    //! Epochs to propagate to [s].
+    const std::vector< double >* epochs;
+
+    //! State histories per body.
+    std::vector< basics::DoubleKeyVector6dValueMap >* stateHistories;
+};
+
+//! Throw run-time error with given message.
+void throwRunTimeError( const std::string& message )
+{
+    boost::throw_exception( boost::enable_error_info( std::runtime_error( message ) ) );
+}
+
+} // namespace
+
+//! Solve Kepler's equation for array of elliptical orbits.
+void solveKeplersEquation( const Eigen::ArrayXd& meanAnomalies,
+                           const Eigen::ArrayXd& eccentricities,
+                           Eigen::ArrayXd& eccentricAnomalies )
+{
+    if ( meanAnomalies.size( ) != eccentricities.size( ) )
+    {
+        throwRunTimeError( "Error: number of mean anomalies does not match number of "
+                           "eccentricities." );
+    }
+
+    eccentricAnomalies.resize( meanAnomalies.size( ) );
+
+    for ( int i = 0; i < meanAnomalies.size( ); i++ )
+    {
+        eccentricAnomalies( i ) = computeEccentricAnomaly( meanAnomalies( i ),
+                                                           eccentricities( i ) );
+    }
+}
+
+//! Constructor taking central body and Keplerian elements of catalog.
+KeplerPropagator::KeplerPropagator( const double aCentralBodyGravitationalParameter,
+                                    const KeplerianElementArrays& someKeplerianElements,
+                                    const double anEpoch, const unsigned int aNumberOfThreads )
+    : epochOfElements( anEpoch ),
+      numberOfThreads( aNumberOfThreads ),
+      semiMajorAxes( someKeplerianElements.semiMajorAxes ),
+      eccentricities( someKeplerianElements.eccentricities ),
+      meanAnomaliesAtEpoch( someKeplerianElements.meanAnomalies )
+{
+    // Check input.
+    if ( !( aCentralBodyGravitationalParameter > 0.0 ) )
+    {
+        throwRunTimeError( "Error: gravitational parameter of central body must be positive." );
+    }
+
+    const int numberOfBodies = static_cast< int >( semiMajorAxes.size( ) );
+    if ( eccentricities.size( ) != numberOfBodies
+         || someKeplerianElements.inclinations.size( ) != numberOfBodies
+         || someKeplerianElements.argumentsOfPeriapsis.size( ) != numberOfBodies
+         || someKeplerianElements.longitudesOfAscendingNode.size( ) != numberOfBodies
+         || meanAnomaliesAtEpoch.size( ) != numberOfBodies )
+    {
+        throwRunTimeError( "Error: sizes of arrays of Keplerian elements are not equal." );
+    }
+
+    if ( numberOfBodies > 0
+         && ( !( semiMajorAxes.minCoeff( ) > 0.0 ) || !( eccentricities.minCoeff( ) >= 0.0 )
+              || !( eccentricities.maxCoeff( ) < 1.0 ) ) )
+    {
+        throwRunTimeError( "Error: Keplerian propagator only supports elliptical orbits." );
+    }
+
+    // Compute per-body constants.
+    meanMotions = ( aCentralBodyGravitationalParameter
+                    / semiMajorAxes.cube( ) ).sqrt( );
+    semiMinorAxisRatios = ( 1.0 - eccentricities.square( ) ).sqrt( );
+    circularVelocities = ( aCentralBodyGravitationalParameter / semiMajorAxes ).sqrt( );
+
+    // Compute perifocal axes in inertial frame (Vallado, 2007).
+    const Eigen::ArrayXd cosineOfInclinations = someKeplerianElements.inclinations.cos( );
+    const Eigen::ArrayXd sineOfInclinations = someKeplerianElements.inclinations.sin( );
+    const Eigen::ArrayXd cosineOfArguments = someKeplerianElements.argumentsOfPeriapsis.cos( );
+    const Eigen::ArrayXd sineOfArguments = someKeplerianElements.argumentsOfPeriapsis.sin( );
+    const Eigen::ArrayXd cosineOfNodes = someKeplerianElements.longitudesOfAscendingNode.cos( );
+    const Eigen::ArrayXd sineOfNodes = someKeplerianElements.longitudesOfAscendingNode.sin( );
+
+    periapsisDirections.resize( numberOfBodies, 3 );
+    periapsisDirections.col( 0 ) = ( cosineOfNodes * cosineOfArguments
+                                     - sineOfNodes * sineOfArguments * cosineOfInclinations )
+            .matrix( );
+    periapsisDirections.col( 1 ) = ( sineOfNodes * cosineOfArguments
+                                     + cosineOfNodes * sineOfArguments * cosineOfInclinations )
+            .matrix( );
+    periapsisDirections.col( 2 ) = ( sineOfArguments * sineOfInclinations ).matrix( );
+
+    perpendicularDirections.resize( numberOfBodies, 3 );
+    perpendicularDirections.col( 0 ) = ( -cosineOfNodes * sineOfArguments
+                                         - sineOfNodes * cosineOfArguments
+                                         * cosineOfInclinations ).matrix( );
+    perpendicularDirections.col( 1 ) = ( -sineOfNodes * sineOfArguments
+                                         + cosineOfNodes * cosineOfArguments
+                                         * cosineOfInclinations ).matrix( );
+    perpendicularDirections.col( 2 ) = ( cosineOfArguments * sineOfInclinations ).matrix( );
+}
+
+//! Compute Cartesian states of catalog at given epoch.
+void KeplerPropagator::computeCartesianStates( const double epoch,
+                                               Eigen::MatrixXd& cartesianStates ) const
+{
+    const CatalogData catalog = { getNumberOfBodies( ), semiMajorAxes.data( ),
+                                  eccentricities.data( ), meanAnomaliesAtEpoch.data( ),
+                                  meanMotions.data( ), semiMinorAxisRatios.data( ),
+                                  circularVelocities.data( ), periapsisDirections.data( ),
+                                  perpendicularDirections.data( ) };
+
+    cartesianStates.resize( meanMotions.size( ), 6 );
+
+    const ComputeCartesianStates loopBody = { &catalog, epoch - epochOfElements,
+                                              cartesianStates.data( ) };
+    basics::executeParallelLoop( getNumberOfBodies( ), loopBody, numberOfThreads );
+}
+
+//! Propagate catalog and store state histories.
+void KeplerPropagator::propagate(
+        const std::vector< double >& epochs,
+        std::vector< basics::DoubleKeyVector6dValueMap >& stateHistories ) const
+{
+    const CatalogData catalog = { getNumberOfBodies( ), semiMajorAxes.data( ),
+                                  eccentricities.data( ), meanAnomaliesAtEpoch.data( ),
+                                  meanMotions.data( ), semiMinorAxisRatios.data( ),
+                                  circularVelocities.data( ), periapsisDirections.data( ),
+                                  perpendicularDirections.data( ) };
+
+    stateHistories.resize( getNumberOfBodies( ) );
+
+    const PropagateCatalog loopBody = { &catalog, epochOfElements, &epochs, &stateHistories };
+    basics::executeParallelLoop( getNumberOfBodies( ), loopBody, numberOfThreads, blockSize );
+}
+
+} // namespace astrodynamics
+} // namespace assist
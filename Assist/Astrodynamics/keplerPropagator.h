@@ -0,0 +1,171 @@
+/*
+ *    Copyright (c) 2010-2014, Delft University of Technology
+ *    Copyright (c) 2010-2014, K. Kumar (me@kartikkumar.com)
+ *    All rights reserved.
+ *    See http://bit.ly/1jern3m for license details.
+ */
+
+#ifndef ASSIST_KEPLER_PROPAGATOR_H
+#define ASSIST_KEPLER_PROPAGATOR_H
+
+#include <cstddef>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "Assist/Basics/commonTypedefs.h"
+
+namespace assist
+{
+namespace astrodynamics
+{
+
+//! Keplerian elements of catalog of orbiting bodies.
+/*!
+ * Keplerian elements of a catalog of orbiting bodies, stored as separate contiguous arrays
+ * (structure-of-arrays). Angles are in radians.
+ */
+struct KeplerianElementArrays
+{
+    //! Semi-major axes [m].
+    Eigen::ArrayXd semiMajorAxes;
+
+    //! Eccentricities [-].
+    Eigen::ArrayXd eccentricities;
+
+    //! Inclinations [rad].
+    Eigen::ArrayXd inclinations;
+
+    //! Arguments of periapsis [rad].
+    Eigen::ArrayXd argumentsOfPeriapsis;
+
+    //! Longitudes of ascending node [rad].
+    Eigen::ArrayXd longitudesOfAscendingNode;
+
+    //! Mean anomalies [rad].
+    Eigen::ArrayXd meanAnomalies;
+};
+
+//! Solve Kepler's equation for array of elliptical orbits.
+/*!
+ * Solves Kepler's equation, M = E - e sin E, for the eccentric anomalies E of an array of
+ * elliptical orbits, given their mean anomalies M and eccentricities e. The mean anomalies are
+ * first reduced to [-pi, pi]. Each solution starts from a blend of a series and a cube-root
+ * starter (accurate for small and large eccentricities, respectively), and is refined by a fixed
+ * number of Halley iterations, without data-dependent branches, so that all lanes of a SIMD
+ * register follow the same path. Three iterations converge to machine precision for
+ * eccentricities up to at least 0.9999.
+ * \param meanAnomalies Mean anomalies [rad].
+ * \param eccentricities Eccentricities, in range [0, 1).
+ * \param eccentricAnomalies Eccentric anomalies, in range [-pi, pi] [rad] (resized if needed).
+ */
+void solveKeplersEquation( const Eigen::ArrayXd& meanAnomalies,
+                           const Eigen::ArrayXd& eccentricities,
+                           Eigen::ArrayXd& eccentricAnomalies );
+
+//! Propagator for catalogs of Keplerian orbits.
+/*!
+ * Propagator for catalogs of bodies on elliptical Keplerian orbits around the same central body.
+ * All per-body constants (mean motion, axis ratio, circular velocity and perifocal axes) are
+ * computed once, and stored as contiguous arrays. States are computed for all bodies at once, by
+ * solving Kepler's equation (see solveKeplersEquation()) and transforming to Cartesian
+ * coordinates, in cache-sized blocks, in parallel for large catalogs.
+ */
+class KeplerPropagator
+{
+public:
+
+    //! Constructor taking central body and Keplerian elements of catalog.
+    /*!
+     * Constructor taking gravitational parameter of central body, and Keplerian elements of
+     * catalog of bodies at given epoch. Throws a run-time error if the gravitational parameter is
+     * not positive, if the sizes of the arrays of elements are not equal, or if an orbit is not
+     * elliptical (i.e., semi-major axis not positive, or eccentricity not in range [0, 1)).
+     * \param aCentralBodyGravitationalParameter Gravitational parameter of central body
+     *          [m^3 s^-2].
+     * \param someKeplerianElements Keplerian elements of catalog at epoch.
+     * \param anEpoch Epoch of Keplerian elements [s] (default=0.0).
+     * \param aNumberOfThreads Number of threads to use (0 = number of hardware threads;
+     *          default=1).
+     */
+    KeplerPropagator( const double aCentralBodyGravitationalParameter,
+                      const KeplerianElementArrays& someKeplerianElements,
+                      const double anEpoch = 0.0, const unsigned int aNumberOfThreads = 1 );
+
+    //! Compute Cartesian states of catalog at given epoch.
+    /*!
+     * Computes Cartesian states of all bodies in the catalog at a given epoch.
+     * \param epoch Epoch [s].
+     * \param cartesianStates Cartesian states, with one row per body, and columns x, y, z, vx,
+     *          vy, vz [m, m s^-1], so that each component is contiguous (resized if needed).
+     */
+    void computeCartesianStates( const double epoch, Eigen::MatrixXd& cartesianStates ) const;
+
+    //! Propagate catalog and store state histories.
+    /*!
+     * Propagates all bodies in the catalog to given epochs, and stores their Cartesian states in
+     * a state history per body. The states are inserted with a hint at the end of each state
+     * history, so that appending epochs in increasing order is amortized O(1) per state.
+     * \param epochs Epochs [s], preferably in increasing order.
+     * \param stateHistories State history per body, to which states are added (resized to the
+     *          number of bodies if needed).
+     */
+    void propagate( const std::vector< double >& epochs,
+                    std::vector< basics::DoubleKeyVector6dValueMap >& stateHistories ) const;
+
+    //! Get number of bodies.
+    /*!
+     * Returns number of bodies in catalog.
+     * \return Number of bodies.
+     */
+    std::size_t getNumberOfBodies( ) const
+    {
+        return static_cast< std::size_t >( meanMotions.size( ) );
+    }
+
+protected:
+
+private:
+
+    //! Epoch of Keplerian elements [s].
+    const double epochOfElements;
+
+    //! Number of threads to use.
+    const unsigned int numberOfThreads;
+
+    //! Semi-major axes [m].
+    Eigen::ArrayXd semiMajorAxes;
+
+    //! Eccentricities [-].
+    Eigen::ArrayXd eccentricities;
+
+    //! Mean anomalies at epoch of elements [rad].
+    Eigen::ArrayXd meanAnomaliesAtEpoch;
+
+    //! Mean motions [rad s^-1].
+    Eigen::ArrayXd meanMotions;
+
+    //! Ratios of semi-minor and semi-major axes, sqrt( 1 - e^2 ) [-].
+    Eigen::ArrayXd semiMinorAxisRatios;
+
+    //! Circular velocities at semi-major axes, sqrt( mu / a ) [m s^-1].
+    Eigen::ArrayXd circularVelocities;
+
+    //! Unit vectors towards periapsis, one row per body.
+    Eigen::MatrixX3d periapsisDirections;
+
+    //! Unit vectors in orbital plane, 90 degrees ahead of periapsis, one row per body.
+    Eigen::MatrixX3d perpendicularDirections;
+};
+
+} // namespace astrodynamics
+} // namespace assist
+
+#endif // ASSIST_KEPLER_PROPAGATOR_H
+
+/*
+ *    References
+ *      Danby, J.M.A. Fundamentals of Celestial Mechanics, 2nd edition, Willmann-Bell, 1988.
+ *      Vallado, D.A. Fundamentals of Astrodynamics and Applications, 3rd edition, Microcosm
+ *          Press, 2007.
+ */
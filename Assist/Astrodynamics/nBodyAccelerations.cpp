@@ -0,0 +1,490 @@
+/*
+ *    Copyright (c) 2010-2014, Delft University of Technology
+ *    Copyright (c) 2010-2014, K. Kumar (me@kartikkumar.com)
+ *    All rights reserved.
+ *    See http://bit.ly/1jern3m for license details.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/exception/all.hpp>
+
+#include "Assist/Astrodynamics/nBodyAccelerations.h"
+#include "Assist/Basics/parallelLoop.h"
+
+namespace assist
+{
+namespace astrodynamics
+{
+
+namespace
+{
+
+//! Number of targets per tile in direct summation.
+const std::size_t targetTileSize = 256;
+
+//! Maximum number of bodies in leaf of octree.
+const std::size_t maximumNumberOfBodiesPerLeaf = 8;
+
+//! Maximum depth of octree (limits depth for coinciding bodies).
+const int maximumOctreeDepth = 40;
+
+//! Check that sizes of positions and gravitational parameters match.
+void checkSizes( const Eigen::MatrixX3d& positions, const Eigen::ArrayXd& gravitationalParameters )
+{
+    if ( positions.rows( ) != gravitationalParameters.size( ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Error: number of gravitational parameters does not "
+                                            "match number of positions." ) ) );
+    }
+}
+
+//! Loop body to compute accelerations by direct summation, in tiles of targets.
+struct ComputeDirectSumAccelerations
+{
+    //! Compute accelerations of targets in range [begin, end).
+    void operator( )( const std::size_t begin, const std::size_t end ) const
+    {
+        typedef Eigen::Map< const Eigen::ArrayXd > ConstArrayMap;
+        const Eigen::ArrayXd::Index size = static_cast< Eigen::ArrayXd::Index >( numberOfBodies );
+        const ConstArrayMap x( positions, size );
+        const ConstArrayMap y( positions + numberOfBodies, size );
+        const ConstArrayMap z( positions + 2 * numberOfBodies, size );
+
+        // Allocate work arrays for one tile.
+        const Eigen::ArrayXd::Index tileSize
+                = static_cast< Eigen::ArrayXd::Index >( targetTileSize );
+        Eigen::ArrayXd dx( tileSize ), dy( tileSize ), dz( tileSize ), factor( tileSize );
+        Eigen::ArrayXd ax( tileSize ), ay( tileSize ), az( tileSize );
+
+        for ( std::size_t tileBegin = begin; tileBegin < end; tileBegin += targetTileSize )
+        {
+            const std::size_t tileEnd = std::min( tileBegin + targetTileSize, end );
+            ax.setZero( );
+            ay.setZero( );
+            az.setZero( );
+
+            for ( std::size_t j = 0; j < numberOfBodies; j++ )
+            {
+                // Skip self-interaction, by splitting tile around source if needed.
+                if ( j >= tileBegin && j < tileEnd )
+                {
+                    accumulate( j, tileBegin, tileBegin, j, x, y, z, dx, dy, dz, factor,
+                                ax, ay, az );
+                    accumulate( j, tileBegin, j + 1, tileEnd, x, y, z, dx, dy, dz, factor,
+                                ax, ay, az );
+                }
+
+                else
+                {
+                    accumulate( j, tileBegin, tileBegin, tileEnd, x, y, z, dx, dy, dz, factor,
+                                ax, ay, az );
+                }
+            }
+
+            const Eigen::ArrayXd::Index numberOfTargets
+                    = static_cast< Eigen::ArrayXd::Index >( tileEnd - tileBegin );
+            for ( Eigen::ArrayXd::Index i = 0; i < numberOfTargets; i++ )
+            {
+                accelerations[ tileBegin + i ] = ax( i );
+                accelerations[ tileBegin + i + numberOfBodies ] = ay( i );
+                accelerations[ tileBegin + i + 2 * numberOfBodies ] = az( i );
+            }
+        }
+    }
+
+    //! Accumulate accelerations due to given source on targets in range [begin, end).
+    template< typename ArrayMap >
+    void accumulate( const std::size_t source, const std::size_t tileBegin,
+                     const std::size_t begin, const std::size_t end,
+                     const ArrayMap& x, const ArrayMap& y, const ArrayMap& z,
+                     Eigen::ArrayXd& dx, Eigen::ArrayXd& dy, Eigen::ArrayXd& dz,
+                     Eigen::ArrayXd& factor,
+                     Eigen::ArrayXd& ax, Eigen::ArrayXd& ay, Eigen::ArrayXd& az ) const
+    {
+        if ( end <= begin )
+        {
+            return;
+        }
+
+        const Eigen::ArrayXd::Index start = static_cast< Eigen::ArrayXd::Index >( begin );
+        const Eigen::ArrayXd::Index offset
+                = static_cast< Eigen::ArrayXd::Index >( begin - tileBegin );
+        const Eigen::ArrayXd::Index count = static_cast< Eigen::ArrayXd::Index >( end - begin );
+
+        dx.head( count ) = x( source ) - x.segment( start, count );
+        dy.head( count ) = y( source ) - y.segment( start, count );
+        dz.head( count ) = z( source ) - z.segment( start, count );
+        factor.head( count ) = dx.head( count ).square( ) + dy.head( count ).square( )
+                + dz.head( count ).square( ) + squaredSofteningLength;
+        factor.head( count ) = gravitationalParameters[ source ]
+                / ( factor.head( count ) * factor.head( count ).sqrt( ) );
+        ax.segment( offset, count ) += factor.head( count ) * dx.head( count );
+        ay.segment( offset, count ) += factor.head( count ) * dy.head( count );
+        az.segment( offset, count ) += factor.head( count ) * dz.head( count );
+    }
+
+    //! Number of bodies.
+    std::size_t numberOfBodies;
+
+    //! Positions of bodies (column-major, one row per body) [m].
+    const double* positions;
+
+    //! Gravitational parameters of bodies [m^3 s^-2].
+    const double* gravitationalParameters;
+
+    //! Squared softening length [m^2].
+    double squaredSofteningLength;
+
+    //! Accelerations of bodies (column-major, one row per body) [m s^-2].
+    double* accelerations;
+};
+
+//! Node of octree.
+struct OctreeNode
+{
+    //! Center of cube covered by node [m].
+    double center[ 3 ];
+
+    //! Half of edge length of cube covered by node [m].
+    double halfSize;
+
+    //! Center of mass of bodies in node [m].
+    double centerOfMass[ 3 ];
+
+    //! Sum of gravitational parameters of bodies in node [m^3 s^-2].
+    double gravitationalParameter;
+
+    //! Range of bodies in node, in tree order.
+    std::size_t bodyBegin, bodyEnd;
+
+    //! Indices of child nodes, or -1 if empty.
+    int children[ 8 ];
+
+    //! Flag indicating if node is leaf.
+    bool isLeaf;
+};
+
+//! Octree of bodies.
+struct Octree
+{
+    //! Build node for bodies in range [begin, end) of tree order, and return its index.
+    int buildNode( const std::size_t begin, const std::size_t end, const double center[ 3 ],
+                   const double halfSize, const int depth )
+    {
+        const int index = static_cast< int >( nodes.size( ) );
+        OctreeNode node = { { center[ 0 ], center[ 1 ], center[ 2 ] }, halfSize,
+                            { 0.0, 0.0, 0.0 }, 0.0, begin, end,
+                            { -1, -1, -1, -1, -1, -1, -1, -1 }, true };
+
+        // Compute gravitational parameter and center of mass (or centroid, if the bodies are
+        // massless).
+        double centroid[ 3 ] = { 0.0, 0.0, 0.0 };
+        for ( std::size_t s = begin; s < end; s++ )
+        {
+            const std::size_t i = bodyOrder[ s ];
+            for ( int k = 0; k < 3; k++ )
+            {
+                node.centerOfMass[ k ] += gravitationalParameters[ i ]
+                        * positions[ i + k * numberOfBodies ];
+                centroid[ k ] += positions[ i + k * numberOfBodies ];
+            }
+
+            node.gravitationalParameter += gravitationalParameters[ i ];
+        }
+
+        for ( int k = 0; k < 3; k++ )
+        {
+            node.centerOfMass[ k ] = node.gravitationalParameter > 0.0
+                    ? node.centerOfMass[ k ] / node.gravitationalParameter
+                    : centroid[ k ] / static_cast< double >( end - begin );
+        }
+
+        nodes.push_back( node );
+
+        if ( end - begin <= maximumNumberOfBodiesPerLeaf || depth == maximumOctreeDepth )
+        {
+            return index;
+        }
+
+        // Sort bodies by octant (counting sort), and build child nodes.
+        nodes[ index ].isLeaf = false;
+        std::size_t octantBegin[ 9 ] = { 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+        for ( std::size_t s = begin; s < end; s++ )
+        {
+            octants[ s ] = computeOctant( bodyOrder[ s ], center );
+            octantBegin[ octants[ s ] + 1 ]++;
+        }
+
+        for ( int o = 0; o < 8; o++ )
+        {
+            octantBegin[ o + 1 ] += octantBegin[ o ];
+        }
+
+        std::size_t octantPosition[ 8 ];
+        std::copy( octantBegin, octantBegin + 8, octantPosition );
+        for ( std::size_t s = begin; s < end; s++ )
+        {
+            sortBuffer[ begin + octantPosition[ octants[ s ] ]++ ] = bodyOrder[ s ];
+        }
+
+        std::copy( sortBuffer.begin( ) + begin, sortBuffer.begin( ) + end,
+                   bodyOrder.begin( ) + begin );
+
+        const double childHalfSize = 0.5 * halfSize;
+        for ( int o = 0; o < 8; o++ )
+        {
+            if ( octantBegin[ o + 1 ] > octantBegin[ o ] )
+            {
+                const double childCenter[ 3 ]
+                        = { center[ 0 ] + ( ( o & 1 ) ? childHalfSize : -childHalfSize ),
+                            center[ 1 ] + ( ( o & 2 ) ? childHalfSize : -childHalfSize ),
+                            center[ 2 ] + ( ( o & 4 ) ? childHalfSize : -childHalfSize ) };
+                const int child = buildNode( begin + octantBegin[ o ], begin + octantBegin[ o + 1 ],
+                                             childCenter, childHalfSize, depth + 1 );
+                nodes[ index ].children[ o ] = child;
+            }
+        }
+
+        return index;
+    }
+
+    //! Compute octant of body with respect to center.
+    int computeOctant( const std::size_t body, const double center[ 3 ] ) const
+    {
+        return ( positions[ body ] > center[ 0 ] ? 1 : 0 )
+                | ( positions[ body + numberOfBodies ] > center[ 1 ] ? 2 : 0 )
+                | ( positions[ body + 2 * numberOfBodies ] > center[ 2 ] ? 4 : 0 );
+    }
+
+    //! Number of bodies.
+    std::size_t numberOfBodies;
+
+    //! Positions of bodies (column-major, one row per body) [m].
+    const double* positions;
+
+    //! Gravitational parameters of bodies [m^3 s^-2].
+    const double* gravitationalParameters;
+
+    //! Indices of bodies in tree order.
+    std::vector< std::size_t > bodyOrder;
+
+    //! Octants of bodies (work array for build).
+    std::vector< int > octants;
+
+    //! Sort buffer (work array for build).
+    std::vector< std::size_t > sortBuffer;
+
+    //! Positions of bodies in tree order, one column per component [m].
+    Eigen::MatrixX3d sortedPositions;
+
+    //! Gravitational parameters of bodies in tree order [m^3 s^-2].
+    std::vector< double > sortedGravitationalParameters;
+
+    //! Nodes of octree; the root is the first node.
+    std::vector< OctreeNode > nodes;
+};
+
+//! Loop body to compute accelerations by traversing octree.
+struct ComputeBarnesHutAccelerations
+{
+    //! Compute accelerations of bodies in range [begin, end) of tree order.
+    void operator( )( const std::size_t begin, const std::size_t end ) const
+    {
+        const std::size_t numberOfBodies = octree->numberOfBodies;
+        const double* positions = octree->sortedPositions.data( );
+        const double* gravitationalParameters = &octree->sortedGravitationalParameters[ 0 ];
+        const double squaredOpeningAngle = openingAngle * openingAngle;
+
+        // Each level adds at most 8 nodes to the stack, and removes one.
+        std::vector< int > stack( 8 * ( maximumOctreeDepth + 1 ) );
+
+        for ( std::size_t s = begin; s < end; s++ )
+        {
+            const double position[ 3 ] = { positions[ s ], positions[ s + numberOfBodies ],
+                                           positions[ s + 2 * numberOfBodies ] };
+            double acceleration[ 3 ] = { 0.0, 0.0, 0.0 };
+
+            std::size_t stackSize = 0;
+            stack[ stackSize++ ] = 0;
+            while ( stackSize > 0 )
+            {
+                const OctreeNode& node = octree->nodes[ stack[ --stackSize ] ];
+
+                if ( node.isLeaf )
+                {
+                    for ( std::size_t t = node.bodyBegin; t < node.bodyEnd; t++ )
+                    {
+                        if ( t != s )
+                        {
+                            const double source[ 3 ] = { positions[ t ],
+                                                         positions[ t + numberOfBodies ],
+                                                         positions[ t + 2 * numberOfBodies ] };
+                            addPointMassAcceleration( position, source,
+                                                      gravitationalParameters[ t ],
+                                                      acceleration );
+                        }
+                    }
+
+                    continue;
+                }
+
+                // Approximate node by point mass if it does not contain the body and is small
+                // enough, as seen from the body.
+                const bool isOutside
+                        = std::fabs( position[ 0 ] - node.center[ 0 ] ) > node.halfSize
+                        || std::fabs( position[ 1 ] - node.center[ 1 ] ) > node.halfSize
+                        || std::fabs( position[ 2 ] - node.center[ 2 ] ) > node.halfSize;
+                const double dx = node.centerOfMass[ 0 ] - position[ 0 ];
+                const double dy = node.centerOfMass[ 1 ] - position[ 1 ];
+                const double dz = node.centerOfMass[ 2 ] - position[ 2 ];
+                const double size = 2.0 * node.halfSize;
+
+                if ( isOutside
+                     && size * size < squaredOpeningAngle * ( dx * dx + dy * dy + dz * dz ) )
+                {
+                    addPointMassAcceleration( position, node.centerOfMass,
+                                              node.gravitationalParameter, acceleration );
+                }
+
+                else
+                {
+                    for ( int o = 0; o < 8; o++ )
+                    {
+                        if ( node.children[ o ] >= 0 )
+                        {
+                            stack[ stackSize++ ] = node.children[ o ];
+                        }
+                    }
+                }
+            }
+
+            const std::size_t i = octree->bodyOrder[ s ];
+            for ( int k = 0; k < 3; k++ )
+            {
+                accelerations[ i + k * numberOfBodies ] = acceleration[ k ];
+            }
+        }
+    }
+
+    //! Add acceleration due to point mass.
+    void addPointMassAcceleration( const double position[ 3 ], const double source[ 3 ],
+                                   const double gravitationalParameter,
+                                   double acceleration[ 3 ] ) const
+    {
+        const double dx = source[ 0 ] - position[ 0 ];
+        const double dy = source[ 1 ] - position[ 1 ];
+        const double dz = source[ 2 ] - position[ 2 ];
+        const double squaredDistance = dx * dx + dy * dy + dz * dz + squaredSofteningLength;
+        const double factor
+                = gravitationalParameter / ( squaredDistance * std::sqrt( squaredDistance ) );
+        acceleration[ 0 ] += factor * dx;
+        acceleration[ 1 ] += factor * dy;
+        acceleration[ 2 ] += factor * dz;
+    }
+
+    //! Octree of bodies.
+    const Octree* octree;
+
+    //! Opening angle [-].
+    double openingAngle;
+
+    //! Squared softening length [m^2].
+    double squaredSofteningLength;
+
+    //! Accelerations of bodies (column-major, one row per body) [m s^-2].
+    double* accelerations;
+};
+
+} // namespace
+
+//! Compute mutual gravitational accelerations by direct summation.
+void computeDirectSumAccelerations( const Eigen::MatrixX3d& positions,
+                                    const Eigen::ArrayXd& gravitationalParameters,
+                                    Eigen::MatrixX3d& accelerations,
+                                    const double softeningLength,
+                                    const unsigned int numberOfThreads )
+{
+    checkSizes( positions, gravitationalParameters );
+
+    const std::size_t numberOfBodies = static_cast< std::size_t >( positions.rows( ) );
+    accelerations.resize( positions.rows( ), 3 );
+
+    const ComputeDirectSumAccelerations loopBody
+            = { numberOfBodies, positions.data( ), gravitationalParameters.data( ),
+                softeningLength * softeningLength, accelerations.data( ) };
+    basics::executeParallelLoop( numberOfBodies, loopBody, numberOfThreads, targetTileSize );
+}
+
+//! Compute mutual gravitational accelerations using Barnes-Hut octree.
+void computeBarnesHutAccelerations( const Eigen::MatrixX3d& positions,
+                                    const Eigen::ArrayXd& gravitationalParameters,
+                                    Eigen::MatrixX3d& accelerations,
+                                    const double openingAngle,
+                                    const double softeningLength,
+                                    const unsigned int numberOfThreads )
+{
+    checkSizes( positions, gravitationalParameters );
+
+    if ( !( openingAngle >= 0.0 ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Error: opening angle is negative." ) ) );
+    }
+
+    const std::size_t numberOfBodies = static_cast< std::size_t >( positions.rows( ) );
+    accelerations.resize( positions.rows( ), 3 );
+
+    if ( numberOfBodies == 0 )
+    {
+        return;
+    }
+
+    // Build octree in cube that encloses all bodies.
+    Octree octree;
+    octree.numberOfBodies = numberOfBodies;
+    octree.positions = positions.data( );
+    octree.gravitationalParameters = gravitationalParameters.data( );
+    octree.bodyOrder.resize( numberOfBodies );
+    for ( std::size_t i = 0; i < numberOfBodies; i++ )
+    {
+        octree.bodyOrder[ i ] = i;
+    }
+
+    octree.octants.resize( numberOfBodies );
+    octree.sortBuffer.resize( numberOfBodies );
+    octree.nodes.reserve( 2 * numberOfBodies / maximumNumberOfBodiesPerLeaf + 1 );
+
+    const Eigen::RowVector3d minimumCorner = positions.colwise( ).minCoeff( );
+    const Eigen::RowVector3d maximumCorner = positions.colwise( ).maxCoeff( );
+    const double rootCenter[ 3 ] = { 0.5 * ( minimumCorner( 0 ) + maximumCorner( 0 ) ),
+                                     0.5 * ( minimumCorner( 1 ) + maximumCorner( 1 ) ),
+                                     0.5 * ( minimumCorner( 2 ) + maximumCorner( 2 ) ) };
+    octree.buildNode( 0, numberOfBodies, rootCenter,
+                      0.5 * ( maximumCorner - minimumCorner ).maxCoeff( ), 0 );
+
+    // Store bodies in tree order, so that the bodies in each leaf are contiguous.
+    octree.sortedPositions.resize( positions.rows( ), 3 );
+    octree.sortedGravitationalParameters.resize( numberOfBodies );
+    for ( std::size_t s = 0; s < numberOfBodies; s++ )
+    {
+        octree.sortedPositions.row( s ) = positions.row( octree.bodyOrder[ s ] );
+        octree.sortedGravitationalParameters[ s ]
+                = gravitationalParameters( octree.bodyOrder[ s ] );
+    }
+
+    // Compute accelerations by traversing octree, in parallel.
+    const ComputeBarnesHutAccelerations loopBody
+            = { &octree, openingAngle, softeningLength * softeningLength, accelerations.data( ) };
+    basics::executeParallelLoop( numberOfBodies, loopBody, numberOfThreads, 256 );
+}
+
+} // namespace astrodynamics
+} // namespace assist
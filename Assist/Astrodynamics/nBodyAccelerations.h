@@ -0,0 +1,81 @@
+/*
+ *    Copyright (c) 2010-2014, Delft University of Technology
+ *    Copyright (c) 2010-2014, K. Kumar (me@kartikkumar.com)
+ *    All rights reserved.
+ *    See http://bit.ly/1jern3m for license details.
+ */
+
+#ifndef ASSIST_N_BODY_ACCELERATIONS_H
+#define ASSIST_N_BODY_ACCELERATIONS_H
+
+#include <Eigen/Core>
+
+namespace assist
+{
+namespace astrodynamics
+{
+
+//! Compute mutual gravitational accelerations by direct summation.
+/*!
+ * Computes mutual gravitational accelerations of N bodies by direct summation over all pairs, at
+ * O(N^2) cost, with optional Plummer softening:
+ *      a_i = sum_j mu_j ( r_j - r_i ) / ( |r_j - r_i|^2 + epsilon^2 )^( 3/2 ),
+ * in which the sum excludes j = i. The gravitational parameters can be computed from masses with
+ * computeGravitationalParameter(). The bodies are processed in tiles of 256 targets, for which
+ * the position components and accelerations stay in L1 cache, while all sources are streamed
+ * through; for each source, the contributions to all targets in a tile are computed with
+ * vectorized array operations (SIMD). Tiles are processed in parallel. Without softening,
+ * coinciding bodies give infinite accelerations. Throws a run-time error if the sizes of the
+ * arrays do not match.
+ * \param positions Positions of bodies, one row per body [m].
+ * \param gravitationalParameters Gravitational parameters of bodies [m^3 s^-2].
+ * \param accelerations Accelerations of bodies, one row per body [m s^-2] (resized if needed).
+ * \param softeningLength Plummer softening length epsilon [m] (default=0.0).
+ * \param numberOfThreads Number of threads to use (0 = number of hardware threads; default=1).
+ */
+void computeDirectSumAccelerations( const Eigen::MatrixX3d& positions,
+                                    const Eigen::ArrayXd& gravitationalParameters,
+                                    Eigen::MatrixX3d& accelerations,
+                                    const double softeningLength = 0.0,
+                                    const unsigned int numberOfThreads = 1 );
+
+//! Compute mutual gravitational accelerations using Barnes-Hut octree.
+/*!
+ * Computes approximate mutual gravitational accelerations of N bodies (see
+ * computeDirectSumAccelerations()) using a Barnes-Hut octree, at O(N log N) cost. The bodies are
+ * sorted into an octree, with at most 8 bodies per leaf, and the gravitational parameter and
+ * center of mass of each node are stored. The acceleration of each body is computed by
+ * traversing the tree: a node is approximated by a point mass at its center of mass if it does
+ * not contain the body, and if the ratio of its size and the distance to its center of mass is
+ * less than the opening angle; otherwise, its children are opened, and the bodies in leaves are
+ * summed directly. An opening angle of zero gives the direct sum (in a different order of
+ * summation); an opening angle of 0.5 typically gives relative errors of order 1e-3. Bodies are
+ * processed in parallel, in tree order, so that consecutive bodies traverse similar nodes. Throws
+ * a run-time error if the sizes of the arrays do not match, or if the opening angle is negative.
+ * \param positions Positions of bodies, one row per body [m].
+ * \param gravitationalParameters Gravitational parameters of bodies [m^3 s^-2].
+ * \param accelerations Accelerations of bodies, one row per body [m s^-2] (resized if needed).
+ * \param openingAngle Opening angle, i.e., maximum ratio of node size and distance for which a
+ *          node is approximated by a point mass [-] (default=0.5).
+ * \param softeningLength Plummer softening length epsilon [m] (default=0.0).
+ * \param numberOfThreads Number of threads to use (0 = number of hardware threads; default=1).
+ */
+void computeBarnesHutAccelerations( const Eigen::MatrixX3d& positions,
+                                    const Eigen::ArrayXd& gravitationalParameters,
+                                    Eigen::MatrixX3d& accelerations,
+                                    const double openingAngle = 0.5,
+                                    const double softeningLength = 0.0,
+                                    const unsigned int numberOfThreads = 1 );
+
+} // namespace astrodynamics
+} // namespace assist
+
+#endif // ASSIST_N_BODY_ACCELERATIONS_H
+
+/*
+ *    References
+ *      Barnes, J., Hut, P. A hierarchical O(N log N) force-calculation algorithm, Nature 324,
+ *          446-449, 1986.
+ *      Nyland, L., Harris, M., Prins, J. Fast N-body simulation with CUDA, GPU Gems 3, chapter 31,
+ *          Addison-Wesley, 2007.
+ */
@@ -0,0 +1,238 @@
+/*
+ *    Copyright (c) 2010-2014, Delft University of Technology
+ *    Copyright (c) 2010-2014, K. Kumar (me@kartikkumar.com)
+ *    All rights reserved.
+ *    See http://bit.ly/1jern3m for license details.
+ */
+
+#include <stdexcept>
+
+#include <boost/exception/all.hpp>
+
+#include "Assist/Astrodynamics/astrodynamicsBasics.h"
+#include "Assist/Astrodynamics/populationBuilder.h"
+#include "Assist/Basics/parallelLoop.h"
+#include "Assist/Mathematics/monteCarloSampler.h"
+
+namespace assist
+{
+namespace astrodynamics
+{
+
+namespace
+{
+
+//! Number of bodies processed per block, sized so that a block stays in the L1 cache.
+const std::size_t blockSize = 1024;
+
+//! Tolerance on power-law index, within which the size distribution is taken as log-uniform.
+const double powerLawIndexTolerance = 1.0e-9;
+
+//! Check if power-law index is close to one.
+bool isPowerLawIndexOne( const double powerLawIndex )
+{
+    return std::fabs( powerLawIndex - 1.0 ) < powerLawIndexTolerance;
+}
+
+//! Loop body to compute masses and gravitational parameters.
+struct ComputeMassesAndGravitationalParameters
+{
+    //! Compute masses and gravitational parameters on range [begin, end).
+    void operator( )( const std::size_t begin, const std::size_t end ) const
+    {
+        for ( std::size_t i = begin; i < end; i++ )
+        {
+            masses[ i ] = computeMassOfSphere( radii[ i ], bulkDensity );
+            gravitationalParameters[ i ] = computeGravitationalParameter( masses[ i ] );
+        }
+    }
+
+    //! Uniform bulk density [kg m^-3].
+    double bulkDensity;
+
+    //! Radii [m].
+    const double* radii;
+
+    //! Masses [kg].
+    double* masses;
+
+    //! Gravitational parameters [m^3 s^-2].
+    double* gravitationalParameters;
+};
+
+//! Loop body to sample population.
+template< typename SizeDistribution >
+struct SamplePopulation
+{
+    //! Sample population on range [begin, end).
+    void operator( )( const std::size_t begin, const std::size_t end ) const
+    {
+        // Process range in blocks, so that the uniform samples and radii are still cached when
+        // the radii and derived quantities are computed in separate, vectorizable, loops. The
+        // uniform sample of body i is sample i of the sampler, so that it doesn't depend on how
+        // the bodies are divided over threads.
+        Eigen::ArrayXd uniformSamples;
+        for ( std::size_t blockBegin = begin; blockBegin < end; blockBegin += blockSize )
+        {
+            const std::size_t blockEnd = std::min( blockBegin + blockSize, end );
+
+            monteCarloSampler->generateUniformSamples( blockEnd - blockBegin, uniformSamples, 0,
+                                                       blockBegin );
+            for ( std::size_t i = blockBegin; i < blockEnd; i++ )
+            {
+                radii[ i ] = sizeDistribution->computeRadius(
+                            uniformSamples( i - blockBegin ) );
+            }
+
+            derivedQuantities( blockBegin, blockEnd );
+        }
+    }
+
+    //! Size distribution to sample radii from.
+    const SizeDistribution* sizeDistribution;
+
+    //! Monte Carlo sampler, single-threaded, used to generate uniform samples.
+    const mathematics::MonteCarloSampler* monteCarloSampler;
+
+    //! Radii [m].
+    double* radii;
+
+    //! Loop body to compute masses and gravitational parameters.
+    ComputeMassesAndGravitationalParameters derivedQuantities;
+};
+
+//! Build population with given size distribution.
+template< typename SizeDistribution >
+void buildPopulationWithSizeDistribution( const SizeDistribution& sizeDistribution,
+                                          const double bulkDensity,
+                                          const std::size_t numberOfBodies,
+                                          const boost::uint64_t seed, Population& population,
+                                          const unsigned int numberOfThreads )
+{
+    const Eigen::ArrayXd::Index size = static_cast< Eigen::ArrayXd::Index >( numberOfBodies );
+    population.radii.resize( size );
+    population.masses.resize( size );
+    population.gravitationalParameters.resize( size );
+
+    const ComputeMassesAndGravitationalParameters derivedQuantities
+            = { bulkDensity, population.radii.data( ), population.masses.data( ),
+                population.gravitationalParameters.data( ) };
+    const mathematics::MonteCarloSampler monteCarloSampler( seed );
+    const SamplePopulation< SizeDistribution > loopBody
+            = { &sizeDistribution, &monteCarloSampler, population.radii.data( ),
+                derivedQuantities };
+    basics::executeParallelLoop( numberOfBodies, loopBody, numberOfThreads );
+}
+
+} // namespace
+
+//! Constructor taking radius range and power-law index.
+PowerLawSizeDistribution::PowerLawSizeDistribution( const double aMinimumRadius,
+                                                    const double aMaximumRadius,
+                                                    const double aPowerLawIndex )
+    : minimumRadius( aMinimumRadius ),
+      isLogarithmic( isPowerLawIndexOne( aPowerLawIndex ) ),
+      logarithmOfRadiusRatio( std::log( aMaximumRadius / aMinimumRadius ) ),
+      minimumRadiusToExponent( std::pow( aMinimumRadius, 1.0 - aPowerLawIndex ) ),
+      rangeToExponent( std::pow( aMaximumRadius, 1.0 - aPowerLawIndex )
+                       - std::pow( aMinimumRadius, 1.0 - aPowerLawIndex ) ),
+      inverseExponent( 1.0 / ( 1.0 - aPowerLawIndex ) )
+{
+    if ( !( aMinimumRadius > 0.0 ) || !( aMaximumRadius > aMinimumRadius ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Error: radius range of power-law size distribution "
+                                            "is invalid." ) ) );
+    }
+}
+
+//! Constructor taking table of radius bins.
+TabulatedSizeDistribution::TabulatedSizeDistribution(
+        const basics::DoubleKeyDoubleValueMap& someRadiusBins )
+{
+    if ( someRadiusBins.size( ) < 2 )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Error: tabulated size distribution must contain at "
+                                            "least two bin edges." ) ) );
+    }
+
+    // Accumulate relative numbers of bodies per bin.
+    binEdges.reserve( someRadiusBins.size( ) );
+    cumulativeProbabilities.reserve( someRadiusBins.size( ) );
+
+    double cumulativeNumber = 0.0;
+    for ( basics::DoubleKeyDoubleValueMap::const_iterator iteratorBin = someRadiusBins.begin( );
+          iteratorBin != someRadiusBins.end( ); iteratorBin++ )
+    {
+        binEdges.push_back( iteratorBin->first );
+        cumulativeProbabilities.push_back( cumulativeNumber );
+
+        if ( iteratorBin->second < 0.0 )
+        {
+            boost::throw_exception(
+                        boost::enable_error_info(
+                            std::runtime_error( "Error: relative number of bodies in bin of "
+                                                "tabulated size distribution is negative." ) ) );
+        }
+
+        cumulativeNumber += iteratorBin->second;
+    }
+
+    // Remove contribution of value of last key, which is the upper edge of the last bin.
+    cumulativeNumber -= someRadiusBins.rbegin( )->second;
+
+    if ( !( cumulativeNumber > 0.0 ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Error: total relative number of bodies in tabulated "
+                                            "size distribution is not positive." ) ) );
+    }
+
+    // Normalize cumulative numbers to probabilities, ensuring that the last is exactly one.
+    for ( std::size_t i = 0; i < cumulativeProbabilities.size( ); i++ )
+    {
+        cumulativeProbabilities[ i ] /= cumulativeNumber;
+    }
+
+    cumulativeProbabilities.back( ) = 1.0;
+}
+
+//! Compute masses and gravitational parameters of population.
+void computeMassesAndGravitationalParameters( const double bulkDensity, Population& population,
+                                              const unsigned int numberOfThreads )
+{
+    population.masses.resize( population.radii.size( ) );
+    population.gravitationalParameters.resize( population.radii.size( ) );
+
+    const ComputeMassesAndGravitationalParameters loopBody
+            = { bulkDensity, population.radii.data( ), population.masses.data( ),
+                population.gravitationalParameters.data( ) };
+    basics::executeParallelLoop( static_cast< std::size_t >( population.radii.size( ) ),
+                                 loopBody, numberOfThreads );
+}
+
+//! Build population with power-law size distribution.
+void buildPopulation( const PowerLawSizeDistribution& sizeDistribution, const double bulkDensity,
+                      const std::size_t numberOfBodies, const boost::uint64_t seed,
+                      Population& population, const unsigned int numberOfThreads )
+{
+    buildPopulationWithSizeDistribution( sizeDistribution, bulkDensity, numberOfBodies, seed,
+                                         population, numberOfThreads );
+}
+
+//! Build population with tabulated size distribution.
+void buildPopulation( const TabulatedSizeDistribution& sizeDistribution,
+                      const double bulkDensity, const std::size_t numberOfBodies,
+                      const boost::uint64_t seed, Population& population,
+                      const unsigned int numberOfThreads )
+{
+    buildPopulationWithSizeDistribution( sizeDistribution, bulkDensity, numberOfBodies, seed,
+                                         population, numberOfThreads );
+}
+
+} // namespace astrodynamics
+} // namespace assist
@@ -0,0 +1,210 @@
+/*
+ *    Copyright (c) 2010-2014, Delft University of Technology
+ *    Copyright (c) 2010-2014, K. Kumar (me@kartikkumar.com)
+ *    All rights reserved.
+ *    See http://bit.ly/1jern3m for license details.
+ */
+
+#ifndef ASSIST_POPULATION_BUILDER_H
+#define ASSIST_POPULATION_BUILDER_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include <boost/cstdint.hpp>
+
+#include <Eigen/Core>
+
+#include "Assist/Basics/commonTypedefs.h"
+
+namespace assist
+{
+namespace astrodynamics
+{
+
+//! Power-law size distribution.
+/*!
+ * Size distribution with a differential number of bodies dN/dR proportional to R^-index, for
+ * radii R between a minimum and maximum radius. Radii are sampled by inverse transform.
+ */
+class PowerLawSizeDistribution
+{
+public:
+
+    //! Constructor taking radius range and power-law index.
+    /*!
+     * Constructor taking radius range and power-law index of differential size distribution.
+     * Throws a run-time error if the minimum radius is not positive or if the maximum radius is
+     * not greater than the minimum radius.
+     * \param aMinimumRadius Minimum radius [m].
+     * \param aMaximumRadius Maximum radius [m].
+     * \param aPowerLawIndex Power-law index of differential size distribution [-].
+     */
+    PowerLawSizeDistribution( const double aMinimumRadius, const double aMaximumRadius,
+                              const double aPowerLawIndex );
+
+    //! Compute radius for given cumulative probability.
+    /*!
+     * Computes radius for a given cumulative probability, i.e., the inverse of the cumulative
+     * distribution function.
+     * \param cumulativeProbability Cumulative probability, in range [0, 1].
+     * \return Radius [m].
+     */
+    double computeRadius( const double cumulativeProbability ) const
+    {
+        if ( isLogarithmic )
+        {
+            return minimumRadius * std::exp( cumulativeProbability * logarithmOfRadiusRatio );
+        }
+
+        return std::pow( minimumRadiusToExponent + cumulativeProbability * rangeToExponent,
+                         inverseExponent );
+    }
+
+protected:
+
+private:
+
+    //! Minimum radius [m].
+    const double minimumRadius;
+
+    //! Flag indicating if power-law index is (close to) one, in which case radii are log-uniform.
+    const bool isLogarithmic;
+
+    //! Natural logarithm of ratio of maximum and minimum radius.
+    const double logarithmOfRadiusRatio;
+
+    //! Minimum radius raised to power 1 - index.
+    const double minimumRadiusToExponent;
+
+    //! Difference between maximum and minimum radius raised to power 1 - index.
+    const double rangeToExponent;
+
+    //! Inverse of 1 - index.
+    const double inverseExponent;
+};
+
+//! Tabulated size distribution.
+/*!
+ * Size distribution given by a table of radius bins, with the number of bodies uniformly
+ * distributed in radius within each bin. Radii are sampled by inverse transform.
+ */
+class TabulatedSizeDistribution
+{
+public:
+
+    //! Constructor taking table of radius bins.
+    /*!
+     * Constructor taking table of radius bins, given as a step-function map: each key is the
+     * lower edge of a bin [m], which extends to the next key, and each value is the relative
+     * number of bodies in that bin. The value of the last key, which is the upper edge of the
+     * last bin, is ignored. Throws a run-time error if the table contains fewer than two keys,
+     * if a relative number of bodies is negative, or if their sum is not positive.
+     * \param someRadiusBins Table of radius bins.
+     */
+    TabulatedSizeDistribution( const basics::DoubleKeyDoubleValueMap& someRadiusBins );
+
+    //! Compute radius for given cumulative probability.
+    /*!
+     * Computes radius for a given cumulative probability, i.e., the inverse of the cumulative
+     * distribution function.
+     * \param cumulativeProbability Cumulative probability, in range [0, 1).
+     * \return Radius [m].
+     */
+    double computeRadius( const double cumulativeProbability ) const
+    {
+        // Find bin that contains cumulative probability, skipping empty bins.
+        const std::size_t binIndex = std::min< std::size_t >(
+                    std::upper_bound( cumulativeProbabilities.begin( ) + 1,
+                                      cumulativeProbabilities.end( ), cumulativeProbability )
+                    - cumulativeProbabilities.begin( ) - 1,
+                    binEdges.size( ) - 2 );
+
+        // Interpolate linearly within bin.
+        return binEdges[ binIndex ] + ( binEdges[ binIndex + 1 ] - binEdges[ binIndex ] )
+                * ( cumulativeProbability - cumulativeProbabilities[ binIndex ] )
+                / ( cumulativeProbabilities[ binIndex + 1 ]
+                    - cumulativeProbabilities[ binIndex ] );
+    }
+
+protected:
+
+private:
+
+    //! Bin edges [m].
+    std::vector< double > binEdges;
+
+    //! Cumulative probabilities at bin edges.
+    std::vector< double > cumulativeProbabilities;
+};
+
+//! Population of spherical bodies.
+/*!
+ * Population of spherical bodies, stored as contiguous arrays of radii, masses and gravitational
+ * parameters (structure-of-arrays).
+ */
+struct Population
+{
+    //! Radii [m].
+    Eigen::ArrayXd radii;
+
+    //! Masses [kg].
+    Eigen::ArrayXd masses;
+
+    //! Gravitational parameters [m^3 s^-2].
+    Eigen::ArrayXd gravitationalParameters;
+};
+
+//! Compute masses and gravitational parameters of population.
+/*!
+ * Computes masses and gravitational parameters of a population from its radii, assuming spheres
+ * of uniform bulk density (see computeMassOfSphere() and computeGravitationalParameter()).
+ * \param bulkDensity Uniform bulk density of bodies [kg m^-3].
+ * \param population Population, of which radii are set and masses and gravitational parameters
+ *          are computed.
+ * \param numberOfThreads Number of threads to use (0 = number of hardware threads; default=1).
+ */
+void computeMassesAndGravitationalParameters( const double bulkDensity, Population& population,
+                                              const unsigned int numberOfThreads = 1 );
+
+//! Build population with power-law size distribution.
+/*!
+ * Builds a population of spherical bodies of uniform bulk density, with radii sampled from a
+ * power-law size distribution. The radius of body i is computed from uniform sample i of stream 0
+ * of a MonteCarloSampler with the given seed, so that for a given seed the population does not
+ * depend on the number of threads used.
+ * \param sizeDistribution Size distribution to sample radii from.
+ * \param bulkDensity Uniform bulk density of bodies [kg m^-3].
+ * \param numberOfBodies Number of bodies in population.
+ * \param seed Seed for random number generation.
+ * \param population Population built (resized if needed).
+ * \param numberOfThreads Number of threads to use (0 = number of hardware threads; default=1).
+ */
+void buildPopulation( const PowerLawSizeDistribution& sizeDistribution, const double bulkDensity,
+                      const std::size_t numberOfBodies, const boost::uint64_t seed,
+                      Population& population, const unsigned int numberOfThreads = 1 );
+
+//! Build population with tabulated size distribution.
+/*!
+ * Builds a population of spherical bodies of uniform bulk density, with radii sampled from a
+ * tabulated size distribution. The radius of body i is computed from uniform sample i of stream 0
+ * of a MonteCarloSampler with the given seed, so that for a given seed the population does not
+ * depend on the number of threads used.
+ * \param sizeDistribution Size distribution to sample radii from.
+ * \param bulkDensity Uniform bulk density of bodies [kg m^-3].
+ * \param numberOfBodies Number of bodies in population.
+ * \param seed Seed for random number generation.
+ * \param population Population built (resized if needed).
+ * \param numberOfThreads Number of threads to use (0 = number of hardware threads; default=1).
+ */
+void buildPopulation( const TabulatedSizeDistribution& sizeDistribution,
+                      const double bulkDensity, const std::size_t numberOfBodies,
+                      const boost::uint64_t seed, Population& population,
+                      const unsigned int numberOfThreads = 1 );
+
+} // namespace astrodynamics
+} // namespace assist
+
+#endif // ASSIST_POPULATION_BUILDER_H
@@ -0,0 +1,325 @@
+/*
+ *    Copyright (c) 2010-2014, Delft University of Technology
+ *    Copyright (c) 2010-2014, K. Kumar (me@kartikkumar.com)
+ *    All rights reserved.
+ *    See http://bit.ly/1jern3m for license details.
+ */
+
+#ifndef ASSIST_QUANTITIES_H
+#define ASSIST_QUANTITIES_H
+
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+#include <TudatCore/Astrodynamics/BasicAstrodynamics/physicalConstants.h>
+
+namespace assist
+{
+namespace astrodynamics
+{
+namespace units
+{
+
+//! Dimension of time.
+struct TimeDimension { };
+
+//! Dimension of length.
+struct LengthDimension { };
+
+//! Dimension of gravitational parameter.
+struct GravitationalParameterDimension { };
+
+// Each unit tag defines the dimension of the unit and the scale factor from the unit to the base
+// (SI) unit of its dimension. The scale factors are inline functions of compile-time constants.
+// Conversions multiply by the scale factor of the unit converted from, and divide by that of the
+// unit converted to, so that, e.g., the length of a Julian year in seconds converts to exactly one
+// Julian year, as for convertSecondsToJulianYears().
+
+//! Second, the base unit of time.
+struct Second
+{
+    typedef TimeDimension Dimension;
+    static double getScaleToBaseUnit( ) { return 1.0; }
+};
+
+//! Julian day.
+struct JulianDay
+{
+    typedef TimeDimension Dimension;
+    static double getScaleToBaseUnit( )
+    {
+        return tudat::basic_astrodynamics::physical_constants::JULIAN_DAY;
+    }
+};
+
+//! Julian year.
+struct JulianYear
+{
+    typedef TimeDimension Dimension;
+    static double getScaleToBaseUnit( )
+    {
+        return tudat::basic_astrodynamics::physical_constants::JULIAN_YEAR;
+    }
+};
+
+//! Meter, the base unit of length.
+struct Meter
+{
+    typedef LengthDimension Dimension;
+    static double getScaleToBaseUnit( ) { return 1.0; }
+};
+
+//! Kilometer.
+struct Kilometer
+{
+    typedef LengthDimension Dimension;
+    static double getScaleToBaseUnit( ) { return 1.0e3; }
+};
+
+//! Cubic meter per second squared, the base unit of gravitational parameter.
+struct CubicMeterPerSecondSquared
+{
+    typedef GravitationalParameterDimension Dimension;
+    static double getScaleToBaseUnit( ) { return 1.0; }
+};
+
+//! Cubic kilometer per second squared.
+struct CubicKilometerPerSecondSquared
+{
+    typedef GravitationalParameterDimension Dimension;
+    static double getScaleToBaseUnit( ) { return 1.0e9; }
+};
+
+} // namespace units
+
+//! Physical quantity expressed in given unit.
+/*!
+ * Physical quantity, stored as a double expressed in a unit that is part of its type. Quantities
+ * of the same dimension convert implicitly into each other, through multiplication by the scale
+ * factor of the other unit and division by that of the unit of the quantity, so that quantities
+ * can be passed across module boundaries without explicit (defensive) conversions, at no run-time
+ * cost beyond that scaling (none, for the same unit). Conversion between quantities of different
+ * dimensions does not compile. Arithmetic is defined between quantities of the same unit, and
+ * with dimensionless scalars.
+ * \tparam Unit Unit tag (see units namespace).
+ */
+template< typename Unit >
+class Quantity
+{
+public:
+
+    //! Type of unit.
+    typedef Unit UnitType;
+
+    //! Default constructor, setting value to zero.
+    Quantity( ) : value( 0.0 ) { }
+
+    //! Constructor taking value expressed in unit.
+    /*!
+     * Constructor taking value expressed in unit of quantity.
+     * \param aValue Value expressed in unit of quantity.
+     */
+    explicit Quantity( const double aValue ) : value( aValue ) { }
+
+    //! Constructor taking quantity expressed in other unit of same dimension.
+    /*!
+     * Constructor taking quantity expressed in other unit of the same dimension, which is
+     * converted to the unit of this quantity.
+     * \param otherQuantity Quantity expressed in other unit.
+     */
+    template< typename OtherUnit >
+    Quantity( const Quantity< OtherUnit >& otherQuantity )
+        : value( otherQuantity.getValue( ) * OtherUnit::getScaleToBaseUnit( )
+                 / Unit::getScaleToBaseUnit( ) )
+    {
+        BOOST_STATIC_ASSERT( ( boost::is_same< typename Unit::Dimension,
+                                               typename OtherUnit::Dimension >::value ) );
+    }
+
+    //! Get value expressed in unit.
+    /*!
+     * Returns value expressed in unit of quantity.
+     * \return Value expressed in unit of quantity.
+     */
+    double getValue( ) const { return value; }
+
+    //! Get value expressed in base unit.
+    /*!
+     * Returns value expressed in base (SI) unit of dimension of quantity.
+     * \return Value expressed in base unit.
+     */
+    double getValueInBaseUnit( ) const { return value * Unit::getScaleToBaseUnit( ); }
+
+    //! Get conversion factor from other unit to unit of quantity.
+    /*!
+     * Returns conversion factor from other unit, of the same dimension, to unit of quantity.
+     * \tparam OtherUnit Unit to convert from.
+     * \return Conversion factor.
+     */
+    template< typename OtherUnit >
+    static double getConversionFactor( )
+    {
+        return OtherUnit::getScaleToBaseUnit( ) / Unit::getScaleToBaseUnit( );
+    }
+
+    //! Add quantity to this quantity.
+    Quantity& operator+=( const Quantity& otherQuantity )
+    {
+        value += otherQuantity.value;
+        return *this;
+    }
+
+    //! Subtract quantity from this quantity.
+    Quantity& operator-=( const Quantity& otherQuantity )
+    {
+        value -= otherQuantity.value;
+        return *this;
+    }
+
+    //! Multiply this quantity by scalar.
+    Quantity& operator*=( const double scalar )
+    {
+        value *= scalar;
+        return *this;
+    }
+
+    //! Divide this quantity by scalar.
+    Quantity& operator/=( const double scalar )
+    {
+        value /= scalar;
+        return *this;
+    }
+
+protected:
+
+private:
+
+    //! Value expressed in unit.
+    double value;
+};
+
+//! Add quantities.
+template< typename Unit >
+inline Quantity< Unit > operator+( Quantity< Unit > firstQuantity,
+                                   const Quantity< Unit >& secondQuantity )
+{
+    return firstQuantity += secondQuantity;
+}
+
+//! Subtract quantities.
+template< typename Unit >
+inline Quantity< Unit > operator-( Quantity< Unit > firstQuantity,
+                                   const Quantity< Unit >& secondQuantity )
+{
+    return firstQuantity -= secondQuantity;
+}
+
+//! Negate quantity.
+template< typename Unit >
+inline Quantity< Unit > operator-( const Quantity< Unit >& quantity )
+{
+    return Quantity< Unit >( -quantity.getValue( ) );
+}
+
+//! Multiply quantity by scalar.
+template< typename Unit >
+inline Quantity< Unit > operator*( Quantity< Unit > quantity, const double scalar )
+{
+    return quantity *= scalar;
+}
+
+//! Multiply scalar by quantity.
+template< typename Unit >
+inline Quantity< Unit > operator*( const double scalar, Quantity< Unit > quantity )
+{
+    return quantity *= scalar;
+}
+
+//! Divide quantity by scalar.
+template< typename Unit >
+inline Quantity< Unit > operator/( Quantity< Unit > quantity, const double scalar )
+{
+    return quantity /= scalar;
+}
+
+//! Divide quantities of same unit, giving dimensionless ratio.
+template< typename Unit >
+inline double operator/( const Quantity< Unit >& firstQuantity,
+                         const Quantity< Unit >& secondQuantity )
+{
+    return firstQuantity.getValue( ) / secondQuantity.getValue( );
+}
+
+//! Check if quantity is less than other quantity.
+template< typename Unit >
+inline bool operator<( const Quantity< Unit >& firstQuantity,
+                       const Quantity< Unit >& secondQuantity )
+{
+    return firstQuantity.getValue( ) < secondQuantity.getValue( );
+}
+
+//! Check if quantity is greater than other quantity.
+template< typename Unit >
+inline bool operator>( const Quantity< Unit >& firstQuantity,
+                       const Quantity< Unit >& secondQuantity )
+{
+    return secondQuantity < firstQuantity;
+}
+
+//! Check if quantity is less than or equal to other quantity.
+template< typename Unit >
+inline bool operator<=( const Quantity< Unit >& firstQuantity,
+                        const Quantity< Unit >& secondQuantity )
+{
+    return !( secondQuantity < firstQuantity );
+}
+
+//! Check if quantity is greater than or equal to other quantity.
+template< typename Unit >
+inline bool operator>=( const Quantity< Unit >& firstQuantity,
+                        const Quantity< Unit >& secondQuantity )
+{
+    return !( firstQuantity < secondQuantity );
+}
+
+//! Check if quantities are equal.
+template< typename Unit >
+inline bool operator==( const Quantity< Unit >& firstQuantity,
+                        const Quantity< Unit >& secondQuantity )
+{
+    return firstQuantity.getValue( ) == secondQuantity.getValue( );
+}
+
+//! Check if quantities are not equal.
+template< typename Unit >
+inline bool operator!=( const Quantity< Unit >& firstQuantity,
+                        const Quantity< Unit >& secondQuantity )
+{
+    return !( firstQuantity == secondQuantity );
+}
+
+//! Typedef for time in seconds.
+typedef Quantity< units::Second > Seconds;
+
+//! Typedef for time in Julian days.
+typedef Quantity< units::JulianDay > JulianDays;
+
+//! Typedef for time in Julian years.
+typedef Quantity< units::JulianYear > JulianYears;
+
+//! Typedef for length in meters.
+typedef Quantity< units::Meter > Meters;
+
+//! Typedef for length in kilometers.
+typedef Quantity< units::Kilometer > Kilometers;
+
+//! Typedef for gravitational parameter in m^3 s^-2.
+typedef Quantity< units::CubicMeterPerSecondSquared > GravitationalParameter;
+
+//! Typedef for gravitational parameter in km^3 s^-2.
+typedef Quantity< units::CubicKilometerPerSecondSquared > GravitationalParameterInKilometers;
+
+} // namespace astrodynamics
+} // namespace assist
+
+#endif // ASSIST_QUANTITIES_H
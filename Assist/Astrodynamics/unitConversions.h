@@ -5,6 +5,9 @@
  *    See http://bit.ly/1jern3m for license details.
  */
 
+#ifndef ASSIST_UNIT_CONVERSIONS_H
+#define ASSIST_UNIT_CONVERSIONS_H
+
 #include <TudatCore/Astrodynamics/BasicAstrodynamics/physicalConstants.h>
 
 namespace assist
@@ -32,7 +35,7 @@ inline double convertJulianYearsToSeconds( const double julianYears )
 inline double convertSecondsToJulianYears( const double seconds )
 {
     return seconds / tudat::basic_astrodynamics::physical_constants::JULIAN_YEAR;
-}	
+}
 
 //! Convert Julian days to seconds.
 /*!
@@ -54,7 +57,9 @@ inline double convertJulianDaysToSeconds( const double julianDays )
 inline double convertSecondsToJulianDays( const double seconds )
 {
     return seconds / tudat::basic_astrodynamics::physical_constants::JULIAN_DAY;
-}   
+}
 
 } // namespace astrodynamics
-} // namespace assist
\ No newline at end of file
+} // namespace assist
+
+#endif // ASSIST_UNIT_CONVERSIONS_H
\ No newline at end of file
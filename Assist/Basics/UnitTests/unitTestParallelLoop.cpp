@@ -0,0 +1,210 @@
+/*
+ *    Copyright (c) 2010-2014, Delft University of Technology
+ *    Copyright (c) 2010-2014, K. Kumar (me@kartikkumar.com)
+ *    All rights reserved.
+ *    See http://bit.ly/1jern3m for license details.
+ */
+
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/thread/thread.hpp>
+
+#include "Assist/Basics/parallelLoop.h"
+
+namespace assist
+{
+namespace unit_tests
+{
+
+//! Loop body that records which chunk visited each iteration.
+struct RecordChunk
+{
+    //! Record begin of chunk for each iteration in range [begin, end).
+    void operator( )( const std::size_t begin, const std::size_t end ) const
+    {
+        for ( std::size_t i = begin; i < end; i++ )
+        {
+            ( *chunkBegins )[ i ] = begin;
+            ( *visitCounts )[ i ]++;
+        }
+    }
+
+    //! Begin of chunk that visited each iteration.
+    std::vector< std::size_t >* chunkBegins;
+
+    //! Number of visits of each iteration.
+    std::vector< int >* visitCounts;
+};
+
+//! Loop body that throws for a given iteration.
+struct ThrowForIteration
+{
+    //! Throw if range [begin, end) contains given iteration.
+    void operator( )( const std::size_t begin, const std::size_t end ) const
+    {
+        if ( begin <= iteration && iteration < end )
+        {
+            throw std::runtime_error( "Error: test error." );
+        }
+    }
+
+    //! Iteration to throw for.
+    std::size_t iteration;
+};
+
+//! Task body that records the thread that executed each task, and throws for a given task.
+struct RecordTask
+{
+    //! Record thread that executed task, and throw if task is the one to throw for.
+    void operator( )( const std::size_t task ) const
+    {
+        ( *threadIds )[ task ] = boost::this_thread::get_id( );
+        ( *visitCounts )[ task ]++;
+
+        if ( task == taskToThrowFor )
+        {
+            throw std::runtime_error( "Error: test error." );
+        }
+    }
+
+    //! Thread that executed each task.
+    std::vector< boost::thread::id >* threadIds;
+
+    //! Number of visits of each task.
+    std::vector< int >* visitCounts;
+
+    //! Task to throw for.
+    std::size_t taskToThrowFor;
+};
+
+BOOST_AUTO_TEST_SUITE( test_parallel_loop )
+
+//! Test implementation of function to get number of threads.
+BOOST_AUTO_TEST_CASE( testGetNumberOfThreadsFunction )
+{
+    BOOST_CHECK_EQUAL( basics::getNumberOfThreads( 3 ), 3u );
+    BOOST_CHECK( basics::getNumberOfThreads( 0 ) >= 1u );
+}
+
+//! Test that parallel loop visits each iteration exactly once, in contiguous chunks.
+BOOST_AUTO_TEST_CASE( testExecuteParallelLoopFunction )
+{
+    const std::size_t numberOfIterations = 10007;
+
+    // Execute loop on 4 threads, with chunks of at least 100 iterations.
+    std::vector< std::size_t > chunkBegins( numberOfIterations, numberOfIterations );
+    std::vector< int > visitCounts( numberOfIterations, 0 );
+    const RecordChunk loopBody = { &chunkBegins, &visitCounts };
+    basics::executeParallelLoop( numberOfIterations, loopBody, 4, 100 );
+
+    // Check that each iteration was visited once, and that there were 4 contiguous chunks.
+    std::size_t numberOfChunks = 1;
+    for ( std::size_t i = 0; i < numberOfIterations; i++ )
+    {
+        BOOST_CHECK_EQUAL( visitCounts.at( i ), 1 );
+        if ( i > 0 && chunkBegins.at( i ) != chunkBegins.at( i - 1 ) )
+        {
+            BOOST_CHECK_EQUAL( chunkBegins.at( i ), i );
+            numberOfChunks++;
+        }
+    }
+
+    BOOST_CHECK_EQUAL( chunkBegins.front( ), 0 );
+    BOOST_CHECK_EQUAL( numberOfChunks, 4 );
+
+    // Check that small loops are executed in one chunk.
+    std::vector< std::size_t > smallChunkBegins( 50, 50 );
+    std::vector< int > smallVisitCounts( 50, 0 );
+    const RecordChunk smallLoopBody = { &smallChunkBegins, &smallVisitCounts };
+    basics::executeParallelLoop( 50, smallLoopBody, 4, 100 );
+
+    for ( std::size_t i = 0; i < 50; i++ )
+    {
+        BOOST_CHECK_EQUAL( smallChunkBegins.at( i ), 0 );
+        BOOST_CHECK_EQUAL( smallVisitCounts.at( i ), 1 );
+    }
+}
+
+//! Test that errors thrown in parallel loop are re-thrown on calling thread.
+BOOST_AUTO_TEST_CASE( testExecuteParallelLoopErrors )
+{
+    // Throw error in last chunk, which is executed on a separate thread.
+    bool isErrorThrown = false;
+
+    try
+    {
+        const ThrowForIteration loopBody = { 9999 };
+        basics::executeParallelLoop( 10000, loopBody, 4, 100 );
+    }
+
+    catch ( std::runtime_error& error )
+    {
+        isErrorThrown = true;
+    }
+
+    BOOST_CHECK( isErrorThrown );
+}
+
+//! Test that dynamic parallel loop executes each task exactly once.
+BOOST_AUTO_TEST_CASE( testExecuteDynamicParallelLoopFunction )
+{
+    const std::size_t numberOfTasks = 1001;
+
+    // Execute tasks on 4 threads, and on one thread.
+    std::vector< boost::thread::id > threadIds( numberOfTasks );
+    std::vector< int > visitCounts( numberOfTasks, 0 );
+    const RecordTask taskBody = { &threadIds, &visitCounts, numberOfTasks };
+    basics::executeDynamicParallelLoop( numberOfTasks, taskBody, 4 );
+
+    std::vector< boost::thread::id > serialThreadIds( numberOfTasks );
+    std::vector< int > serialVisitCounts( numberOfTasks, 0 );
+    const RecordTask serialTaskBody = { &serialThreadIds, &serialVisitCounts, numberOfTasks };
+    basics::executeDynamicParallelLoop( numberOfTasks, serialTaskBody, 1 );
+
+    // Check that each task was executed once, and that the serial loop ran on this thread.
+    for ( std::size_t i = 0; i < numberOfTasks; i++ )
+    {
+        BOOST_CHECK_EQUAL( visitCounts.at( i ), 1 );
+        BOOST_CHECK_EQUAL( serialVisitCounts.at( i ), 1 );
+        BOOST_CHECK( serialThreadIds.at( i ) == boost::this_thread::get_id( ) );
+    }
+
+    // Check that an empty loop does nothing.
+    basics::executeDynamicParallelLoop( 0, taskBody, 4 );
+}
+
+//! Test that errors thrown in dynamic parallel loop are re-thrown on calling thread.
+BOOST_AUTO_TEST_CASE( testExecuteDynamicParallelLoopErrors )
+{
+    bool isErrorThrown = false;
+
+    std::vector< boost::thread::id > threadIds( 100 );
+    std::vector< int > visitCounts( 100, 0 );
+
+    try
+    {
+        const RecordTask taskBody = { &threadIds, &visitCounts, 50 };
+        basics::executeDynamicParallelLoop( 100, taskBody, 4 );
+    }
+
+    catch ( std::runtime_error& error )
+    {
+        isErrorThrown = true;
+    }
+
+    BOOST_CHECK( isErrorThrown );
+
+    // Check that no task was executed more than once.
+    for ( std::size_t i = 0; i < 100; i++ )
+    {
+        BOOST_CHECK_LE( visitCounts.at( i ), 1 );
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace assist
@@ -0,0 +1,285 @@
+/*
+ *    Copyright (c) 2010-2014, Delft University of Technology
+ *    Copyright (c) 2010-2014, K. Kumar (me@kartikkumar.com)
+ *    All rights reserved.
+ *    See http://bit.ly/1jern3m for license details.
+ */
+
+#ifndef ASSIST_PARALLEL_LOOP_H
+#define ASSIST_PARALLEL_LOOP_H
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include <boost/exception_ptr.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+
+namespace assist
+{
+namespace basics
+{
+
+//! Get number of threads to use.
+/*!
+ * Returns the number of threads to use for a parallel loop. If the number requested is zero, the
+ * number of hardware threads is returned (or one, if it cannot be determined).
+ * \param numberOfThreads Number of threads requested (0 = number of hardware threads).
+ * \return Number of threads to use.
+ */
+inline unsigned int getNumberOfThreads( const unsigned int numberOfThreads )
+{
+    if ( numberOfThreads > 0 )
+    {
+        return numberOfThreads;
+    }
+
+    return std::max( boost::thread::hardware_concurrency( ), 1u );
+}
+
+namespace detail
+{
+
+//! Functor that executes a loop body on a range, and catches any error thrown.
+template< typename LoopBody >
+struct ExecuteLoopRange
+{
+    //! Constructor taking loop body, range and pointer to error.
+    ExecuteLoopRange( const LoopBody& aLoopBody, const std::size_t aBegin, const std::size_t anEnd,
+                      boost::exception_ptr* anError )
+        : loopBody( aLoopBody ),
+          begin( aBegin ),
+          end( anEnd ),
+          error( anError )
+    { }
+
+    //! Execute loop body on range [begin, end).
+    void operator( )( )
+    {
+        try
+        {
+            loopBody( begin, end );
+        }
+
+        catch ( ... )
+        {
+            *error = boost::current_exception( );
+        }
+    }
+
+    //! Loop body.
+    LoopBody loopBody;
+
+    //! Start of range.
+    std::size_t begin;
+
+    //! End of range.
+    std::size_t end;
+
+    //! Error thrown by loop body, if any.
+    boost::exception_ptr* error;
+};
+
+//! Queue of tasks shared by threads of a dynamic parallel loop.
+struct TaskQueue
+{
+    //! Constructor taking number of tasks.
+    TaskQueue( const std::size_t aNumberOfTasks )
+        : numberOfTasks( aNumberOfTasks ),
+          nextTask( 0 )
+    { }
+
+    //! Claim next task, if any; returns false if no tasks remain or an error was thrown.
+    bool claimTask( std::size_t& task )
+    {
+        boost::lock_guard< boost::mutex > lock( mutex );
+        if ( nextTask >= numberOfTasks || error )
+        {
+            return false;
+        }
+
+        task = nextTask++;
+        return true;
+    }
+
+    //! Store error, if it is the first.
+    void storeError( const boost::exception_ptr& anError )
+    {
+        boost::lock_guard< boost::mutex > lock( mutex );
+        if ( !error )
+        {
+            error = anError;
+        }
+    }
+
+    //! Mutex that protects queue.
+    boost::mutex mutex;
+
+    //! Number of tasks.
+    const std::size_t numberOfTasks;
+
+    //! Index of next task to claim.
+    std::size_t nextTask;
+
+    //! First error thrown by a task, if any.
+    boost::exception_ptr error;
+};
+
+//! Functor that executes tasks claimed from a queue, until the queue is empty.
+template< typename TaskBody >
+struct ExecuteQueuedTasks
+{
+    //! Constructor taking task body and pointer to task queue.
+    ExecuteQueuedTasks( const TaskBody& aTaskBody, TaskQueue* aTaskQueue )
+        : taskBody( aTaskBody ),
+          taskQueue( aTaskQueue )
+    { }
+
+    //! Execute tasks until queue is empty.
+    void operator( )( )
+    {
+        std::size_t task = 0;
+        while ( taskQueue->claimTask( task ) )
+        {
+            try
+            {
+                taskBody( task );
+            }
+
+            catch ( ... )
+            {
+                taskQueue->storeError( boost::current_exception( ) );
+            }
+        }
+    }
+
+    //! Task body.
+    TaskBody taskBody;
+
+    //! Queue of tasks.
+    TaskQueue* taskQueue;
+};
+
+} // namespace detail
+
+//! Execute loop in parallel.
+/*!
+ * Executes a loop over the range [0, numberOfIterations) in parallel, by splitting it into
+ * contiguous chunks of (nearly) equal size and calling loopBody( begin, end ) for each chunk on a
+ * separate thread. The first chunk is executed on the calling thread. No more threads are used
+ * than there are chunks of at least minimumChunkSize iterations, so small loops are executed
+ * serially, without the overhead of creating threads. The chunk boundaries depend only on the
+ * number of iterations and the number of threads used. If loopBody throws, the first error (in
+ * order of chunks) is re-thrown after all threads have finished. The loop body is copied for
+ * each chunk, so it should hold references or pointers to shared data.
+ * \param numberOfIterations Number of loop iterations.
+ * \param loopBody Loop body, callable as loopBody( std::size_t begin, std::size_t end ).
+ * \param numberOfThreads Number of threads to use (0 = number of hardware threads; default=0).
+ * \param minimumChunkSize Minimum number of iterations per thread (default=1024).
+ */
+template< typename LoopBody >
+void executeParallelLoop( const std::size_t numberOfIterations, const LoopBody& loopBody,
+                          const unsigned int numberOfThreads = 0,
+                          const std::size_t minimumChunkSize = 1024 )
+{
+    if ( numberOfIterations == 0 )
+    {
+        return;
+    }
+
+    // Determine number of chunks, each executed by its own thread.
+    const std::size_t numberOfChunks = std::max< std::size_t >(
+                1, std::min< std::size_t >( getNumberOfThreads( numberOfThreads ),
+                                            numberOfIterations
+                                            / std::max< std::size_t >( minimumChunkSize, 1 ) ) );
+
+    if ( numberOfChunks == 1 )
+    {
+        loopBody( 0, numberOfIterations );
+        return;
+    }
+
+    // Set up chunks.
+    std::vector< boost::exception_ptr > errors( numberOfChunks );
+    std::vector< detail::ExecuteLoopRange< LoopBody > > chunks;
+    chunks.reserve( numberOfChunks );
+    for ( std::size_t i = 0; i < numberOfChunks; i++ )
+    {
+        chunks.push_back( detail::ExecuteLoopRange< LoopBody >(
+                              loopBody, i * numberOfIterations / numberOfChunks,
+                              ( i + 1 ) * numberOfIterations / numberOfChunks, &errors[ i ] ) );
+    }
+
+    // Execute all but the first chunk on separate threads, and the first on this thread.
+    boost::thread_group threads;
+    for ( std::size_t i = 1; i < numberOfChunks; i++ )
+    {
+        threads.create_thread( chunks[ i ] );
+    }
+
+    chunks[ 0 ]( );
+    threads.join_all( );
+
+    // Re-throw first error, if any.
+    for ( std::size_t i = 0; i < numberOfChunks; i++ )
+    {
+        if ( errors[ i ] )
+        {
+            boost::rethrow_exception( errors[ i ] );
+        }
+    }
+}
+
+//! Execute tasks in parallel, with dynamic load balancing.
+/*!
+ * Executes tasks [0, numberOfTasks) in parallel, by calling taskBody( task ) for each task. Unlike
+ * executeParallelLoop(), the tasks are not assigned to threads in advance: each thread claims the
+ * next task from a shared queue as soon as it has finished its previous task, so that tasks with
+ * unequal costs (e.g., integrations with adaptive step sizes) are balanced over the threads. The
+ * tasks are claimed in increasing order, and one of the threads is the calling thread. Claiming a
+ * task requires a lock, so tasks should be coarse (e.g., batches of work items). If taskBody
+ * throws, no further tasks are started, and the first error is re-thrown after all threads have
+ * finished. The task body is copied for each thread, so it should hold references or pointers to
+ * shared data.
+ * \param numberOfTasks Number of tasks.
+ * \param taskBody Task body, callable as taskBody( std::size_t task ).
+ * \param numberOfThreads Number of threads to use (0 = number of hardware threads; default=0).
+ */
+template< typename TaskBody >
+void executeDynamicParallelLoop( const std::size_t numberOfTasks, const TaskBody& taskBody,
+                                 const unsigned int numberOfThreads = 0 )
+{
+    if ( numberOfTasks == 0 )
+    {
+        return;
+    }
+
+    const std::size_t numberOfWorkers = std::min< std::size_t >(
+                getNumberOfThreads( numberOfThreads ), numberOfTasks );
+
+    // Execute tasks on separate threads and on this thread, until the queue is empty.
+    detail::TaskQueue taskQueue( numberOfTasks );
+    detail::ExecuteQueuedTasks< TaskBody > worker( taskBody, &taskQueue );
+
+    boost::thread_group threads;
+    for ( std::size_t i = 1; i < numberOfWorkers; i++ )
+    {
+        threads.create_thread( worker );
+    }
+
+    worker( );
+    threads.join_all( );
+
+    // Re-throw first error, if any.
+    if ( taskQueue.error )
+    {
+        boost::rethrow_exception( taskQueue.error );
+    }
+}
+
+} // namespace basics
+} // namespace assist
+
+#endif // ASSIST_PARALLEL_LOOP_H
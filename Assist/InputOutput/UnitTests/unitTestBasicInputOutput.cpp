@@ -9,8 +9,14 @@
 #include <string>
 #include <sstream>
 
+#include <boost/algorithm/string.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int_distribution.hpp>
 #include <boost/test/unit_test.hpp>
 
+#include <TudatCore/InputOutput/streamFilters.h>
+
 #include "Assist/InputOutput/basicInputOutput.h"
 #include "Assist/InputOutput/rootPath.h"
 
@@ -19,6 +25,41 @@ namespace assist
 namespace unit_tests
 {
 
+namespace
+{
+
+//! Filter comments and blank lines with TudatCore's RemoveComment stream filter (reference).
+std::string filterCommentsAndBlankLinesWithStreamFilter( const std::string& unfilteredData,
+                                                         const char commentCharacter )
+{
+    // Remove empty lines.
+    std::istringstream unfilteredDataStream( unfilteredData );
+    std::string nonEmptyLines;
+    std::string line;
+    while ( std::getline( unfilteredDataStream, line ) )
+    {
+        if ( !line.empty( ) )
+        {
+            nonEmptyLines += line + "\n";
+        }
+    }
+
+    // Filter comment lines.
+    std::string filteredData;
+    boost::iostreams::filtering_ostream filterProcessor;
+    filterProcessor.push( tudat::input_output::stream_filters::RemoveComment( commentCharacter ) );
+    filterProcessor.push( boost::iostreams::back_inserter( filteredData ) );
+    filterProcessor << nonEmptyLines;
+    filterProcessor.flush( );
+
+    // Trim all stray characters.
+    boost::trim( filteredData );
+
+    return filteredData;
+}
+
+} // namespace
+
 BOOST_AUTO_TEST_SUITE( test_basic_input_output )
 
 //! Test implementation of function that checks number of input arguments provided.
@@ -166,6 +207,64 @@ BOOST_AUTO_TEST_CASE( testInputFileReadAndFilterFunction )
     }
 }
 
+//! Test that native comment filter gives output identical to TudatCore's stream filter.
+BOOST_AUTO_TEST_CASE( testFilterCommentsAndBlankLinesFunction )
+{
+    // Test 1: Check handcrafted data with comments at start, in the middle and at the end of
+    //         lines, blank lines, carriage returns and a last line without newline.
+    {
+        const std::string unfilteredData
+                = "# Header\n\n1.0, 2.0 # trailing comment\n  # indented comment\n3.0, 4.0\r\n"
+                  "\n\n#\n5.0,6.0#\n\t\n7.0, 8.0";
+
+        const char commentCharacters[ 5 ] = { '#', '%', ' ', ',', '\n' };
+        for ( unsigned int i = 0; i < 5; i++ )
+        {
+            BOOST_CHECK_EQUAL(
+                        input_output::filterCommentsAndBlankLines(
+                            unfilteredData, commentCharacters[ i ] ),
+                        filterCommentsAndBlankLinesWithStreamFilter(
+                            unfilteredData, commentCharacters[ i ] ) );
+        }
+
+        BOOST_CHECK_EQUAL( input_output::filterCommentsAndBlankLines( unfilteredData ),
+                           "1.0, 2.0 \n  \n3.0, 4.0\r\n5.0,6.0\n\t\n7.0, 8.0" );
+    }
+
+    // Test 2: Check random data drawn from a small alphabet, such that all combinations of
+    //         comments, blank lines and whitespace occur.
+    {
+        const std::string alphabet = "a1 #%\n\n\r\t";
+        boost::mt19937 randomNumberGenerator( 42 );
+        boost::random::uniform_int_distribution< std::size_t > characterDistribution(
+                    0, alphabet.size( ) - 1 );
+        boost::random::uniform_int_distribution< std::size_t > lengthDistribution( 0, 200 );
+
+        for ( unsigned int i = 0; i < 2000; i++ )
+        {
+            std::string unfilteredData( lengthDistribution( randomNumberGenerator ), ' ' );
+            for ( std::size_t j = 0; j < unfilteredData.size( ); j++ )
+            {
+                unfilteredData[ j ] = alphabet[ characterDistribution( randomNumberGenerator ) ];
+            }
+
+            const char commentCharacter = ( i % 2 == 0 ) ? '#' : '%';
+            BOOST_REQUIRE_EQUAL(
+                        input_output::filterCommentsAndBlankLines(
+                            unfilteredData, commentCharacter ),
+                        filterCommentsAndBlankLinesWithStreamFilter(
+                            unfilteredData, commentCharacter ) );
+        }
+    }
+
+    // Test 3: Check that empty data and data containing only comments are filtered to an empty
+    //         string.
+    {
+        BOOST_CHECK_EQUAL( input_output::filterCommentsAndBlankLines( "" ), "" );
+        BOOST_CHECK_EQUAL( input_output::filterCommentsAndBlankLines( "# a\n\n#b" ), "" );
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END( )
 
 } // namespace unit_tests
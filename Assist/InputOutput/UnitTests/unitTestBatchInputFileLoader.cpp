@@ -0,0 +1,156 @@
+/*
+ *    Copyright (c) 2010-2014, Delft University of Technology
+ *    Copyright (c) 2010-2014, K. Kumar (me@kartikkumar.com)
+ *    All rights reserved.
+ *    See http://bit.ly/1jern3m for license details.
+ */
+
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include "Assist/InputOutput/basicInputOutput.h"
+#include "Assist/InputOutput/batchInputFileLoader.h"
+#include "Assist/InputOutput/rootPath.h"
+
+namespace assist
+{
+namespace unit_tests
+{
+
+BOOST_AUTO_TEST_SUITE( test_batch_input_file_loader )
+
+//! Test listing of input files in directory given relative to Assist root-path.
+BOOST_AUTO_TEST_CASE( testListInputFilesInDirectoryFunction )
+{
+    // List test input files in unit test directory.
+    const std::vector< std::string > inputFileNames
+            = input_output::listInputFilesInDirectory( "InputOutput/UnitTests", ".txt" );
+
+    // Check that the test input files are listed, sorted by name.
+    const std::string customCommentCharacterFile
+            = "InputOutput/UnitTests/testInputFileCustomCommentCharacter.txt";
+    const std::string defaultCommentCharacterFile
+            = "InputOutput/UnitTests/testInputFileDefaultCommentCharacter.txt";
+
+    std::vector< std::size_t > indices;
+    for ( std::size_t i = 0; i < inputFileNames.size( ); i++ )
+    {
+        if ( inputFileNames.at( i ).find( customCommentCharacterFile ) != std::string::npos
+             || inputFileNames.at( i ).find( defaultCommentCharacterFile ) != std::string::npos )
+        {
+            indices.push_back( i );
+        }
+    }
+
+    BOOST_REQUIRE_EQUAL( indices.size( ), 2 );
+    BOOST_CHECK( inputFileNames.at( indices.at( 0 ) ).find( customCommentCharacterFile )
+                 != std::string::npos );
+    BOOST_CHECK( std::adjacent_find( inputFileNames.begin( ), inputFileNames.end( ),
+                                     std::greater< std::string >( ) )
+                 == inputFileNames.end( ) );
+
+    // Check that a run-time error is thrown for a non-existent directory.
+    bool isErrorThrown = false;
+
+    try
+    {
+        input_output::listInputFilesInDirectory( "InputOutput/NonExistentDirectory" );
+    }
+
+    catch ( std::runtime_error& error )
+    {
+        isErrorThrown = true;
+    }
+
+    BOOST_CHECK( isErrorThrown );
+}
+
+//! Test that batch loader hands out filtered input files in order.
+BOOST_AUTO_TEST_CASE( testBatchInputFileLoaderOrder )
+{
+    // Set list of input files, alternating between two files that filter differently with the
+    // default comment character.
+    const std::string customCommentCharacterFile
+            = input_output::getAssistRootPath( )
+            + "/InputOutput/UnitTests/testInputFileCustomCommentCharacter.txt";
+    const std::string defaultCommentCharacterFile
+            = input_output::getAssistRootPath( )
+            + "/InputOutput/UnitTests/testInputFileDefaultCommentCharacter.txt";
+
+    std::vector< std::string > inputFileNames;
+    for ( unsigned int i = 0; i < 50; i++ )
+    {
+        inputFileNames.push_back( ( i % 3 == 0 ) ? customCommentCharacterFile
+                                                 : defaultCommentCharacterFile );
+    }
+
+    // Set expected filtered strings.
+    const std::string expectedCustom
+            = input_output::readAndFilterInputFile( customCommentCharacterFile );
+    const std::string expectedDefault
+            = input_output::readAndFilterInputFile( defaultCommentCharacterFile );
+    BOOST_REQUIRE( expectedCustom != expectedDefault );
+
+    // Load batch with more threads than the prefetch depth, and check order of output.
+    input_output::BatchInputFileLoader loader( inputFileNames, 2, 3 );
+    BOOST_CHECK_EQUAL( loader.getNumberOfInputFiles( ), inputFileNames.size( ) );
+
+    unsigned int numberOfFilesHandedOut = 0;
+    while ( loader.hasNextInputFile( ) )
+    {
+        BOOST_CHECK_EQUAL( loader.getNextInputFileName( ),
+                           inputFileNames.at( numberOfFilesHandedOut ) );
+        BOOST_CHECK_EQUAL( loader.getNextInputFile( ),
+                           ( numberOfFilesHandedOut % 3 == 0 ) ? expectedCustom
+                                                               : expectedDefault );
+        numberOfFilesHandedOut++;
+    }
+
+    BOOST_CHECK_EQUAL( numberOfFilesHandedOut, inputFileNames.size( ) );
+
+    // Check that a run-time error is thrown once the batch is exhausted.
+    bool isErrorThrown = false;
+
+    try
+    {
+        loader.getNextInputFile( );
+    }
+
+    catch ( std::runtime_error& error )
+    {
+        isErrorThrown = true;
+    }
+
+    BOOST_CHECK( isErrorThrown );
+}
+
+//! Test that batch loader applies custom comment character and can be destroyed early.
+BOOST_AUTO_TEST_CASE( testBatchInputFileLoaderCustomCommentCharacter )
+{
+    // Set list of input files.
+    const std::vector< std::string > inputFileNames(
+                10, input_output::getAssistRootPath( )
+                + "/InputOutput/UnitTests/testInputFileCustomCommentCharacter.txt" );
+
+    // Set expected filtered string.
+    const std::string expectedFilteredString = "First line that should not be filtered.\n"
+                                               "Second line that should not be filtered.\n"
+                                               "Last line that should not be filtered.";
+
+    // Load only the first few files; the destructor should stop the remaining prefetches.
+    input_output::BatchInputFileLoader loader( inputFileNames, 4, 2, '%' );
+    for ( unsigned int i = 0; i < 3; i++ )
+    {
+        BOOST_CHECK_EQUAL( loader.getNextInputFile( ), expectedFilteredString );
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace assist
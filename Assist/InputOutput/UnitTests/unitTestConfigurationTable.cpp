@@ -0,0 +1,310 @@
+/*
+ *    Copyright (c) 2010-2014, Delft University of Technology
+ *    Copyright (c) 2010-2014, K. Kumar (me@kartikkumar.com)
+ *    All rights reserved.
+ *    See http://bit.ly/1jern3m for license details.
+ */
+
+#include <ctime>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "Assist/InputOutput/basicInputOutput.h"
+#include "Assist/InputOutput/configurationTable.h"
+#include "Assist/InputOutput/rootPath.h"
+
+namespace assist
+{
+namespace unit_tests
+{
+
+namespace
+{
+
+//! Replace first occurrence of text in file, in place.
+void replaceInFile( const std::string& fileName, const std::string& oldText,
+                    const std::string& newText )
+{
+    std::fstream fileStream( fileName.c_str( ), std::ios::in | std::ios::out | std::ios::binary );
+    std::string contents( ( std::istreambuf_iterator< char >( fileStream ) ),
+                          std::istreambuf_iterator< char >( ) );
+    contents.replace( contents.find( oldText ), oldText.size( ), newText );
+    fileStream.clear( );
+    fileStream.seekp( 0 );
+    fileStream << contents;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE( test_configuration_table )
+
+//! Test parsing of configuration file and typed lookups.
+BOOST_AUTO_TEST_CASE( testConfigurationTableTypedLookups )
+{
+    // Read and parse test configuration file.
+    const input_output::ConfigurationTable configurationTable(
+                input_output::readAndFilterInputFile(
+                    input_output::getAssistRootPath( )
+                    + "/InputOutput/UnitTests/testConfigurationFile.txt" ) );
+
+    // Check that all parameters are parsed, with all separators supported.
+    BOOST_CHECK_EQUAL( configurationTable.getNumberOfParameters( ), 4 );
+    BOOST_CHECK_EQUAL( configurationTable.getInteger( "numberOfBodies" ), 1000 );
+    BOOST_CHECK_EQUAL( configurationTable.getDouble( "numberOfBodies" ), 1000.0 );
+    BOOST_CHECK_EQUAL( configurationTable.getDouble( "semiMajorAxis" ), 7.0e6 );
+    BOOST_CHECK_EQUAL( configurationTable.getBoolean( "isOutputWritten" ), true );
+    BOOST_CHECK_EQUAL( configurationTable.getString( "outputFileName" ), "results.txt" );
+    BOOST_CHECK( configurationTable.hasParameter( "semiMajorAxis" ) );
+    BOOST_CHECK( !configurationTable.hasParameter( "eccentricity" ) );
+
+    // Check that lookups of missing parameters and parameters of the wrong type throw errors.
+    bool isErrorThrown = false;
+
+    try
+    {
+        configurationTable.getInteger( "semiMajorAxis" );
+    }
+
+    catch ( std::runtime_error& error )
+    {
+        isErrorThrown = true;
+    }
+
+    BOOST_CHECK( isErrorThrown );
+
+    isErrorThrown = false;
+
+    try
+    {
+        configurationTable.getDouble( "eccentricity" );
+    }
+
+    catch ( std::runtime_error& error )
+    {
+        isErrorThrown = true;
+    }
+
+    BOOST_CHECK( isErrorThrown );
+}
+
+//! Test validation of correct configuration.
+BOOST_AUTO_TEST_CASE( testConfigurationTableValidationSuccess )
+{
+    input_output::ConfigurationTable configurationTable(
+                "numberOfBodies = 10\nsemiMajorAxis = 7.0e6\nisOutputWritten = off" );
+
+    configurationTable.declareIntegerParameter( "numberOfBodies", 1, 100 );
+    configurationTable.declareDoubleParameter( "semiMajorAxis", 6.378e6 );
+    configurationTable.declareBooleanParameter( "isOutputWritten" );
+    configurationTable.declareStringParameter( "outputFileName", false );
+
+    // Check that no error is thrown.
+    bool isErrorThrown = false;
+
+    try
+    {
+        configurationTable.validate( );
+    }
+
+    catch ( std::runtime_error& error )
+    {
+        isErrorThrown = true;
+    }
+
+    BOOST_CHECK( !isErrorThrown );
+    BOOST_CHECK_EQUAL( configurationTable.getBoolean( "isOutputWritten" ), false );
+}
+
+//! Test that validation reports all errors in one pass.
+BOOST_AUTO_TEST_CASE( testConfigurationTableValidationErrors )
+{
+    input_output::ConfigurationTable configurationTable(
+                "numberOfBodies = 1000\nsemiMajorAxis = abc\nisOutputWritten = maybe\n"
+                "eccentricty = 0.1\nnumberOfBodies = 2\nmissingValue =" );
+
+    configurationTable.declareIntegerParameter( "numberOfBodies", 1, 100 );
+    configurationTable.declareDoubleParameter( "semiMajorAxis" );
+    configurationTable.declareBooleanParameter( "isOutputWritten" );
+    configurationTable.declareDoubleParameter( "eccentricity", 0.0, 1.0 );
+
+    // Validate configuration and catch error message.
+    std::string errorMessage;
+
+    try
+    {
+        configurationTable.validate( );
+    }
+
+    catch ( std::runtime_error& error )
+    {
+        errorMessage = error.what( );
+    }
+
+    // Check that all errors are reported in a single error message.
+    BOOST_CHECK( errorMessage.find( "7 error(s)" ) != std::string::npos );
+    BOOST_CHECK( errorMessage.find( "Line 5: numberOfBodies is given more than once." )
+                 != std::string::npos );
+    BOOST_CHECK( errorMessage.find( "Line 6: no value given for missingValue." )
+                 != std::string::npos );
+    BOOST_CHECK( errorMessage.find( "numberOfBodies is: 1000, which is greater than 100." )
+                 != std::string::npos );
+    BOOST_CHECK( errorMessage.find( "semiMajorAxis is: abc, which is not a number." )
+                 != std::string::npos );
+    BOOST_CHECK( errorMessage.find( "isOutputWritten is: maybe, which is not a boolean." )
+                 != std::string::npos );
+    BOOST_CHECK( errorMessage.find( "eccentricity is missing." ) != std::string::npos );
+    BOOST_CHECK( errorMessage.find( "eccentricty is not a known parameter." )
+                 != std::string::npos );
+}
+
+//! Test that syntax errors are reported with line numbers of unfiltered data.
+BOOST_AUTO_TEST_CASE( testConfigurationTableLineNumbers )
+{
+    input_output::ConfigurationTable configurationTable(
+                "# Comment line.\n\nnumberOfBodies = 1000 # Trailing comment.\n\n"
+                "# Another comment line.\nnumberOfBodies = 2\nmissingValue = # Comment.", '#' );
+
+    // Validate configuration and catch error message.
+    std::string errorMessage;
+
+    try
+    {
+        configurationTable.validate( );
+    }
+
+    catch ( std::runtime_error& error )
+    {
+        errorMessage = error.what( );
+    }
+
+    // Check that line numbers count comment and blank lines.
+    BOOST_CHECK( errorMessage.find( "Line 6: numberOfBodies is given more than once." )
+                 != std::string::npos );
+    BOOST_CHECK( errorMessage.find( "Line 7: no value given for missingValue." )
+                 != std::string::npos );
+}
+
+//! Test loading of configuration table through binary cache file.
+BOOST_AUTO_TEST_CASE( testConfigurationTableCache )
+{
+    // Copy test configuration file to temporary directory.
+    const boost::filesystem::path temporaryDirectory
+            = boost::filesystem::temp_directory_path( )
+            / boost::filesystem::unique_path( "assist-%%%%-%%%%-%%%%" );
+    boost::filesystem::create_directory( temporaryDirectory );
+    const std::string inputFileName = ( temporaryDirectory / "configuration.txt" ).string( );
+    boost::filesystem::copy_file( input_output::getAssistRootPath( )
+                                  + "/InputOutput/UnitTests/testConfigurationFile.txt",
+                                  inputFileName );
+
+    // Load configuration table; this should write the cache file.
+    const input_output::ConfigurationTable parsedConfigurationTable
+            = input_output::loadConfigurationTable( inputFileName, '#', true );
+    BOOST_CHECK( boost::filesystem::exists( inputFileName + ".cache" ) );
+
+    // Read configuration table from cache, and check that it matches the parsed table.
+    input_output::ConfigurationTable cachedConfigurationTable;
+    BOOST_CHECK( cachedConfigurationTable.readCache( inputFileName + ".cache", inputFileName ) );
+    BOOST_CHECK_EQUAL( cachedConfigurationTable.getNumberOfParameters( ),
+                       parsedConfigurationTable.getNumberOfParameters( ) );
+    BOOST_CHECK_EQUAL( cachedConfigurationTable.getInteger( "numberOfBodies" ), 1000 );
+    BOOST_CHECK_EQUAL( cachedConfigurationTable.getDouble( "semiMajorAxis" ), 7.0e6 );
+    BOOST_CHECK_EQUAL( cachedConfigurationTable.getBoolean( "isOutputWritten" ), true );
+    BOOST_CHECK_EQUAL( cachedConfigurationTable.getString( "outputFileName" ), "results.txt" );
+
+    // Check that the cache is rejected for a different comment character.
+    BOOST_CHECK( !cachedConfigurationTable.readCache(
+                     inputFileName + ".cache", inputFileName, '%' ) );
+
+    // Modify input file, and check that the stale cache is rejected and the file reparsed.
+    {
+        std::ofstream inputFileStream( inputFileName.c_str( ), std::ios::app );
+        inputFileStream << "eccentricity = 0.1\n";
+    }
+
+    BOOST_CHECK( !cachedConfigurationTable.readCache( inputFileName + ".cache", inputFileName ) );
+    BOOST_CHECK_EQUAL( input_output::loadConfigurationTable( inputFileName, '#', true )
+                       .getDouble( "eccentricity" ), 0.1 );
+
+    // Check that a cache written without a hash is rejected if the hash is to be checked.
+    BOOST_CHECK( !cachedConfigurationTable.readCache(
+                     inputFileName + ".cache", inputFileName, '#', true ) );
+
+    // Modify input file in place, without changing its size, and check that the stale cache is
+    // rejected based on the modification time (set explicitly, since the time stamps of some
+    // file systems are too coarse to tell edits in quick succession apart).
+    const std::time_t lastWriteTime = boost::filesystem::last_write_time( inputFileName );
+    replaceInFile( inputFileName, "1000", "2000" );
+    boost::filesystem::last_write_time( inputFileName, lastWriteTime + 10 );
+    BOOST_CHECK( !cachedConfigurationTable.readCache( inputFileName + ".cache", inputFileName ) );
+    BOOST_CHECK_EQUAL( input_output::loadConfigurationTable( inputFileName, '#', true )
+                       .getInteger( "numberOfBodies" ), 2000 );
+
+    // Write cache with hash, modify input file in place, without changing its size, and restore
+    // its modification time, which a check of size and modification time cannot detect. Check
+    // that the stale cache is rejected based on the hash.
+    boost::filesystem::last_write_time( inputFileName, lastWriteTime + 20 );
+    BOOST_CHECK_EQUAL( input_output::loadConfigurationTable( inputFileName, '#', true, true )
+                       .getInteger( "numberOfBodies" ), 2000 );
+    BOOST_CHECK( cachedConfigurationTable.readCache(
+                     inputFileName + ".cache", inputFileName, '#', true ) );
+
+    replaceInFile( inputFileName, "2000", "3000" );
+    boost::filesystem::last_write_time( inputFileName, lastWriteTime + 20 );
+    BOOST_CHECK( cachedConfigurationTable.readCache( inputFileName + ".cache", inputFileName ) );
+    BOOST_CHECK( !cachedConfigurationTable.readCache(
+                     inputFileName + ".cache", inputFileName, '#', true ) );
+    BOOST_CHECK_EQUAL( input_output::loadConfigurationTable( inputFileName, '#', true, true )
+                       .getInteger( "numberOfBodies" ), 3000 );
+
+    boost::filesystem::remove_all( temporaryDirectory );
+}
+
+//! Test that a run-time error is thrown for an input file that cannot be read.
+BOOST_AUTO_TEST_CASE( testConfigurationTableMissingInputFile )
+{
+    // Declare error flags.
+    bool isErrorThrownForMissingInputFile = false;
+    bool isErrorThrownForMissingInputFileWithCache = false;
+
+    const std::string inputFileName = ( boost::filesystem::temp_directory_path( )
+                                        / boost::filesystem::unique_path(
+                                            "assist-%%%%-%%%%-%%%%.txt" ) ).string( );
+
+    // Try to load configuration table from missing input file.
+    try
+    {
+        input_output::loadConfigurationTable( inputFileName );
+    }
+
+    catch ( std::runtime_error& )
+    {
+        isErrorThrownForMissingInputFile = true;
+    }
+
+    // Try to load configuration table from missing input file, using the cache.
+    try
+    {
+        input_output::loadConfigurationTable( inputFileName, '#', true );
+    }
+
+    catch ( std::runtime_error& )
+    {
+        isErrorThrownForMissingInputFileWithCache = true;
+    }
+
+    // Check that errors were thrown, and that no cache was written.
+    BOOST_CHECK( isErrorThrownForMissingInputFile );
+    BOOST_CHECK( isErrorThrownForMissingInputFileWithCache );
+    BOOST_CHECK( !boost::filesystem::exists( inputFileName + ".cache" ) );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace assist
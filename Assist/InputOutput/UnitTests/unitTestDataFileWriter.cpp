@@ -0,0 +1,251 @@
+/*
+ *    Copyright (c) 2010-2014, Delft University of Technology
+ *    Copyright (c) 2010-2014, K. Kumar (me@kartikkumar.com)
+ *    All rights reserved.
+ *    See http://bit.ly/1jern3m for license details.
+ */
+
+#include <clocale>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#include <boost/cstdint.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "Assist/Basics/commonTypedefs.h"
+
+#include "Assist/InputOutput/basicInputOutput.h"
+#include "Assist/InputOutput/dataFileWriter.h"
+
+namespace assist
+{
+namespace unit_tests
+{
+
+namespace
+{
+
+//! Get path to unique temporary file.
+std::string getTemporaryFilePath( )
+{
+    return ( boost::filesystem::temp_directory_path( )
+             / boost::filesystem::unique_path( "assist-%%%%-%%%%-%%%%.txt" ) ).string( );
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE( test_data_file_writer )
+
+//! Test formatting of doubles with known shortest representations.
+BOOST_AUTO_TEST_CASE( testConvertDoubleToStringFunction )
+{
+    using input_output::convertDoubleToString;
+
+    BOOST_CHECK_EQUAL( convertDoubleToString( 0.0 ), "0" );
+    BOOST_CHECK_EQUAL( convertDoubleToString( -0.0 ), "-0" );
+    BOOST_CHECK_EQUAL( convertDoubleToString( 1.0 ), "1" );
+    BOOST_CHECK_EQUAL( convertDoubleToString( 0.1 ), "0.1" );
+    BOOST_CHECK_EQUAL( convertDoubleToString( -2.5 ), "-2.5" );
+    BOOST_CHECK_EQUAL( convertDoubleToString( 1200.0 ), "1200" );
+    BOOST_CHECK_EQUAL( convertDoubleToString( 123456.789 ), "123456.789" );
+    BOOST_CHECK_EQUAL( convertDoubleToString( 0.00001234 ), "0.00001234" );
+    BOOST_CHECK_EQUAL( convertDoubleToString( 1.234e-6 ), "1.234e-6" );
+    BOOST_CHECK_EQUAL( convertDoubleToString( 1.0e21 ), "1e21" );
+    BOOST_CHECK_EQUAL( convertDoubleToString( 3.0e-7 ), "3e-7" );
+    BOOST_CHECK_EQUAL( convertDoubleToString( 1.0 / 3.0 ), "0.3333333333333333" );
+    BOOST_CHECK_EQUAL( convertDoubleToString( std::numeric_limits< double >::max( ) ),
+                       "1.7976931348623157e308" );
+    BOOST_CHECK_EQUAL( convertDoubleToString( std::numeric_limits< double >::denorm_min( ) ),
+                       "5e-324" );
+    BOOST_CHECK_EQUAL( convertDoubleToString( std::numeric_limits< double >::infinity( ) ),
+                       "inf" );
+    BOOST_CHECK_EQUAL( convertDoubleToString( -std::numeric_limits< double >::infinity( ) ),
+                       "-inf" );
+    BOOST_CHECK_EQUAL( convertDoubleToString( std::numeric_limits< double >::quiet_NaN( ) ),
+                       "nan" );
+}
+
+//! Test that formatted doubles round-trip exactly for random bit patterns.
+BOOST_AUTO_TEST_CASE( testConvertDoubleToStringRoundTrip )
+{
+    boost::mt19937 randomNumberGenerator( 42 );
+
+    for ( unsigned int i = 0; i < 200000; i++ )
+    {
+        // Generate random bit pattern, and interpret as double.
+        const boost::uint64_t bits
+                = ( static_cast< boost::uint64_t >( randomNumberGenerator( ) ) << 32 )
+                | randomNumberGenerator( );
+        double value = 0.0;
+        std::memcpy( &value, &bits, sizeof( double ) );
+
+        if ( value != value )
+        {
+            continue;
+        }
+
+        const std::string formattedValue = input_output::convertDoubleToString( value );
+        BOOST_REQUIRE_LE( formattedValue.size( ), input_output::MAXIMUM_DOUBLE_STRING_LENGTH );
+
+        const double parsedValue = std::strtod( formattedValue.c_str( ), 0 );
+        BOOST_REQUIRE_MESSAGE( std::memcmp( &parsedValue, &value, sizeof( double ) ) == 0,
+                               "Round-trip failed for " << formattedValue );
+    }
+}
+
+//! Test that double-key, double-value map is written and read back losslessly.
+BOOST_AUTO_TEST_CASE( testWriteDoubleKeyDoubleValueMapRoundTrip )
+{
+    // Set data map, with values that are not exactly representable in decimal.
+    basics::DoubleKeyDoubleValueMap dataMap;
+    for ( unsigned int i = 0; i < 1000; i++ )
+    {
+        dataMap[ i * 0.1 ] = 1.0 / ( i + 3.0 ) - 1.0e-9 * i;
+    }
+
+    // Write data map with header, and read it back in.
+    const std::string outputFileName = getTemporaryFilePath( );
+    input_output::writeDoubleKeyDoubleValueMap( outputFileName, dataMap,
+                                                "Test output\nkey,value" );
+
+    const basics::DoubleKeyDoubleValueMap parsedDataMap
+            = input_output::parseDoubleKeyDoubleValueMap(
+                input_output::readAndFilterInputFile( outputFileName ) );
+    boost::filesystem::remove( outputFileName );
+
+    // Check that data map is recovered exactly.
+    BOOST_REQUIRE_EQUAL( parsedDataMap.size( ), dataMap.size( ) );
+    BOOST_CHECK( parsedDataMap == dataMap );
+}
+
+//! Test that double-key, Vector6d-value map is written and read back losslessly.
+BOOST_AUTO_TEST_CASE( testWriteDoubleKeyVector6dValueMapRoundTrip )
+{
+    // Set state history.
+    basics::DoubleKeyVector6dValueMap stateHistory;
+    for ( unsigned int i = 0; i < 100; i++ )
+    {
+        tudat::basic_mathematics::Vector6d state;
+        state << 7.0e6 * std::cos( i * 0.01 ), 7.0e6 * std::sin( i * 0.01 ), 1.0 / ( i + 1.0 ),
+                -7.5e3 * std::sin( i * 0.01 ), 7.5e3 * std::cos( i * 0.01 ), -1.0e-12 * i;
+        stateHistory[ 86400.0 * i / 7.0 ] = state;
+    }
+
+    // Write state history with custom delimiter and comment character, and read it back in.
+    const std::string outputFileName = getTemporaryFilePath( );
+    input_output::writeDoubleKeyVector6dValueMap( outputFileName, stateHistory,
+                                                  "State history", ' ', '%' );
+
+    const basics::DoubleKeyVector6dValueMap parsedStateHistory
+            = input_output::parseDoubleKeyVector6dValueMap(
+                input_output::readAndFilterInputFile( outputFileName, '%' ) );
+    boost::filesystem::remove( outputFileName );
+
+    // Check that state history is recovered exactly.
+    BOOST_REQUIRE_EQUAL( parsedStateHistory.size( ), stateHistory.size( ) );
+
+    basics::DoubleKeyVector6dValueMap::const_iterator iteratorParsed
+            = parsedStateHistory.begin( );
+    for ( basics::DoubleKeyVector6dValueMap::const_iterator iteratorState
+          = stateHistory.begin( ); iteratorState != stateHistory.end( );
+          iteratorState++, iteratorParsed++ )
+    {
+        BOOST_CHECK_EQUAL( iteratorParsed->first, iteratorState->first );
+        BOOST_CHECK( iteratorParsed->second == iteratorState->second );
+    }
+}
+
+//! Test that parse functions throw a run-time error for malformed data.
+BOOST_AUTO_TEST_CASE( testParseFunctionsRunTimeError )
+{
+    // Check that a well-formed string is parsed with mixed delimiters.
+    const basics::DoubleKeyVector3dValueMap parsedDataMap
+            = input_output::parseDoubleKeyVector3dValueMap( "1.0, 2.0 3.0,\t4.0\n2, 3, 4, 5" );
+    BOOST_CHECK_EQUAL( parsedDataMap.size( ), 2 );
+    BOOST_CHECK_EQUAL( parsedDataMap.find( 2.0 )->second.z( ), 5.0 );
+
+    // Check that too few columns, too many columns and non-numerical data throw errors.
+    const char* malformedData[ 3 ] = { "1.0, 2.0\n3.0", "1.0, 2.0, 3.0", "1.0, abc" };
+
+    for ( unsigned int i = 0; i < 3; i++ )
+    {
+        bool isErrorThrown = false;
+
+        try
+        {
+            input_output::parseDoubleKeyDoubleValueMap( malformedData[ i ] );
+        }
+
+        catch ( std::runtime_error& error )
+        {
+            isErrorThrown = true;
+        }
+
+        BOOST_CHECK( isErrorThrown );
+    }
+}
+
+//! Test that parse functions use '.' as decimal point, independent of the C locale.
+BOOST_AUTO_TEST_CASE( testParseFunctionsLocale )
+{
+    // Set C locale with comma as decimal point, if one is installed.
+    const std::string originalLocale = std::setlocale( LC_NUMERIC, 0 );
+    const char* localeNames[ 4 ] = { "de_DE.UTF-8", "de_DE", "nl_NL.UTF-8", "fr_FR.UTF-8" };
+    bool isLocaleSet = false;
+    for ( unsigned int i = 0; i < 4 && !isLocaleSet; i++ )
+    {
+        isLocaleSet = std::setlocale( LC_NUMERIC, localeNames[ i ] ) != 0;
+    }
+
+    if ( !isLocaleSet )
+    {
+        BOOST_TEST_MESSAGE( "No locale with comma as decimal point installed; using C locale." );
+    }
+
+    // Check that data written with '.' as decimal point is parsed exactly.
+    const basics::DoubleKeyDoubleValueMap parsedDataMap
+            = input_output::parseDoubleKeyDoubleValueMap( "0.5, 1.25\n-2.5e-3 3.0625" );
+    std::setlocale( LC_NUMERIC, originalLocale.c_str( ) );
+
+    BOOST_REQUIRE_EQUAL( parsedDataMap.size( ), 2 );
+    BOOST_CHECK_EQUAL( parsedDataMap.find( 0.5 )->second, 1.25 );
+    BOOST_CHECK_EQUAL( parsedDataMap.find( -2.5e-3 )->second, 3.0625 );
+}
+
+//! Test that data file writer throws a run-time error for delimiters that can occur in doubles.
+BOOST_AUTO_TEST_CASE( testDataFileWriterInvalidDelimiter )
+{
+    const std::string outputFileName = getTemporaryFilePath( );
+    const char invalidDelimiters[ 6 ] = { '.', '-', '+', 'e', '7', '\n' };
+
+    for ( unsigned int i = 0; i < 6; i++ )
+    {
+        bool isErrorThrown = false;
+
+        try
+        {
+            input_output::DataFileWriter writer( outputFileName, invalidDelimiters[ i ] );
+        }
+
+        catch ( std::runtime_error& error )
+        {
+            isErrorThrown = true;
+        }
+
+        BOOST_CHECK( isErrorThrown );
+    }
+
+    // Check that output file was not created.
+    BOOST_CHECK( !boost::filesystem::exists( outputFileName ) );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace assist
@@ -0,0 +1,150 @@
+/*
+ *    Copyright (c) 2010-2014, Delft University of Technology
+ *    Copyright (c) 2010-2014, K. Kumar (me@kartikkumar.com)
+ *    All rights reserved.
+ *    See http://bit.ly/1jern3m for license details.
+ */
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "Assist/Basics/commonTypedefs.h"
+
+#include "Assist/InputOutput/incrementalInputFileReader.h"
+
+namespace assist
+{
+namespace unit_tests
+{
+
+namespace
+{
+
+//! Append text to file.
+void appendToFile( const std::string& fileName, const std::string& text )
+{
+    std::ofstream fileStream( fileName.c_str( ), std::ios::out | std::ios::app | std::ios::binary );
+    fileStream << text;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE( test_incremental_input_file_reader )
+
+//! Test incremental reading of growing file, including partial lines and rotation.
+BOOST_AUTO_TEST_CASE( testIncrementalInputFileReader )
+{
+    // Set up temporary directory for log file.
+    const boost::filesystem::path temporaryDirectory
+            = boost::filesystem::temp_directory_path( )
+            / boost::filesystem::unique_path( "assist-%%%%-%%%%-%%%%" );
+    boost::filesystem::create_directory( temporaryDirectory );
+    const std::string logFileName = ( temporaryDirectory / "log.txt" ).string( );
+
+    input_output::IncrementalInputFileReader reader( logFileName );
+
+    // Check that a non-existent file yields no data.
+    BOOST_CHECK_EQUAL( reader.readNewData( ), "" );
+
+    // Write header and first complete line, plus a partial line.
+    appendToFile( logFileName, "# Epoch, value\n0.0, 1.0\n1.0, 2." );
+    BOOST_CHECK_EQUAL( reader.readNewData( ), "0.0, 1.0" );
+    BOOST_CHECK_EQUAL( reader.getOffset( ), 31 );
+
+    // Check that polling without new data yields no data.
+    BOOST_CHECK_EQUAL( reader.readNewData( ), "" );
+
+    // Complete partial line, and add a comment and another line.
+    appendToFile( logFileName, "5\n# Comment\n2.0, 3.0\n" );
+    BOOST_CHECK_EQUAL( reader.readNewData( ), "1.0, 2.5\n2.0, 3.0" );
+
+    // Append samples, and feed them into step-function map.
+    basics::DoubleKeyDoubleValueMap stepFunction;
+    std::vector< std::string > unparsableLines;
+    appendToFile( logFileName, "3.0, 4.0\n4.0, 5.0\n5.0" );
+    BOOST_CHECK_EQUAL( reader.readNewSamples( stepFunction, unparsableLines ), 2 );
+    appendToFile( logFileName, ", 6.0\n" );
+    BOOST_CHECK_EQUAL( reader.readNewSamples( stepFunction, unparsableLines ), 1 );
+    BOOST_CHECK( unparsableLines.empty( ) );
+    BOOST_REQUIRE_EQUAL( stepFunction.size( ), 3 );
+    BOOST_CHECK_EQUAL( stepFunction[ 3.0 ], 4.0 );
+    BOOST_CHECK_EQUAL( stepFunction[ 5.0 ], 6.0 );
+    BOOST_CHECK_EQUAL( reader.getNumberOfRestarts( ), 0 );
+
+    // Rotate log file: move it away and start a new one. The old file is kept, so that the new
+    // file is guaranteed to get a different inode.
+    boost::filesystem::rename( logFileName, logFileName + ".1" );
+    appendToFile( logFileName, "6.0, 7.0\n" );
+    BOOST_CHECK_EQUAL( reader.readNewData( ), "6.0, 7.0" );
+    BOOST_CHECK_EQUAL( reader.getNumberOfRestarts( ), 1 );
+
+    // Truncate log file, and check that reading starts again from the beginning.
+    {
+        std::ofstream fileStream( logFileName.c_str( ), std::ios::out | std::ios::trunc );
+        fileStream << "7\n";
+    }
+    BOOST_CHECK_EQUAL( reader.readNewData( ), "7" );
+    BOOST_CHECK_EQUAL( reader.getNumberOfRestarts( ), 2 );
+
+    boost::filesystem::remove_all( temporaryDirectory );
+}
+
+//! Test incremental reading of samples, including malformed lines, duplicates and restarts.
+BOOST_AUTO_TEST_CASE( testIncrementalInputFileReaderSamples )
+{
+    // Set up temporary directory for log file.
+    const boost::filesystem::path temporaryDirectory
+            = boost::filesystem::temp_directory_path( )
+            / boost::filesystem::unique_path( "assist-%%%%-%%%%-%%%%" );
+    boost::filesystem::create_directory( temporaryDirectory );
+    const std::string logFileName = ( temporaryDirectory / "log.txt" ).string( );
+
+    input_output::IncrementalInputFileReader reader( logFileName );
+    basics::DoubleKeyDoubleValueMap stepFunction;
+    std::vector< std::string > unparsableLines;
+
+    // Append samples with a line that cannot be parsed in between, and check that the line is
+    // skipped and returned, without holding up the lines after it.
+    appendToFile( logFileName, "0.0, 1.0\n1.0\n2.0, 3.0\n" );
+    BOOST_CHECK_EQUAL( reader.readNewSamples( stepFunction, unparsableLines ), 2 );
+    BOOST_REQUIRE_EQUAL( unparsableLines.size( ), 1 );
+    BOOST_CHECK_EQUAL( unparsableLines.front( ), "1.0" );
+    BOOST_CHECK_EQUAL( reader.getOffset( ), 22 );
+
+    // Append more samples, and check that the malformed line is not read again.
+    appendToFile( logFileName, "1.0, 2.0\n" );
+    BOOST_CHECK_EQUAL( reader.readNewSamples( stepFunction, unparsableLines ), 1 );
+    BOOST_CHECK( unparsableLines.empty( ) );
+    BOOST_CHECK_EQUAL( stepFunction[ 1.0 ], 2.0 );
+
+    // Append samples with duplicate keys in a single chunk, and check that the last sample wins.
+    appendToFile( logFileName, "4.0, 5.0\n4.0, 6.0\n2.0, 7.0\n" );
+    BOOST_CHECK_EQUAL( reader.readNewSamples( stepFunction, unparsableLines ), 1 );
+    BOOST_CHECK_EQUAL( stepFunction[ 4.0 ], 6.0 );
+    BOOST_CHECK_EQUAL( stepFunction[ 2.0 ], 7.0 );
+    BOOST_CHECK_EQUAL( reader.getNumberOfRestarts( ), 0 );
+
+    // Truncate log file and write samples with changed values, and check that the values are
+    // overwritten, without counting the keys that were already present.
+    {
+        std::ofstream fileStream( logFileName.c_str( ), std::ios::out | std::ios::trunc );
+        fileStream << "0.0, 10.0\n3.0, 4.0\n";
+    }
+    BOOST_CHECK_EQUAL( reader.readNewSamples( stepFunction, unparsableLines ), 1 );
+    BOOST_CHECK_EQUAL( reader.getNumberOfRestarts( ), 1 );
+    BOOST_REQUIRE_EQUAL( stepFunction.size( ), 5 );
+    BOOST_CHECK_EQUAL( stepFunction[ 0.0 ], 10.0 );
+    BOOST_CHECK_EQUAL( stepFunction[ 2.0 ], 7.0 );
+    BOOST_CHECK_EQUAL( stepFunction[ 3.0 ], 4.0 );
+
+    boost::filesystem::remove_all( temporaryDirectory );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace assist
@@ -5,14 +5,15 @@
  *    See http://bit.ly/1jern3m for license details.
  */
 
+#include <clocale>
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
+#include <sstream>
 #include <stdexcept>
 
 #include <boost/algorithm/string.hpp>
 #include <boost/exception/all.hpp>
-#include <boost/iostreams/filtering_stream.hpp>
-
-#include <TudatCore/InputOutput/streamFilters.h>
 
 #include "Assist/InputOutput/basicInputOutput.h"
 
@@ -21,6 +22,173 @@ namespace assist
 namespace input_output
 {
 
+namespace
+{
+
+//! Check if character is a column delimiter.
+bool isDelimiter( const char character )
+{
+    return character == ',' || character == ' ' || character == '\t' || character == '\r';
+}
+
+//! Parse double with '.' as decimal point, independent of C locale.
+/*!
+ * Parses a double at a given position with std::strtod(), which uses the decimal point of the
+ * current C locale. If that is not '.', which is the decimal point written by DataFileWriter,
+ * the column (up to the next delimiter or the end of the line) is copied with '.' replaced by the
+ * decimal point of the locale first. If the column cannot be parsed completely, the end of the
+ * parsed double is set to the given position.
+ */
+double parseDouble( const char* position, const char* lineEnd, const char* decimalPoint,
+                    const char*& valueEnd )
+{
+    char* end = 0;
+    if ( std::strcmp( decimalPoint, "." ) == 0 )
+    {
+        const double value = std::strtod( position, &end );
+        valueEnd = end;
+        return value;
+    }
+
+    const char* columnEnd = position;
+    std::string column;
+    while ( columnEnd < lineEnd && !isDelimiter( *columnEnd ) )
+    {
+        if ( *columnEnd == '.' )
+        {
+            column += decimalPoint;
+        }
+
+        else
+        {
+            column += *columnEnd;
+        }
+
+        columnEnd++;
+    }
+
+    const double value = std::strtod( column.c_str( ), &end );
+    valueEnd = ( end == column.c_str( ) + column.size( ) ) ? columnEnd : position;
+    return value;
+}
+
+//! Parse fixed number of delimited columns of doubles from each line of filtered data.
+/*!
+ * Parses a fixed number of columns of doubles from each line of filtered data and passes them to
+ * a given row handler. Columns may be separated by commas and/or whitespace. Doubles are parsed
+ * with '.' as decimal point, independent of the C locale (see parseDouble()).
+ */
+template< int NumberOfColumns, typename RowHandler >
+void parseColumns( const std::string& filteredData, RowHandler& rowHandler )
+{
+    double values[ NumberOfColumns ];
+
+    // Get decimal point of C locale once, since it is the same for all columns.
+    const char* const decimalPoint = std::localeconv( )->decimal_point;
+
+    const char* position = filteredData.c_str( );
+    const char* const dataEnd = position + filteredData.size( );
+    unsigned int lineNumber = 0;
+
+    while ( position < dataEnd )
+    {
+        lineNumber++;
+
+        const char* lineEnd = position;
+        while ( lineEnd < dataEnd && *lineEnd != '\n' )
+        {
+            lineEnd++;
+        }
+
+        int numberOfValues = 0;
+        while ( true )
+        {
+            // Skip delimiters; std::strtod() cannot be used for this since it also skips newlines.
+            while ( position < lineEnd && isDelimiter( *position ) )
+            {
+                position++;
+            }
+
+            if ( position == lineEnd )
+            {
+                break;
+            }
+
+            const char* valueEnd = 0;
+            const double value = parseDouble( position, lineEnd, decimalPoint, valueEnd );
+
+            if ( valueEnd == position || valueEnd > lineEnd || numberOfValues == NumberOfColumns )
+            {
+                numberOfValues = -1;
+                break;
+            }
+
+            values[ numberOfValues++ ] = value;
+            position = valueEnd;
+        }
+
+        if ( numberOfValues != NumberOfColumns )
+        {
+            std::ostringstream errorMessage;
+            errorMessage << "Error: could not parse " << NumberOfColumns
+                         << " columns on line " << lineNumber << " of filtered data.";
+            boost::throw_exception(
+                        boost::enable_error_info( std::runtime_error( errorMessage.str( ) ) ) );
+        }
+
+        rowHandler( values );
+        position = lineEnd + 1;
+    }
+}
+
+//! Row handler that inserts parsed rows into a map, appending at the end when keys are sorted.
+/*!
+ * Row handler that inserts parsed rows into a map, with a hint at the end of the map, which is
+ * amortized O(1) for sorted keys. For duplicate keys, the last row wins.
+ */
+template< typename MapType, int NumberOfValueColumns >
+struct InsertRowIntoMap
+{
+    //! Constructor taking map to insert rows into.
+    InsertRowIntoMap( MapType& aDataMap ) : dataMap( aDataMap ) { }
+
+    //! Insert row into map.
+    void operator( )( const double* values )
+    {
+        typename MapType::mapped_type value;
+        assignValue( value, values + 1 );
+        dataMap.insert( dataMap.end( ), std::make_pair( values[ 0 ], value ) )->second = value;
+    }
+
+    //! Assign scalar value.
+    static void assignValue( double& value, const double* values ) { value = values[ 0 ]; }
+
+    //! Assign vector value.
+    template< typename VectorType >
+    static void assignValue( VectorType& value, const double* values )
+    {
+        for ( int i = 0; i < NumberOfValueColumns; i++ )
+        {
+            value( i ) = values[ i ];
+        }
+    }
+
+    //! Map to insert rows into.
+    MapType& dataMap;
+};
+
+//! Parse map with given number of value columns from filtered data.
+template< typename MapType, int NumberOfValueColumns >
+MapType parseDoubleKeyMap( const std::string& filteredData )
+{
+    MapType dataMap;
+    InsertRowIntoMap< MapType, NumberOfValueColumns > rowHandler( dataMap );
+    parseColumns< NumberOfValueColumns + 1 >( filteredData, rowHandler );
+    return dataMap;
+}
+
+} // namespace
+
 //! Check number of input arguments.
 void checkNumberOfInputArguments( const int numberOfInputArguments,
                                   const int requiredNumberOfInputArguments )
@@ -44,50 +212,83 @@ void checkNumberOfInputArguments( const int numberOfInputArguments,
     }
 }
 
-//! Read in input file and filters out comment lines.
-std::string readAndFilterInputFile( const std::string& inputFileName, const char commentCharacter )
+//! Filter comments and blank lines out of data.
+std::string filterCommentsAndBlankLines( const std::string& unfilteredData,
+                                         const char commentCharacter )
 {
-    // Create input file stream.
-    std::ifstream inputFileStream( inputFileName.c_str( ) );
+    // Declare filtered data string; it can never be larger than the unfiltered data.
+    std::string filteredData;
+    filteredData.reserve( unfilteredData.size( ) );
 
-    // Declare filtered data string.
-    std::string unfilteredData;
+    const char* const dataBegin = unfilteredData.data( );
+    const char* const dataEnd = dataBegin + unfilteredData.size( );
 
-    // Declare line data string.
-    std::string line;
+    // Set start of current line, and start of run of consecutive, uncommented lines that hasn't
+    // been copied to the filtered data yet.
+    const char* lineStart = dataBegin;
+    const char* runStart = dataBegin;
 
-    // Read input file line-by-line and store in unfilteredData.
-    if ( inputFileStream.is_open( ) )
+    // Set position of next comment character at or after the start of the current line. The
+    // comment character is searched for over the remaining data, rather than per line, so that
+    // the data is scanned only once, regardless of the number of comment characters in it.
+    const char* nextComment = dataBegin;
+    bool isNextCommentFound = false;
+
+    while ( lineStart < dataEnd )
     {
-        while ( std::getline( inputFileStream, line ) )
+        // Find end of line.
+        const char* lineEnd = static_cast< const char* >(
+                    std::memchr( lineStart, '\n', dataEnd - lineStart ) );
+        if ( lineEnd == 0 )
         {
-            if ( !line.empty( ) )
+            lineEnd = dataEnd;
+        }
+
+        // Find next comment character, if the last one found lies before this line.
+        if ( !isNextCommentFound || nextComment < lineStart )
+        {
+            nextComment = static_cast< const char* >(
+                        std::memchr( lineStart, commentCharacter, dataEnd - lineStart ) );
+            if ( nextComment == 0 )
             {
-                unfilteredData += line + "\n";
+                nextComment = dataEnd;
             }
+            isNextCommentFound = true;
         }
-    }
-
-    // Close input file.
-    inputFileStream.close( );
 
-    // Create filter processor to filter out comment lines.
-    boost::iostreams::filtering_ostream filterProcessor;
+        // Extend run if line is not empty and doesn't contain a comment.
+        if ( nextComment >= lineEnd && lineEnd != lineStart )
+        {
+            if ( lineEnd == dataEnd )
+            {
+                filteredData.append( runStart, lineEnd - runStart );
+                filteredData += '\n';
+                runStart = dataEnd;
+            }
+        }
 
-    // Add remove comment lines filter.
-    filterProcessor.push( tudat::input_output::stream_filters::RemoveComment( commentCharacter ) );
+        // Else, copy run so far and the uncommented part of this line (if any).
+        else
+        {
+            filteredData.append( runStart, lineStart - runStart );
 
-    // Create filtered data string.
-    std::string filteredData;
+            if ( nextComment > lineStart && lineEnd != lineStart )
+            {
+                filteredData.append( lineStart, nextComment - lineStart );
+                filteredData += '\n';
+            }
 
-    // Last step in the chain; store the resulting string in filteredData.
-    filterProcessor.push( boost::iostreams::back_inserter( filteredData ) );
+            runStart = ( lineEnd == dataEnd ) ? dataEnd : lineEnd + 1;
+        }
 
-    // Push in unfiltered data.
-    filterProcessor << unfilteredData;
+        lineStart = ( lineEnd == dataEnd ) ? dataEnd : lineEnd + 1;
+    }
 
-    // Make sure the data is processed by the chain.
-    filterProcessor.flush( );
+    // Copy remaining run, which ends with a newline.
+    if ( runStart < dataEnd )
+    {
+        filteredData.append( runStart, dataEnd - runStart );
+    }
 
     // Trim all stray characters.
     boost::trim( filteredData );
@@ -96,5 +297,56 @@ std::string readAndFilterInputFile( const std::string& inputFileName, const char
     return filteredData;
 }
 
+//! Read in input file and filters out comment lines.
+std::string readAndFilterInputFile( const std::string& inputFileName, const char commentCharacter )
+{
+    // Create input file stream.
+    std::ifstream inputFileStream( inputFileName.c_str( ), std::ios::in | std::ios::binary );
+
+    // Declare unfiltered data string.
+    std::string unfilteredData;
+
+    // Read entire input file in one go and store in unfilteredData.
+    if ( inputFileStream.is_open( ) )
+    {
+        inputFileStream.seekg( 0, std::ios::end );
+        const std::streamoff fileSize = inputFileStream.tellg( );
+        inputFileStream.seekg( 0, std::ios::beg );
+
+        if ( fileSize > 0 )
+        {
+            unfilteredData.resize( static_cast< std::size_t >( fileSize ) );
+            inputFileStream.read( &unfilteredData[ 0 ], fileSize );
+            unfilteredData.resize( static_cast< std::size_t >( inputFileStream.gcount( ) ) );
+        }
+    }
+
+    // Close input file.
+    inputFileStream.close( );
+
+    // Filter out comment lines and blank lines.
+    return filterCommentsAndBlankLines( unfilteredData, commentCharacter );
+}
+
+//! Parse double-key, double-value map from filtered data.
+basics::DoubleKeyDoubleValueMap parseDoubleKeyDoubleValueMap( const std::string& filteredData )
+{
+    return parseDoubleKeyMap< basics::DoubleKeyDoubleValueMap, 1 >( filteredData );
+}
+
+//! Parse double-key, Vector3d-value map from filtered data.
+basics::DoubleKeyVector3dValueMap parseDoubleKeyVector3dValueMap(
+        const std::string& filteredData )
+{
+    return parseDoubleKeyMap< basics::DoubleKeyVector3dValueMap, 3 >( filteredData );
+}
+
+//! Parse double-key, Vector6d-value map from filtered data.
+basics::DoubleKeyVector6dValueMap parseDoubleKeyVector6dValueMap(
+        const std::string& filteredData )
+{
+    return parseDoubleKeyMap< basics::DoubleKeyVector6dValueMap, 6 >( filteredData );
+}
+
 } // namespace input_output
 } // namespace assist
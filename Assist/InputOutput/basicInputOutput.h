@@ -10,6 +10,8 @@
 
 #include <string>
 
+#include "Assist/Basics/commonTypedefs.h"
+
 namespace assist
 {
 namespace input_output
@@ -27,9 +29,25 @@ namespace input_output
 void checkNumberOfInputArguments( const int numberOfInputArguments,
                                   const int requiredNumberOfInputArguments = 1 );
 
+//! Filter comments and blank lines out of data.
+/*!
+ * Filters comments and blank lines out of data (ASCII). Each line is cut off at the first
+ * occurrence of the comment character; lines that are empty, or that start with the comment
+ * character, are removed entirely. Finally, leading and trailing whitespace is trimmed. Newline
+ * and comment character positions are found with std::memchr() over the whole data set, which is
+ * vectorized by the C library, and surviving runs of uncommented lines are copied in bulk.
+ * \param unfilteredData Unfiltered data as string.
+ * \param commentCharacter Comment character used to denote comment lines
+ *          (default is taken as '#').
+ * \return Filtered data as string.
+ */
+std::string filterCommentsAndBlankLines( const std::string& unfilteredData,
+                                         const char commentCharacter = '#' );
+
 //! Read in input file and filters out comment lines.
 /*!
- * Reads in an input file (ASCII) and filters out comment lines.
+ * Reads in an input file (ASCII) and filters out comment lines (see
+ * filterCommentsAndBlankLines()). The file is read in one go.
  * \param inputFileName input file name.
  * \param commentCharacter Comment character used to denote comment lines
  *          (default is taken as '#').
@@ -38,6 +56,46 @@ void checkNumberOfInputArguments( const int numberOfInputArguments,
 std::string readAndFilterInputFile( const std::string& inputFileName,
                                     const char commentCharacter = '#' );
 
+//! Parse double-key, double-value map from filtered data.
+/*!
+ * Parses a double-key, double-value map from filtered data (see readAndFilterInputFile()). Each
+ * line of the filtered data must contain exactly two columns (key and value), separated by
+ * commas and/or whitespace. This is the layout written by writeDoubleKeyDoubleValueMap(). Doubles
+ * are parsed with '.' as decimal point, independent of the C locale. For duplicate keys, the last
+ * line wins. Throws a run-time error if a line cannot be parsed.
+ * \param filteredData Filtered data as string.
+ * \return Map containing parsed keys and values.
+ */
+basics::DoubleKeyDoubleValueMap parseDoubleKeyDoubleValueMap( const std::string& filteredData );
+
+//! Parse double-key, Vector3d-value map from filtered data.
+/*!
+ * Parses a double-key, Vector3d-value map from filtered data (see readAndFilterInputFile()). Each
+ * line of the filtered data must contain exactly four columns (key and vector components),
+ * separated by commas and/or whitespace. This is the layout written by
+ * writeDoubleKeyVector3dValueMap(). Doubles are parsed with '.' as decimal point, independent of
+ * the C locale. For duplicate keys, the last line wins. Throws a run-time error if a line cannot
+ * be parsed.
+ * \param filteredData Filtered data as string.
+ * \return Map containing parsed keys and values.
+ */
+basics::DoubleKeyVector3dValueMap parseDoubleKeyVector3dValueMap(
+        const std::string& filteredData );
+
+//! Parse double-key, Vector6d-value map from filtered data.
+/*!
+ * Parses a double-key, Vector6d-value map from filtered data (see readAndFilterInputFile()). Each
+ * line of the filtered data must contain exactly seven columns (key and vector components),
+ * separated by commas and/or whitespace. This is the layout written by
+ * writeDoubleKeyVector6dValueMap(). Doubles are parsed with '.' as decimal point, independent of
+ * the C locale. For duplicate keys, the last line wins. Throws a run-time error if a line cannot
+ * be parsed.
+ * \param filteredData Filtered data as string.
+ * \return Map containing parsed keys and values.
+ */
+basics::DoubleKeyVector6dValueMap parseDoubleKeyVector6dValueMap(
+        const std::string& filteredData );
+
 } // namespace input_output
 } // namespace assist
 
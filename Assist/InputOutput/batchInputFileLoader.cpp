@@ -0,0 +1,226 @@
+/*
+ *    Copyright (c) 2010-2014, Delft University of Technology
+ *    Copyright (c) 2010-2014, K. Kumar (me@kartikkumar.com)
+ *    All rights reserved.
+ *    See http://bit.ly/1jern3m for license details.
+ */
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <boost/bind.hpp>
+#include <boost/exception/all.hpp>
+#include <boost/filesystem.hpp>
+
+#include "Assist/InputOutput/basicInputOutput.h"
+#include "Assist/InputOutput/batchInputFileLoader.h"
+#include "Assist/InputOutput/rootPath.h"
+
+namespace assist
+{
+namespace input_output
+{
+
+//! List input files in directory.
+std::vector< std::string > listInputFilesInDirectory( const std::string& directory,
+                                                      const std::string& fileExtension )
+{
+    // Resolve relative directories with respect to the Assist root-path.
+    boost::filesystem::path directoryPath( directory );
+    if ( directoryPath.is_relative( ) )
+    {
+        directoryPath = boost::filesystem::path( getAssistRootPath( ) ) / directoryPath;
+    }
+
+    // Check that the directory exists; else throw an error.
+    if ( !boost::filesystem::is_directory( directoryPath ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Error: directory " + directoryPath.string( )
+                            + " does not exist." ) ) );
+    }
+
+    // Collect all regular files with the required extension.
+    std::vector< std::string > inputFileNames;
+    for ( boost::filesystem::directory_iterator iteratorDirectory( directoryPath );
+          iteratorDirectory != boost::filesystem::directory_iterator( ); iteratorDirectory++ )
+    {
+        if ( boost::filesystem::is_regular_file( iteratorDirectory->status( ) )
+             && ( fileExtension.empty( )
+                  || iteratorDirectory->path( ).extension( ).string( ) == fileExtension ) )
+        {
+            inputFileNames.push_back( iteratorDirectory->path( ).string( ) );
+        }
+    }
+
+    // Directory iteration order is unspecified, so sort by name to get a reproducible batch.
+    std::sort( inputFileNames.begin( ), inputFileNames.end( ) );
+
+    return inputFileNames;
+}
+
+//! Constructor taking list of input files and prefetch settings.
+BatchInputFileLoader::BatchInputFileLoader( const std::vector< std::string >& someInputFileNames,
+                                            const unsigned int aPrefetchDepth,
+                                            const unsigned int aNumberOfThreads,
+                                            const char aCommentCharacter )
+    : inputFileNames( someInputFileNames ),
+      prefetchDepth( std::max( aPrefetchDepth, 1u ) ),
+      commentCharacter( aCommentCharacter ),
+      nextIndexToLoad( 0 ),
+      nextIndexToHandOut( 0 ),
+      isStopRequested( false )
+{
+    // There is no use in having more threads than files that may be loaded simultaneously.
+    const std::size_t numberOfThreads
+            = std::min( std::max< std::size_t >( aNumberOfThreads, 1 ),
+                        std::min( prefetchDepth, std::max< std::size_t >(
+                                      inputFileNames.size( ), 1 ) ) );
+
+    // Start I/O threads.
+    for ( std::size_t i = 0; i < numberOfThreads; i++ )
+    {
+        ioThreads.create_thread( boost::bind( &BatchInputFileLoader::loadInputFiles, this ) );
+    }
+}
+
+//! Destructor.
+BatchInputFileLoader::~BatchInputFileLoader( )
+{
+    {
+        boost::lock_guard< boost::mutex > lock( mutex );
+        isStopRequested = true;
+    }
+
+    prefetchSlotAvailable.notify_all( );
+    ioThreads.join_all( );
+}
+
+//! Check if there are input files left to hand out.
+bool BatchInputFileLoader::hasNextInputFile( ) const
+{
+    boost::lock_guard< boost::mutex > lock( mutex );
+    return nextIndexToHandOut < inputFileNames.size( );
+}
+
+//! Get name of next input file.
+const std::string& BatchInputFileLoader::getNextInputFileName( ) const
+{
+    boost::lock_guard< boost::mutex > lock( mutex );
+
+    if ( nextIndexToHandOut >= inputFileNames.size( ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Error: no input files left in batch." ) ) );
+    }
+
+    return inputFileNames.at( nextIndexToHandOut );
+}
+
+//! Get next filtered input file.
+std::string BatchInputFileLoader::getNextInputFile( )
+{
+    boost::unique_lock< boost::mutex > lock( mutex );
+
+    if ( nextIndexToHandOut >= inputFileNames.size( ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Error: no input files left in batch." ) ) );
+    }
+
+    // Wait until the next input file in line has been loaded, or failed to load.
+    while ( loadedInputFiles.count( nextIndexToHandOut ) == 0
+            && loadingErrors.count( nextIndexToHandOut ) == 0 )
+    {
+        inputFileLoaded.wait( lock );
+    }
+
+    const std::size_t index = nextIndexToHandOut++;
+
+    // Handing out a file frees up a prefetch slot, regardless of whether loading succeeded.
+    prefetchSlotAvailable.notify_all( );
+
+    // Re-throw error if loading failed.
+    std::map< std::size_t, boost::exception_ptr >::iterator iteratorError
+            = loadingErrors.find( index );
+    if ( iteratorError != loadingErrors.end( ) )
+    {
+        const boost::exception_ptr error = iteratorError->second;
+        loadingErrors.erase( iteratorError );
+        lock.unlock( );
+        boost::rethrow_exception( error );
+    }
+
+    // Swap filtered data out of buffer to avoid copying it.
+    std::string filteredData;
+    std::map< std::size_t, std::string >::iterator iteratorLoaded
+            = loadedInputFiles.find( index );
+    filteredData.swap( iteratorLoaded->second );
+    loadedInputFiles.erase( iteratorLoaded );
+
+    return filteredData;
+}
+
+//! Load input files, executed by each I/O thread.
+void BatchInputFileLoader::loadInputFiles( )
+{
+    while ( true )
+    {
+        std::size_t index = 0;
+
+        // Claim next input file, once a prefetch slot is available.
+        {
+            boost::unique_lock< boost::mutex > lock( mutex );
+
+            while ( !isStopRequested && nextIndexToLoad < inputFileNames.size( )
+                    && nextIndexToLoad >= nextIndexToHandOut + prefetchDepth )
+            {
+                prefetchSlotAvailable.wait( lock );
+            }
+
+            if ( isStopRequested || nextIndexToLoad >= inputFileNames.size( ) )
+            {
+                return;
+            }
+
+            index = nextIndexToLoad++;
+        }
+
+        // Read and filter input file without holding the lock.
+        std::string filteredData;
+        boost::exception_ptr error;
+        try
+        {
+            filteredData = readAndFilterInputFile( inputFileNames.at( index ), commentCharacter );
+        }
+
+        catch ( ... )
+        {
+            error = boost::current_exception( );
+        }
+
+        // Store result and notify caller.
+        {
+            boost::lock_guard< boost::mutex > lock( mutex );
+
+            if ( error )
+            {
+                loadingErrors[ index ] = error;
+            }
+
+            else
+            {
+                loadedInputFiles[ index ].swap( filteredData );
+            }
+        }
+
+        inputFileLoaded.notify_all( );
+    }
+}
+
+} // namespace input_output
+} // namespace assist
@@ -0,0 +1,150 @@
+/*
+ *    Copyright (c) 2010-2014, Delft University of Technology
+ *    Copyright (c) 2010-2014, K. Kumar (me@kartikkumar.com)
+ *    All rights reserved.
+ *    See http://bit.ly/1jern3m for license details.
+ */
+
+#ifndef ASSIST_BATCH_INPUT_FILE_LOADER_H
+#define ASSIST_BATCH_INPUT_FILE_LOADER_H
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <boost/exception_ptr.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+
+namespace assist
+{
+namespace input_output
+{
+
+//! List input files in directory.
+/*!
+ * Lists all regular files in a given directory, sorted by file name. If the directory given is a
+ * relative path, it is resolved relative to the Assist root-path (see getAssistRootPath()).
+ * Optionally, only files with a given extension (including the leading dot, e.g., ".txt") are
+ * listed. Throws a run-time error if the directory does not exist.
+ * \param directory Directory to list input files in.
+ * \param fileExtension Extension of files to list (default is empty, i.e., all files are listed).
+ * \return Sorted list of absolute paths to input files in directory.
+ */
+std::vector< std::string > listInputFilesInDirectory( const std::string& directory,
+                                                      const std::string& fileExtension = "" );
+
+//! Batch input file loader.
+/*!
+ * Loader that reads and filters a batch of input files (see readAndFilterInputFile()) in the
+ * background, whilst the caller processes previously loaded files. A pool of I/O threads
+ * prefetches the next files in the batch; the filtered data is handed out strictly in the order
+ * of the list of input files given. The prefetch depth bounds the number of files that are being
+ * read or are waiting to be handed out at any one time, and therefore bounds the memory used.
+ * Errors thrown whilst reading an input file are re-thrown when that file is handed out.
+ */
+class BatchInputFileLoader : boost::noncopyable
+{
+public:
+
+    //! Constructor taking list of input files and prefetch settings.
+    /*!
+     * Constructor taking list of input files and prefetch settings. The I/O threads are started
+     * by the constructor, so prefetching commences immediately.
+     * \param someInputFileNames List of paths to input files to load (in order).
+     * \param aPrefetchDepth Maximum number of input files loaded ahead of the caller (default=4).
+     * \param aNumberOfThreads Number of background I/O threads (default=1).
+     * \param aCommentCharacter Comment character used to denote comment lines (default='#').
+     */
+    BatchInputFileLoader( const std::vector< std::string >& someInputFileNames,
+                          const unsigned int aPrefetchDepth = 4,
+                          const unsigned int aNumberOfThreads = 1,
+                          const char aCommentCharacter = '#' );
+
+    //! Destructor.
+    /*!
+     * Destructor, which stops all I/O threads. Files that are still being read are finished
+     * before the destructor returns; files that haven't been started are skipped.
+     */
+    ~BatchInputFileLoader( );
+
+    //! Check if there are input files left to hand out.
+    /*!
+     * Checks if there are input files left to hand out.
+     * \return True if there are input files left.
+     */
+    bool hasNextInputFile( ) const;
+
+    //! Get next filtered input file.
+    /*!
+     * Returns the filtered data of the next input file in the batch, blocking until it has been
+     * loaded. Throws a run-time error if all input files have already been handed out.
+     * \return Filtered data of next input file as string.
+     */
+    std::string getNextInputFile( );
+
+    //! Get name of next input file.
+    /*!
+     * Returns the name of the next input file to be handed out by getNextInputFile().
+     * \return Name of next input file.
+     */
+    const std::string& getNextInputFileName( ) const;
+
+    //! Get number of input files in batch.
+    /*!
+     * Returns the total number of input files in the batch.
+     * \return Number of input files.
+     */
+    std::size_t getNumberOfInputFiles( ) const { return inputFileNames.size( ); }
+
+protected:
+
+private:
+
+    //! Load input files, executed by each I/O thread.
+    void loadInputFiles( );
+
+    //! List of input files to load.
+    const std::vector< std::string > inputFileNames;
+
+    //! Maximum number of input files loaded ahead of the caller.
+    const std::size_t prefetchDepth;
+
+    //! Comment character used to denote comment lines.
+    const char commentCharacter;
+
+    //! Index of next input file to be claimed by an I/O thread.
+    std::size_t nextIndexToLoad;
+
+    //! Index of next input file to be handed out to the caller.
+    std::size_t nextIndexToHandOut;
+
+    //! Flag indicating that the I/O threads should stop.
+    bool isStopRequested;
+
+    //! Filtered data of loaded input files that haven't been handed out yet, indexed by position.
+    std::map< std::size_t, std::string > loadedInputFiles;
+
+    //! Errors thrown whilst loading input files, indexed by position.
+    std::map< std::size_t, boost::exception_ptr > loadingErrors;
+
+    //! Mutex guarding shared state.
+    mutable boost::mutex mutex;
+
+    //! Condition signalled when a loaded input file becomes available.
+    boost::condition_variable inputFileLoaded;
+
+    //! Condition signalled when a prefetch slot frees up or the threads should stop.
+    boost::condition_variable prefetchSlotAvailable;
+
+    //! Pool of I/O threads.
+    boost::thread_group ioThreads;
+};
+
+} // namespace input_output
+} // namespace assist
+
+#endif // ASSIST_BATCH_INPUT_FILE_LOADER_H
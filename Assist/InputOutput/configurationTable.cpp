@@ -0,0 +1,690 @@
+/*
+ *    Copyright (c) 2010-2014, Delft University of Technology
+ *    Copyright (c) 2010-2014, K. Kumar (me@kartikkumar.com)
+ *    All rights reserved.
+ *    See http://bit.ly/1jern3m for license details.
+ */
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/exception/all.hpp>
+
+#include "Assist/Basics/comparisonFunctions.h"
+
+#include "Assist/InputOutput/configurationTable.h"
+
+namespace assist
+{
+namespace input_output
+{
+
+namespace
+{
+
+//! Identifier written at the start of binary cache files.
+const char cacheFileIdentifier[ 8 ] = { 'A', 'S', 'S', 'I', 'S', 'T', 'C', 'T' };
+
+//! Version of binary cache file format.
+const boost::uint32_t cacheFileVersion = 3;
+
+//! Write plain-old-data value to binary stream.
+template< typename DataType >
+void writeBinary( std::ostream& outputStream, const DataType& value )
+{
+    outputStream.write( reinterpret_cast< const char* >( &value ), sizeof( DataType ) );
+}
+
+//! Read plain-old-data value from binary stream.
+template< typename DataType >
+bool readBinary( std::istream& inputStream, DataType& value )
+{
+    inputStream.read( reinterpret_cast< char* >( &value ), sizeof( DataType ) );
+    return inputStream.good( );
+}
+
+//! Write string to binary stream, preceded by its length.
+void writeBinaryString( std::ostream& outputStream, const std::string& value )
+{
+    writeBinary( outputStream, static_cast< boost::uint64_t >( value.size( ) ) );
+    outputStream.write( value.data( ), static_cast< std::streamsize >( value.size( ) ) );
+}
+
+//! Read string, preceded by its length, from binary stream.
+bool readBinaryString( std::istream& inputStream, std::string& value )
+{
+    boost::uint64_t length = 0;
+    if ( !readBinary( inputStream, length ) || length > ( 1ULL << 32 ) )
+    {
+        return false;
+    }
+
+    value.resize( static_cast< std::size_t >( length ) );
+    if ( length > 0 )
+    {
+        inputStream.read( &value[ 0 ], static_cast< std::streamsize >( length ) );
+    }
+    return inputStream.good( );
+}
+
+//! Read contents of input file in one go; returns false if it can't be opened.
+bool readInputFile( const std::string& inputFileName, std::string& contents )
+{
+    std::ifstream inputFileStream( inputFileName.c_str( ), std::ios::in | std::ios::binary );
+    if ( !inputFileStream.is_open( ) )
+    {
+        return false;
+    }
+
+    std::ostringstream contentsStream;
+    contentsStream << inputFileStream.rdbuf( );
+    contents = contentsStream.str( );
+    return !inputFileStream.bad( );
+}
+
+//! Compute 64-bit FNV-1a hash of contents.
+boost::uint64_t computeContentHash( const std::string& contents )
+{
+    boost::uint64_t hash = 14695981039346656037ULL;
+    for ( std::size_t i = 0; i < contents.size( ); i++ )
+    {
+        hash ^= static_cast< unsigned char >( contents[ i ] );
+        hash *= 1099511628211ULL;
+    }
+
+    return hash;
+}
+
+//! Signature of input file, used to check if a cache is up to date.
+struct InputFileSignature
+{
+    //! Size of input file [bytes].
+    boost::uint64_t fileSize;
+
+    //! Last modification time of input file, whole seconds since the epoch.
+    boost::int64_t lastWriteTime;
+
+    //! Nanoseconds of last modification time of input file.
+    boost::int64_t lastWriteTimeNanoseconds;
+
+    //! Flag indicating if the contents of the input file are hashed.
+    bool isContentHashed;
+
+    //! Hash of contents of input file (zero if not hashed).
+    boost::uint64_t contentHash;
+};
+
+//! Get signature of input file, hashing its contents if requested; returns false on failure.
+/*!
+ * Gets size and last modification time of input file, with sub-second resolution where the
+ * platform provides it (otherwise, the nanoseconds are zero). The contents are only read and
+ * hashed if requested.
+ */
+bool getInputFileSignature( const std::string& inputFileName, const bool isContentHashed,
+                            InputFileSignature& signature )
+{
+    struct stat fileStatus;
+    if ( stat( inputFileName.c_str( ), &fileStatus ) != 0 )
+    {
+        return false;
+    }
+
+    signature.fileSize = static_cast< boost::uint64_t >( fileStatus.st_size );
+    signature.lastWriteTime = static_cast< boost::int64_t >( fileStatus.st_mtime );
+#if defined( __APPLE__ )
+    signature.lastWriteTimeNanoseconds
+            = static_cast< boost::int64_t >( fileStatus.st_mtimespec.tv_nsec );
+#elif defined( _WIN32 )
+    signature.lastWriteTimeNanoseconds = 0;
+#else
+    signature.lastWriteTimeNanoseconds
+            = static_cast< boost::int64_t >( fileStatus.st_mtim.tv_nsec );
+#endif
+    signature.isContentHashed = isContentHashed;
+    signature.contentHash = 0;
+
+    if ( isContentHashed )
+    {
+        std::string contents;
+        if ( !readInputFile( inputFileName, contents ) )
+        {
+            return false;
+        }
+
+        signature.contentHash = computeContentHash( contents );
+    }
+
+    return true;
+}
+
+} // namespace
+
+//! Constructor taking filtered data to parse.
+ConfigurationTable::ConfigurationTable( const std::string& filteredData )
+{
+    parseData( filteredData, true, '#' );
+}
+
+//! Constructor taking unfiltered data to parse.
+ConfigurationTable::ConfigurationTable( const std::string& unfilteredData,
+                                        const char commentCharacter )
+{
+    parseData( unfilteredData, false, commentCharacter );
+}
+
+//! Declare integer parameter.
+void ConfigurationTable::declareIntegerParameter( const std::string& key,
+                                                  const int lowerBound, const int upperBound,
+                                                  const bool isRequired )
+{
+    addDeclaration( key, integerParameter, lowerBound, upperBound, isRequired );
+}
+
+//! Declare double parameter.
+void ConfigurationTable::declareDoubleParameter( const std::string& key,
+                                                 const double lowerBound,
+                                                 const double upperBound,
+                                                 const bool isRequired )
+{
+    addDeclaration( key, doubleParameter, lowerBound, upperBound, isRequired );
+}
+
+//! Declare boolean parameter.
+void ConfigurationTable::declareBooleanParameter( const std::string& key,
+                                                  const bool isRequired )
+{
+    addDeclaration( key, booleanParameter, 0.0, 0.0, isRequired );
+}
+
+//! Declare string parameter.
+void ConfigurationTable::declareStringParameter( const std::string& key, const bool isRequired )
+{
+    addDeclaration( key, stringParameter, 0.0, 0.0, isRequired );
+}
+
+//! Validate parameters.
+void ConfigurationTable::validate( ) const
+{
+    std::vector< std::string > errors = syntaxErrors;
+
+    // Check declared parameters.
+    for ( std::vector< std::string >::const_iterator iteratorKey = declarationOrder.begin( );
+          iteratorKey != declarationOrder.end( ); iteratorKey++ )
+    {
+        const Declaration& declaration = declarations.find( *iteratorKey )->second;
+        const EntryTable::const_iterator iteratorEntry = entries.find( *iteratorKey );
+
+        if ( iteratorEntry == entries.end( ) )
+        {
+            if ( declaration.isRequired )
+            {
+                errors.push_back( *iteratorKey + " is missing." );
+            }
+            continue;
+        }
+
+        const Entry& entry = iteratorEntry->second;
+
+        // Check type and range; the range checks throw run-time errors that are collected.
+        try
+        {
+            switch ( declaration.type )
+            {
+            case integerParameter:
+
+                if ( !entry.isInteger )
+                {
+                    errors.push_back( *iteratorKey + " is: " + entry.stringValue
+                                      + ", which is not an integer." );
+                    break;
+                }
+
+                basics::checkInRange( entry.integerValue, *iteratorKey,
+                                      static_cast< int >( declaration.lowerBound ),
+                                      static_cast< int >( declaration.upperBound ) );
+                break;
+
+            case doubleParameter:
+
+                if ( !entry.isDouble )
+                {
+                    errors.push_back( *iteratorKey + " is: " + entry.stringValue
+                                      + ", which is not a number." );
+                    break;
+                }
+
+                basics::checkInRange( entry.doubleValue, *iteratorKey,
+                                      declaration.lowerBound, declaration.upperBound );
+                break;
+
+            case booleanParameter:
+
+                if ( !entry.isBoolean )
+                {
+                    errors.push_back( *iteratorKey + " is: " + entry.stringValue
+                                      + ", which is not a boolean." );
+                }
+                break;
+
+            case stringParameter:
+
+                break;
+            }
+        }
+
+        catch ( std::runtime_error& error )
+        {
+            errors.push_back( std::string( error.what( ) ) + "." );
+        }
+    }
+
+    // Check for parameters that haven't been declared, which are typically typos.
+    for ( std::vector< std::string >::const_iterator iteratorKey = keyOrder.begin( );
+          iteratorKey != keyOrder.end( ); iteratorKey++ )
+    {
+        if ( declarations.find( *iteratorKey ) == declarations.end( ) )
+        {
+            errors.push_back( *iteratorKey + " is not a known parameter." );
+        }
+    }
+
+    // Throw all errors at once.
+    if ( !errors.empty( ) )
+    {
+        std::ostringstream errorMessage;
+        errorMessage << "Error: " << errors.size( ) << " error(s) in configuration:";
+        for ( unsigned int i = 0; i < errors.size( ); i++ )
+        {
+            errorMessage << "\n" << errors.at( i );
+        }
+
+        boost::throw_exception(
+                    boost::enable_error_info( std::runtime_error( errorMessage.str( ) ) ) );
+    }
+}
+
+//! Get integer parameter.
+int ConfigurationTable::getInteger( const std::string& key ) const
+{
+    const Entry& entry = findEntry( key );
+
+    if ( !entry.isInteger )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Error: " + key + " is: " + entry.stringValue
+                                            + ", which is not an integer." ) ) );
+    }
+
+    return entry.integerValue;
+}
+
+//! Get double parameter.
+double ConfigurationTable::getDouble( const std::string& key ) const
+{
+    const Entry& entry = findEntry( key );
+
+    if ( !entry.isDouble )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Error: " + key + " is: " + entry.stringValue
+                                            + ", which is not a number." ) ) );
+    }
+
+    return entry.doubleValue;
+}
+
+//! Get boolean parameter.
+bool ConfigurationTable::getBoolean( const std::string& key ) const
+{
+    const Entry& entry = findEntry( key );
+
+    if ( !entry.isBoolean )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Error: " + key + " is: " + entry.stringValue
+                                            + ", which is not a boolean." ) ) );
+    }
+
+    return entry.booleanValue;
+}
+
+//! Get string parameter.
+const std::string& ConfigurationTable::getString( const std::string& key ) const
+{
+    return findEntry( key ).stringValue;
+}
+
+//! Write table to binary cache file.
+void ConfigurationTable::writeCache( const std::string& cacheFileName,
+                                     const std::string& inputFileName,
+                                     const char commentCharacter,
+                                     const bool isContentHashed ) const
+{
+    InputFileSignature signature;
+
+    if ( !syntaxErrors.empty( )
+         || !getInputFileSignature( inputFileName, isContentHashed, signature ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Error: cannot cache configuration of "
+                                            + inputFileName + "." ) ) );
+    }
+
+    std::ofstream cacheFileStream( cacheFileName.c_str( ), std::ios::out | std::ios::binary );
+
+    // Write header.
+    cacheFileStream.write( cacheFileIdentifier, sizeof( cacheFileIdentifier ) );
+    writeBinary( cacheFileStream, cacheFileVersion );
+    writeBinary( cacheFileStream, commentCharacter );
+    writeBinary( cacheFileStream, signature.fileSize );
+    writeBinary( cacheFileStream, signature.lastWriteTime );
+    writeBinary( cacheFileStream, signature.lastWriteTimeNanoseconds );
+    writeBinary( cacheFileStream, signature.isContentHashed );
+    writeBinary( cacheFileStream, signature.contentHash );
+    writeBinary( cacheFileStream, static_cast< boost::uint64_t >( keyOrder.size( ) ) );
+
+    // Write entries in the order they were parsed.
+    for ( std::vector< std::string >::const_iterator iteratorKey = keyOrder.begin( );
+          iteratorKey != keyOrder.end( ); iteratorKey++ )
+    {
+        const Entry& entry = entries.find( *iteratorKey )->second;
+        writeBinaryString( cacheFileStream, *iteratorKey );
+        writeBinaryString( cacheFileStream, entry.stringValue );
+        writeBinary( cacheFileStream, entry.isInteger );
+        writeBinary( cacheFileStream, entry.isDouble );
+        writeBinary( cacheFileStream, entry.isBoolean );
+        writeBinary( cacheFileStream, entry.integerValue );
+        writeBinary( cacheFileStream, entry.doubleValue );
+        writeBinary( cacheFileStream, entry.booleanValue );
+    }
+
+    cacheFileStream.close( );
+
+    if ( !cacheFileStream )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Error: could not write cache file "
+                                            + cacheFileName + "." ) ) );
+    }
+}
+
+//! Read table from binary cache file.
+bool ConfigurationTable::readCache( const std::string& cacheFileName,
+                                    const std::string& inputFileName,
+                                    const char commentCharacter,
+                                    const bool isContentHashed )
+{
+    InputFileSignature signature;
+    if ( !getInputFileSignature( inputFileName, false, signature ) )
+    {
+        return false;
+    }
+
+    std::ifstream cacheFileStream( cacheFileName.c_str( ), std::ios::in | std::ios::binary );
+    if ( !cacheFileStream.is_open( ) )
+    {
+        return false;
+    }
+
+    // Read and check header.
+    char identifier[ sizeof( cacheFileIdentifier ) ];
+    boost::uint32_t version = 0;
+    char cachedCommentCharacter = 0;
+    InputFileSignature cachedSignature;
+    boost::uint64_t numberOfEntries = 0;
+
+    cacheFileStream.read( identifier, sizeof( identifier ) );
+    if ( !cacheFileStream.good( )
+         || std::memcmp( identifier, cacheFileIdentifier, sizeof( identifier ) ) != 0
+         || !readBinary( cacheFileStream, version ) || version != cacheFileVersion
+         || !readBinary( cacheFileStream, cachedCommentCharacter )
+         || cachedCommentCharacter != commentCharacter
+         || !readBinary( cacheFileStream, cachedSignature.fileSize )
+         || cachedSignature.fileSize != signature.fileSize
+         || !readBinary( cacheFileStream, cachedSignature.lastWriteTime )
+         || cachedSignature.lastWriteTime != signature.lastWriteTime
+         || !readBinary( cacheFileStream, cachedSignature.lastWriteTimeNanoseconds )
+         || cachedSignature.lastWriteTimeNanoseconds != signature.lastWriteTimeNanoseconds
+         || !readBinary( cacheFileStream, cachedSignature.isContentHashed )
+         || !readBinary( cacheFileStream, cachedSignature.contentHash )
+         || !readBinary( cacheFileStream, numberOfEntries ) )
+    {
+        return false;
+    }
+
+    // Check hash of contents of input file, if requested; this requires the input file to be
+    // read, so it is only done if the size and modification time match.
+    if ( isContentHashed
+         && ( !cachedSignature.isContentHashed
+              || !getInputFileSignature( inputFileName, true, signature )
+              || signature.contentHash != cachedSignature.contentHash ) )
+    {
+        return false;
+    }
+
+    // Read entries into temporary tables, so that this table is unchanged if reading fails.
+    EntryTable cachedEntries;
+    std::vector< std::string > cachedKeyOrder;
+
+    for ( boost::uint64_t i = 0; i < numberOfEntries; i++ )
+    {
+        std::string key;
+        Entry entry;
+
+        if ( !readBinaryString( cacheFileStream, key )
+             || !readBinaryString( cacheFileStream, entry.stringValue )
+             || !readBinary( cacheFileStream, entry.isInteger )
+             || !readBinary( cacheFileStream, entry.isDouble )
+             || !readBinary( cacheFileStream, entry.isBoolean )
+             || !readBinary( cacheFileStream, entry.integerValue )
+             || !readBinary( cacheFileStream, entry.doubleValue )
+             || !readBinary( cacheFileStream, entry.booleanValue ) )
+        {
+            return false;
+        }
+
+        cachedEntries[ key ] = entry;
+        cachedKeyOrder.push_back( key );
+    }
+
+    entries.swap( cachedEntries );
+    keyOrder.swap( cachedKeyOrder );
+    syntaxErrors.clear( );
+
+    return true;
+}
+
+//! Parse data into table.
+void ConfigurationTable::parseData( const std::string& data, const bool isDataFiltered,
+                                    const char commentCharacter )
+{
+    std::istringstream dataStream( data );
+    std::string line;
+    unsigned int lineNumber = 0;
+
+    while ( std::getline( dataStream, line ) )
+    {
+        lineNumber++;
+
+        // Cut off comment, if the data hasn't been filtered yet.
+        if ( !isDataFiltered )
+        {
+            line = line.substr( 0, line.find( commentCharacter ) );
+        }
+
+        boost::trim( line );
+
+        if ( line.empty( ) )
+        {
+            continue;
+        }
+
+        // Split line in key and value; the key is separated from the value by whitespace and/or
+        // a single '=' or ':'.
+        const std::size_t keyEnd = line.find_first_of( " \t=:" );
+        const std::string key = line.substr( 0, keyEnd );
+
+        std::size_t valueStart = line.find_first_not_of( " \t", keyEnd );
+        if ( valueStart != std::string::npos
+             && ( line[ valueStart ] == '=' || line[ valueStart ] == ':' ) )
+        {
+            valueStart = line.find_first_not_of( " \t", valueStart + 1 );
+        }
+
+        std::ostringstream errorMessage;
+        errorMessage << "Line " << lineNumber << ": ";
+
+        if ( key.empty( ) )
+        {
+            errorMessage << "no key given.";
+            syntaxErrors.push_back( errorMessage.str( ) );
+            continue;
+        }
+
+        if ( valueStart == std::string::npos )
+        {
+            errorMessage << "no value given for " << key << ".";
+            syntaxErrors.push_back( errorMessage.str( ) );
+            continue;
+        }
+
+        if ( entries.find( key ) != entries.end( ) )
+        {
+            errorMessage << key << " is given more than once.";
+            syntaxErrors.push_back( errorMessage.str( ) );
+            continue;
+        }
+
+        // Convert value to all types it can represent.
+        Entry entry;
+        entry.stringValue = line.substr( valueStart );
+        const char* valueBegin = entry.stringValue.c_str( );
+        const char* valueEnd = valueBegin + entry.stringValue.size( );
+        char* conversionEnd = 0;
+
+        errno = 0;
+        const long integerValue = std::strtol( valueBegin, &conversionEnd, 10 );
+        entry.isInteger = ( conversionEnd == valueEnd && errno == 0
+                            && integerValue >= std::numeric_limits< int >::min( )
+                            && integerValue <= std::numeric_limits< int >::max( ) );
+        entry.integerValue = entry.isInteger ? static_cast< int >( integerValue ) : 0;
+
+        entry.doubleValue = std::strtod( valueBegin, &conversionEnd );
+        entry.isDouble = ( conversionEnd == valueEnd );
+
+        const std::string lowerCaseValue = boost::to_lower_copy( entry.stringValue );
+        if ( lowerCaseValue == "true" || lowerCaseValue == "yes" || lowerCaseValue == "on"
+             || lowerCaseValue == "1" )
+        {
+            entry.isBoolean = true;
+            entry.booleanValue = true;
+        }
+
+        else if ( lowerCaseValue == "false" || lowerCaseValue == "no" || lowerCaseValue == "off"
+                  || lowerCaseValue == "0" )
+        {
+            entry.isBoolean = true;
+            entry.booleanValue = false;
+        }
+
+        entries[ key ] = entry;
+        keyOrder.push_back( key );
+    }
+}
+
+//! Find entry; throws a run-time error if it's not present.
+const ConfigurationTable::Entry& ConfigurationTable::findEntry( const std::string& key ) const
+{
+    const EntryTable::const_iterator iteratorEntry = entries.find( key );
+
+    if ( iteratorEntry == entries.end( ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Error: " + key + " is missing." ) ) );
+    }
+
+    return iteratorEntry->second;
+}
+
+//! Add declaration.
+void ConfigurationTable::addDeclaration( const std::string& key,
+                                         const ConfigurationParameterType type,
+                                         const double lowerBound, const double upperBound,
+                                         const bool isRequired )
+{
+    if ( declarations.find( key ) == declarations.end( ) )
+    {
+        declarationOrder.push_back( key );
+    }
+
+    Declaration declaration;
+    declaration.type = type;
+    declaration.isRequired = isRequired;
+    declaration.lowerBound = lowerBound;
+    declaration.upperBound = upperBound;
+    declarations[ key ] = declaration;
+}
+
+//! Load configuration table from input file.
+ConfigurationTable loadConfigurationTable( const std::string& inputFileName,
+                                           const char commentCharacter,
+                                           const bool isCacheUsed,
+                                           const bool isContentHashed )
+{
+    const std::string cacheFileName = inputFileName + ".cache";
+
+    ConfigurationTable configurationTable;
+    if ( isCacheUsed
+         && configurationTable.readCache( cacheFileName, inputFileName, commentCharacter,
+                                          isContentHashed ) )
+    {
+        return configurationTable;
+    }
+
+    // Parse unfiltered contents of input file, so that line numbers of syntax errors are those
+    // of the input file.
+    std::string inputFileContents;
+    if ( !readInputFile( inputFileName, inputFileContents ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Error: could not read input file "
+                                            + inputFileName + "." ) ) );
+    }
+
+    configurationTable = ConfigurationTable( inputFileContents, commentCharacter );
+
+    // Write cache; failure to do so (e.g., for a read-only directory) is not an error, since the
+    // cache only serves to speed up subsequent loads.
+    if ( isCacheUsed )
+    {
+        try
+        {
+            configurationTable.writeCache( cacheFileName, inputFileName, commentCharacter,
+                                           isContentHashed );
+        }
+
+        catch ( std::runtime_error& )
+        { }
+    }
+
+    return configurationTable;
+}
+
+} // namespace input_output
+} // namespace assist
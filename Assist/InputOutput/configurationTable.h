@@ -0,0 +1,328 @@
+/*
+ *    Copyright (c) 2010-2014, Delft University of Technology
+ *    Copyright (c) 2010-2014, K. Kumar (me@kartikkumar.com)
+ *    All rights reserved.
+ *    See http://bit.ly/1jern3m for license details.
+ */
+
+#ifndef ASSIST_CONFIGURATION_TABLE_H
+#define ASSIST_CONFIGURATION_TABLE_H
+
+#include <cstddef>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <boost/unordered_map.hpp>
+
+namespace assist
+{
+namespace input_output
+{
+
+//! Configuration parameter types.
+enum ConfigurationParameterType
+{
+    integerParameter,
+    doubleParameter,
+    booleanParameter,
+    stringParameter
+};
+
+//! Configuration table.
+/*!
+ * Table of configuration parameters, parsed once from filtered data (see
+ * readAndFilterInputFile()) into a hashed key-value table. Each line of the filtered data must
+ * contain a key, followed by an optional '=' or ':' and the value (e.g., "semiMajorAxis = 7.0e6").
+ * Values are converted to all types they can represent (integer, double, boolean and string)
+ * whilst parsing, so that typed lookups are O(1) and involve no string conversions.
+ *
+ * Expected parameters can be declared, together with their type and valid range. The validate()
+ * function then checks all parameters in one pass, using the range checks in
+ * comparisonFunctions.h, and reports all syntax, type, range, missing-parameter and
+ * unknown-parameter errors together in a single run-time error.
+ */
+class ConfigurationTable
+{
+public:
+
+    //! Default constructor, creating an empty table.
+    ConfigurationTable( ) { }
+
+    //! Constructor taking filtered data to parse.
+    /*!
+     * Constructor taking filtered data to parse. Syntax errors (e.g., lines without values and
+     * duplicate keys) are not thrown, but stored and reported by validate(), with the numbers of
+     * the lines of the filtered data they occur on.
+     * \param filteredData Filtered data as string.
+     */
+    explicit ConfigurationTable( const std::string& filteredData );
+
+    //! Constructor taking unfiltered data to parse.
+    /*!
+     * Constructor taking unfiltered data to parse, e.g., the contents of an input file. Each line
+     * is cut off at the first occurrence of the comment character and blank lines are skipped, as
+     * by filterCommentsAndBlankLines(), but syntax errors are reported with the numbers of the
+     * lines of the unfiltered data they occur on.
+     * \param unfilteredData Unfiltered data as string.
+     * \param commentCharacter Comment character used to denote comments.
+     */
+    ConfigurationTable( const std::string& unfilteredData, const char commentCharacter );
+
+    //! Declare integer parameter.
+    /*!
+     * Declares an integer parameter, with an optional valid range.
+     * \param key Key of parameter.
+     * \param lowerBound Lower bound of valid range (default is minimum integer).
+     * \param upperBound Upper bound of valid range (default is maximum integer).
+     * \param isRequired Flag indicating if parameter is required (default=true).
+     */
+    void declareIntegerParameter( const std::string& key,
+                                  const int lowerBound = std::numeric_limits< int >::min( ),
+                                  const int upperBound = std::numeric_limits< int >::max( ),
+                                  const bool isRequired = true );
+
+    //! Declare double parameter.
+    /*!
+     * Declares a double parameter, with an optional valid range.
+     * \param key Key of parameter.
+     * \param lowerBound Lower bound of valid range (default is minus infinity).
+     * \param upperBound Upper bound of valid range (default is infinity).
+     * \param isRequired Flag indicating if parameter is required (default=true).
+     */
+    void declareDoubleParameter(
+            const std::string& key,
+            const double lowerBound = -std::numeric_limits< double >::infinity( ),
+            const double upperBound = std::numeric_limits< double >::infinity( ),
+            const bool isRequired = true );
+
+    //! Declare boolean parameter.
+    /*!
+     * Declares a boolean parameter. Accepted values are true/false, yes/no, on/off and 1/0
+     * (case-insensitive).
+     * \param key Key of parameter.
+     * \param isRequired Flag indicating if parameter is required (default=true).
+     */
+    void declareBooleanParameter( const std::string& key, const bool isRequired = true );
+
+    //! Declare string parameter.
+    /*!
+     * Declares a string parameter.
+     * \param key Key of parameter.
+     * \param isRequired Flag indicating if parameter is required (default=true).
+     */
+    void declareStringParameter( const std::string& key, const bool isRequired = true );
+
+    //! Validate parameters.
+    /*!
+     * Validates all parameters against their declarations. All errors found, including syntax
+     * errors encountered during parsing, are collected and thrown together as a single run-time
+     * error, with one error per line in the error message. Parameters that are present, but
+     * haven't been declared, are reported as errors too.
+     */
+    void validate( ) const;
+
+    //! Check if parameter is present.
+    /*!
+     * Checks if a parameter is present in the table.
+     * \param key Key of parameter.
+     * \return True if parameter is present.
+     */
+    bool hasParameter( const std::string& key ) const
+    {
+        return entries.find( key ) != entries.end( );
+    }
+
+    //! Get integer parameter.
+    /*!
+     * Returns value of an integer parameter. Throws a run-time error if the parameter is not
+     * present or is not an integer.
+     * \param key Key of parameter.
+     * \return Value of parameter.
+     */
+    int getInteger( const std::string& key ) const;
+
+    //! Get double parameter.
+    /*!
+     * Returns value of a double parameter. Integers are accepted as doubles. Throws a run-time
+     * error if the parameter is not present or is not a number.
+     * \param key Key of parameter.
+     * \return Value of parameter.
+     */
+    double getDouble( const std::string& key ) const;
+
+    //! Get boolean parameter.
+    /*!
+     * Returns value of a boolean parameter. Throws a run-time error if the parameter is not
+     * present or is not a boolean.
+     * \param key Key of parameter.
+     * \return Value of parameter.
+     */
+    bool getBoolean( const std::string& key ) const;
+
+    //! Get string parameter.
+    /*!
+     * Returns value of a parameter as string, exactly as given in the filtered data. Throws a
+     * run-time error if the parameter is not present.
+     * \param key Key of parameter.
+     * \return Value of parameter.
+     */
+    const std::string& getString( const std::string& key ) const;
+
+    //! Get number of parameters.
+    /*!
+     * Returns number of parameters in the table.
+     * \return Number of parameters.
+     */
+    std::size_t getNumberOfParameters( ) const { return entries.size( ); }
+
+    //! Write table to binary cache file.
+    /*!
+     * Writes the parsed table (not the declarations) to a binary cache file, so that it can be
+     * read back without parsing. The cache file records the size and last modification time
+     * (with sub-second resolution, where the platform provides it) of the input file it was
+     * generated from and the comment character used to filter it, so that stale caches can be
+     * detected without reading the input file. Optionally, a hash of the contents of the input
+     * file is recorded too, for file systems on which an edit can leave the size and
+     * modification time unchanged (e.g., because of coarse timestamps), at the cost of reading
+     * the input file. The cache format is machine-specific. Throws a run-time error if the table
+     * contains syntax errors or the cache file cannot be written.
+     * \param cacheFileName Cache file name.
+     * \param inputFileName Name of input file the table was parsed from.
+     * \param commentCharacter Comment character used to filter the input file (default='#').
+     * \param isContentHashed Flag indicating if a hash of the contents of the input file should
+     *          be recorded (default=false).
+     */
+    void writeCache( const std::string& cacheFileName, const std::string& inputFileName,
+                     const char commentCharacter = '#',
+                     const bool isContentHashed = false ) const;
+
+    //! Read table from binary cache file.
+    /*!
+     * Reads a parsed table from a binary cache file written by writeCache(), if the cache is up
+     * to date with respect to the input file it was generated from and the comment character
+     * matches. If not, the table is left unchanged. By default, the cache is up to date if the
+     * size and modification time of the input file match, which doesn't require the input file
+     * to be read. If the contents are checked as well, the input file is read and hashed (only if
+     * the size and modification time match), and caches written without a hash are rejected.
+     * \param cacheFileName Cache file name.
+     * \param inputFileName Name of input file the table was parsed from.
+     * \param commentCharacter Comment character used to filter the input file (default='#').
+     * \param isContentHashed Flag indicating if the hash of the contents of the input file should
+     *          be checked too (default=false).
+     * \return True if the cache was up to date and read successfully.
+     */
+    bool readCache( const std::string& cacheFileName, const std::string& inputFileName,
+                    const char commentCharacter = '#', const bool isContentHashed = false );
+
+protected:
+
+private:
+
+    //! Configuration entry, containing value of parameter converted to all types possible.
+    struct Entry
+    {
+        //! Default constructor.
+        Entry( )
+            : isInteger( false ), isDouble( false ), isBoolean( false ),
+              integerValue( 0 ), doubleValue( 0.0 ), booleanValue( false )
+        { }
+
+        //! Value as given in filtered data.
+        std::string stringValue;
+
+        //! Flag indicating if value is an integer.
+        bool isInteger;
+
+        //! Flag indicating if value is a double.
+        bool isDouble;
+
+        //! Flag indicating if value is a boolean.
+        bool isBoolean;
+
+        //! Value as integer.
+        int integerValue;
+
+        //! Value as double.
+        double doubleValue;
+
+        //! Value as boolean.
+        bool booleanValue;
+    };
+
+    //! Parameter declaration.
+    struct Declaration
+    {
+        //! Type of parameter.
+        ConfigurationParameterType type;
+
+        //! Flag indicating if parameter is required.
+        bool isRequired;
+
+        //! Lower bound of valid range (for integers and doubles).
+        double lowerBound;
+
+        //! Upper bound of valid range (for integers and doubles).
+        double upperBound;
+    };
+
+    //! Typedef for hashed table of configuration entries.
+    typedef boost::unordered_map< std::string, Entry > EntryTable;
+
+    //! Typedef for hashed table of parameter declarations.
+    typedef boost::unordered_map< std::string, Declaration > DeclarationTable;
+
+    //! Parse data into table, cutting off comments if the data hasn't been filtered yet.
+    void parseData( const std::string& data, const bool isDataFiltered,
+                    const char commentCharacter );
+
+    //! Find entry; throws a run-time error if it's not present.
+    const Entry& findEntry( const std::string& key ) const;
+
+    //! Add declaration.
+    void addDeclaration( const std::string& key, const ConfigurationParameterType type,
+                         const double lowerBound, const double upperBound,
+                         const bool isRequired );
+
+    //! Table of configuration entries.
+    EntryTable entries;
+
+    //! Table of parameter declarations.
+    DeclarationTable declarations;
+
+    //! Order in which parameters were declared, to report errors in a reproducible order.
+    std::vector< std::string > declarationOrder;
+
+    //! Order in which keys were parsed, to report errors in a reproducible order.
+    std::vector< std::string > keyOrder;
+
+    //! Syntax errors encountered whilst parsing.
+    std::vector< std::string > syntaxErrors;
+};
+
+//! Load configuration table from input file.
+/*!
+ * Loads a configuration table from an input file, by reading the file and parsing its contents,
+ * with comments and blank lines skipped (see filterCommentsAndBlankLines()), so that syntax
+ * errors are reported with line numbers of the input file. Optionally, the parsed table is
+ * cached in a binary cache file next to the input file (input file name with ".cache"
+ * appended), so that subsequent loads of an unchanged input file skip reading and parsing (see
+ * ConfigurationTable::writeCache()). The table is not validated; call
+ * ConfigurationTable::validate() after declaring parameters. Throws a run-time error if the
+ * input file cannot be read.
+ * \param inputFileName Input file name.
+ * \param commentCharacter Comment character used to denote comment lines (default='#').
+ * \param isCacheUsed Flag indicating if binary cache file should be used (default=false).
+ * \param isContentHashed Flag indicating if the cache should check a hash of the contents of the
+ *          input file as well as its size and modification time (default=false).
+ * \return Configuration table.
+ */
+ConfigurationTable loadConfigurationTable( const std::string& inputFileName,
+                                           const char commentCharacter = '#',
+                                           const bool isCacheUsed = false,
+                                           const bool isContentHashed = false );
+
+} // namespace input_output
+} // namespace assist
+
+#endif // ASSIST_CONFIGURATION_TABLE_H
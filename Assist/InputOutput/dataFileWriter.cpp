@@ -0,0 +1,591 @@
+/*
+ *    Copyright (c) 2010-2014, Delft University of Technology
+ *    Copyright (c) 2010-2014, K. Kumar (me@kartikkumar.com)
+ *    All rights reserved.
+ *    See http://bit.ly/1jern3m for license details.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#include <boost/cstdint.hpp>
+#include <boost/exception/all.hpp>
+#include <boost/math/special_functions/fpclassify.hpp>
+#include <boost/math/special_functions/sign.hpp>
+
+#include "Assist/InputOutput/dataFileWriter.h"
+
+namespace assist
+{
+namespace input_output
+{
+
+namespace
+{
+
+//! Significands of cached powers of ten 10^k, for k = -348, -340, ..., 340 (Loitsch, 2010).
+const boost::uint64_t cachedPowersSignificands[ 87 ] =
+{
+    0xfa8fd5a0081c0288ULL, 0xbaaee17fa23ebf76ULL, 0x8b16fb203055ac76ULL, 0xcf42894a5dce35eaULL,
+    0x9a6bb0aa55653b2dULL, 0xe61acf033d1a45dfULL, 0xab70fe17c79ac6caULL, 0xff77b1fcbebcdc4fULL,
+    0xbe5691ef416bd60cULL, 0x8dd01fad907ffc3cULL, 0xd3515c2831559a83ULL, 0x9d71ac8fada6c9b5ULL,
+    0xea9c227723ee8bcbULL, 0xaecc49914078536dULL, 0x823c12795db6ce57ULL, 0xc21094364dfb5637ULL,
+    0x9096ea6f3848984fULL, 0xd77485cb25823ac7ULL, 0xa086cfcd97bf97f4ULL, 0xef340a98172aace5ULL,
+    0xb23867fb2a35b28eULL, 0x84c8d4dfd2c63f3bULL, 0xc5dd44271ad3cdbaULL, 0x936b9fcebb25c996ULL,
+    0xdbac6c247d62a584ULL, 0xa3ab66580d5fdaf6ULL, 0xf3e2f893dec3f126ULL, 0xb5b5ada8aaff80b8ULL,
+    0x87625f056c7c4a8bULL, 0xc9bcff6034c13053ULL, 0x964e858c91ba2655ULL, 0xdff9772470297ebdULL,
+    0xa6dfbd9fb8e5b88fULL, 0xf8a95fcf88747d94ULL, 0xb94470938fa89bcfULL, 0x8a08f0f8bf0f156bULL,
+    0xcdb02555653131b6ULL, 0x993fe2c6d07b7facULL, 0xe45c10c42a2b3b06ULL, 0xaa242499697392d3ULL,
+    0xfd87b5f28300ca0eULL, 0xbce5086492111aebULL, 0x8cbccc096f5088ccULL, 0xd1b71758e219652cULL,
+    0x9c40000000000000ULL, 0xe8d4a51000000000ULL, 0xad78ebc5ac620000ULL, 0x813f3978f8940984ULL,
+    0xc097ce7bc90715b3ULL, 0x8f7e32ce7bea5c70ULL, 0xd5d238a4abe98068ULL, 0x9f4f2726179a2245ULL,
+    0xed63a231d4c4fb27ULL, 0xb0de65388cc8ada8ULL, 0x83c7088e1aab65dbULL, 0xc45d1df942711d9aULL,
+    0x924d692ca61be758ULL, 0xda01ee641a708deaULL, 0xa26da3999aef774aULL, 0xf209787bb47d6b85ULL,
+    0xb454e4a179dd1877ULL, 0x865b86925b9bc5c2ULL, 0xc83553c5c8965d3dULL, 0x952ab45cfa97a0b3ULL,
+    0xde469fbd99a05fe3ULL, 0xa59bc234db398c25ULL, 0xf6c69a72a3989f5cULL, 0xb7dcbf5354e9beceULL,
+    0x88fcf317f22241e2ULL, 0xcc20ce9bd35c78a5ULL, 0x98165af37b2153dfULL, 0xe2a0b5dc971f303aULL,
+    0xa8d9d1535ce3b396ULL, 0xfb9b7cd9a4a7443cULL, 0xbb764c4ca7a44410ULL, 0x8bab8eefb6409c1aULL,
+    0xd01fef10a657842cULL, 0x9b10a4e5e9913129ULL, 0xe7109bfba19c0c9dULL, 0xac2820d9623bf429ULL,
+    0x80444b5e7aa7cf85ULL, 0xbf21e44003acdd2dULL, 0x8e679c2f5e44ff8fULL, 0xd433179d9c8cb841ULL,
+    0x9e19db92b4e31ba9ULL, 0xeb96bf6ebadf77d9ULL, 0xaf87023b9bf0ee6bULL
+};
+
+//! Binary exponents of cached powers of ten 10^k, for k = -348, -340, ..., 340.
+const int cachedPowersBinaryExponents[ 87 ] =
+{
+    -1220, -1193, -1166, -1140, -1113, -1087, -1060, -1034, -1007, -980, -954, -927,
+    -901, -874, -847, -821, -794, -768, -741, -715, -688, -661, -635, -608,
+    -582, -555, -529, -502, -475, -449, -422, -396, -369, -343, -316, -289,
+    -263, -236, -210, -183, -157, -130, -103, -77, -50, -24, 3, 30,
+    56, 83, 109, 136, 162, 189, 216, 242, 269, 295, 322, 348,
+    375, 402, 428, 455, 481, 508, 534, 561, 588, 614, 641, 667,
+    694, 720, 747, 774, 800, 827, 853, 880, 907, 933, 960, 986,
+    1013, 1039, 1066
+};
+
+//! Powers of ten that fit in 64 bits.
+const boost::uint64_t powersOfTen[ 20 ] =
+{
+    1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL,
+    1000000000ULL, 10000000000ULL, 100000000000ULL, 1000000000000ULL, 10000000000000ULL,
+    100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL, 100000000000000000ULL,
+    1000000000000000000ULL, 10000000000000000000ULL
+};
+
+//! Do-it-yourself floating-point number, with 64-bit significand and binary exponent.
+struct DiyFloat
+{
+    //! Constructor taking significand and binary exponent.
+    DiyFloat( const boost::uint64_t aSignificand, const int aBinaryExponent )
+        : significand( aSignificand ), binaryExponent( aBinaryExponent )
+    { }
+
+    //! Constructor taking (positive, finite) double.
+    explicit DiyFloat( const double value )
+    {
+        boost::uint64_t bits = 0;
+        std::memcpy( &bits, &value, sizeof( double ) );
+
+        const int biasedExponent = static_cast< int >( ( bits >> 52 ) & 0x7FF );
+        significand = bits & 0x000FFFFFFFFFFFFFULL;
+
+        // Add hidden bit for normal numbers.
+        if ( biasedExponent != 0 )
+        {
+            significand += 0x0010000000000000ULL;
+            binaryExponent = biasedExponent - 1075;
+        }
+
+        else
+        {
+            binaryExponent = -1074;
+        }
+    }
+
+    //! Subtract significands of numbers with equal binary exponents.
+    DiyFloat operator-( const DiyFloat& otherNumber ) const
+    {
+        return DiyFloat( significand - otherNumber.significand, binaryExponent );
+    }
+
+    //! Multiply numbers, rounding the 128-bit product of the significands to 64 bits.
+    DiyFloat operator*( const DiyFloat& otherNumber ) const
+    {
+        const boost::uint64_t lowerMask = 0xFFFFFFFFULL;
+        const boost::uint64_t a = significand >> 32;
+        const boost::uint64_t b = significand & lowerMask;
+        const boost::uint64_t c = otherNumber.significand >> 32;
+        const boost::uint64_t d = otherNumber.significand & lowerMask;
+        const boost::uint64_t ac = a * c;
+        const boost::uint64_t bc = b * c;
+        const boost::uint64_t ad = a * d;
+        const boost::uint64_t bd = b * d;
+        const boost::uint64_t middle = ( bd >> 32 ) + ( ad & lowerMask ) + ( bc & lowerMask )
+                + ( 1ULL << 31 );
+        return DiyFloat( ac + ( ad >> 32 ) + ( bc >> 32 ) + ( middle >> 32 ),
+                         binaryExponent + otherNumber.binaryExponent + 64 );
+    }
+
+    //! Normalize, such that the most significant bit of the significand is set.
+    DiyFloat normalize( ) const
+    {
+        DiyFloat normalized = *this;
+        while ( !( normalized.significand & 0x8000000000000000ULL ) )
+        {
+            normalized.significand <<= 1;
+            normalized.binaryExponent--;
+        }
+        return normalized;
+    }
+
+    //! Significand.
+    boost::uint64_t significand;
+
+    //! Binary exponent.
+    int binaryExponent;
+};
+
+//! Get cached power of ten, such that product with number of given exponent lies in [-60, -32].
+DiyFloat getCachedPower( const int binaryExponent, int& decimalExponent )
+{
+    // Compute ceil( ( -61 - binaryExponent ) * log10( 2 ) ), offset to keep argument positive.
+    const double approximateIndex = ( -61 - binaryExponent ) * 0.30102999566398114 + 347.0;
+    int k = static_cast< int >( approximateIndex );
+    if ( approximateIndex - k > 0.0 )
+    {
+        k++;
+    }
+
+    const unsigned int index = static_cast< unsigned int >( ( k >> 3 ) + 1 );
+    decimalExponent = -( -348 + static_cast< int >( index << 3 ) );
+
+    return DiyFloat( cachedPowersSignificands[ index ], cachedPowersBinaryExponents[ index ] );
+}
+
+//! Round last digit generated towards the exact value, whilst staying within the safe interval.
+void roundWeed( char* digits, const int numberOfDigits, const boost::uint64_t delta,
+                boost::uint64_t rest, const boost::uint64_t tenKappa,
+                const boost::uint64_t distanceToUpperBound )
+{
+    while ( rest < distanceToUpperBound && delta - rest >= tenKappa
+            && ( rest + tenKappa < distanceToUpperBound
+                 || distanceToUpperBound - rest > rest + tenKappa - distanceToUpperBound ) )
+    {
+        digits[ numberOfDigits - 1 ]--;
+        rest += tenKappa;
+    }
+}
+
+//! Count number of decimal digits of 32-bit integer.
+int countDecimalDigits( const boost::uint32_t number )
+{
+    int numberOfDigits = 1;
+    while ( numberOfDigits < 10 && number >= powersOfTen[ numberOfDigits ] )
+    {
+        numberOfDigits++;
+    }
+    return numberOfDigits;
+}
+
+//! Generate shortest digits within safe interval (Loitsch, 2010).
+void generateDigits( const DiyFloat& scaledValue, const DiyFloat& upperBound,
+                     boost::uint64_t delta, char* digits, int& numberOfDigits,
+                     int& decimalExponent )
+{
+    const DiyFloat one( 1ULL << -upperBound.binaryExponent, upperBound.binaryExponent );
+    const boost::uint64_t distanceToUpperBound = ( upperBound - scaledValue ).significand;
+
+    // Split upper bound in integral and fractional parts.
+    boost::uint32_t integralPart
+            = static_cast< boost::uint32_t >( upperBound.significand >> -one.binaryExponent );
+    boost::uint64_t fractionalPart = upperBound.significand & ( one.significand - 1 );
+
+    int kappa = countDecimalDigits( integralPart );
+    numberOfDigits = 0;
+
+    // Generate digits of integral part.
+    while ( kappa > 0 )
+    {
+        const boost::uint32_t divisor = static_cast< boost::uint32_t >( powersOfTen[ kappa - 1 ] );
+        const boost::uint32_t digit = integralPart / divisor;
+        integralPart %= divisor;
+
+        if ( digit != 0 || numberOfDigits != 0 )
+        {
+            digits[ numberOfDigits++ ] = static_cast< char >( '0' + digit );
+        }
+
+        kappa--;
+
+        const boost::uint64_t rest
+                = ( static_cast< boost::uint64_t >( integralPart ) << -one.binaryExponent )
+                + fractionalPart;
+        if ( rest <= delta )
+        {
+            decimalExponent += kappa;
+            roundWeed( digits, numberOfDigits, delta, rest,
+                       powersOfTen[ kappa ] << -one.binaryExponent, distanceToUpperBound );
+            return;
+        }
+    }
+
+    // Generate digits of fractional part.
+    while ( true )
+    {
+        fractionalPart *= 10;
+        delta *= 10;
+
+        const char digit = static_cast< char >( fractionalPart >> -one.binaryExponent );
+        if ( digit != 0 || numberOfDigits != 0 )
+        {
+            digits[ numberOfDigits++ ] = static_cast< char >( '0' + digit );
+        }
+
+        fractionalPart &= one.significand - 1;
+        kappa--;
+
+        if ( fractionalPart < delta )
+        {
+            decimalExponent += kappa;
+            const int index = -kappa;
+            roundWeed( digits, numberOfDigits, delta, fractionalPart, one.significand,
+                       distanceToUpperBound * ( index < 20 ? powersOfTen[ index ] : 0 ) );
+            return;
+        }
+    }
+}
+
+//! Generate shortest digits of positive, finite, non-zero double with the Grisu2 algorithm.
+void computeGrisu2Digits( const double value, char* digits, int& numberOfDigits,
+                          int& decimalExponent )
+{
+    const DiyFloat exactValue( value );
+
+    // Compute boundaries of the interval of real numbers that round to the value.
+    DiyFloat upperBound = DiyFloat( ( exactValue.significand << 1 ) + 1,
+                                    exactValue.binaryExponent - 1 ).normalize( );
+    DiyFloat lowerBound = ( exactValue.significand == 0x0010000000000000ULL )
+            ? DiyFloat( ( exactValue.significand << 2 ) - 1, exactValue.binaryExponent - 2 )
+            : DiyFloat( ( exactValue.significand << 1 ) - 1, exactValue.binaryExponent - 1 );
+    lowerBound.significand <<= lowerBound.binaryExponent - upperBound.binaryExponent;
+    lowerBound.binaryExponent = upperBound.binaryExponent;
+
+    // Scale value and boundaries with cached power of ten.
+    const DiyFloat cachedPower = getCachedPower( upperBound.binaryExponent, decimalExponent );
+    const DiyFloat scaledValue = exactValue.normalize( ) * cachedPower;
+    DiyFloat scaledUpperBound = upperBound * cachedPower;
+    DiyFloat scaledLowerBound = lowerBound * cachedPower;
+
+    // Shrink interval by one unit on both sides to account for rounding in the products.
+    scaledLowerBound.significand++;
+    scaledUpperBound.significand--;
+
+    generateDigits( scaledValue, scaledUpperBound,
+                    scaledUpperBound.significand - scaledLowerBound.significand,
+                    digits, numberOfDigits, decimalExponent );
+}
+
+//! Write decimal exponent in scientific notation.
+std::size_t writeExponent( int exponent, char* buffer )
+{
+    std::size_t position = 0;
+    buffer[ position++ ] = 'e';
+
+    if ( exponent < 0 )
+    {
+        buffer[ position++ ] = '-';
+        exponent = -exponent;
+    }
+
+    if ( exponent >= 100 )
+    {
+        buffer[ position++ ] = static_cast< char >( '0' + exponent / 100 );
+        exponent %= 100;
+        buffer[ position++ ] = static_cast< char >( '0' + exponent / 10 );
+    }
+
+    else if ( exponent >= 10 )
+    {
+        buffer[ position++ ] = static_cast< char >( '0' + exponent / 10 );
+    }
+
+    buffer[ position++ ] = static_cast< char >( '0' + exponent % 10 );
+    return position;
+}
+
+//! Format digits with decimal exponent in fixed or scientific notation.
+std::size_t formatDigits( const char* digits, const int numberOfDigits,
+                          const int decimalExponent, char* buffer )
+{
+    // Position of decimal point relative to start of digits.
+    const int decimalPointPosition = numberOfDigits + decimalExponent;
+    std::size_t position = 0;
+
+    // Integer: digits followed by trailing zeros (e.g., 1200).
+    if ( decimalExponent >= 0 && decimalPointPosition <= 21 )
+    {
+        std::memcpy( buffer, digits, numberOfDigits );
+        position = numberOfDigits;
+        std::memset( buffer + position, '0', decimalExponent );
+        position += decimalExponent;
+    }
+
+    // Decimal point within digits (e.g., 12.34).
+    else if ( decimalPointPosition > 0 && decimalPointPosition <= 21 )
+    {
+        std::memcpy( buffer, digits, decimalPointPosition );
+        buffer[ decimalPointPosition ] = '.';
+        std::memcpy( buffer + decimalPointPosition + 1, digits + decimalPointPosition,
+                     numberOfDigits - decimalPointPosition );
+        position = numberOfDigits + 1;
+    }
+
+    // Decimal point before digits, with leading zeros (e.g., 0.001234).
+    else if ( decimalPointPosition >= -4 && decimalPointPosition <= 0 )
+    {
+        buffer[ position++ ] = '0';
+        buffer[ position++ ] = '.';
+        std::memset( buffer + position, '0', -decimalPointPosition );
+        position += -decimalPointPosition;
+        std::memcpy( buffer + position, digits, numberOfDigits );
+        position += numberOfDigits;
+    }
+
+    // Scientific notation (e.g., 1.234e-7).
+    else
+    {
+        buffer[ position++ ] = digits[ 0 ];
+        if ( numberOfDigits > 1 )
+        {
+            buffer[ position++ ] = '.';
+            std::memcpy( buffer + position, digits + 1, numberOfDigits - 1 );
+            position += numberOfDigits - 1;
+        }
+        position += writeExponent( decimalPointPosition - 1, buffer + position );
+    }
+
+    return position;
+}
+
+//! Write map with vector values to file.
+template< typename MapType >
+void writeDoubleKeyVectorValueMap( const std::string& outputFileName, const MapType& dataMap,
+                                   const std::string& header, const char delimiter,
+                                   const char commentCharacter )
+{
+    DataFileWriter writer( outputFileName, delimiter, commentCharacter );
+
+    if ( !header.empty( ) )
+    {
+        writer.writeComment( header );
+    }
+
+    for ( typename MapType::const_iterator iteratorDataMap = dataMap.begin( );
+          iteratorDataMap != dataMap.end( ); iteratorDataMap++ )
+    {
+        writer.writeRow( iteratorDataMap->first, iteratorDataMap->second );
+    }
+
+    writer.flush( );
+}
+
+} // namespace
+
+//! Write double to character buffer in shortest round-trip format.
+std::size_t writeDoubleToBuffer( double value, char* buffer )
+{
+    if ( ( boost::math::isnan )( value ) )
+    {
+        std::memcpy( buffer, "nan", 3 );
+        return 3;
+    }
+
+    std::size_t position = 0;
+
+    // Write sign; this includes the sign of negative zero, so that it round-trips.
+    if ( ( boost::math::signbit )( value ) )
+    {
+        buffer[ position++ ] = '-';
+        value = -value;
+    }
+
+    if ( ( boost::math::isinf )( value ) )
+    {
+        std::memcpy( buffer + position, "inf", 3 );
+        return position + 3;
+    }
+
+    if ( value == 0.0 )
+    {
+        buffer[ position++ ] = '0';
+        return position;
+    }
+
+    char digits[ 18 ];
+    int numberOfDigits = 0;
+    int decimalExponent = 0;
+    computeGrisu2Digits( value, digits, numberOfDigits, decimalExponent );
+
+    return position + formatDigits( digits, numberOfDigits, decimalExponent, buffer + position );
+}
+
+//! Convert double to string in shortest round-trip format.
+std::string convertDoubleToString( const double value )
+{
+    char buffer[ MAXIMUM_DOUBLE_STRING_LENGTH ];
+    return std::string( buffer, writeDoubleToBuffer( value, buffer ) );
+}
+
+//! Constructor taking output file name and format settings.
+DataFileWriter::DataFileWriter( const std::string& outputFileName,
+                                const char aDelimiter,
+                                const char aCommentCharacter,
+                                const std::size_t aBufferSize )
+    : delimiter( aDelimiter ),
+      commentCharacter( aCommentCharacter ),
+      buffer( std::max< std::size_t >( aBufferSize, 2 * MAXIMUM_DOUBLE_STRING_LENGTH ) ),
+      bufferPosition( 0 ),
+      isStartOfRow( true )
+{
+    // Check delimiter before the output file is truncated.
+    if ( delimiter == '\0' || delimiter == '\n'
+         || std::strchr( "0123456789+-.eEinfa", delimiter ) != 0 )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Error: delimiter can occur in formatted double or ends row." ) ) );
+    }
+
+    outputFileStream.open( outputFileName.c_str( ), std::ios::out | std::ios::binary );
+    if ( !outputFileStream.is_open( ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Error: could not open output file " + outputFileName + "." ) ) );
+    }
+}
+
+//! Destructor.
+DataFileWriter::~DataFileWriter( )
+{
+    try
+    {
+        flush( );
+    }
+
+    catch ( ... )
+    { }
+}
+
+//! Write comment.
+void DataFileWriter::writeComment( const std::string& comment )
+{
+    if ( !isStartOfRow )
+    {
+        endRow( );
+    }
+
+    std::size_t lineStart = 0;
+    while ( lineStart <= comment.size( ) )
+    {
+        std::size_t lineEnd = comment.find( '\n', lineStart );
+        if ( lineEnd == std::string::npos )
+        {
+            lineEnd = comment.size( );
+        }
+
+        // Write line in chunks, in case it is larger than the buffer.
+        reserve( 2 );
+        buffer[ bufferPosition++ ] = commentCharacter;
+        buffer[ bufferPosition++ ] = ' ';
+
+        std::size_t chunkStart = lineStart;
+        while ( chunkStart < lineEnd )
+        {
+            reserve( 1 );
+            const std::size_t chunkSize
+                    = std::min( lineEnd - chunkStart, buffer.size( ) - bufferPosition );
+            std::memcpy( &buffer[ bufferPosition ], comment.data( ) + chunkStart, chunkSize );
+            bufferPosition += chunkSize;
+            chunkStart += chunkSize;
+        }
+
+        endRow( );
+        lineStart = lineEnd + 1;
+    }
+}
+
+//! Flush write buffer to file.
+void DataFileWriter::flush( )
+{
+    writeBuffer( );
+    outputFileStream.flush( );
+
+    if ( !outputFileStream )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Error: could not write to output file." ) ) );
+    }
+}
+
+//! Write contents of buffer to file stream.
+void DataFileWriter::writeBuffer( )
+{
+    outputFileStream.write( &buffer[ 0 ], static_cast< std::streamsize >( bufferPosition ) );
+    bufferPosition = 0;
+}
+
+//! Write double-key, double-value map to file.
+void writeDoubleKeyDoubleValueMap( const std::string& outputFileName,
+                                   const basics::DoubleKeyDoubleValueMap& dataMap,
+                                   const std::string& header,
+                                   const char delimiter,
+                                   const char commentCharacter )
+{
+    DataFileWriter writer( outputFileName, delimiter, commentCharacter );
+
+    if ( !header.empty( ) )
+    {
+        writer.writeComment( header );
+    }
+
+    for ( basics::DoubleKeyDoubleValueMap::const_iterator iteratorDataMap = dataMap.begin( );
+          iteratorDataMap != dataMap.end( ); iteratorDataMap++ )
+    {
+        writer.writeRow( iteratorDataMap->first, iteratorDataMap->second );
+    }
+
+    writer.flush( );
+}
+
+//! Write double-key, Vector3d-value map to file.
+void writeDoubleKeyVector3dValueMap( const std::string& outputFileName,
+                                     const basics::DoubleKeyVector3dValueMap& dataMap,
+                                     const std::string& header,
+                                     const char delimiter,
+                                     const char commentCharacter )
+{
+    writeDoubleKeyVectorValueMap( outputFileName, dataMap, header, delimiter, commentCharacter );
+}
+
+//! Write double-key, Vector6d-value map to file.
+void writeDoubleKeyVector6dValueMap( const std::string& outputFileName,
+                                     const basics::DoubleKeyVector6dValueMap& dataMap,
+                                     const std::string& header,
+                                     const char delimiter,
+                                     const char commentCharacter )
+{
+    writeDoubleKeyVectorValueMap( outputFileName, dataMap, header, delimiter, commentCharacter );
+}
+
+} // namespace input_output
+} // namespace assist
+
+/*
+ *    The implementation of the Grisu2 algorithm follows Loitsch (2010), and the 64-bit
+ *    arithmetic variant used in Milo Yip's dtoa.
+ */
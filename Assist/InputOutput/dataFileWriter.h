@@ -0,0 +1,260 @@
+/*
+ *    Copyright (c) 2010-2014, Delft University of Technology
+ *    Copyright (c) 2010-2014, K. Kumar (me@kartikkumar.com)
+ *    All rights reserved.
+ *    See http://bit.ly/1jern3m for license details.
+ */
+
+#ifndef ASSIST_DATA_FILE_WRITER_H
+#define ASSIST_DATA_FILE_WRITER_H
+
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+#include <Eigen/Core>
+
+#include "Assist/Basics/commonTypedefs.h"
+
+namespace assist
+{
+namespace input_output
+{
+
+//! Maximum number of characters written by writeDoubleToBuffer().
+const std::size_t MAXIMUM_DOUBLE_STRING_LENGTH = 32;
+
+//! Write double to character buffer in shortest round-trip format.
+/*!
+ * Writes a double to a character buffer using the Grisu2 algorithm (Loitsch, 2010). The string
+ * written is guaranteed to be converted back to exactly the same double by std::strtod() and is
+ * the shortest such string for the vast majority of values (for the remainder, a few more digits
+ * than strictly necessary are written, up to the 17 digits required in the worst case). Values
+ * are written in fixed notation if their decimal exponent lies in [-5, 20], and in scientific
+ * notation (e.g., 1.5e-7) otherwise. Infinities and NaN are written as "inf", "-inf" and "nan".
+ * No terminating null-character is written.
+ * \param value Double to write.
+ * \param buffer Character buffer of at least MAXIMUM_DOUBLE_STRING_LENGTH characters.
+ * \return Number of characters written.
+ */
+std::size_t writeDoubleToBuffer( const double value, char* buffer );
+
+//! Convert double to string in shortest round-trip format.
+/*!
+ * Converts a double to a string in shortest round-trip format (see writeDoubleToBuffer()).
+ * \param value Double to convert.
+ * \return String representation of double.
+ */
+std::string convertDoubleToString( const double value );
+
+//! Buffered writer for tabulated data files.
+/*!
+ * Writer for tabulated (ASCII) data files, consisting of optional comment lines followed by rows
+ * of delimited columns of doubles. Doubles are formatted in shortest round-trip format (see
+ * writeDoubleToBuffer()) into a large internal buffer, which is written to file in one go when it
+ * is full, when flush() is called and when the writer is destroyed. Files written can be read
+ * back losslessly with readAndFilterInputFile() in conjunction with the parse functions in
+ * basicInputOutput.h, as long as the same comment character is used.
+ */
+class DataFileWriter : boost::noncopyable
+{
+public:
+
+    //! Constructor taking output file name and format settings.
+    /*!
+     * Constructor taking output file name and format settings. The output file is opened
+     * (truncated) by the constructor; a run-time error is thrown if this fails. A run-time error
+     * is also thrown if the delimiter can occur in a formatted double (a digit, '+', '-', '.',
+     * 'e', 'E', or a letter of "inf" or "nan") or is a newline, since rows could then not be
+     * parsed back.
+     * \param outputFileName Output file name.
+     * \param aDelimiter Delimiter used to separate columns (default=',').
+     * \param aCommentCharacter Comment character used to denote comment lines (default='#').
+     * \param aBufferSize Size of write buffer [bytes] (default=1 MiB).
+     */
+    DataFileWriter( const std::string& outputFileName,
+                    const char aDelimiter = ',',
+                    const char aCommentCharacter = '#',
+                    const std::size_t aBufferSize = 1048576 );
+
+    //! Destructor.
+    /*!
+     * Destructor, which flushes the write buffer to file. Since destructors must not throw,
+     * errors encountered here are silently ignored; call flush() explicitly to catch them.
+     */
+    ~DataFileWriter( );
+
+    //! Write comment.
+    /*!
+     * Writes a comment to file. Each line of the comment is written as a separate line, prefixed
+     * with the comment character and a space. Any row being written is ended first.
+     * \param comment Comment to write (may contain newlines).
+     */
+    void writeComment( const std::string& comment );
+
+    //! Write value to current row.
+    /*!
+     * Writes a value to the current row, preceded by the delimiter if this is not the first value
+     * on the row.
+     * \param value Value to write.
+     */
+    void writeValue( const double value )
+    {
+        reserve( MAXIMUM_DOUBLE_STRING_LENGTH + 1 );
+
+        if ( !isStartOfRow )
+        {
+            buffer[ bufferPosition++ ] = delimiter;
+        }
+
+        bufferPosition += writeDoubleToBuffer( value, &buffer[ bufferPosition ] );
+        isStartOfRow = false;
+    }
+
+    //! End current row.
+    /*!
+     * Ends the current row by writing a newline.
+     */
+    void endRow( )
+    {
+        reserve( 1 );
+        buffer[ bufferPosition++ ] = '\n';
+        isStartOfRow = true;
+    }
+
+    //! Write row containing key and value.
+    /*!
+     * Writes a complete row, containing a key and a value.
+     * \param key Key to write in first column.
+     * \param value Value to write in second column.
+     */
+    void writeRow( const double key, const double value )
+    {
+        writeValue( key );
+        writeValue( value );
+        endRow( );
+    }
+
+    //! Write row containing key and vector of values.
+    /*!
+     * Writes a complete row, containing a key followed by all coefficients of an Eigen vector.
+     * \param key Key to write in first column.
+     * \param values Vector of values to write in subsequent columns.
+     */
+    template< typename DerivedType >
+    void writeRow( const double key, const Eigen::MatrixBase< DerivedType >& values )
+    {
+        writeValue( key );
+        for ( int i = 0; i < values.size( ); i++ )
+        {
+            writeValue( values.coeff( i ) );
+        }
+        endRow( );
+    }
+
+    //! Flush write buffer to file.
+    /*!
+     * Writes the contents of the write buffer to file and flushes the file stream. Throws a
+     * run-time error if writing fails.
+     */
+    void flush( );
+
+protected:
+
+private:
+
+    //! Ensure there is space in the buffer for a given number of characters.
+    void reserve( const std::size_t numberOfCharacters )
+    {
+        if ( bufferPosition + numberOfCharacters > buffer.size( ) )
+        {
+            writeBuffer( );
+        }
+    }
+
+    //! Write contents of buffer to file stream.
+    void writeBuffer( );
+
+    //! Output file stream.
+    std::ofstream outputFileStream;
+
+    //! Delimiter used to separate columns.
+    const char delimiter;
+
+    //! Comment character used to denote comment lines.
+    const char commentCharacter;
+
+    //! Write buffer.
+    std::vector< char > buffer;
+
+    //! Current position in write buffer.
+    std::size_t bufferPosition;
+
+    //! Flag indicating if nothing has been written to the current row yet.
+    bool isStartOfRow;
+};
+
+//! Write double-key, double-value map to file.
+/*!
+ * Writes a double-key, double-value map to a tabulated data file, with one row per entry
+ * containing the key and the value. An optional header is written as comment lines first.
+ * \param outputFileName Output file name.
+ * \param dataMap Map to write.
+ * \param header Header to write as comment (default is empty, i.e., no header is written).
+ * \param delimiter Delimiter used to separate columns (default=',').
+ * \param commentCharacter Comment character used to denote comment lines (default='#').
+ */
+void writeDoubleKeyDoubleValueMap( const std::string& outputFileName,
+                                   const basics::DoubleKeyDoubleValueMap& dataMap,
+                                   const std::string& header = "",
+                                   const char delimiter = ',',
+                                   const char commentCharacter = '#' );
+
+//! Write double-key, Vector3d-value map to file.
+/*!
+ * Writes a double-key, Vector3d-value map to a tabulated data file, with one row per entry
+ * containing the key and the three vector components. An optional header is written as comment
+ * lines first.
+ * \param outputFileName Output file name.
+ * \param dataMap Map to write.
+ * \param header Header to write as comment (default is empty, i.e., no header is written).
+ * \param delimiter Delimiter used to separate columns (default=',').
+ * \param commentCharacter Comment character used to denote comment lines (default='#').
+ */
+void writeDoubleKeyVector3dValueMap( const std::string& outputFileName,
+                                     const basics::DoubleKeyVector3dValueMap& dataMap,
+                                     const std::string& header = "",
+                                     const char delimiter = ',',
+                                     const char commentCharacter = '#' );
+
+//! Write double-key, Vector6d-value map to file.
+/*!
+ * Writes a double-key, Vector6d-value map (e.g., a state history) to a tabulated data file, with
+ * one row per entry containing the key and the six vector components. An optional header is
+ * written as comment lines first.
+ * \param outputFileName Output file name.
+ * \param dataMap Map to write.
+ * \param header Header to write as comment (default is empty, i.e., no header is written).
+ * \param delimiter Delimiter used to separate columns (default=',').
+ * \param commentCharacter Comment character used to denote comment lines (default='#').
+ */
+void writeDoubleKeyVector6dValueMap( const std::string& outputFileName,
+                                     const basics::DoubleKeyVector6dValueMap& dataMap,
+                                     const std::string& header = "",
+                                     const char delimiter = ',',
+                                     const char commentCharacter = '#' );
+
+} // namespace input_output
+} // namespace assist
+
+#endif // ASSIST_DATA_FILE_WRITER_H
+
+/*
+ *    References
+ *      Loitsch, F. Printing floating-point numbers quickly and accurately with integers, PLDI'10
+ *          Proceedings of the 2010 ACM SIGPLAN Conference on Programming Language Design and
+ *          Implementation, pp. 233-243, 2010.
+ */
@@ -0,0 +1,149 @@
+/*
+ *    Copyright (c) 2010-2014, Delft University of Technology
+ *    Copyright (c) 2010-2014, K. Kumar (me@kartikkumar.com)
+ *    All rights reserved.
+ *    See http://bit.ly/1jern3m for license details.
+ */
+
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#include "Assist/InputOutput/basicInputOutput.h"
+#include "Assist/InputOutput/incrementalInputFileReader.h"
+
+namespace assist
+{
+namespace input_output
+{
+
+//! Constructor taking input file name and comment character.
+IncrementalInputFileReader::IncrementalInputFileReader( const std::string& anInputFileName,
+                                                        const char aCommentCharacter )
+    : inputFileName( anInputFileName ),
+      commentCharacter( aCommentCharacter ),
+      offset( 0 ),
+      inode( 0 ),
+      isFileSeen( false ),
+      numberOfRestarts( 0 )
+{ }
+
+//! Read new data.
+std::string IncrementalInputFileReader::readNewData( )
+{
+    // Get size and inode of input file; if it doesn't exist (e.g., in the middle of a rotation),
+    // there is no new data.
+    struct stat fileStatus;
+    if ( stat( inputFileName.c_str( ), &fileStatus ) != 0 )
+    {
+        return "";
+    }
+
+    const boost::uint64_t fileSize = static_cast< boost::uint64_t >( fileStatus.st_size );
+    const boost::uint64_t fileInode = static_cast< boost::uint64_t >( fileStatus.st_ino );
+
+    // Start again from the beginning if the file was replaced or truncated. Note that on
+    // platforms without inodes, st_ino is zero, so only truncation is detected there.
+    if ( isFileSeen && ( fileInode != inode || fileSize < offset ) )
+    {
+        offset = 0;
+        partialLine.clear( );
+        numberOfRestarts++;
+    }
+
+    isFileSeen = true;
+    inode = fileInode;
+
+    if ( fileSize == offset )
+    {
+        return "";
+    }
+
+    // Read appended bytes, after the partial line held back from the previous poll.
+    std::ifstream inputFileStream( inputFileName.c_str( ), std::ios::in | std::ios::binary );
+    if ( !inputFileStream.is_open( ) )
+    {
+        return "";
+    }
+
+    inputFileStream.seekg( static_cast< std::streamoff >( offset ), std::ios::beg );
+
+    std::string newData;
+    newData.swap( partialLine );
+    const std::size_t partialLineSize = newData.size( );
+    newData.resize( partialLineSize + static_cast< std::size_t >( fileSize - offset ) );
+    inputFileStream.read( &newData[ partialLineSize ],
+                          static_cast< std::streamsize >( fileSize - offset ) );
+    newData.resize( partialLineSize + static_cast< std::size_t >( inputFileStream.gcount( ) ) );
+    offset += static_cast< boost::uint64_t >( inputFileStream.gcount( ) );
+
+    // Hold back partial last line until it is terminated.
+    const std::size_t lastNewline = newData.rfind( '\n' );
+    if ( lastNewline == std::string::npos )
+    {
+        partialLine.swap( newData );
+        return "";
+    }
+
+    partialLine.assign( newData, lastNewline + 1, std::string::npos );
+    newData.resize( lastNewline + 1 );
+
+    return filterCommentsAndBlankLines( newData, commentCharacter );
+}
+
+//! Read new samples into step-function map.
+std::size_t IncrementalInputFileReader::readNewSamples(
+        basics::DoubleKeyDoubleValueMap& stepFunction,
+        std::vector< std::string >& unparsableLines )
+{
+    unparsableLines.clear( );
+    const std::string newData = readNewData( );
+
+    // Parse new data in one go; if that fails, parse it line by line, skipping the lines that
+    // cannot be parsed, so that a malformed line doesn't hold up the lines after it.
+    basics::DoubleKeyDoubleValueMap newSamples;
+    try
+    {
+        newSamples = parseDoubleKeyDoubleValueMap( newData );
+    }
+
+    catch ( std::runtime_error& )
+    {
+        newSamples.clear( );
+
+        std::istringstream newDataStream( newData );
+        std::string line;
+        while ( std::getline( newDataStream, line ) )
+        {
+            try
+            {
+                const basics::DoubleKeyDoubleValueMap lineSample
+                        = parseDoubleKeyDoubleValueMap( line );
+                newSamples[ lineSample.begin( )->first ] = lineSample.begin( )->second;
+            }
+
+            catch ( std::runtime_error& )
+            {
+                unparsableLines.push_back( line );
+            }
+        }
+    }
+
+    // Insert new samples, overwriting values of keys that are already present (e.g., samples
+    // read again after the input file was truncated or replaced).
+    const std::size_t previousNumberOfSamples = stepFunction.size( );
+    for ( basics::DoubleKeyDoubleValueMap::const_iterator iteratorSample = newSamples.begin( );
+          iteratorSample != newSamples.end( ); iteratorSample++ )
+    {
+        stepFunction.insert( stepFunction.end( ), *iteratorSample )->second
+                = iteratorSample->second;
+    }
+
+    return stepFunction.size( ) - previousNumberOfSamples;
+}
+
+} // namespace input_output
+} // namespace assist
@@ -0,0 +1,118 @@
+/*
+ *    Copyright (c) 2010-2014, Delft University of Technology
+ *    Copyright (c) 2010-2014, K. Kumar (me@kartikkumar.com)
+ *    All rights reserved.
+ *    See http://bit.ly/1jern3m for license details.
+ */
+
+#ifndef ASSIST_INCREMENTAL_INPUT_FILE_READER_H
+#define ASSIST_INCREMENTAL_INPUT_FILE_READER_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <boost/cstdint.hpp>
+
+#include "Assist/Basics/commonTypedefs.h"
+
+namespace assist
+{
+namespace input_output
+{
+
+//! Incremental reader for growing input files.
+/*!
+ * Reader that follows an input file (ASCII) that is continuously appended to, such as a live
+ * simulation log. Each poll reads only the bytes appended since the previous poll, starting from
+ * the last consumed byte offset, and filters them (see filterCommentsAndBlankLines()), so that
+ * the cost of a poll is proportional to the new data only. A partial last line (i.e., one that
+ * isn't terminated by a newline yet) is held back until it is completed. If the file is
+ * truncated, or replaced by a new file (detected through a change of inode), e.g., by log
+ * rotation, the reader starts again from the beginning of the file.
+ */
+class IncrementalInputFileReader
+{
+public:
+
+    //! Constructor taking input file name and comment character.
+    /*!
+     * Constructor taking input file name and comment character. The input file does not need to
+     * exist yet.
+     * \param anInputFileName Input file name.
+     * \param aCommentCharacter Comment character used to denote comment lines (default='#').
+     */
+    IncrementalInputFileReader( const std::string& anInputFileName,
+                                const char aCommentCharacter = '#' );
+
+    //! Read new data.
+    /*!
+     * Reads all complete lines appended to the input file since the previous call and filters
+     * out comments and blank lines. If the input file does not exist, an empty string is
+     * returned.
+     * \return Filtered new data as string (empty if there is no new data).
+     */
+    std::string readNewData( );
+
+    //! Read new samples into step-function map.
+    /*!
+     * Reads all complete lines appended to the input file since the previous call and parses
+     * them as key-value pairs (see parseDoubleKeyDoubleValueMap()), which are inserted into a
+     * given step-function map. Since samples in a log are typically appended in increasing key
+     * order, they are inserted with a hint at the end of the map, which is amortized O(1).
+     * Samples with keys that are already present, in the map or earlier in the new lines (e.g.,
+     * samples read again after the input file was truncated or replaced), overwrite the values,
+     * so that the last sample read for a key wins. Lines that cannot be parsed are skipped and
+     * returned, rather than thrown, so that a malformed line doesn't hold up the reader.
+     * \param stepFunction Step-function map to insert new samples into.
+     * \param unparsableLines Lines that could not be parsed and were skipped (cleared first).
+     * \return Number of samples inserted with keys that were not present yet.
+     */
+    std::size_t readNewSamples( basics::DoubleKeyDoubleValueMap& stepFunction,
+                                std::vector< std::string >& unparsableLines );
+
+    //! Get byte offset up to which the input file has been consumed.
+    /*!
+     * Returns the byte offset up to which the input file has been consumed, including the
+     * partial last line that is held back.
+     * \return Byte offset.
+     */
+    boost::uint64_t getOffset( ) const { return offset; }
+
+    //! Get number of times the input file was truncated or replaced.
+    /*!
+     * Returns the number of times the input file was detected to be truncated or replaced.
+     * \return Number of restarts.
+     */
+    unsigned int getNumberOfRestarts( ) const { return numberOfRestarts; }
+
+protected:
+
+private:
+
+    //! Input file name.
+    const std::string inputFileName;
+
+    //! Comment character used to denote comment lines.
+    const char commentCharacter;
+
+    //! Byte offset up to which the input file has been consumed.
+    boost::uint64_t offset;
+
+    //! Inode of input file at last poll.
+    boost::uint64_t inode;
+
+    //! Flag indicating if the input file has been opened before.
+    bool isFileSeen;
+
+    //! Partial last line, not yet terminated by a newline.
+    std::string partialLine;
+
+    //! Number of times the input file was truncated or replaced.
+    unsigned int numberOfRestarts;
+};
+
+} // namespace input_output
+} // namespace assist
+
+#endif // ASSIST_INCREMENTAL_INPUT_FILE_READER_H
@@ -0,0 +1,261 @@
+/*
+ *    Copyright (c) 2010-2014, Delft University of Technology
+ *    Copyright (c) 2010-2014, K. Kumar (me@kartikkumar.com)
+ *    All rights reserved.
+ *    See http://bit.ly/1jern3m for license details.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include "Assist/Basics/commonTypedefs.h"
+#include "Assist/Mathematics/covarianceMatrix.h"
+
+namespace assist
+{
+namespace unit_tests
+{
+
+namespace
+{
+
+//! Compute samples of correlated channels, with large means.
+/*!
+ * Computes samples of correlated channels, by mixing oscillating variates with an upper
+ * triangular matrix, and adds means from 1e6 to 2e6.
+ * \param numberOfSamples Number of samples.
+ * \param numberOfChannels Number of channels.
+ * \return Samples, with one row per sample and one column per channel.
+ */
+Eigen::MatrixXd computeCorrelatedSamples( const int numberOfSamples, const int numberOfChannels )
+{
+    Eigen::MatrixXd variates( numberOfSamples, numberOfChannels );
+    Eigen::MatrixXd mixing( numberOfChannels, numberOfChannels );
+    for ( int j = 0; j < numberOfChannels; j++ )
+    {
+        for ( int i = 0; i < numberOfSamples; i++ )
+        {
+            variates( i, j ) = std::sqrt( 2.0 ) * std::cos( 1.3 * ( i + 1 ) * ( j + 1 ) + 0.7 * j );
+        }
+
+        for ( int k = 0; k < numberOfChannels; k++ )
+        {
+            mixing( k, j ) = k <= j ? 10.0 * std::cos( 0.9 * ( k + 1 ) * ( j + 1 ) ) : 0.0;
+        }
+    }
+
+    Eigen::MatrixXd samples = variates * mixing;
+    samples.rowwise( ) += Eigen::RowVectorXd::LinSpaced( numberOfChannels, 1.0e6, 2.0e6 );
+    return samples;
+}
+
+//! Compute covariance matrix with two passes over samples, per pair of channels.
+Eigen::MatrixXd computeReferenceCovarianceMatrix( const Eigen::MatrixXd& samples )
+{
+    const Eigen::RowVectorXd means = samples.colwise( ).mean( );
+    Eigen::MatrixXd covarianceMatrix( samples.cols( ), samples.cols( ) );
+    for ( int j = 0; j < samples.cols( ); j++ )
+    {
+        for ( int k = 0; k < samples.cols( ); k++ )
+        {
+            double sum = 0.0;
+            for ( int i = 0; i < samples.rows( ); i++ )
+            {
+                sum += ( samples( i, j ) - means( j ) ) * ( samples( i, k ) - means( k ) );
+            }
+
+            covarianceMatrix( j, k ) = sum / ( samples.rows( ) - 1 );
+        }
+    }
+
+    return covarianceMatrix;
+}
+
+//! Compute largest difference between matrices, relative to largest element of second one.
+double computeRelativeDifference( const Eigen::MatrixXd& firstMatrix,
+                                  const Eigen::MatrixXd& secondMatrix )
+{
+    return ( firstMatrix - secondMatrix ).cwiseAbs( ).maxCoeff( )
+            / secondMatrix.cwiseAbs( ).maxCoeff( );
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE( test_covariance_matrix )
+
+//! Test covariance and correlation matrices of all samples.
+BOOST_AUTO_TEST_CASE( testCovarianceMatrix )
+{
+    // Set 5000 samples of 150 correlated channels, and compute reference covariance matrix.
+    const Eigen::MatrixXd samples = computeCorrelatedSamples( 5000, 150 );
+    const Eigen::MatrixXd expectedCovarianceMatrix = computeReferenceCovarianceMatrix( samples );
+
+    Eigen::MatrixXd covarianceMatrix;
+    mathematics::computeCovarianceMatrix( samples, covarianceMatrix );
+    BOOST_REQUIRE_EQUAL( covarianceMatrix.rows( ), 150 );
+    BOOST_REQUIRE_EQUAL( covarianceMatrix.cols( ), 150 );
+    BOOST_CHECK_SMALL( computeRelativeDifference( covarianceMatrix, expectedCovarianceMatrix ),
+                       1.0e-12 );
+    BOOST_CHECK( covarianceMatrix == covarianceMatrix.transpose( ) );
+
+    // Check that results are identical for multiple threads.
+    Eigen::MatrixXd parallelCovarianceMatrix;
+    mathematics::computeCovarianceMatrix( samples, parallelCovarianceMatrix, 4 );
+    BOOST_CHECK( parallelCovarianceMatrix == covarianceMatrix );
+
+    // Check correlation matrix against scaled covariance matrix.
+    Eigen::MatrixXd correlationMatrix;
+    mathematics::computeCorrelationMatrix( samples, correlationMatrix, 3 );
+    BOOST_CHECK( ( correlationMatrix.diagonal( ).array( ) == 1.0 ).all( ) );
+    for ( int j = 0; j < 150; j++ )
+    {
+        for ( int k = 0; k < j; k++ )
+        {
+            BOOST_CHECK_CLOSE_FRACTION(
+                        correlationMatrix( j, k ),
+                        expectedCovarianceMatrix( j, k )
+                        / std::sqrt( expectedCovarianceMatrix( j, j )
+                                     * expectedCovarianceMatrix( k, k ) ), 1.0e-10 );
+        }
+    }
+}
+
+//! Test streaming of samples in chunks, and merging of accumulators.
+BOOST_AUTO_TEST_CASE( testCovarianceMatrixAccumulator )
+{
+    // Set 5000 samples of 150 correlated channels, and compute reference covariance matrix.
+    const Eigen::MatrixXd samples = computeCorrelatedSamples( 5000, 150 );
+    const Eigen::MatrixXd expectedCovarianceMatrix = computeReferenceCovarianceMatrix( samples );
+
+    // Add samples in chunks of unequal sizes.
+    mathematics::CovarianceAccumulator accumulator( 150, 2 );
+    for ( int first = 0; first < 5000; first += 700 )
+    {
+        accumulator.addSamples( samples.middleRows( first, std::min( 700, 5000 - first ) ) );
+    }
+
+    BOOST_CHECK_EQUAL( accumulator.getNumberOfSamples( ), 5000 );
+    BOOST_CHECK_SMALL( computeRelativeDifference(
+                           accumulator.getMeans( ).transpose( ), samples.colwise( ).mean( ) ),
+                       1.0e-14 );
+    BOOST_CHECK_SMALL( computeRelativeDifference( accumulator.computeCovarianceMatrix( ),
+                                                  expectedCovarianceMatrix ), 1.0e-11 );
+
+    // Merge accumulators of halves of samples, as accumulated by separate threads.
+    mathematics::CovarianceAccumulator firstAccumulator( 150 );
+    mathematics::CovarianceAccumulator secondAccumulator( 150 );
+    firstAccumulator.addSamples( samples.topRows( 1234 ) );
+    secondAccumulator.addSamples( samples.bottomRows( 3766 ) );
+    firstAccumulator.merge( secondAccumulator );
+    firstAccumulator.merge( mathematics::CovarianceAccumulator( 150 ) );
+    BOOST_CHECK_EQUAL( firstAccumulator.getNumberOfSamples( ), 5000 );
+    BOOST_CHECK_SMALL( computeRelativeDifference( firstAccumulator.computeCovarianceMatrix( ),
+                                                  expectedCovarianceMatrix ), 1.0e-11 );
+}
+
+//! Test packing of aligned series.
+BOOST_AUTO_TEST_CASE( testCovarianceMatrixPackAlignedSeries )
+{
+    // Set 5000 samples of 3 correlated channels, and compute reference covariance matrix.
+    const Eigen::MatrixXd samples = computeCorrelatedSamples( 5000, 3 );
+    const Eigen::MatrixXd expectedCovarianceMatrix = computeReferenceCovarianceMatrix( samples );
+
+    std::vector< basics::DoubleKeyDoubleValueMap > series( 3 );
+    for ( int i = 0; i < 5000; i++ )
+    {
+        for ( int j = 0; j < 3; j++ )
+        {
+            series[ j ][ 0.1 * i ] = samples( i, j );
+        }
+    }
+
+    Eigen::MatrixXd packedSamples;
+    mathematics::packAlignedSeries( series, packedSamples );
+    BOOST_CHECK( packedSamples == samples );
+
+    Eigen::MatrixXd covarianceMatrix;
+    mathematics::computeCovarianceMatrix( packedSamples, covarianceMatrix );
+    BOOST_CHECK_SMALL( computeRelativeDifference( covarianceMatrix, expectedCovarianceMatrix ),
+                       1.0e-12 );
+}
+
+//! Test that run-time errors are thrown for invalid input.
+BOOST_AUTO_TEST_CASE( testCovarianceMatrixErrors )
+{
+    // Declare error flags.
+    bool isErrorThrownForNumberOfColumns = false;
+    bool isErrorThrownForMergedNumberOfChannels = false;
+    bool isErrorThrownForNumberOfSamples = false;
+    bool isErrorThrownForMisalignedSeries = false;
+
+    // Try to add samples with wrong number of columns.
+    try
+    {
+        mathematics::CovarianceAccumulator accumulator( 10 );
+        accumulator.addSamples( Eigen::MatrixXd::Ones( 5, 11 ) );
+    }
+
+    catch ( std::runtime_error& )
+    {
+        isErrorThrownForNumberOfColumns = true;
+    }
+
+    // Try to merge accumulators with different numbers of channels.
+    try
+    {
+        mathematics::CovarianceAccumulator accumulator( 10 );
+        accumulator.merge( mathematics::CovarianceAccumulator( 11 ) );
+    }
+
+    catch ( std::runtime_error& )
+    {
+        isErrorThrownForMergedNumberOfChannels = true;
+    }
+
+    // Try to compute covariance matrix of single sample.
+    try
+    {
+        Eigen::MatrixXd covarianceMatrix;
+        mathematics::computeCovarianceMatrix( Eigen::MatrixXd::Ones( 1, 3 ), covarianceMatrix );
+    }
+
+    catch ( std::runtime_error& )
+    {
+        isErrorThrownForNumberOfSamples = true;
+    }
+
+    // Try to pack series with different keys.
+    try
+    {
+        std::vector< basics::DoubleKeyDoubleValueMap > series( 2 );
+        series[ 0 ][ 1.0 ] = 1.0;
+        series[ 0 ][ 2.0 ] = 2.0;
+        series[ 1 ][ 1.0 ] = 1.0;
+        series[ 1 ][ 3.0 ] = 2.0;
+        Eigen::MatrixXd packedSamples;
+        mathematics::packAlignedSeries( series, packedSamples );
+    }
+
+    catch ( std::runtime_error& )
+    {
+        isErrorThrownForMisalignedSeries = true;
+    }
+
+    // Check that errors were thrown.
+    BOOST_CHECK( isErrorThrownForNumberOfColumns );
+    BOOST_CHECK( isErrorThrownForMergedNumberOfChannels );
+    BOOST_CHECK( isErrorThrownForNumberOfSamples );
+    BOOST_CHECK( isErrorThrownForMisalignedSeries );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace assist
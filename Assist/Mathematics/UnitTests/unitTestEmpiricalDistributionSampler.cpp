@@ -0,0 +1,200 @@
+/*
+ *    Copyright (c) 2010-2014, Delft University of Technology
+ *    Copyright (c) 2010-2014, K. Kumar (me@kartikkumar.com)
+ *    All rights reserved.
+ *    See http://bit.ly/1jern3m for license details.
+ */
+
+#include <cmath>
+#include <stdexcept>
+
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include "Assist/Basics/commonTypedefs.h"
+#include "Assist/Mathematics/empiricalDistributionSampler.h"
+#include "Assist/Mathematics/monteCarloSampler.h"
+
+namespace assist
+{
+namespace unit_tests
+{
+
+BOOST_AUTO_TEST_SUITE( test_empirical_distribution_sampler )
+
+//! Test that samples follow distribution.
+BOOST_AUTO_TEST_CASE( testEmpiricalDistributionSamplerDistribution )
+{
+    // Set probability density with bin probabilities 1/11, 6/11, 0 and 4/11.
+    basics::DoubleKeyDoubleValueMap probabilityDensity;
+    probabilityDensity[ 0.0 ] = 1.0;
+    probabilityDensity[ 1.0 ] = 3.0;
+    probabilityDensity[ 3.0 ] = 0.0;
+    probabilityDensity[ 4.0 ] = 2.0;
+    probabilityDensity[ 6.0 ] = 0.0;
+
+    const mathematics::EmpiricalDistributionSampler sampler( probabilityDensity );
+    const mathematics::MonteCarloSampler monteCarloSampler( 42 );
+
+    const int numberOfSamples = 1000000;
+    Eigen::ArrayXd samples;
+    sampler.generateSamples( monteCarloSampler, numberOfSamples, samples );
+    BOOST_REQUIRE_EQUAL( samples.size( ), numberOfSamples );
+
+    // Count samples in bins, and compute mean of samples in second bin.
+    const double edges[ 5 ] = { 0.0, 1.0, 3.0, 4.0, 6.0 };
+    const double probabilities[ 4 ] = { 1.0 / 11.0, 6.0 / 11.0, 0.0, 4.0 / 11.0 };
+    int counts[ 4 ] = { 0, 0, 0, 0 };
+    double sumOfSecondBin = 0.0;
+    for ( int i = 0; i < numberOfSamples; i++ )
+    {
+        BOOST_REQUIRE( samples( i ) >= 0.0 && samples( i ) < 6.0 );
+        int bin = 0;
+        while ( samples( i ) >= edges[ bin + 1 ] )
+        {
+            bin++;
+        }
+
+        counts[ bin ]++;
+        if ( bin == 1 )
+        {
+            sumOfSecondBin += samples( i );
+        }
+    }
+
+    // Check counts within five standard deviations, and that empty bin is never sampled.
+    for ( int b = 0; b < 4; b++ )
+    {
+        const double expectedCount = probabilities[ b ] * numberOfSamples;
+        BOOST_CHECK_SMALL( counts[ b ] - expectedCount,
+                           5.0 * std::sqrt( expectedCount * ( 1.0 - probabilities[ b ] ) ) );
+    }
+
+    BOOST_CHECK_EQUAL( counts[ 2 ], 0 );
+    BOOST_CHECK_CLOSE_FRACTION( sumOfSecondBin / counts[ 1 ], 2.0, 1.0e-3 );
+
+    // Check samples against samples drawn from uniform samples of stream.
+    Eigen::ArrayXd uniformSamples;
+    monteCarloSampler.generateUniformSamples( 2000, uniformSamples );
+    for ( int i = 0; i < 1000; i++ )
+    {
+        BOOST_CHECK_EQUAL( samples( i ), sampler.drawSample( uniformSamples( 2 * i ),
+                                                             uniformSamples( 2 * i + 1 ) ) );
+    }
+}
+
+//! Test that samples are independent of threads and chunks.
+BOOST_AUTO_TEST_CASE( testEmpiricalDistributionSamplerStreams )
+{
+    // Set probability density with bin probabilities 1/11, 6/11, 0 and 4/11.
+    basics::DoubleKeyDoubleValueMap probabilityDensity;
+    probabilityDensity[ 0.0 ] = 1.0;
+    probabilityDensity[ 1.0 ] = 3.0;
+    probabilityDensity[ 3.0 ] = 0.0;
+    probabilityDensity[ 4.0 ] = 2.0;
+    probabilityDensity[ 6.0 ] = 0.0;
+
+    const mathematics::EmpiricalDistributionSampler sampler( probabilityDensity );
+    const mathematics::MonteCarloSampler monteCarloSampler( 7 );
+    const mathematics::MonteCarloSampler parallelMonteCarloSampler( 7, 4 );
+
+    // Generate samples over multiple chunks, on one and multiple threads.
+    Eigen::ArrayXd samples;
+    Eigen::ArrayXd parallelSamples;
+    sampler.generateSamples( monteCarloSampler, 2500000, samples, 3 );
+    sampler.generateSamples( parallelMonteCarloSampler, 2500000, parallelSamples, 3 );
+    BOOST_CHECK( ( samples == parallelSamples ).all( ) );
+
+    // Check that subsequence of stream is reproduced, and that other streams differ.
+    Eigen::ArrayXd subsequence;
+    sampler.generateSamples( parallelMonteCarloSampler, 1000, subsequence, 3, 1048000 );
+    BOOST_CHECK( ( subsequence == samples.segment( 1048000, 1000 ) ).all( ) );
+
+    Eigen::ArrayXd otherSamples;
+    sampler.generateSamples( monteCarloSampler, 1000, otherSamples, 4 );
+    BOOST_CHECK( ( otherSamples != samples.head( 1000 ) ).any( ) );
+}
+
+//! Test that run-time errors are thrown for invalid input.
+BOOST_AUTO_TEST_CASE( testEmpiricalDistributionSamplerErrors )
+{
+    // Set probability density with bin probabilities 1/11, 6/11, 0 and 4/11.
+    basics::DoubleKeyDoubleValueMap probabilityDensity;
+    probabilityDensity[ 0.0 ] = 1.0;
+    probabilityDensity[ 1.0 ] = 3.0;
+    probabilityDensity[ 3.0 ] = 0.0;
+    probabilityDensity[ 4.0 ] = 2.0;
+    probabilityDensity[ 6.0 ] = 0.0;
+
+    // Declare error flags.
+    bool isErrorThrownForSingleKey = false;
+    bool isErrorThrownForNegativeDensity = false;
+    bool isErrorThrownForZeroProbability = false;
+    bool isErrorThrownForOddNumberOfUniformSamples = false;
+
+    // Try to create sampler for density with one key.
+    try
+    {
+        basics::DoubleKeyDoubleValueMap singleKeyDensity;
+        singleKeyDensity[ 0.0 ] = 1.0;
+        const mathematics::EmpiricalDistributionSampler sampler( singleKeyDensity );
+    }
+
+    catch ( std::runtime_error& )
+    {
+        isErrorThrownForSingleKey = true;
+    }
+
+    // Try to create sampler for density with negative value.
+    try
+    {
+        probabilityDensity[ 3.0 ] = -1.0;
+        const mathematics::EmpiricalDistributionSampler sampler( probabilityDensity );
+    }
+
+    catch ( std::runtime_error& )
+    {
+        isErrorThrownForNegativeDensity = true;
+    }
+
+    // Try to create sampler for density that is zero on all bins.
+    try
+    {
+        basics::DoubleKeyDoubleValueMap zeroDensity;
+        zeroDensity[ 0.0 ] = 0.0;
+        zeroDensity[ 1.0 ] = 1.0;
+        const mathematics::EmpiricalDistributionSampler sampler( zeroDensity );
+    }
+
+    catch ( std::runtime_error& )
+    {
+        isErrorThrownForZeroProbability = true;
+    }
+
+    // Try to transform odd number of uniform samples.
+    try
+    {
+        probabilityDensity[ 3.0 ] = 0.0;
+        const mathematics::EmpiricalDistributionSampler sampler( probabilityDensity );
+        Eigen::ArrayXd samples;
+        sampler.transformUniformSamples( Eigen::ArrayXd::Constant( 3, 0.5 ), samples );
+    }
+
+    catch ( std::runtime_error& )
+    {
+        isErrorThrownForOddNumberOfUniformSamples = true;
+    }
+
+    // Check that errors were thrown.
+    BOOST_CHECK( isErrorThrownForSingleKey );
+    BOOST_CHECK( isErrorThrownForNegativeDensity );
+    BOOST_CHECK( isErrorThrownForZeroProbability );
+    BOOST_CHECK( isErrorThrownForOddNumberOfUniformSamples );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace assist
@@ -0,0 +1,398 @@
+/*
+ *    Copyright (c) 2010-2014, Delft University of Technology
+ *    Copyright (c) 2010-2014, K. Kumar (me@kartikkumar.com)
+ *    All rights reserved.
+ *    See http://bit.ly/1jern3m for license details.
+ */
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include "Assist/Basics/commonTypedefs.h"
+#include "Assist/Mathematics/ensembleIntegrator.h"
+
+namespace assist
+{
+namespace unit_tests
+{
+
+//! Dynamics of isotropic harmonic oscillator.
+class HarmonicOscillatorModel : public mathematics::EnsembleDynamicsModel
+{
+public:
+
+    //! Constructor taking angular frequency.
+    HarmonicOscillatorModel( const double anAngularFrequency )
+        : angularFrequency( anAngularFrequency )
+    { }
+
+    //! Compute state derivatives, i.e., velocities and accelerations -omega^2 r.
+    void computeStateDerivatives( const Eigen::ArrayXd&, const Eigen::MatrixXd& states,
+                                  Eigen::MatrixXd& stateDerivatives ) const
+    {
+        stateDerivatives.leftCols( 3 ) = states.rightCols( 3 );
+        stateDerivatives.rightCols( 3 )
+                = -angularFrequency * angularFrequency * states.leftCols( 3 );
+    }
+
+    //! Angular frequency [rad s^-1].
+    const double angularFrequency;
+
+protected:
+
+private:
+};
+
+//! Dynamics of point mass in central gravity field.
+class TwoBodyModel : public mathematics::EnsembleDynamicsModel
+{
+public:
+
+    //! Constructor taking gravitational parameter.
+    TwoBodyModel( const double aGravitationalParameter )
+        : gravitationalParameter( aGravitationalParameter )
+    { }
+
+    //! Compute state derivatives, i.e., velocities and accelerations -mu r / |r|^3.
+    void computeStateDerivatives( const Eigen::ArrayXd&, const Eigen::MatrixXd& states,
+                                  Eigen::MatrixXd& stateDerivatives ) const
+    {
+        stateDerivatives.leftCols( 3 ) = states.rightCols( 3 );
+
+        // Store -mu / |r|^3 in last column of derivatives, which is overwritten last.
+        stateDerivatives.col( 5 ).array( ) = -gravitationalParameter
+                * ( states.col( 0 ).array( ).square( ) + states.col( 1 ).array( ).square( )
+                    + states.col( 2 ).array( ).square( ) ).pow( -1.5 );
+        for ( int c = 0; c < 3; c++ )
+        {
+            stateDerivatives.col( 3 + c ).array( )
+                    = stateDerivatives.col( 5 ).array( ) * states.col( c ).array( );
+        }
+    }
+
+    //! Gravitational parameter [m^3 s^-2].
+    const double gravitationalParameter;
+
+protected:
+
+private:
+};
+
+//! Dynamics that give non-finite state derivatives.
+class NonFiniteModel : public mathematics::EnsembleDynamicsModel
+{
+public:
+
+    //! Compute non-finite state derivatives.
+    void computeStateDerivatives( const Eigen::ArrayXd&, const Eigen::MatrixXd&,
+                                  Eigen::MatrixXd& stateDerivatives ) const
+    {
+        stateDerivatives.setConstant( std::numeric_limits< double >::quiet_NaN( ) );
+    }
+
+protected:
+
+private:
+};
+
+BOOST_AUTO_TEST_SUITE( test_ensemble_integrator )
+
+//! Test integration of harmonic oscillators against analytical solution.
+BOOST_AUTO_TEST_CASE( testEnsembleIntegratorHarmonicOscillator )
+{
+    const double angularFrequency = 0.05;
+    const HarmonicOscillatorModel model( angularFrequency );
+
+    // Set initial states with components spread over [-1, 1], and output epochs.
+    const int numberOfMembers = 150;
+    Eigen::MatrixXd initialStates( numberOfMembers, 6 );
+    for ( int i = 0; i < numberOfMembers; i++ )
+    {
+        for ( int c = 0; c < 6; c++ )
+        {
+            initialStates( i, c ) = std::cos( 0.37 * ( i + 1 ) * ( c + 1 ) );
+        }
+    }
+
+    std::vector< double > outputEpochs;
+    for ( int k = 0; k <= 50; k++ )
+    {
+        outputEpochs.push_back( 100.0 + 25.0 * k );
+    }
+
+    const mathematics::EnsembleIntegratorType integratorTypes[ 2 ]
+            = { mathematics::rungeKutta4Integrator, mathematics::dormandPrince45Integrator };
+    const double tolerances[ 2 ] = { 1.0e-5, 1.0e-8 };
+
+    for ( int t = 0; t < 2; t++ )
+    {
+        // Integrate ensemble with step size of 0.4 s, in batches of 32 members.
+        const mathematics::EnsembleIntegrator integrator(
+                    model, integratorTypes[ t ], 0.4, 1.0e-11, 1.0e-11, 32 );
+        std::vector< basics::DoubleKeyVector6dValueMap > stateHistories;
+        integrator.integrate( 100.0, initialStates, outputEpochs, stateHistories );
+
+        // Check that states are stored at output epochs, and match the analytical solution.
+        BOOST_REQUIRE_EQUAL( stateHistories.size( ), numberOfMembers );
+        for ( int i = 0; i < numberOfMembers; i++ )
+        {
+            BOOST_REQUIRE_EQUAL( stateHistories[ i ].size( ), outputEpochs.size( ) );
+
+            std::size_t k = 0;
+            for ( basics::DoubleKeyVector6dValueMap::const_iterator iteratorState
+                  = stateHistories[ i ].begin( );
+                  iteratorState != stateHistories[ i ].end( ); iteratorState++, k++ )
+            {
+                BOOST_CHECK_EQUAL( iteratorState->first, outputEpochs[ k ] );
+
+                const double phase = angularFrequency * ( iteratorState->first - 100.0 );
+                for ( int c = 0; c < 3; c++ )
+                {
+                    const double position = initialStates( i, c ) * std::cos( phase )
+                            + initialStates( i, 3 + c ) / angularFrequency * std::sin( phase );
+                    const double velocity = initialStates( i, 3 + c ) * std::cos( phase )
+                            - initialStates( i, c ) * angularFrequency * std::sin( phase );
+                    BOOST_CHECK_SMALL( iteratorState->second( c ) - position, tolerances[ t ] );
+                    BOOST_CHECK_SMALL( iteratorState->second( 3 + c ) - velocity,
+                                       angularFrequency * tolerances[ t ] );
+                }
+            }
+        }
+    }
+}
+
+//! Test integration of orbits with adaptive integrator against analytical solution.
+BOOST_AUTO_TEST_CASE( testEnsembleIntegratorCircularOrbits )
+{
+    const double gravitationalParameter = 3.986004418e14;
+    const TwoBodyModel model( gravitationalParameter );
+
+    // Set circular orbits with radii from 7000 km to 42000 km, in different planes.
+    Eigen::MatrixXd orbitStates( 40, 6 );
+    Eigen::VectorXd radii( 40 );
+    for ( int i = 0; i < 40; i++ )
+    {
+        radii( i ) = 7.0e6 + i * 35.0e6 / 39.0;
+        const double speed = std::sqrt( gravitationalParameter / radii( i ) );
+        const double inclination = 0.05 * i;
+        orbitStates.row( i ) << radii( i ), 0.0, 0.0,
+                0.0, speed * std::cos( inclination ), speed * std::sin( inclination );
+    }
+
+    std::vector< double > orbitOutputEpochs;
+    for ( int k = 0; k <= 24; k++ )
+    {
+        orbitOutputEpochs.push_back( 3600.0 * k );
+    }
+
+    // Integrate orbits, which require different numbers of steps, in batches of 8 members.
+    const mathematics::EnsembleIntegrator integrator(
+                model, mathematics::dormandPrince45Integrator, 60.0, 1.0e-12, 1.0e-6, 8, 2 );
+    std::vector< basics::DoubleKeyVector6dValueMap > stateHistories;
+    integrator.integrate( 0.0, orbitStates, orbitOutputEpochs, stateHistories );
+
+    // Check that initial states are stored, and that positions match circular motion.
+    BOOST_REQUIRE_EQUAL( stateHistories.size( ), 40 );
+    for ( int i = 0; i < 40; i++ )
+    {
+        BOOST_REQUIRE_EQUAL( stateHistories[ i ].size( ), orbitOutputEpochs.size( ) );
+        BOOST_CHECK( stateHistories[ i ].begin( )->second == orbitStates.row( i ).transpose( ) );
+
+        const double angularVelocity
+                = std::sqrt( gravitationalParameter / ( radii( i ) * radii( i ) * radii( i ) ) );
+        const double inclination = 0.05 * i;
+        for ( basics::DoubleKeyVector6dValueMap::const_iterator iteratorState
+              = stateHistories[ i ].begin( );
+              iteratorState != stateHistories[ i ].end( ); iteratorState++ )
+        {
+            const double angle = angularVelocity * iteratorState->first;
+            Eigen::Vector3d expectedPosition;
+            expectedPosition << std::cos( angle ),
+                    std::sin( angle ) * std::cos( inclination ),
+                    std::sin( angle ) * std::sin( inclination );
+            expectedPosition *= radii( i );
+
+            BOOST_CHECK_SMALL( ( iteratorState->second.segment< 3 >( 0 )
+                                 - expectedPosition ).norm( ), 1.0 );
+        }
+    }
+}
+
+//! Test that results do not depend on number of threads and batch size.
+BOOST_AUTO_TEST_CASE( testEnsembleIntegratorThreads )
+{
+    const TwoBodyModel model( 1.0 );
+
+    // Set eccentric orbits, which require different numbers of adaptive steps.
+    const int numberOfMembers = 150;
+    Eigen::MatrixXd orbitStates = Eigen::MatrixXd::Zero( numberOfMembers, 6 );
+    for ( int i = 0; i < numberOfMembers; i++ )
+    {
+        orbitStates( i, 0 ) = 1.0;
+        orbitStates( i, 4 ) = 0.6 + 0.6 * std::fabs( std::cos( 0.37 * ( i + 1 ) ) );
+        orbitStates( i, 5 ) = 0.1 * std::cos( 0.74 * ( i + 1 ) );
+    }
+
+    std::vector< double > orbitOutputEpochs;
+    for ( int k = 1; k <= 20; k++ )
+    {
+        orbitOutputEpochs.push_back( 1.5 * k );
+    }
+
+    const mathematics::EnsembleIntegrator integrator(
+                model, mathematics::dormandPrince45Integrator, 0.01, 1.0e-10, 1.0e-10, 16 );
+    const mathematics::EnsembleIntegrator integratorInParallel(
+                model, mathematics::dormandPrince45Integrator, 0.01, 1.0e-10, 1.0e-10, 16, 4 );
+    const mathematics::EnsembleIntegrator integratorWithSingleMemberBatches(
+                model, mathematics::dormandPrince45Integrator, 0.01, 1.0e-10, 1.0e-10, 1, 3 );
+
+    std::vector< basics::DoubleKeyVector6dValueMap > stateHistories;
+    std::vector< basics::DoubleKeyVector6dValueMap > stateHistoriesInParallel;
+    std::vector< basics::DoubleKeyVector6dValueMap > stateHistoriesOfSingleMembers;
+    integrator.integrate( 0.0, orbitStates, orbitOutputEpochs, stateHistories );
+    integratorInParallel.integrate( 0.0, orbitStates, orbitOutputEpochs,
+                                    stateHistoriesInParallel );
+    integratorWithSingleMemberBatches.integrate( 0.0, orbitStates, orbitOutputEpochs,
+                                                 stateHistoriesOfSingleMembers );
+
+    // Check that results are identical for different numbers of threads, and agree for
+    // different batch sizes.
+    for ( int i = 0; i < numberOfMembers; i++ )
+    {
+        BOOST_REQUIRE_EQUAL( stateHistories[ i ].size( ), orbitOutputEpochs.size( ) );
+        BOOST_CHECK( stateHistoriesInParallel[ i ] == stateHistories[ i ] );
+
+        BOOST_REQUIRE_EQUAL( stateHistoriesOfSingleMembers[ i ].size( ),
+                             orbitOutputEpochs.size( ) );
+        BOOST_CHECK_SMALL( ( stateHistoriesOfSingleMembers[ i ].rbegin( )->second
+                             - stateHistories[ i ].rbegin( )->second ).norm( ), 1.0e-12 );
+    }
+}
+
+//! Test that run-time errors are thrown for invalid input.
+BOOST_AUTO_TEST_CASE( testEnsembleIntegratorErrors )
+{
+    // Declare error flags.
+    bool isErrorThrownForStepSize = false;
+    bool isErrorThrownForTolerance = false;
+    bool isErrorThrownForBatchSize = false;
+    bool isErrorThrownForStates = false;
+    bool isErrorThrownForFirstOutputEpoch = false;
+    bool isErrorThrownForOutputEpochs = false;
+    bool isErrorThrownForMinimumStepSize = false;
+
+    const HarmonicOscillatorModel model( 1.0 );
+    std::vector< basics::DoubleKeyVector6dValueMap > stateHistories;
+
+    // Set initial states and output epochs.
+    const Eigen::MatrixXd initialStates = Eigen::MatrixXd::Ones( 40, 6 );
+    std::vector< double > outputEpochs;
+    for ( int k = 0; k <= 10; k++ )
+    {
+        outputEpochs.push_back( 100.0 + 25.0 * k );
+    }
+
+    // Try to create integrators with invalid settings.
+    try
+    {
+        mathematics::EnsembleIntegrator integrator(
+                    model, mathematics::rungeKutta4Integrator, 0.0 );
+    }
+
+    catch ( std::runtime_error& )
+    {
+        isErrorThrownForStepSize = true;
+    }
+
+    try
+    {
+        mathematics::EnsembleIntegrator integrator(
+                    model, mathematics::dormandPrince45Integrator, 1.0, 1.0e-10, -1.0 );
+    }
+
+    catch ( std::runtime_error& )
+    {
+        isErrorThrownForTolerance = true;
+    }
+
+    try
+    {
+        mathematics::EnsembleIntegrator integrator(
+                    model, mathematics::dormandPrince45Integrator, 1.0, 1.0e-10, 1.0e-10, 0 );
+    }
+
+    catch ( std::runtime_error& )
+    {
+        isErrorThrownForBatchSize = true;
+    }
+
+    // Try to integrate states with wrong number of columns.
+    const mathematics::EnsembleIntegrator integrator( model );
+    try
+    {
+        integrator.integrate( 100.0, initialStates.leftCols( 3 ), outputEpochs, stateHistories );
+    }
+
+    catch ( std::runtime_error& )
+    {
+        isErrorThrownForStates = true;
+    }
+
+    // Try to integrate to output epochs before initial epoch, and in wrong order.
+    try
+    {
+        integrator.integrate( 200.0, initialStates, outputEpochs, stateHistories );
+    }
+
+    catch ( std::runtime_error& )
+    {
+        isErrorThrownForFirstOutputEpoch = true;
+    }
+
+    try
+    {
+        std::vector< double > unsortedOutputEpochs = outputEpochs;
+        unsortedOutputEpochs[ 5 ] = unsortedOutputEpochs[ 4 ];
+        integrator.integrate( 100.0, initialStates, unsortedOutputEpochs, stateHistories );
+    }
+
+    catch ( std::runtime_error& )
+    {
+        isErrorThrownForOutputEpochs = true;
+    }
+
+    // Try to integrate dynamics with non-finite derivatives, in parallel.
+    try
+    {
+        const NonFiniteModel nonFiniteModel;
+        const mathematics::EnsembleIntegrator nonFiniteIntegrator(
+                    nonFiniteModel, mathematics::dormandPrince45Integrator, 1.0, 1.0e-10,
+                    1.0e-10, 16, 4 );
+        nonFiniteIntegrator.integrate( 100.0, initialStates, outputEpochs, stateHistories );
+    }
+
+    catch ( std::runtime_error& )
+    {
+        isErrorThrownForMinimumStepSize = true;
+    }
+
+    // Check that errors were thrown.
+    BOOST_CHECK( isErrorThrownForStepSize );
+    BOOST_CHECK( isErrorThrownForTolerance );
+    BOOST_CHECK( isErrorThrownForBatchSize );
+    BOOST_CHECK( isErrorThrownForStates );
+    BOOST_CHECK( isErrorThrownForFirstOutputEpoch );
+    BOOST_CHECK( isErrorThrownForOutputEpochs );
+    BOOST_CHECK( isErrorThrownForMinimumStepSize );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace assist
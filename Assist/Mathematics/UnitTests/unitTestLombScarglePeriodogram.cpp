@@ -0,0 +1,301 @@
+/*
+ *    Copyright (c) 2010-2014, Delft University of Technology
+ *    Copyright (c) 2010-2014, K. Kumar (me@kartikkumar.com)
+ *    All rights reserved.
+ *    See http://bit.ly/1jern3m for license details.
+ */
+
+#include <cmath>
+#include <stdexcept>
+
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include <TudatCore/Mathematics/BasicMathematics/mathematicalConstants.h>
+
+#include "Assist/Basics/commonTypedefs.h"
+#include "Assist/Mathematics/lombScarglePeriodogram.h"
+
+namespace assist
+{
+namespace unit_tests
+{
+
+namespace
+{
+
+//! Frequency of sinusoid.
+const double signalFrequency = 0.37;
+
+//! Step between frequencies.
+const double frequencyStep = 1.0e-3;
+
+//! Number of frequencies.
+const std::size_t numberOfFrequencies = 2000;
+
+//! Compute normalized power at given frequency from definition, with explicit time offset.
+double computeReferencePower( const Eigen::ArrayXd& epochs, const Eigen::ArrayXd& values,
+                              const double frequency )
+{
+    using tudat::basic_mathematics::mathematical_constants::PI;
+    const double angularFrequency = 2.0 * PI * frequency;
+    const double mean = values.mean( );
+    const double variance = ( values - mean ).square( ).sum( ) / ( values.size( ) - 1 );
+
+    double doubleSineSum = 0.0;
+    double doubleCosineSum = 0.0;
+    for ( int i = 0; i < epochs.size( ); i++ )
+    {
+        doubleSineSum += std::sin( 2.0 * angularFrequency * epochs( i ) );
+        doubleCosineSum += std::cos( 2.0 * angularFrequency * epochs( i ) );
+    }
+
+    const double offset = std::atan2( doubleSineSum, doubleCosineSum )
+            / ( 2.0 * angularFrequency );
+
+    double cosineSum = 0.0;
+    double sineSum = 0.0;
+    double squaredCosineSum = 0.0;
+    double squaredSineSum = 0.0;
+    for ( int i = 0; i < epochs.size( ); i++ )
+    {
+        const double phase = angularFrequency * ( epochs( i ) - offset );
+        cosineSum += ( values( i ) - mean ) * std::cos( phase );
+        sineSum += ( values( i ) - mean ) * std::sin( phase );
+        squaredCosineSum += std::cos( phase ) * std::cos( phase );
+        squaredSineSum += std::sin( phase ) * std::sin( phase );
+    }
+
+    return ( cosineSum * cosineSum / squaredCosineSum + sineSum * sineSum / squaredSineSum )
+            / ( 2.0 * variance );
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE( test_lomb_scargle_periodogram )
+
+//! Test direct evaluation against definition, and that it is independent of number of threads.
+BOOST_AUTO_TEST_CASE( testLombScarglePeriodogramDirectEvaluation )
+{
+    using tudat::basic_mathematics::mathematical_constants::PI;
+
+    // Set sinusoid with frequency of 0.37 and noise of unit variance, sampled at 500 scattered
+    // epochs in [0, 100].
+    Eigen::ArrayXd epochs( 500 );
+    Eigen::ArrayXd values( 500 );
+    for ( int i = 0; i < epochs.size( ); i++ )
+    {
+        epochs( i ) = 100.0 * std::fmod( 0.618033988749895 * ( i + 1 ), 1.0 );
+        values( i ) = 3.0 + std::sin( 2.0 * PI * signalFrequency * epochs( i ) )
+                + std::sqrt( 12.0 ) * ( std::fmod( 0.414213562373095 * ( i + 1 ), 1.0 ) - 0.5 );
+    }
+
+    Eigen::ArrayXd powers;
+    mathematics::computeDirectLombScarglePeriodogram( epochs, values, frequencyStep,
+                                                      numberOfFrequencies, powers );
+    BOOST_REQUIRE_EQUAL( powers.size( ), 2000 );
+
+    // Check powers against definition.
+    for ( int k = 0; k < powers.size( ); k += 37 )
+    {
+        const double referencePower
+                = computeReferencePower( epochs, values, ( k + 1 ) * frequencyStep );
+        BOOST_CHECK_CLOSE_FRACTION( powers( k ), referencePower, 1.0e-9 );
+    }
+
+    // Check that peak is at frequency of sinusoid.
+    Eigen::ArrayXd::Index peakIndex = 0;
+    powers.maxCoeff( &peakIndex );
+    BOOST_CHECK_SMALL( ( peakIndex + 1 ) * frequencyStep - signalFrequency, 2.0e-3 );
+
+    // Check that results are identical for multiple threads.
+    Eigen::ArrayXd powersInParallel;
+    mathematics::computeDirectLombScarglePeriodogram( epochs, values, frequencyStep,
+                                                      numberOfFrequencies, powersInParallel, 3 );
+    BOOST_CHECK( ( powersInParallel == powers ).all( ) );
+}
+
+//! Test fast evaluation against direct evaluation.
+BOOST_AUTO_TEST_CASE( testLombScarglePeriodogramFastEvaluation )
+{
+    using tudat::basic_mathematics::mathematical_constants::PI;
+
+    // Set sinusoid with frequency of 0.37 and noise of unit variance, sampled at 500 scattered
+    // epochs in [0, 100].
+    Eigen::ArrayXd epochs( 500 );
+    Eigen::ArrayXd values( 500 );
+    for ( int i = 0; i < epochs.size( ); i++ )
+    {
+        epochs( i ) = 100.0 * std::fmod( 0.618033988749895 * ( i + 1 ), 1.0 );
+        values( i ) = 3.0 + std::sin( 2.0 * PI * signalFrequency * epochs( i ) )
+                + std::sqrt( 12.0 ) * ( std::fmod( 0.414213562373095 * ( i + 1 ), 1.0 ) - 0.5 );
+    }
+
+    Eigen::ArrayXd directPowers;
+    Eigen::ArrayXd fastPowers;
+    mathematics::computeDirectLombScarglePeriodogram( epochs, values, frequencyStep,
+                                                      numberOfFrequencies, directPowers );
+    mathematics::computeFastLombScarglePeriodogram( epochs, values, frequencyStep,
+                                                    numberOfFrequencies, fastPowers );
+
+    BOOST_REQUIRE_EQUAL( fastPowers.size( ), directPowers.size( ) );
+    BOOST_CHECK_SMALL( ( fastPowers - directPowers ).abs( ).maxCoeff( )
+                       / directPowers.maxCoeff( ), 1.0e-4 );
+
+    // Check that fast evaluation is independent of offset of epochs.
+    const Eigen::ArrayXd shiftedEpochs = epochs + 1.0e6;
+    Eigen::ArrayXd shiftedFastPowers;
+    mathematics::computeFastLombScarglePeriodogram( shiftedEpochs, values, frequencyStep,
+                                                    numberOfFrequencies, shiftedFastPowers );
+    BOOST_CHECK_SMALL( ( shiftedFastPowers - directPowers ).abs( ).maxCoeff( )
+                       / directPowers.maxCoeff( ), 1.0e-4 );
+
+    // Check that direct evaluation is selected for small problems, and fast evaluation otherwise.
+    Eigen::ArrayXd powers;
+    mathematics::computeLombScarglePeriodogram( epochs, values, frequencyStep,
+                                                numberOfFrequencies, powers );
+    BOOST_CHECK( ( powers == directPowers ).all( ) );
+
+    mathematics::computeFastLombScarglePeriodogram( epochs, values, frequencyStep, 4000,
+                                                    fastPowers );
+    mathematics::computeLombScarglePeriodogram( epochs, values, frequencyStep, 4000, powers );
+    BOOST_CHECK( ( powers == fastPowers ).all( ) );
+}
+
+//! Test periodogram of series.
+BOOST_AUTO_TEST_CASE( testLombScarglePeriodogramSeries )
+{
+    using tudat::basic_mathematics::mathematical_constants::PI;
+
+    // Set sinusoid with frequency of 0.37 and noise of unit variance, sampled at 500 scattered
+    // epochs in [0, 100].
+    Eigen::ArrayXd epochs( 500 );
+    Eigen::ArrayXd values( 500 );
+    for ( int i = 0; i < epochs.size( ); i++ )
+    {
+        epochs( i ) = 100.0 * std::fmod( 0.618033988749895 * ( i + 1 ), 1.0 );
+        values( i ) = 3.0 + std::sin( 2.0 * PI * signalFrequency * epochs( i ) )
+                + std::sqrt( 12.0 ) * ( std::fmod( 0.414213562373095 * ( i + 1 ), 1.0 ) - 0.5 );
+    }
+
+    basics::DoubleKeyDoubleValueMap series;
+    for ( int i = 0; i < epochs.size( ); i++ )
+    {
+        series[ epochs( i ) ] = values( i );
+    }
+
+    // Sort samples by epoch, as in series.
+    Eigen::ArrayXd sortedEpochs( epochs.size( ) );
+    Eigen::ArrayXd sortedValues( values.size( ) );
+    int i = 0;
+    for ( basics::DoubleKeyDoubleValueMap::const_iterator iteratorSample = series.begin( );
+          iteratorSample != series.end( ); iteratorSample++, i++ )
+    {
+        sortedEpochs( i ) = iteratorSample->first;
+        sortedValues( i ) = iteratorSample->second;
+    }
+
+    Eigen::ArrayXd powers;
+    mathematics::computeLombScarglePeriodogram( sortedEpochs, sortedValues, frequencyStep,
+                                                numberOfFrequencies, powers );
+
+    const basics::DoubleKeyDoubleValueMap periodogram
+            = mathematics::computeLombScarglePeriodogram( series, frequencyStep,
+                                                          numberOfFrequencies );
+    BOOST_REQUIRE_EQUAL( periodogram.size( ), numberOfFrequencies );
+
+    int k = 0;
+    for ( basics::DoubleKeyDoubleValueMap::const_iterator iteratorFrequency
+          = periodogram.begin( ); iteratorFrequency != periodogram.end( );
+          iteratorFrequency++, k++ )
+    {
+        BOOST_CHECK_CLOSE_FRACTION( iteratorFrequency->first, ( k + 1 ) * frequencyStep,
+                                    1.0e-15 );
+        BOOST_CHECK_EQUAL( iteratorFrequency->second, powers( k ) );
+    }
+}
+
+//! Test that run-time errors are thrown for invalid input.
+BOOST_AUTO_TEST_CASE( testLombScarglePeriodogramErrors )
+{
+    using tudat::basic_mathematics::mathematical_constants::PI;
+
+    // Set sinusoid with frequency of 0.37 and noise of unit variance, sampled at 500 scattered
+    // epochs in [0, 100].
+    Eigen::ArrayXd epochs( 500 );
+    Eigen::ArrayXd values( 500 );
+    for ( int i = 0; i < epochs.size( ); i++ )
+    {
+        epochs( i ) = 100.0 * std::fmod( 0.618033988749895 * ( i + 1 ), 1.0 );
+        values( i ) = 3.0 + std::sin( 2.0 * PI * signalFrequency * epochs( i ) )
+                + std::sqrt( 12.0 ) * ( std::fmod( 0.414213562373095 * ( i + 1 ), 1.0 ) - 0.5 );
+    }
+
+    // Declare error flags.
+    bool isErrorThrownForSizes = false;
+    bool isErrorThrownForNumberOfSamples = false;
+    bool isErrorThrownForVariance = false;
+    bool isErrorThrownForFrequencyStep = false;
+
+    Eigen::ArrayXd powers;
+
+    // Try to compute periodogram for arrays with mismatching sizes.
+    try
+    {
+        mathematics::computeDirectLombScarglePeriodogram( epochs, values.head( 499 ),
+                                                          frequencyStep, 10, powers );
+    }
+
+    catch ( std::runtime_error& )
+    {
+        isErrorThrownForSizes = true;
+    }
+
+    // Try to compute periodogram for single sample.
+    try
+    {
+        mathematics::computeFastLombScarglePeriodogram( epochs.head( 1 ), values.head( 1 ),
+                                                        frequencyStep, 10, powers );
+    }
+
+    catch ( std::runtime_error& )
+    {
+        isErrorThrownForNumberOfSamples = true;
+    }
+
+    // Try to compute periodogram for constant values.
+    try
+    {
+        mathematics::computeLombScarglePeriodogram( epochs, Eigen::ArrayXd::Ones( 500 ),
+                                                    frequencyStep, 10, powers );
+    }
+
+    catch ( std::runtime_error& )
+    {
+        isErrorThrownForVariance = true;
+    }
+
+    // Try to compute periodogram with zero frequency step.
+    try
+    {
+        mathematics::computeLombScarglePeriodogram( epochs, values, 0.0, 10, powers );
+    }
+
+    catch ( std::runtime_error& )
+    {
+        isErrorThrownForFrequencyStep = true;
+    }
+
+    // Check that errors were thrown.
+    BOOST_CHECK( isErrorThrownForSizes );
+    BOOST_CHECK( isErrorThrownForNumberOfSamples );
+    BOOST_CHECK( isErrorThrownForVariance );
+    BOOST_CHECK( isErrorThrownForFrequencyStep );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace assist
@@ -0,0 +1,209 @@
+/*
+ *    Copyright (c) 2010-2014, Delft University of Technology
+ *    Copyright (c) 2010-2014, K. Kumar (me@kartikkumar.com)
+ *    All rights reserved.
+ *    See http://bit.ly/1jern3m for license details.
+ */
+
+#include <cmath>
+#include <stdexcept>
+
+#include <boost/cstdint.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include "Assist/Mathematics/monteCarloSampler.h"
+#include "Assist/Mathematics/statistics.h"
+
+namespace assist
+{
+namespace unit_tests
+{
+
+BOOST_AUTO_TEST_SUITE( test_monte_carlo_sampler )
+
+//! Test Philox-4x32-10 against known-answer test vectors (Salmon et al., 2011).
+BOOST_AUTO_TEST_CASE( testComputePhilox4x32BlockFunction )
+{
+    const boost::uint32_t counters[ 3 ][ 4 ]
+            = { { 0u, 0u, 0u, 0u },
+                { 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu },
+                { 0x243F6A88u, 0x85A308D3u, 0x13198A2Eu, 0x03707344u } };
+    const boost::uint32_t keys[ 3 ][ 2 ]
+            = { { 0u, 0u }, { 0xFFFFFFFFu, 0xFFFFFFFFu }, { 0xA4093822u, 0x299F31D0u } };
+    const boost::uint32_t expectedBlocks[ 3 ][ 4 ]
+            = { { 0x6627E8D5u, 0xE169C58Du, 0xBC57AC4Cu, 0x9B00DBD8u },
+                { 0x408F276Du, 0x41C83B0Eu, 0xA20BC7C6u, 0x6D5451FDu },
+                { 0xD16CFE09u, 0x94FDCCEBu, 0x5001E420u, 0x24126EA1u } };
+
+    for ( int t = 0; t < 3; t++ )
+    {
+        boost::uint32_t block[ 4 ];
+        mathematics::computePhilox4x32Block( counters[ t ], keys[ t ], block );
+
+        for ( int k = 0; k < 4; k++ )
+        {
+            BOOST_CHECK_EQUAL( block[ k ], expectedBlocks[ t ][ k ] );
+        }
+    }
+}
+
+//! Test conversion of random words to uniform random numbers at the edges of the interval.
+BOOST_AUTO_TEST_CASE( testConvertToUniformRandomNumberFunction )
+{
+    // Check that all-zero and all-one words map to half a step inside the open interval.
+    BOOST_CHECK_EQUAL( mathematics::convertToUniformRandomNumber( 0u, 0u ),
+                       0.5 / 4503599627370496.0 );
+    BOOST_CHECK_EQUAL( mathematics::convertToUniformRandomNumber( 0xFFFFFFFFu, 0xFFFFFFFFu ),
+                       1.0 - 0.5 / 4503599627370496.0 );
+    BOOST_CHECK( mathematics::convertToUniformRandomNumber( 0xFFFFFFFFu, 0xFFFFFFFFu ) < 1.0 );
+
+    // Check that the lower 12 bits are ignored.
+    BOOST_CHECK_EQUAL( mathematics::convertToUniformRandomNumber( 0xFFFFF000u, 0xFFFFFFFFu ),
+                       mathematics::convertToUniformRandomNumber( 0xFFFFFFFFu, 0xFFFFFFFFu ) );
+}
+
+//! Test that samples are pure functions of seed, stream and sample index.
+BOOST_AUTO_TEST_CASE( testMonteCarloSamplerReproducibility )
+{
+    const mathematics::MonteCarloSampler sampler( 42 );
+    const mathematics::MonteCarloSampler samplerInParallel( 42, 4 );
+
+    // Generate samples with one and multiple threads, and in parts.
+    Eigen::ArrayXd uniformSamples;
+    Eigen::ArrayXd uniformSamplesInParallel;
+    Eigen::ArrayXd uniformSamplesPart;
+    sampler.generateUniformSamples( 300001, uniformSamples, 7 );
+    samplerInParallel.generateUniformSamples( 300001, uniformSamplesInParallel, 7 );
+    sampler.generateUniformSamples( 1001, uniformSamplesPart, 7, 123457 );
+
+    Eigen::ArrayXd normalSamples;
+    Eigen::ArrayXd normalSamplesInParallel;
+    Eigen::ArrayXd normalSamplesPart;
+    sampler.generateNormalSamples( 300001, normalSamples, 7 );
+    samplerInParallel.generateNormalSamples( 300001, normalSamplesInParallel, 7 );
+    samplerInParallel.generateNormalSamples( 1001, normalSamplesPart, 7, 123457 );
+
+    // Check that results are bit-identical.
+    BOOST_CHECK( ( uniformSamplesInParallel == uniformSamples ).all( ) );
+    BOOST_CHECK( ( uniformSamplesPart == uniformSamples.segment( 123457, 1001 ) ).all( ) );
+    BOOST_CHECK( ( normalSamplesInParallel == normalSamples ).all( ) );
+    BOOST_CHECK( ( normalSamplesPart == normalSamples.segment( 123457, 1001 ) ).all( ) );
+
+    // Check that other seeds and streams give other samples.
+    Eigen::ArrayXd otherSamples;
+    mathematics::MonteCarloSampler( 43 ).generateUniformSamples( 100, otherSamples, 7 );
+    BOOST_CHECK( ( otherSamples != uniformSamples.head( 100 ) ).all( ) );
+    sampler.generateUniformSamples( 100, otherSamples, 8 );
+    BOOST_CHECK( ( otherSamples != uniformSamples.head( 100 ) ).all( ) );
+}
+
+//! Test statistics of uniform and normal samples.
+BOOST_AUTO_TEST_CASE( testMonteCarloSamplerStatistics )
+{
+    const std::size_t numberOfSamples = 1000000;
+    const mathematics::MonteCarloSampler sampler( 2014, 2 );
+
+    // Check mean and variance of uniform samples, which lie in the open interval (0, 1).
+    Eigen::ArrayXd samples;
+    sampler.generateUniformSamples( numberOfSamples, samples );
+    BOOST_CHECK_GT( samples.minCoeff( ), 0.0 );
+    BOOST_CHECK_LT( samples.maxCoeff( ), 1.0 );
+    BOOST_CHECK_SMALL( samples.mean( ) - 0.5, 2.0e-3 );
+    BOOST_CHECK_SMALL( ( samples - 0.5 ).square( ).mean( ) - 1.0 / 12.0, 1.0e-3 );
+
+    // Check mean, variance, kurtosis and tail fraction of normal samples.
+    sampler.generateNormalSamples( numberOfSamples, samples );
+    const double variance = samples.square( ).mean( );
+    BOOST_CHECK_SMALL( samples.mean( ), 5.0e-3 );
+    BOOST_CHECK_SMALL( variance - 1.0, 5.0e-3 );
+    BOOST_CHECK_SMALL( samples.square( ).square( ).mean( ) / ( variance * variance ) - 3.0,
+                       3.0e-2 );
+    BOOST_CHECK_SMALL( ( samples.abs( ) > 2.0 ).cast< double >( ).mean( ) - 0.0455, 1.0e-3 );
+
+    // Check that consecutive normal samples are uncorrelated.
+    BOOST_CHECK_SMALL( ( samples.head( numberOfSamples - 1 )
+                         * samples.tail( numberOfSamples - 1 ) ).mean( ), 5.0e-3 );
+}
+
+//! Test generation of normal dispersions.
+BOOST_AUTO_TEST_CASE( testMonteCarloSamplerDispersions )
+{
+    // Set dispersions, with standard deviations computed from full widths at half maximum.
+    Eigen::VectorXd means( 3 );
+    means << 1.0e3, -5.0, 0.0;
+    Eigen::VectorXd standardDeviations( 3 );
+    standardDeviations << mathematics::convertFullWidthHalfMaximumToStandardDeviation( 10.0 ),
+            mathematics::convertFullWidthHalfMaximumToStandardDeviation( 0.1 ), 0.0;
+
+    const mathematics::MonteCarloSampler sampler( 1 );
+    const mathematics::MonteCarloSampler samplerInParallel( 1, 3 );
+    Eigen::MatrixXd samples;
+    Eigen::MatrixXd samplesInParallel;
+    sampler.generateNormalDispersions( means, standardDeviations, 200000, samples );
+    samplerInParallel.generateNormalDispersions( means, standardDeviations, 200000,
+                                                 samplesInParallel );
+
+    BOOST_REQUIRE_EQUAL( samples.rows( ), 200000 );
+    BOOST_REQUIRE_EQUAL( samples.cols( ), 3 );
+    BOOST_CHECK( samplesInParallel == samples );
+
+    // Check that columns are scaled normal samples of streams, with the given moments.
+    Eigen::ArrayXd normalSamples;
+    for ( int d = 0; d < 3; d++ )
+    {
+        sampler.generateNormalSamples( 200000, normalSamples, d );
+        BOOST_CHECK( ( samples.col( d ).array( )
+                       == means( d ) + standardDeviations( d ) * normalSamples ).all( ) );
+
+        const double mean = samples.col( d ).mean( );
+        BOOST_CHECK_SMALL( mean - means( d ), 1.0e-2 * standardDeviations( d ) + 1.0e-15 );
+        BOOST_CHECK_SMALL( std::sqrt( ( samples.col( d ).array( ) - mean ).square( ).mean( ) )
+                           - standardDeviations( d ), 1.0e-2 * standardDeviations( d ) + 1.0e-15 );
+    }
+}
+
+//! Test that run-time errors are thrown for invalid input.
+BOOST_AUTO_TEST_CASE( testMonteCarloSamplerErrors )
+{
+    // Declare error flags.
+    bool isErrorThrownForSizes = false;
+    bool isErrorThrownForStandardDeviation = false;
+
+    const mathematics::MonteCarloSampler sampler( 1 );
+    Eigen::MatrixXd samples;
+
+    // Try to generate dispersions with mismatching sizes.
+    try
+    {
+        sampler.generateNormalDispersions( Eigen::VectorXd::Zero( 3 ),
+                                           Eigen::VectorXd::Ones( 2 ), 10, samples );
+    }
+
+    catch ( std::runtime_error& )
+    {
+        isErrorThrownForSizes = true;
+    }
+
+    // Try to generate dispersions with negative standard deviation.
+    try
+    {
+        sampler.generateNormalDispersions( Eigen::VectorXd::Zero( 2 ),
+                                           -Eigen::VectorXd::Ones( 2 ), 10, samples );
+    }
+
+    catch ( std::runtime_error& )
+    {
+        isErrorThrownForStandardDeviation = true;
+    }
+
+    // Check that errors were thrown.
+    BOOST_CHECK( isErrorThrownForSizes );
+    BOOST_CHECK( isErrorThrownForStandardDeviation );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace assist
@@ -0,0 +1,277 @@
+/*
+ *    Copyright (c) 2010-2014, Delft University of Technology
+ *    Copyright (c) 2010-2014, K. Kumar (me@kartikkumar.com)
+ *    All rights reserved.
+ *    See http://bit.ly/1jern3m for license details.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include "Assist/Basics/commonTypedefs.h"
+#include "Assist/Mathematics/rollingQuantiles.h"
+
+namespace assist
+{
+namespace unit_tests
+{
+
+namespace
+{
+
+//! Compute integer values in [-50, 49], scattered such that values are duplicated.
+Eigen::ArrayXd computeScatteredValues( const int numberOfValues )
+{
+    Eigen::ArrayXd values( numberOfValues );
+    for ( int i = 0; i < numberOfValues; i++ )
+    {
+        values( i ) = std::floor( 100.0 * std::fmod( 0.414213562373095 * ( i + 1 ), 1.0 ) - 50.0 );
+    }
+
+    return values;
+}
+
+//! Compute quantile of values [first, end) by sorting copy.
+double computeReferenceQuantile( const Eigen::ArrayXd& values, const int first, const int end,
+                                 const double probability )
+{
+    std::vector< double > window( values.data( ) + first, values.data( ) + end );
+    std::sort( window.begin( ), window.end( ) );
+    const double position = ( window.size( ) - 1 ) * probability;
+    const std::size_t k = static_cast< std::size_t >( std::floor( position ) );
+    if ( k + 1 == window.size( ) )
+    {
+        return window[ k ];
+    }
+
+    return window[ k ] + ( position - k ) * ( window[ k + 1 ] - window[ k ] );
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE( test_rolling_quantiles )
+
+//! Test quantile of window with insertions and removals.
+BOOST_AUTO_TEST_CASE( testRollingQuantile )
+{
+    mathematics::RollingQuantile median( 0.5 );
+    median.insert( 3.0 );
+    BOOST_CHECK_EQUAL( median.getQuantile( ), 3.0 );
+    median.insert( 1.0 );
+    BOOST_CHECK_EQUAL( median.getQuantile( ), 2.0 );
+    median.insert( 7.0 );
+    median.insert( 3.0 );
+    BOOST_CHECK_EQUAL( median.getQuantile( ), 3.0 );
+    median.remove( 1.0 );
+    median.remove( 3.0 );
+    BOOST_CHECK_EQUAL( median.getNumberOfValues( ), 2 );
+    BOOST_CHECK_EQUAL( median.getQuantile( ), 5.0 );
+
+    // Check extreme quantiles.
+    const Eigen::ArrayXd values = computeScatteredValues( 100 );
+    mathematics::RollingQuantile minimum( 0.0 );
+    mathematics::RollingQuantile maximum( 1.0 );
+    for ( int i = 0; i < 100; i++ )
+    {
+        minimum.insert( values( i ) );
+        maximum.insert( values( i ) );
+    }
+
+    BOOST_CHECK_EQUAL( minimum.getQuantile( ), values.head( 100 ).minCoeff( ) );
+    BOOST_CHECK_EQUAL( maximum.getQuantile( ), values.head( 100 ).maxCoeff( ) );
+}
+
+//! Test quantiles of windows with fixed number of values.
+BOOST_AUTO_TEST_CASE( testRollingQuantilesFixedNumberOfValues )
+{
+    const Eigen::ArrayXd values = computeScatteredValues( 20000 );
+
+    const double probabilities[ 2 ] = { 0.5, 0.9 };
+    for ( int p = 0; p < 2; p++ )
+    {
+        Eigen::ArrayXd quantiles;
+        mathematics::computeRollingQuantiles( values, 101, probabilities[ p ], quantiles );
+        BOOST_REQUIRE_EQUAL( quantiles.size( ), values.size( ) );
+        for ( int i = 0; i < values.size( ); i++ )
+        {
+            BOOST_CHECK_EQUAL( quantiles( i ),
+                               computeReferenceQuantile( values, std::max( 0, i - 100 ), i + 1,
+                                                         probabilities[ p ] ) );
+        }
+    }
+
+    // Check that results are identical for multiple threads, for values split over threads.
+    const Eigen::ArrayXd repeatedValues = values.replicate( 15, 1 );
+    Eigen::ArrayXd quantiles;
+    Eigen::ArrayXd parallelQuantiles;
+    mathematics::computeRollingQuantiles( repeatedValues, 101, 0.5, quantiles );
+    mathematics::computeRollingQuantiles( repeatedValues, 101, 0.5, parallelQuantiles, 4 );
+    BOOST_CHECK( ( parallelQuantiles == quantiles ).all( ) );
+}
+
+//! Test quantiles of windows with fixed width.
+BOOST_AUTO_TEST_CASE( testRollingQuantilesFixedWidth )
+{
+    // Set values at unevenly spaced abscissae.
+    const Eigen::ArrayXd values = computeScatteredValues( 20000 );
+    Eigen::ArrayXd abscissae( values.size( ) );
+    basics::DoubleKeyDoubleValueMap series;
+    double abscissa = 0.0;
+    for ( int i = 0; i < values.size( ); i++ )
+    {
+        abscissa += 2.0 * std::fmod( 0.618033988749895 * ( i + 1 ), 1.0 );
+        abscissae( i ) = abscissa;
+        series[ abscissae( i ) ] = values( i );
+    }
+
+    Eigen::ArrayXd quantiles;
+    mathematics::computeRollingQuantiles( abscissae, values, 50.0, 0.25, quantiles );
+    BOOST_REQUIRE_EQUAL( quantiles.size( ), values.size( ) );
+    int first = 0;
+    for ( int i = 0; i < values.size( ); i++ )
+    {
+        while ( abscissae( first ) <= abscissae( i ) - 50.0 )
+        {
+            first++;
+        }
+
+        BOOST_CHECK_EQUAL( quantiles( i ), computeReferenceQuantile( values, first, i + 1, 0.25 ) );
+    }
+
+    // Check that results are identical for multiple threads, for values split over threads.
+    const Eigen::ArrayXd repeatedValues = values.replicate( 15, 1 );
+    const Eigen::ArrayXd repeatedAbscissae = Eigen::ArrayXd::LinSpaced(
+                repeatedValues.size( ), 0.0, 0.7 * repeatedValues.size( ) );
+    Eigen::ArrayXd serialQuantiles;
+    Eigen::ArrayXd parallelQuantiles;
+    mathematics::computeRollingQuantiles( repeatedAbscissae, repeatedValues, 50.0, 0.25,
+                                          serialQuantiles );
+    mathematics::computeRollingQuantiles( repeatedAbscissae, repeatedValues, 50.0, 0.25,
+                                          parallelQuantiles, 3 );
+    BOOST_CHECK( ( parallelQuantiles == serialQuantiles ).all( ) );
+
+    // Check that results are identical for series stored in map.
+    const basics::DoubleKeyDoubleValueMap quantileSeries
+            = mathematics::computeRollingQuantiles( series, 50.0, 0.25 );
+    BOOST_REQUIRE_EQUAL( quantileSeries.size( ), series.size( ) );
+    int i = 0;
+    for ( basics::DoubleKeyDoubleValueMap::const_iterator iteratorPoint = quantileSeries.begin( );
+          iteratorPoint != quantileSeries.end( ); iteratorPoint++, i++ )
+    {
+        BOOST_CHECK_EQUAL( iteratorPoint->first, abscissae( i ) );
+        BOOST_CHECK_EQUAL( iteratorPoint->second, quantiles( i ) );
+    }
+}
+
+//! Test that run-time errors are thrown for invalid input.
+BOOST_AUTO_TEST_CASE( testRollingQuantilesErrors )
+{
+    // Declare error flags.
+    bool isErrorThrownForProbability = false;
+    bool isErrorThrownForMissingValue = false;
+    bool isErrorThrownForEmptyWindow = false;
+    bool isErrorThrownForNumberOfValuesInWindow = false;
+    bool isErrorThrownForUnsortedAbscissae = false;
+    bool isErrorThrownForWindowWidth = false;
+
+    // Set values at evenly spaced abscissae.
+    const Eigen::ArrayXd values = computeScatteredValues( 20 );
+    const Eigen::ArrayXd abscissae = Eigen::ArrayXd::LinSpaced( 20, 0.0, 19.0 );
+    basics::DoubleKeyDoubleValueMap series;
+    for ( int i = 0; i < values.size( ); i++ )
+    {
+        series[ abscissae( i ) ] = values( i );
+    }
+
+    Eigen::ArrayXd quantiles;
+
+    // Try to compute quantiles for probability larger than one.
+    try
+    {
+        mathematics::computeRollingQuantiles( values, 10, 1.5, quantiles );
+    }
+
+    catch ( std::runtime_error& )
+    {
+        isErrorThrownForProbability = true;
+    }
+
+    // Try to remove value that is not in window.
+    try
+    {
+        mathematics::RollingQuantile median( 0.5 );
+        median.insert( 1.0 );
+        median.insert( 2.0 );
+        median.remove( 1.5 );
+    }
+
+    catch ( std::runtime_error& )
+    {
+        isErrorThrownForMissingValue = true;
+    }
+
+    // Try to get quantile of empty window.
+    try
+    {
+        mathematics::RollingQuantile( 0.5 ).getQuantile( );
+    }
+
+    catch ( std::runtime_error& )
+    {
+        isErrorThrownForEmptyWindow = true;
+    }
+
+    // Try to compute quantiles for windows without values.
+    try
+    {
+        mathematics::computeRollingQuantiles( values, 0, 0.5, quantiles );
+    }
+
+    catch ( std::runtime_error& )
+    {
+        isErrorThrownForNumberOfValuesInWindow = true;
+    }
+
+    // Try to compute quantiles for unsorted abscissae.
+    try
+    {
+        Eigen::ArrayXd unsortedAbscissae = abscissae;
+        std::swap( unsortedAbscissae( 10 ), unsortedAbscissae( 11 ) );
+        mathematics::computeRollingQuantiles( unsortedAbscissae, values, 10.0, 0.5, quantiles );
+    }
+
+    catch ( std::runtime_error& )
+    {
+        isErrorThrownForUnsortedAbscissae = true;
+    }
+
+    // Try to compute quantiles for window with zero width.
+    try
+    {
+        mathematics::computeRollingQuantiles( series, 0.0, 0.5 );
+    }
+
+    catch ( std::runtime_error& )
+    {
+        isErrorThrownForWindowWidth = true;
+    }
+
+    // Check that errors were thrown.
+    BOOST_CHECK( isErrorThrownForProbability );
+    BOOST_CHECK( isErrorThrownForMissingValue );
+    BOOST_CHECK( isErrorThrownForEmptyWindow );
+    BOOST_CHECK( isErrorThrownForNumberOfValuesInWindow );
+    BOOST_CHECK( isErrorThrownForUnsortedAbscissae );
+    BOOST_CHECK( isErrorThrownForWindowWidth );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace assist
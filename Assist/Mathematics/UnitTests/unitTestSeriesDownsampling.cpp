@@ -0,0 +1,258 @@
+/*
+ *    Copyright (c) 2010-2014, Delft University of Technology
+ *    Copyright (c) 2010-2014, K. Kumar (me@kartikkumar.com)
+ *    All rights reserved.
+ *    See http://bit.ly/1jern3m for license details.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include "Assist/Basics/commonTypedefs.h"
+#include "Assist/Mathematics/seriesDownsampling.h"
+
+namespace assist
+{
+namespace unit_tests
+{
+
+BOOST_AUTO_TEST_SUITE( test_series_downsampling )
+
+//! Test downsampling by extrema of buckets.
+BOOST_AUTO_TEST_CASE( testSeriesDownsamplingMinimumMaximum )
+{
+    // Set sinusoid with 100001 points and noise with standard deviation of 0.1.
+    Eigen::ArrayXd abscissae( 100001 );
+    Eigen::ArrayXd values( abscissae.size( ) );
+    for ( int i = 0; i < abscissae.size( ); i++ )
+    {
+        abscissae( i ) = 0.5 * i;
+        values( i ) = std::sin( 1.0e-4 * i )
+                + 0.1 * std::sqrt( 12.0 ) * ( std::fmod( 0.414213562373095 * i, 1.0 ) - 0.5 );
+    }
+
+    // Add spikes, including at first and last points.
+    const int spikes[ 5 ] = { 0, 12345, 50000, 77777, 100000 };
+    for ( int s = 0; s < 5; s++ )
+    {
+        values( spikes[ s ] ) = s % 2 == 0 ? 10.0 : -10.0;
+    }
+
+    basics::DoubleKeyDoubleValueMap series;
+    for ( int i = 0; i < abscissae.size( ); i++ )
+    {
+        series[ abscissae( i ) ] = values( i );
+    }
+
+    Eigen::ArrayXd downsampledAbscissae;
+    Eigen::ArrayXd downsampledValues;
+    mathematics::downsampleMinimumMaximum( abscissae, values, 300, downsampledAbscissae,
+                                           downsampledValues );
+
+    // Check that the extrema of each bucket are kept, in order.
+    BOOST_REQUIRE_EQUAL( downsampledAbscissae.size( ), 600 );
+    for ( int b = 0; b < 300; b++ )
+    {
+        const int first = b * 100001 / 300;
+        const int size = ( b + 1 ) * 100001 / 300 - first;
+        Eigen::ArrayXd::Index minimum = 0;
+        Eigen::ArrayXd::Index maximum = 0;
+        values.segment( first, size ).minCoeff( &minimum );
+        values.segment( first, size ).maxCoeff( &maximum );
+
+        BOOST_CHECK_EQUAL( downsampledAbscissae( 2 * b ),
+                           abscissae( first + std::min( minimum, maximum ) ) );
+        BOOST_CHECK_EQUAL( downsampledAbscissae( 2 * b + 1 ),
+                           abscissae( first + std::max( minimum, maximum ) ) );
+        BOOST_CHECK_EQUAL( downsampledValues( 2 * b + 1 ),
+                           values( first + std::max( minimum, maximum ) ) );
+    }
+
+    BOOST_CHECK_EQUAL( downsampledValues.maxCoeff( ), 10.0 );
+    BOOST_CHECK_EQUAL( downsampledValues.minCoeff( ), -10.0 );
+
+    // Check that results are identical for multiple threads, and for series stored in map.
+    Eigen::ArrayXd parallelAbscissae;
+    Eigen::ArrayXd parallelValues;
+    mathematics::downsampleMinimumMaximum( abscissae, values, 300, parallelAbscissae,
+                                           parallelValues, 4 );
+    BOOST_CHECK( ( parallelAbscissae == downsampledAbscissae ).all( ) );
+    BOOST_CHECK( ( parallelValues == downsampledValues ).all( ) );
+
+    const basics::DoubleKeyDoubleValueMap downsampledSeries
+            = mathematics::downsampleMinimumMaximum( series, 300 );
+    BOOST_REQUIRE_EQUAL( downsampledSeries.size( ), 600 );
+    int i = 0;
+    for ( basics::DoubleKeyDoubleValueMap::const_iterator iteratorPoint
+          = downsampledSeries.begin( ); iteratorPoint != downsampledSeries.end( );
+          iteratorPoint++, i++ )
+    {
+        BOOST_CHECK_EQUAL( iteratorPoint->first, downsampledAbscissae( i ) );
+        BOOST_CHECK_EQUAL( iteratorPoint->second, downsampledValues( i ) );
+    }
+
+    // Check that each point is kept once, if there are more buckets than points.
+    mathematics::downsampleMinimumMaximum( abscissae.head( 10 ), values.head( 10 ), 20,
+                                           downsampledAbscissae, downsampledValues );
+    BOOST_CHECK( ( downsampledAbscissae == abscissae.head( 10 ) ).all( ) );
+    BOOST_CHECK( ( downsampledValues == values.head( 10 ) ).all( ) );
+}
+
+//! Test downsampling using Largest-Triangle-Three-Buckets algorithm.
+BOOST_AUTO_TEST_CASE( testSeriesDownsamplingLargestTriangleThreeBuckets )
+{
+    // Check selection for small series, with buckets { 1, 2 } and { 3, 4, 5 }.
+    Eigen::ArrayXd smallAbscissae( 7 );
+    Eigen::ArrayXd smallValues( 7 );
+    smallAbscissae << 0.0, 1.0, 2.0, 3.0, 4.0, 5.0, 6.0;
+    smallValues << 0.0, 1.0, 5.0, 1.0, -3.0, 0.0, 0.0;
+
+    Eigen::ArrayXd downsampledAbscissae;
+    Eigen::ArrayXd downsampledValues;
+    mathematics::downsampleLargestTriangleThreeBuckets( smallAbscissae, smallValues, 4,
+                                                        downsampledAbscissae,
+                                                        downsampledValues );
+    BOOST_REQUIRE_EQUAL( downsampledAbscissae.size( ), 4 );
+    BOOST_CHECK_EQUAL( downsampledAbscissae( 0 ), 0.0 );
+    BOOST_CHECK_EQUAL( downsampledAbscissae( 1 ), 2.0 );
+    BOOST_CHECK_EQUAL( downsampledAbscissae( 2 ), 4.0 );
+    BOOST_CHECK_EQUAL( downsampledAbscissae( 3 ), 6.0 );
+    BOOST_CHECK_EQUAL( downsampledValues( 2 ), -3.0 );
+
+    // Set large series of sinusoid with 100001 points and noise with standard deviation of 0.1.
+    Eigen::ArrayXd abscissae( 100001 );
+    Eigen::ArrayXd values( abscissae.size( ) );
+    for ( int i = 0; i < abscissae.size( ); i++ )
+    {
+        abscissae( i ) = 0.5 * i;
+        values( i ) = std::sin( 1.0e-4 * i )
+                + 0.1 * std::sqrt( 12.0 ) * ( std::fmod( 0.414213562373095 * i, 1.0 ) - 0.5 );
+    }
+
+    // Add spikes, including at first and last points.
+    const int spikes[ 5 ] = { 0, 12345, 50000, 77777, 100000 };
+    for ( int s = 0; s < 5; s++ )
+    {
+        values( spikes[ s ] ) = s % 2 == 0 ? 10.0 : -10.0;
+    }
+
+    basics::DoubleKeyDoubleValueMap series;
+    for ( int i = 0; i < abscissae.size( ); i++ )
+    {
+        series[ abscissae( i ) ] = values( i );
+    }
+
+    // Check that large series is downsampled to points of series in order, with end points and
+    // spikes.
+    mathematics::downsampleLargestTriangleThreeBuckets( abscissae, values, 1000,
+                                                        downsampledAbscissae,
+                                                        downsampledValues );
+    BOOST_REQUIRE_EQUAL( downsampledAbscissae.size( ), 1000 );
+    BOOST_CHECK_EQUAL( downsampledAbscissae( 0 ), 0.0 );
+    BOOST_CHECK_EQUAL( downsampledAbscissae( 999 ), 50000.0 );
+    BOOST_CHECK( ( downsampledAbscissae.tail( 999 ) > downsampledAbscissae.head( 999 ) ).all( ) );
+    BOOST_CHECK( ( downsampledValues.abs( ) == 10.0 ).count( ) == 5 );
+    for ( int i = 0; i < 1000; i++ )
+    {
+        BOOST_CHECK_EQUAL( downsampledValues( i ),
+                           values( static_cast< int >( 2.0 * downsampledAbscissae( i ) ) ) );
+    }
+
+    // Check that results are identical for multiple threads, and for series stored in map.
+    Eigen::ArrayXd parallelAbscissae;
+    Eigen::ArrayXd parallelValues;
+    mathematics::downsampleLargestTriangleThreeBuckets( abscissae, values, 1000,
+                                                        parallelAbscissae, parallelValues, 3 );
+    BOOST_CHECK( ( parallelAbscissae == downsampledAbscissae ).all( ) );
+    BOOST_CHECK( ( parallelValues == downsampledValues ).all( ) );
+
+    const basics::DoubleKeyDoubleValueMap downsampledSeries
+            = mathematics::downsampleLargestTriangleThreeBuckets( series, 1000 );
+    BOOST_REQUIRE_EQUAL( downsampledSeries.size( ), 1000 );
+    int i = 0;
+    for ( basics::DoubleKeyDoubleValueMap::const_iterator iteratorPoint
+          = downsampledSeries.begin( ); iteratorPoint != downsampledSeries.end( );
+          iteratorPoint++, i++ )
+    {
+        BOOST_CHECK_EQUAL( iteratorPoint->first, downsampledAbscissae( i ) );
+        BOOST_CHECK_EQUAL( iteratorPoint->second, downsampledValues( i ) );
+    }
+
+    // Check that series is copied if it has no more points than requested.
+    mathematics::downsampleLargestTriangleThreeBuckets( smallAbscissae, smallValues, 7,
+                                                        downsampledAbscissae,
+                                                        downsampledValues );
+    BOOST_CHECK( ( downsampledAbscissae == smallAbscissae ).all( ) );
+    BOOST_CHECK( ( downsampledValues == smallValues ).all( ) );
+}
+
+//! Test that run-time errors are thrown for invalid input.
+BOOST_AUTO_TEST_CASE( testSeriesDownsamplingErrors )
+{
+    // Declare error flags.
+    bool isErrorThrownForSizes = false;
+    bool isErrorThrownForNumberOfBuckets = false;
+    bool isErrorThrownForNumberOfPoints = false;
+
+    // Set series of linear function.
+    const Eigen::ArrayXd abscissae = Eigen::ArrayXd::LinSpaced( 20, 0.0, 19.0 );
+    const Eigen::ArrayXd values = 2.0 * abscissae;
+    basics::DoubleKeyDoubleValueMap series;
+    for ( int i = 0; i < abscissae.size( ); i++ )
+    {
+        series[ abscissae( i ) ] = values( i );
+    }
+
+    Eigen::ArrayXd downsampledAbscissae;
+    Eigen::ArrayXd downsampledValues;
+
+    // Try to downsample arrays with mismatching sizes.
+    try
+    {
+        mathematics::downsampleLargestTriangleThreeBuckets( abscissae, values.head( 10 ), 5,
+                                                            downsampledAbscissae,
+                                                            downsampledValues );
+    }
+
+    catch ( std::runtime_error& )
+    {
+        isErrorThrownForSizes = true;
+    }
+
+    // Try to downsample to zero buckets.
+    try
+    {
+        mathematics::downsampleMinimumMaximum( series, 0 );
+    }
+
+    catch ( std::runtime_error& )
+    {
+        isErrorThrownForNumberOfBuckets = true;
+    }
+
+    // Try to downsample to two points.
+    try
+    {
+        mathematics::downsampleLargestTriangleThreeBuckets( series, 2 );
+    }
+
+    catch ( std::runtime_error& )
+    {
+        isErrorThrownForNumberOfPoints = true;
+    }
+
+    // Check that errors were thrown.
+    BOOST_CHECK( isErrorThrownForSizes );
+    BOOST_CHECK( isErrorThrownForNumberOfBuckets );
+    BOOST_CHECK( isErrorThrownForNumberOfPoints );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace assist
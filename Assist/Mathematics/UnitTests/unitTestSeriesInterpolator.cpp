@@ -0,0 +1,286 @@
+/*
+ *    Copyright (c) 2010-2014, Delft University of Technology
+ *    Copyright (c) 2010-2014, K. Kumar (me@kartikkumar.com)
+ *    All rights reserved.
+ *    See http://bit.ly/1jern3m for license details.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <TudatCore/Mathematics/BasicMathematics/mathematicalConstants.h>
+
+#include "Assist/Basics/commonTypedefs.h"
+#include "Assist/Mathematics/seriesInterpolator.h"
+
+namespace assist
+{
+namespace unit_tests
+{
+
+namespace
+{
+
+//! Compute abscissa k of non-uniform grid of 101 points over [0, pi].
+/*!
+ * Computes abscissa k of a uniform grid of 101 points over [0, pi], stretched so that points are
+ * denser near the start.
+ */
+double computeGridAbscissa( const int k )
+{
+    using tudat::basic_mathematics::mathematical_constants::PI;
+    const double fraction = static_cast< double >( k ) / 100.0;
+    return PI * fraction * ( 0.5 + 0.5 * fraction );
+}
+
+//! Compute unsorted abscissae, scattered over [0, pi).
+std::vector< double > computeScatteredAbscissae( const int numberOfAbscissae )
+{
+    using tudat::basic_mathematics::mathematical_constants::PI;
+    std::vector< double > abscissae;
+    for ( int i = 1; i <= numberOfAbscissae; i++ )
+    {
+        abscissae.push_back( PI * std::fmod( 0.618033988749895 * i, 1.0 ) );
+    }
+
+    return abscissae;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE( test_series_interpolator )
+
+//! Test that all methods pass through points, and reproduce linear functions.
+BOOST_AUTO_TEST_CASE( testSeriesInterpolatorLinearFunction )
+{
+    // Set sine and linear series on non-uniform grid over [0, pi], and scattered abscissae.
+    basics::DoubleKeyDoubleValueMap sineSeries;
+    for ( int k = 0; k <= 100; k++ )
+    {
+        sineSeries[ computeGridAbscissa( k ) ] = std::sin( computeGridAbscissa( k ) );
+    }
+
+    basics::DoubleKeyDoubleValueMap linearSeries;
+    for ( int k = 0; k <= 100; k++ )
+    {
+        linearSeries[ computeGridAbscissa( k ) ] = 3.0 - 2.0 * computeGridAbscissa( k );
+    }
+
+    const std::vector< double > scatteredAbscissae = computeScatteredAbscissae( 2000 );
+
+    const mathematics::SeriesInterpolationMethod methods[ 3 ]
+            = { mathematics::linearSeriesInterpolation,
+                mathematics::cubicSplineSeriesInterpolation,
+                mathematics::akimaSeriesInterpolation };
+
+    for ( int m = 0; m < 3; m++ )
+    {
+        mathematics::SeriesInterpolator linearInterpolator( linearSeries, methods[ m ] );
+        mathematics::SeriesInterpolator sineInterpolator( sineSeries, methods[ m ] );
+
+        for ( basics::DoubleKeyDoubleValueMap::const_iterator iteratorPoint
+              = sineSeries.begin( ); iteratorPoint != sineSeries.end( ); iteratorPoint++ )
+        {
+            BOOST_CHECK_SMALL( sineInterpolator.interpolate( iteratorPoint->first )
+                               - iteratorPoint->second, 1.0e-15 );
+        }
+
+        for ( std::size_t i = 0; i < scatteredAbscissae.size( ); i++ )
+        {
+            BOOST_CHECK_SMALL( linearInterpolator.interpolate( scatteredAbscissae[ i ] )
+                               - ( 3.0 - 2.0 * scatteredAbscissae[ i ] ), 1.0e-13 );
+        }
+    }
+}
+
+//! Test accuracy of methods for smooth function.
+BOOST_AUTO_TEST_CASE( testSeriesInterpolatorAccuracy )
+{
+    using tudat::basic_mathematics::mathematical_constants::PI;
+
+    // Set sine series on non-uniform grid over [0, pi], and sorted abscissae including the ends.
+    basics::DoubleKeyDoubleValueMap sineSeries;
+    for ( int k = 0; k <= 100; k++ )
+    {
+        sineSeries[ computeGridAbscissa( k ) ] = std::sin( computeGridAbscissa( k ) );
+    }
+
+    std::vector< double > sortedAbscissae = computeScatteredAbscissae( 2000 );
+    std::sort( sortedAbscissae.begin( ), sortedAbscissae.end( ) );
+    sortedAbscissae.push_back( PI );
+    sortedAbscissae.insert( sortedAbscissae.begin( ), 0.0 );
+
+    const mathematics::SeriesInterpolationMethod methods[ 3 ]
+            = { mathematics::linearSeriesInterpolation,
+                mathematics::cubicSplineSeriesInterpolation,
+                mathematics::akimaSeriesInterpolation };
+
+    // Set tolerances for grid spacing of at most 0.047: O(h^2) for linear and Akima
+    // interpolation, and O(h^4) for cubic splines, since the second derivative of sine vanishes
+    // at the ends.
+    const double tolerances[ 3 ] = { 3.0e-4, 1.0e-6, 1.0e-4 };
+
+    for ( int m = 0; m < 3; m++ )
+    {
+        const mathematics::SeriesInterpolator interpolator( sineSeries, methods[ m ] );
+
+        std::vector< double > values;
+        interpolator.interpolate( sortedAbscissae, values );
+
+        BOOST_REQUIRE_EQUAL( values.size( ), sortedAbscissae.size( ) );
+        for ( std::size_t i = 0; i < sortedAbscissae.size( ); i++ )
+        {
+            BOOST_CHECK_SMALL( values[ i ] - std::sin( sortedAbscissae[ i ] ), tolerances[ m ] );
+        }
+    }
+}
+
+//! Test that Akima interpolation does not overshoot near step.
+BOOST_AUTO_TEST_CASE( testSeriesInterpolatorAkimaStep )
+{
+    basics::DoubleKeyDoubleValueMap stepSeries;
+    for ( int k = 0; k < 10; k++ )
+    {
+        stepSeries[ static_cast< double >( k ) ] = k < 5 ? 0.0 : 1.0;
+    }
+
+    mathematics::SeriesInterpolator akimaInterpolator(
+                stepSeries, mathematics::akimaSeriesInterpolation );
+    mathematics::SeriesInterpolator splineInterpolator(
+                stepSeries, mathematics::cubicSplineSeriesInterpolation );
+
+    double minimumSplineValue = 0.0;
+    for ( double abscissa = 0.0; abscissa <= 9.0; abscissa += 0.01 )
+    {
+        const double value = akimaInterpolator.interpolate( abscissa );
+        BOOST_CHECK( value >= 0.0 && value <= 1.0 );
+        BOOST_CHECK( abscissa > 4.0 || value == 0.0 );
+        BOOST_CHECK( abscissa < 5.0 || value == 1.0 );
+
+        minimumSplineValue = std::min( minimumSplineValue,
+                                       splineInterpolator.interpolate( abscissa ) );
+    }
+
+    // Check that the cubic spline does overshoot.
+    BOOST_CHECK_LT( minimumSplineValue, -1.0e-2 );
+}
+
+//! Test that single queries in any order and batch queries give identical results.
+BOOST_AUTO_TEST_CASE( testSeriesInterpolatorQueries )
+{
+    using tudat::basic_mathematics::mathematical_constants::PI;
+
+    // Set sine series on non-uniform grid over [0, pi], and sorted and unsorted abscissae.
+    basics::DoubleKeyDoubleValueMap sineSeries;
+    for ( int k = 0; k <= 100; k++ )
+    {
+        sineSeries[ computeGridAbscissa( k ) ] = std::sin( computeGridAbscissa( k ) );
+    }
+
+    std::vector< double > sortedAbscissae = computeScatteredAbscissae( 2000 );
+    std::sort( sortedAbscissae.begin( ), sortedAbscissae.end( ) );
+    sortedAbscissae.push_back( PI );
+    sortedAbscissae.insert( sortedAbscissae.begin( ), 0.0 );
+    const std::vector< double > scatteredAbscissae = computeScatteredAbscissae( 2000 );
+
+    mathematics::SeriesInterpolator interpolator(
+                sineSeries, mathematics::akimaSeriesInterpolation );
+
+    // Interpolate sorted and scattered abscissae in batches.
+    std::vector< double > sortedValues;
+    std::vector< double > scatteredValues;
+    interpolator.interpolate( sortedAbscissae, sortedValues );
+    interpolator.interpolate( scatteredAbscissae, scatteredValues );
+
+    // Check that single queries, in sorted, reversed and scattered order, give identical results.
+    for ( std::size_t i = 0; i < sortedAbscissae.size( ); i++ )
+    {
+        BOOST_CHECK_EQUAL( interpolator.interpolate( sortedAbscissae[ i ] ), sortedValues[ i ] );
+    }
+
+    for ( std::size_t i = sortedAbscissae.size( ); i > 0; i-- )
+    {
+        BOOST_CHECK_EQUAL( interpolator.interpolate( sortedAbscissae[ i - 1 ] ),
+                           sortedValues[ i - 1 ] );
+    }
+
+    for ( std::size_t i = 0; i < scatteredAbscissae.size( ); i++ )
+    {
+        BOOST_CHECK_EQUAL( interpolator.interpolate( scatteredAbscissae[ i ] ),
+                           scatteredValues[ i ] );
+    }
+
+    // Check that the interpolant of two points is linear for all methods.
+    basics::DoubleKeyDoubleValueMap twoPointSeries;
+    twoPointSeries[ 1.0 ] = 2.0;
+    twoPointSeries[ 3.0 ] = 6.0;
+    mathematics::SeriesInterpolator twoPointInterpolator(
+                twoPointSeries, mathematics::akimaSeriesInterpolation );
+    mathematics::SeriesInterpolator twoPointSplineInterpolator( twoPointSeries );
+    BOOST_CHECK_EQUAL( twoPointInterpolator.interpolate( 2.5 ), 5.0 );
+    BOOST_CHECK_EQUAL( twoPointSplineInterpolator.interpolate( 1.5 ), 3.0 );
+}
+
+//! Test that run-time errors are thrown for invalid input.
+BOOST_AUTO_TEST_CASE( testSeriesInterpolatorErrors )
+{
+    // Declare error flags.
+    bool isErrorThrownForSeries = false;
+    bool isErrorThrownForAbscissa = false;
+    bool isErrorThrownForAbscissae = false;
+
+    // Try to create interpolator for series with one point.
+    try
+    {
+        basics::DoubleKeyDoubleValueMap onePointSeries;
+        onePointSeries[ 1.0 ] = 2.0;
+        mathematics::SeriesInterpolator interpolator( onePointSeries );
+    }
+
+    catch ( std::runtime_error& )
+    {
+        isErrorThrownForSeries = true;
+    }
+
+    // Try to interpolate outside range of series.
+    basics::DoubleKeyDoubleValueMap sineSeries;
+    for ( int k = 0; k <= 100; k++ )
+    {
+        sineSeries[ computeGridAbscissa( k ) ] = std::sin( computeGridAbscissa( k ) );
+    }
+    mathematics::SeriesInterpolator interpolator( sineSeries );
+    try
+    {
+        interpolator.interpolate( 3.2 );
+    }
+
+    catch ( std::runtime_error& )
+    {
+        isErrorThrownForAbscissa = true;
+    }
+
+    try
+    {
+        std::vector< double > values;
+        interpolator.interpolate( std::vector< double >( 1, -0.1 ), values );
+    }
+
+    catch ( std::runtime_error& )
+    {
+        isErrorThrownForAbscissae = true;
+    }
+
+    // Check that errors were thrown.
+    BOOST_CHECK( isErrorThrownForSeries );
+    BOOST_CHECK( isErrorThrownForAbscissa );
+    BOOST_CHECK( isErrorThrownForAbscissae );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace assist
@@ -0,0 +1,328 @@
+/*
+ *    Copyright (c) 2010-2014, Delft University of Technology
+ *    Copyright (c) 2010-2014, K. Kumar (me@kartikkumar.com)
+ *    All rights reserved.
+ *    See http://bit.ly/1jern3m for license details.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/cstdint.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include <TudatCore/Mathematics/BasicMathematics/mathematicalConstants.h>
+
+#include "Assist/Mathematics/sigmaClipping.h"
+
+namespace assist
+{
+namespace unit_tests
+{
+
+namespace
+{
+
+//! Compute value of standard normal distribution, from scattered uniform values.
+/*!
+ * Computes value of standard normal distribution with the Box-Muller transform of two scattered
+ * uniform values, given by the fractional parts of multiples of irrational numbers.
+ * \param index Index of value (> 0).
+ * \return Value of standard normal distribution.
+ */
+double computeNormalValue( const int index )
+{
+    using tudat::basic_mathematics::mathematical_constants::PI;
+    return std::sqrt( -2.0 * std::log( std::fmod( 0.618033988749895 * index, 1.0 ) ) )
+            * std::cos( 2.0 * PI * std::fmod( 0.414213562373095 * index, 1.0 ) );
+}
+
+//! Get values that are not rejected.
+std::vector< double > getRemainingValues( const Eigen::ArrayXd& values,
+                                          const std::vector< boost::uint64_t >& rejectionMask )
+{
+    std::vector< double > remainingValues;
+    for ( int i = 0; i < values.size( ); i++ )
+    {
+        if ( !mathematics::isRejected( rejectionMask, i ) )
+        {
+            remainingValues.push_back( values( i ) );
+        }
+    }
+
+    return remainingValues;
+}
+
+//! Compute median by sorting copy.
+double computeMedian( std::vector< double > someValues )
+{
+    std::sort( someValues.begin( ), someValues.end( ) );
+    const std::size_t middle = someValues.size( ) / 2;
+    return someValues.size( ) % 2 == 1
+            ? someValues[ middle ] : 0.5 * ( someValues[ middle - 1 ] + someValues[ middle ] );
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE( test_sigma_clipping )
+
+//! Test clipping of small set of values.
+BOOST_AUTO_TEST_CASE( testSigmaClippingSmallSet )
+{
+    // Clip outlier, after which median is 2.5 and MAD is 1.
+    Eigen::ArrayXd smallValues( 5 );
+    smallValues << 3.0, 1.0, 100.0, 4.0, 2.0;
+
+    std::vector< boost::uint64_t > rejectionMask;
+    double centre = 0.0;
+    double standardDeviation = 0.0;
+    BOOST_CHECK_EQUAL( mathematics::clipOutliers( smallValues, 3.0, rejectionMask, centre,
+                                                  standardDeviation ), 1 );
+    BOOST_REQUIRE_EQUAL( rejectionMask.size( ), 1 );
+    BOOST_CHECK_EQUAL( rejectionMask[ 0 ], 4 );
+    BOOST_CHECK( mathematics::isRejected( rejectionMask, 2 ) );
+    BOOST_CHECK_EQUAL( centre, 2.5 );
+    BOOST_CHECK_CLOSE_FRACTION( standardDeviation, 1.482602218505602, 1.0e-15 );
+
+    // Check that mean and standard deviation are computed without clipping.
+    mathematics::clipOutliers( smallValues, 3.0, rejectionMask, centre, standardDeviation,
+                               mathematics::meanSigmaClipping, 0 );
+    BOOST_CHECK_EQUAL( rejectionMask[ 0 ], 0 );
+    BOOST_CHECK_CLOSE_FRACTION( centre, 22.0, 1.0e-15 );
+    BOOST_CHECK_CLOSE_FRACTION( standardDeviation, std::sqrt( 1522.0 ), 1.0e-14 );
+}
+
+//! Test that finite values near the limits of the range of doubles are not rejected.
+BOOST_AUTO_TEST_CASE( testSigmaClippingExtremeValues )
+{
+    // Set values spread over [-1e308, 1e308], so that deviations from the first value overflow,
+    // and add values that are not finite.
+    Eigen::ArrayXd extremeValues( 24 );
+    extremeValues( 0 ) = -1.0e308;
+    for ( int k = -10; k <= 10; k++ )
+    {
+        extremeValues( k + 11 ) = k * 1.0e307;
+    }
+
+    extremeValues( 22 ) = std::numeric_limits< double >::quiet_NaN( );
+    extremeValues( 23 ) = std::numeric_limits< double >::infinity( );
+
+    // Check that only values that are not finite are rejected.
+    std::vector< boost::uint64_t > rejectionMask;
+    double centre = 0.0;
+    double standardDeviation = 0.0;
+    BOOST_CHECK_EQUAL( mathematics::clipOutliers( extremeValues, 3.0, rejectionMask, centre,
+                                                  standardDeviation ), 2 );
+    BOOST_REQUIRE_EQUAL( rejectionMask.size( ), 1 );
+    BOOST_CHECK_EQUAL( rejectionMask[ 0 ], 0xC00000 );
+    BOOST_CHECK_CLOSE_FRACTION( centre, -5.0e306, 1.0e-15 );
+}
+
+//! Test clipping with median and MAD.
+BOOST_AUTO_TEST_CASE( testSigmaClippingMedian )
+{
+    // Set 300000 normal values, with mean 10 and standard deviation 2, with outliers at every
+    // 300th value, and values that are not finite.
+    Eigen::ArrayXd values( 300000 );
+    for ( int i = 0; i < values.size( ); i++ )
+    {
+        values( i ) = i % 300 == 0
+                ? ( i % 600 == 0 ? 1.0 : -1.0 )
+                  * ( 40.0 + 960.0 * std::fmod( 0.732050807568877 * i, 1.0 ) )
+                : 10.0 + 2.0 * computeNormalValue( i );
+    }
+
+    values( 1234 ) = std::numeric_limits< double >::quiet_NaN( );
+    values( 5678 ) = std::numeric_limits< double >::infinity( );
+
+    std::vector< boost::uint64_t > rejectionMask;
+    double centre = 0.0;
+    double standardDeviation = 0.0;
+    const std::size_t numberOfRejectedValues = mathematics::clipOutliers(
+                values, 3.0, rejectionMask, centre, standardDeviation );
+
+    // Check that outliers and values that are not finite are rejected.
+    BOOST_REQUIRE_EQUAL( rejectionMask.size( ), 4688 );
+    for ( int i = 0; i < values.size( ); i += 300 )
+    {
+        BOOST_CHECK( mathematics::isRejected( rejectionMask, i ) );
+    }
+
+    BOOST_CHECK( mathematics::isRejected( rejectionMask, 1234 ) );
+    BOOST_CHECK( mathematics::isRejected( rejectionMask, 5678 ) );
+    BOOST_CHECK_CLOSE_FRACTION( centre, 10.0, 2.0e-3 );
+    BOOST_CHECK_CLOSE_FRACTION( standardDeviation, 2.0, 2.0e-2 );
+
+    // Check that statistics are exactly the median and scaled MAD of remaining values, and that
+    // clipping has converged.
+    const std::vector< double > remainingValues = getRemainingValues( values, rejectionMask );
+    BOOST_CHECK_EQUAL( remainingValues.size( ), values.size( ) - numberOfRejectedValues );
+    std::vector< double > absoluteDeviations( remainingValues.size( ) );
+    for ( std::size_t i = 0; i < remainingValues.size( ); i++ )
+    {
+        absoluteDeviations[ i ] = std::fabs( remainingValues[ i ] - centre );
+        BOOST_CHECK( absoluteDeviations[ i ] <= 3.0 * standardDeviation );
+    }
+
+    BOOST_CHECK_EQUAL( centre, computeMedian( remainingValues ) );
+    BOOST_CHECK_EQUAL( standardDeviation,
+                       1.482602218505602 * computeMedian( absoluteDeviations ) );
+
+    // Check that results are identical for multiple threads.
+    std::vector< boost::uint64_t > parallelRejectionMask;
+    double parallelCentre = 0.0;
+    double parallelStandardDeviation = 0.0;
+    BOOST_CHECK_EQUAL( mathematics::clipOutliers( values, 3.0, parallelRejectionMask,
+                                                  parallelCentre, parallelStandardDeviation,
+                                                  mathematics::medianSigmaClipping, 10, 4 ),
+                       numberOfRejectedValues );
+    BOOST_CHECK( parallelRejectionMask == rejectionMask );
+    BOOST_CHECK_EQUAL( parallelCentre, centre );
+    BOOST_CHECK_EQUAL( parallelStandardDeviation, standardDeviation );
+}
+
+//! Test clipping with mean and standard deviation.
+BOOST_AUTO_TEST_CASE( testSigmaClippingMean )
+{
+    // Set 300000 normal values, with mean 10 and standard deviation 2, with outliers at every
+    // 300th value, and values that are not finite.
+    Eigen::ArrayXd values( 300000 );
+    for ( int i = 0; i < values.size( ); i++ )
+    {
+        values( i ) = i % 300 == 0
+                ? ( i % 600 == 0 ? 1.0 : -1.0 )
+                  * ( 40.0 + 960.0 * std::fmod( 0.732050807568877 * i, 1.0 ) )
+                : 10.0 + 2.0 * computeNormalValue( i );
+    }
+
+    values( 1234 ) = std::numeric_limits< double >::quiet_NaN( );
+    values( 5678 ) = std::numeric_limits< double >::infinity( );
+
+    std::vector< boost::uint64_t > rejectionMask;
+    double centre = 0.0;
+    double standardDeviation = 0.0;
+    const std::size_t numberOfRejectedValues = mathematics::clipOutliers(
+                values, 3.0, rejectionMask, centre, standardDeviation,
+                mathematics::meanSigmaClipping, 100 );
+
+    for ( int i = 0; i < values.size( ); i += 300 )
+    {
+        BOOST_CHECK( mathematics::isRejected( rejectionMask, i ) );
+    }
+
+    // Check that statistics are the mean and standard deviation of remaining values, and that
+    // clipping has converged.
+    const std::vector< double > remainingValues = getRemainingValues( values, rejectionMask );
+    BOOST_CHECK_EQUAL( remainingValues.size( ), values.size( ) - numberOfRejectedValues );
+    double mean = 0.0;
+    for ( std::size_t i = 0; i < remainingValues.size( ); i++ )
+    {
+        mean += remainingValues[ i ];
+        BOOST_CHECK( std::fabs( remainingValues[ i ] - centre ) <= 3.0 * standardDeviation );
+    }
+
+    mean /= remainingValues.size( );
+    double variance = 0.0;
+    for ( std::size_t i = 0; i < remainingValues.size( ); i++ )
+    {
+        variance += ( remainingValues[ i ] - mean ) * ( remainingValues[ i ] - mean );
+    }
+
+    variance /= remainingValues.size( );
+    BOOST_CHECK_CLOSE_FRACTION( centre, mean, 1.0e-12 );
+    BOOST_CHECK_CLOSE_FRACTION( standardDeviation, std::sqrt( variance ), 1.0e-10 );
+    BOOST_CHECK_CLOSE_FRACTION( centre, 10.0, 2.0e-3 );
+
+    // Check that results are identical for multiple threads.
+    std::vector< boost::uint64_t > parallelRejectionMask;
+    double parallelCentre = 0.0;
+    double parallelStandardDeviation = 0.0;
+    mathematics::clipOutliers( values, 3.0, parallelRejectionMask, parallelCentre,
+                               parallelStandardDeviation, mathematics::meanSigmaClipping, 100, 3 );
+    BOOST_CHECK( parallelRejectionMask == rejectionMask );
+    BOOST_CHECK_EQUAL( parallelCentre, centre );
+    BOOST_CHECK_EQUAL( parallelStandardDeviation, standardDeviation );
+}
+
+//! Test that run-time errors are thrown for invalid input.
+BOOST_AUTO_TEST_CASE( testSigmaClippingErrors )
+{
+    // Declare error flags.
+    bool isErrorThrownForNumberOfStandardDeviations = false;
+    bool isErrorThrownForNonFiniteValues = false;
+    bool isErrorThrownForAllValuesRejectedWithMedian = false;
+    bool isErrorThrownForAllValuesRejectedWithMean = false;
+
+    std::vector< boost::uint64_t > rejectionMask;
+    double centre = 0.0;
+    double standardDeviation = 0.0;
+
+    // Try to clip values with zero threshold.
+    try
+    {
+        mathematics::clipOutliers( Eigen::ArrayXd::LinSpaced( 10, 1.0, 10.0 ), 0.0, rejectionMask,
+                                   centre, standardDeviation );
+    }
+
+    catch ( std::runtime_error& )
+    {
+        isErrorThrownForNumberOfStandardDeviations = true;
+    }
+
+    // Try to clip values that are not finite.
+    try
+    {
+        mathematics::clipOutliers(
+                    Eigen::ArrayXd::Constant( 10, std::numeric_limits< double >::quiet_NaN( ) ),
+                    3.0, rejectionMask, centre, standardDeviation );
+    }
+
+    catch ( std::runtime_error& )
+    {
+        isErrorThrownForNonFiniteValues = true;
+    }
+
+    // Try to clip values with a threshold for which both values deviate too much from the
+    // median (0.5), so that no values remain.
+    Eigen::ArrayXd twoValues( 2 );
+    twoValues << 0.0, 1.0;
+    try
+    {
+        mathematics::clipOutliers( twoValues, 0.1, rejectionMask, centre, standardDeviation,
+                                   mathematics::medianSigmaClipping );
+    }
+
+    catch ( std::runtime_error& )
+    {
+        isErrorThrownForAllValuesRejectedWithMedian = true;
+    }
+
+    // Try to clip the same values with the mean.
+    try
+    {
+        mathematics::clipOutliers( twoValues, 0.1, rejectionMask, centre, standardDeviation,
+                                   mathematics::meanSigmaClipping );
+    }
+
+    catch ( std::runtime_error& )
+    {
+        isErrorThrownForAllValuesRejectedWithMean = true;
+    }
+
+    // Check that errors were thrown.
+    BOOST_CHECK( isErrorThrownForNumberOfStandardDeviations );
+    BOOST_CHECK( isErrorThrownForNonFiniteValues );
+    BOOST_CHECK( isErrorThrownForAllValuesRejectedWithMedian );
+    BOOST_CHECK( isErrorThrownForAllValuesRejectedWithMean );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace assist
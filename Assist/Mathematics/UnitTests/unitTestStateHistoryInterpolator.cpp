@@ -0,0 +1,345 @@
+/*
+ *    Copyright (c) 2010-2014, Delft University of Technology
+ *    Copyright (c) 2010-2014, K. Kumar (me@kartikkumar.com)
+ *    All rights reserved.
+ *    See http://bit.ly/1jern3m for license details.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include "Assist/Basics/commonTypedefs.h"
+
+#include "Assist/Mathematics/stateHistoryInterpolator.h"
+
+namespace assist
+{
+namespace unit_tests
+{
+
+using tudat::basic_mathematics::Vector6d;
+
+namespace
+{
+
+//! Radius of circular orbit [m].
+const double orbitalRadius = 7.0e6;
+
+//! Angular velocity on circular orbit [rad s^-1].
+const double angularVelocity = std::sqrt( 3.986004418e14 / ( 7.0e6 * 7.0e6 * 7.0e6 ) );
+
+//! Compute state of which position is cubic polynomial in time.
+Vector6d computeCubicState( const double epoch )
+{
+    const double t = ( epoch - 5000.0 ) / 1000.0;
+    Vector6d state;
+    state << 1.0 + 2.0 * t - 3.0 * t * t + 0.5 * t * t * t,
+            -4.0 + t * t,
+            7.0 - 2.0 * t * t * t,
+            ( 2.0 - 6.0 * t + 1.5 * t * t ) / 1000.0,
+            2.0 * t / 1000.0,
+            -6.0 * t * t / 1000.0;
+    return state;
+}
+
+//! Compute state on circular orbit.
+Vector6d computeOrbitState( const double epoch )
+{
+    const double angle = angularVelocity * epoch;
+    Vector6d state;
+    state << orbitalRadius * std::cos( angle ), orbitalRadius * std::sin( angle ), 0.0,
+            -orbitalRadius * angularVelocity * std::sin( angle ),
+            orbitalRadius * angularVelocity * std::cos( angle ), 0.0;
+    return state;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE( test_state_history_interpolator )
+
+//! Test that Hermite interpolation reproduces cubic polynomial.
+BOOST_AUTO_TEST_CASE( testHermiteInterpolationOfCubic )
+{
+    // Sample state history of cubic polynomial at non-uniform epochs, with steps between 30 and
+    // 90 s.
+    basics::DoubleKeyVector6dValueMap cubicStateHistory;
+    for ( int i = 0; i < 200; i++ )
+    {
+        const double epoch = 1000.0 + 60.0 * i + 15.0 * std::sin( 1.7 * i );
+        cubicStateHistory[ epoch ] = computeCubicState( epoch );
+    }
+
+    // Set query epochs in range of state history, in scrambled order.
+    std::vector< double > queryEpochs;
+    for ( int i = 0; i < 1000; i++ )
+    {
+        queryEpochs.push_back( 1000.0 + 11900.0 * std::fmod( 0.618033988749895 * i, 1.0 ) );
+    }
+
+    mathematics::StateHistoryInterpolator interpolator( cubicStateHistory );
+
+    // Check that interpolated states match cubic polynomial.
+    for ( std::size_t i = 0; i < queryEpochs.size( ); i++ )
+    {
+        const Vector6d state = interpolator.interpolate( queryEpochs[ i ] );
+        const Vector6d expectedState = computeCubicState( queryEpochs[ i ] );
+        BOOST_CHECK_SMALL( ( state - expectedState ).segment< 3 >( 0 ).norm( ), 1.0e-12 );
+        BOOST_CHECK_SMALL( ( state - expectedState ).segment< 3 >( 3 ).norm( ), 1.0e-13 );
+    }
+}
+
+//! Test that Lagrange interpolation reproduces polynomial of degree less than number of epochs.
+BOOST_AUTO_TEST_CASE( testLagrangeInterpolationOfCubic )
+{
+    // Sample state history of cubic polynomial at non-uniform epochs, with steps between 30 and
+    // 90 s.
+    basics::DoubleKeyVector6dValueMap cubicStateHistory;
+    for ( int i = 0; i < 200; i++ )
+    {
+        const double epoch = 1000.0 + 60.0 * i + 15.0 * std::sin( 1.7 * i );
+        cubicStateHistory[ epoch ] = computeCubicState( epoch );
+    }
+
+    // Set query epochs in range of state history, in scrambled order.
+    std::vector< double > queryEpochs;
+    for ( int i = 0; i < 1000; i++ )
+    {
+        queryEpochs.push_back( 1000.0 + 11900.0 * std::fmod( 0.618033988749895 * i, 1.0 ) );
+    }
+
+    mathematics::StateHistoryInterpolator interpolator(
+                cubicStateHistory, mathematics::lagrangeStateInterpolation, 4 );
+
+    // Check that interpolated states match cubic polynomial, including at the ends, where the
+    // window is shifted inwards.
+    queryEpochs.push_back( cubicStateHistory.begin( )->first + 1.0 );
+    queryEpochs.push_back( cubicStateHistory.rbegin( )->first - 1.0 );
+    for ( std::size_t i = 0; i < queryEpochs.size( ); i++ )
+    {
+        const Vector6d state = interpolator.interpolate( queryEpochs[ i ] );
+        const Vector6d expectedState = computeCubicState( queryEpochs[ i ] );
+        BOOST_CHECK_SMALL( ( state - expectedState ).segment< 3 >( 0 ).norm( ), 1.0e-12 );
+        BOOST_CHECK_SMALL( ( state - expectedState ).segment< 3 >( 3 ).norm( ), 1.0e-13 );
+    }
+}
+
+//! Test accuracy of interpolation of circular orbit.
+BOOST_AUTO_TEST_CASE( testInterpolationOfCircularOrbit )
+{
+    // Sample state history of circular orbit at non-uniform epochs, with steps between 30 and
+    // 90 s.
+    basics::DoubleKeyVector6dValueMap orbitStateHistory;
+    for ( int i = 0; i < 200; i++ )
+    {
+        const double epoch = 1000.0 + 60.0 * i + 15.0 * std::sin( 1.7 * i );
+        orbitStateHistory[ epoch ] = computeOrbitState( epoch );
+    }
+
+    // Set query epochs in range of state history, in scrambled order.
+    std::vector< double > queryEpochs;
+    for ( int i = 0; i < 1000; i++ )
+    {
+        queryEpochs.push_back( 1000.0 + 11900.0 * std::fmod( 0.618033988749895 * i, 1.0 ) );
+    }
+
+    mathematics::StateHistoryInterpolator hermiteInterpolator( orbitStateHistory );
+    mathematics::StateHistoryInterpolator lagrangeInterpolator(
+                orbitStateHistory, mathematics::lagrangeStateInterpolation );
+
+    // Check that interpolated positions and velocities are accurate, given the maximum step of
+    // 90 s (about 1/64th of the orbit).
+    for ( std::size_t i = 0; i < queryEpochs.size( ); i++ )
+    {
+        const Vector6d expectedState = computeOrbitState( queryEpochs[ i ] );
+        const Vector6d hermiteState = hermiteInterpolator.interpolate( queryEpochs[ i ] );
+        const Vector6d lagrangeState = lagrangeInterpolator.interpolate( queryEpochs[ i ] );
+
+        BOOST_CHECK_SMALL( ( hermiteState - expectedState ).segment< 3 >( 0 ).norm( ), 5.0 );
+        BOOST_CHECK_SMALL( ( hermiteState - expectedState ).segment< 3 >( 3 ).norm( ), 0.1 );
+        BOOST_CHECK_SMALL( ( lagrangeState - expectedState ).segment< 3 >( 0 ).norm( ), 1.0e-4 );
+        BOOST_CHECK_SMALL( ( lagrangeState - expectedState ).segment< 3 >( 3 ).norm( ), 1.0e-7 );
+    }
+}
+
+//! Test that interpolation at epochs of state history returns stored states.
+BOOST_AUTO_TEST_CASE( testInterpolationAtEpochsOfStateHistory )
+{
+    // Sample state history of circular orbit at non-uniform epochs.
+    basics::DoubleKeyVector6dValueMap orbitStateHistory;
+    for ( int i = 0; i < 200; i++ )
+    {
+        const double epoch = 1000.0 + 60.0 * i + 15.0 * std::sin( 1.7 * i );
+        orbitStateHistory[ epoch ] = computeOrbitState( epoch );
+    }
+
+    mathematics::StateHistoryInterpolator hermiteInterpolator( orbitStateHistory );
+    mathematics::StateHistoryInterpolator lagrangeInterpolator(
+                orbitStateHistory, mathematics::lagrangeStateInterpolation );
+
+    for ( basics::DoubleKeyVector6dValueMap::const_iterator iteratorState
+          = orbitStateHistory.begin( ); iteratorState != orbitStateHistory.end( );
+          iteratorState++ )
+    {
+        BOOST_CHECK( lagrangeInterpolator.interpolate( iteratorState->first )
+                     == iteratorState->second );
+        BOOST_CHECK_SMALL( ( hermiteInterpolator.interpolate( iteratorState->first )
+                             - iteratorState->second ).norm( ), 1.0e-8 );
+    }
+}
+
+//! Test that results do not depend on order of queries.
+BOOST_AUTO_TEST_CASE( testIndependenceOfQueryOrder )
+{
+    // Sample state history of circular orbit at non-uniform epochs, with steps between 30 and
+    // 90 s.
+    basics::DoubleKeyVector6dValueMap orbitStateHistory;
+    for ( int i = 0; i < 200; i++ )
+    {
+        const double epoch = 1000.0 + 60.0 * i + 15.0 * std::sin( 1.7 * i );
+        orbitStateHistory[ epoch ] = computeOrbitState( epoch );
+    }
+
+    // Set query epochs in range of state history, in scrambled order.
+    std::vector< double > queryEpochs;
+    for ( int i = 0; i < 1000; i++ )
+    {
+        queryEpochs.push_back( 1000.0 + 11900.0 * std::fmod( 0.618033988749895 * i, 1.0 ) );
+    }
+
+    const mathematics::StateInterpolationMethod methods[ 2 ]
+            = { mathematics::hermiteStateInterpolation, mathematics::lagrangeStateInterpolation };
+
+    std::vector< double > sortedEpochs = queryEpochs;
+    std::sort( sortedEpochs.begin( ), sortedEpochs.end( ) );
+    std::vector< double > reversedEpochs( sortedEpochs.rbegin( ), sortedEpochs.rend( ) );
+
+    for ( int m = 0; m < 2; m++ )
+    {
+        mathematics::StateHistoryInterpolator interpolator( orbitStateHistory, methods[ m ] );
+
+        // Interpolate states in batch, in random, increasing and decreasing order.
+        Eigen::MatrixXd states;
+        Eigen::MatrixXd sortedStates;
+        Eigen::MatrixXd reversedStates;
+        interpolator.interpolate( queryEpochs, states );
+        interpolator.interpolate( sortedEpochs, sortedStates );
+        interpolator.interpolate( reversedEpochs, reversedStates );
+        BOOST_REQUIRE_EQUAL( states.rows( ), static_cast< int >( queryEpochs.size( ) ) );
+        BOOST_REQUIRE_EQUAL( states.cols( ), 6 );
+
+        // Check that each state matches the state from a new interpolator, i.e., without cursor
+        // history.
+        for ( std::size_t i = 0; i < queryEpochs.size( ); i++ )
+        {
+            mathematics::StateHistoryInterpolator newInterpolator( orbitStateHistory,
+                                                                   methods[ m ] );
+            const Vector6d expectedState = newInterpolator.interpolate( queryEpochs[ i ] );
+            BOOST_CHECK( Vector6d( states.row( i ).transpose( ) ) == expectedState );
+
+            const std::size_t sortedIndex = static_cast< std::size_t >(
+                        std::lower_bound( sortedEpochs.begin( ), sortedEpochs.end( ),
+                                          queryEpochs[ i ] ) - sortedEpochs.begin( ) );
+            BOOST_CHECK( Vector6d( sortedStates.row( sortedIndex ).transpose( ) )
+                         == expectedState );
+            BOOST_CHECK( Vector6d( reversedStates.row( queryEpochs.size( ) - 1 - sortedIndex )
+                                   .transpose( ) ) == expectedState );
+        }
+    }
+}
+
+//! Test that run-time errors are thrown for invalid input.
+BOOST_AUTO_TEST_CASE( testStateHistoryInterpolatorErrors )
+{
+    // Sample state history of cubic polynomial.
+    basics::DoubleKeyVector6dValueMap cubicStateHistory;
+    for ( int i = 0; i < 10; i++ )
+    {
+        cubicStateHistory[ 60.0 * i ] = computeCubicState( 60.0 * i );
+    }
+
+    // Declare error flags.
+    bool isErrorThrownForSingleState = false;
+    bool isErrorThrownForLargeWindow = false;
+    bool isErrorThrownForSmallWindow = false;
+    bool isErrorThrownForEpochBefore = false;
+    bool isErrorThrownForEpochAfter = false;
+
+    // Try to construct interpolator with single state.
+    basics::DoubleKeyVector6dValueMap singleStateHistory;
+    singleStateHistory[ 0.0 ] = Vector6d::Zero( );
+    try
+    {
+        mathematics::StateHistoryInterpolator interpolator( singleStateHistory );
+    }
+
+    catch ( std::runtime_error& )
+    {
+        isErrorThrownForSingleState = true;
+    }
+
+    // Try to construct Lagrange interpolator with window larger than state history.
+    try
+    {
+        mathematics::StateHistoryInterpolator interpolator(
+                    cubicStateHistory, mathematics::lagrangeStateInterpolation,
+                    cubicStateHistory.size( ) + 1 );
+    }
+
+    catch ( std::runtime_error& )
+    {
+        isErrorThrownForLargeWindow = true;
+    }
+
+    // Try to construct Lagrange interpolator with window of one epoch.
+    try
+    {
+        mathematics::StateHistoryInterpolator interpolator(
+                    cubicStateHistory, mathematics::lagrangeStateInterpolation, 1 );
+    }
+
+    catch ( std::runtime_error& )
+    {
+        isErrorThrownForSmallWindow = true;
+    }
+
+    // Try to interpolate outside range of state history.
+    mathematics::StateHistoryInterpolator interpolator( cubicStateHistory );
+    try
+    {
+        interpolator.interpolate( cubicStateHistory.begin( )->first - 1.0e-6 );
+    }
+
+    catch ( std::runtime_error& )
+    {
+        isErrorThrownForEpochBefore = true;
+    }
+
+    try
+    {
+        interpolator.interpolate( cubicStateHistory.rbegin( )->first + 1.0e-6 );
+    }
+
+    catch ( std::runtime_error& )
+    {
+        isErrorThrownForEpochAfter = true;
+    }
+
+    // Check that errors were thrown.
+    BOOST_CHECK( isErrorThrownForSingleState );
+    BOOST_CHECK( isErrorThrownForLargeWindow );
+    BOOST_CHECK( isErrorThrownForSmallWindow );
+    BOOST_CHECK( isErrorThrownForEpochBefore );
+    BOOST_CHECK( isErrorThrownForEpochAfter );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace assist
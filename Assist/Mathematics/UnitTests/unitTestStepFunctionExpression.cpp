@@ -0,0 +1,217 @@
+/*
+ *    Copyright (c) 2010-2014, Delft University of Technology
+ *    Copyright (c) 2010-2014, K. Kumar (me@kartikkumar.com)
+ *    All rights reserved.
+ *    See http://bit.ly/1jern3m for license details.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "Assist/Basics/commonTypedefs.h"
+#include "Assist/Mathematics/statistics.h"
+#include "Assist/Mathematics/stepFunctionExpression.h"
+
+namespace assist
+{
+namespace unit_tests
+{
+
+namespace
+{
+
+//! Get value of step function at abscissa.
+double getStepFunctionValue( const basics::DoubleKeyDoubleValueMap& stepFunction,
+                             const double abscissa )
+{
+    basics::DoubleKeyDoubleValueMap::const_iterator iteratorPoint
+            = stepFunction.upper_bound( abscissa );
+    if ( iteratorPoint != stepFunction.begin( ) )
+    {
+        iteratorPoint--;
+    }
+
+    return iteratorPoint->second;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE( test_step_function_expression )
+
+//! Test evaluation of expression with all operations.
+BOOST_AUTO_TEST_CASE( testStepFunctionExpressionEvaluation )
+{
+    using mathematics::StepFunctionExpression;
+
+    // Set power profiles and duty cycle, with keys that partly coincide.
+    basics::DoubleKeyDoubleValueMap firstPower;
+    firstPower[ 0.0 ] = 1.0;
+    firstPower[ 10.0 ] = 3.0;
+    firstPower[ 20.0 ] = 0.0;
+
+    basics::DoubleKeyDoubleValueMap secondPower;
+    secondPower[ 5.0 ] = 2.0;
+    secondPower[ 10.0 ] = 4.0;
+    secondPower[ 15.0 ] = 1.0;
+
+    basics::DoubleKeyDoubleValueMap dutyCycle;
+    dutyCycle[ 0.0 ] = 1.0;
+    dutyCycle[ 8.0 ] = 0.0;
+    dutyCycle[ 12.0 ] = 0.5;
+
+    const StepFunctionExpression first( firstPower );
+    const StepFunctionExpression second( secondPower );
+    const StepFunctionExpression duty( dutyCycle );
+
+    const StepFunctionExpression limitedPower
+            = mathematics::pointwiseMinimum( first + second, StepFunctionExpression( 5.0 ) )
+            * duty;
+    StepFunctionExpression combination
+            = mathematics::pointwiseMaximum( 2.0 * first - second / 4.0, -duty + 1.0 )
+            / ( 3.0 + second ) - 1.0;
+    combination += combination;
+
+    // Check values against values of inputs, at and between keys, and outside keys.
+    for ( double abscissa = -5.0; abscissa <= 25.0; abscissa += 0.5 )
+    {
+        const double firstValue = getStepFunctionValue( firstPower, abscissa );
+        const double secondValue = getStepFunctionValue( secondPower, abscissa );
+        const double dutyValue = getStepFunctionValue( dutyCycle, abscissa );
+
+        BOOST_CHECK_EQUAL( limitedPower.evaluate( abscissa ),
+                           std::min( firstValue + secondValue, 5.0 ) * dutyValue );
+        BOOST_CHECK_CLOSE_FRACTION(
+                    combination.evaluate( abscissa ),
+                    2.0 * ( std::max( 2.0 * firstValue - secondValue / 4.0, -dutyValue + 1.0 )
+                            / ( 3.0 + secondValue ) - 1.0 ), 1.0e-15 );
+    }
+
+    // Check step function of expression, which omits keys without change of value.
+    const basics::DoubleKeyDoubleValueMap stepFunction = limitedPower.computeStepFunction( );
+    basics::DoubleKeyDoubleValueMap expectedStepFunction;
+    expectedStepFunction[ 0.0 ] = 3.0;
+    expectedStepFunction[ 8.0 ] = 0.0;
+    expectedStepFunction[ 12.0 ] = 2.5;
+    expectedStepFunction[ 15.0 ] = 2.0;
+    expectedStepFunction[ 20.0 ] = 0.5;
+
+    BOOST_REQUIRE_EQUAL( stepFunction.size( ), expectedStepFunction.size( ) );
+    BOOST_CHECK( stepFunction == expectedStepFunction );
+
+    // Check that constant expression is evaluated.
+    BOOST_CHECK_EQUAL( ( StepFunctionExpression( 2.0 ) * 3.0 ).evaluate( 1.0 ), 6.0 );
+}
+
+//! Test window averages of expressions against averages of their step functions.
+BOOST_AUTO_TEST_CASE( testStepFunctionExpressionWindowAverage )
+{
+    using mathematics::StepFunctionExpression;
+
+    // Set step functions with keys scattered over [0, 1000] and values in [-1, 1].
+    const double keyIncrements[ 3 ] = { 0.618033988749895, 0.414213562373095, 0.732050807568877 };
+    basics::DoubleKeyDoubleValueMap stepFunctions[ 3 ];
+    for ( int f = 0; f < 3; f++ )
+    {
+        for ( int i = 1; i <= 1000; i++ )
+        {
+            stepFunctions[ f ][ 1000.0 * std::fmod( keyIncrements[ f ] * i, 1.0 ) ]
+                    = std::cos( 1.3 * i * ( f + 1 ) );
+        }
+    }
+
+    const StepFunctionExpression expression
+            = mathematics::pointwiseMaximum(
+                StepFunctionExpression( stepFunctions[ 0 ] )
+                * StepFunctionExpression( stepFunctions[ 1 ] ),
+                StepFunctionExpression( stepFunctions[ 2 ] ) - 0.5 )
+            + StepFunctionExpression( stepFunctions[ 0 ] );
+    const basics::DoubleKeyDoubleValueMap stepFunction = expression.computeStepFunction( );
+
+    // Check step function at scattered abscissae.
+    for ( int i = 1; i <= 1000; i++ )
+    {
+        const double abscissa = 1000.0 * std::fmod( 0.236067977499790 * i, 1.0 );
+        BOOST_CHECK_EQUAL( getStepFunctionValue( stepFunction, abscissa ),
+                           expression.evaluate( abscissa ) );
+    }
+
+    // Check window averages, for windows with many steps and within one step.
+    const double lowerBounds[ 4 ] = { 1.0, 123.4, 500.0, 700.0 };
+    const double upperBounds[ 4 ] = { 999.0, 456.7, 500.001, 700.0001 };
+    for ( int w = 0; w < 4; w++ )
+    {
+        BOOST_CHECK_CLOSE_FRACTION(
+                    expression.computeWindowAverage( lowerBounds[ w ], upperBounds[ w ] ),
+                    mathematics::computeStepFunctionWindowAverage( stepFunction, lowerBounds[ w ],
+                                                                   upperBounds[ w ] ),
+                    1.0e-12 );
+    }
+
+    // Check window average outside keys, where first and last values hold.
+    BOOST_CHECK_CLOSE_FRACTION( expression.computeWindowAverage( -10.0, -5.0 ),
+                                stepFunction.begin( )->second, 1.0e-15 );
+    BOOST_CHECK_CLOSE_FRACTION( expression.computeWindowAverage( 2000.0, 2001.0 ),
+                                stepFunction.rbegin( )->second, 1.0e-15 );
+}
+
+//! Test that run-time errors are thrown for invalid input.
+BOOST_AUTO_TEST_CASE( testStepFunctionExpressionErrors )
+{
+    using mathematics::StepFunctionExpression;
+
+    // Declare error flags.
+    bool isErrorThrownForEmptyStepFunction = false;
+    bool isErrorThrownForConstantExpression = false;
+    bool isErrorThrownForWindow = false;
+
+    // Try to create expression of empty step function.
+    try
+    {
+        const basics::DoubleKeyDoubleValueMap emptyStepFunction;
+        const StepFunctionExpression expression( emptyStepFunction );
+    }
+
+    catch ( std::runtime_error& )
+    {
+        isErrorThrownForEmptyStepFunction = true;
+    }
+
+    // Try to compute step function of constant expression.
+    try
+    {
+        StepFunctionExpression( 1.0 ).computeStepFunction( );
+    }
+
+    catch ( std::runtime_error& )
+    {
+        isErrorThrownForConstantExpression = true;
+    }
+
+    // Try to compute average over window with reversed bounds.
+    try
+    {
+        basics::DoubleKeyDoubleValueMap stepFunction;
+        stepFunction[ 0.0 ] = 1.0;
+        stepFunction[ 10.0 ] = 3.0;
+        StepFunctionExpression( stepFunction ).computeWindowAverage( 2.0, 1.0 );
+    }
+
+    catch ( std::runtime_error& )
+    {
+        isErrorThrownForWindow = true;
+    }
+
+    // Check that errors were thrown.
+    BOOST_CHECK( isErrorThrownForEmptyStepFunction );
+    BOOST_CHECK( isErrorThrownForConstantExpression );
+    BOOST_CHECK( isErrorThrownForWindow );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace assist
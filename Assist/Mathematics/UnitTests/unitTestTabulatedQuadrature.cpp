@@ -0,0 +1,239 @@
+/*
+ *    Copyright (c) 2010-2014, Delft University of Technology
+ *    Copyright (c) 2010-2014, K. Kumar (me@kartikkumar.com)
+ *    All rights reserved.
+ *    See http://bit.ly/1jern3m for license details.
+ */
+
+#include <cmath>
+#include <stdexcept>
+
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include "Assist/Basics/commonTypedefs.h"
+#include "Assist/Mathematics/tabulatedQuadrature.h"
+
+namespace assist
+{
+namespace unit_tests
+{
+
+namespace
+{
+
+//! Compute sorted grid with non-uniform spacing between given bounds.
+/*!
+ * Computes sorted grid between given bounds, with spacings that vary between 0.5 and 1.5 times
+ * the mean spacing.
+ */
+Eigen::ArrayXd computeNonUniformGrid( const int numberOfPoints, const double lowerBound,
+                                      const double upperBound )
+{
+    Eigen::ArrayXd spacings( numberOfPoints - 1 );
+    for ( int i = 0; i < numberOfPoints - 1; i++ )
+    {
+        spacings( i ) = 1.0 + 0.5 * std::sin( 1.7 * i );
+    }
+
+    spacings *= ( upperBound - lowerBound ) / spacings.sum( );
+
+    Eigen::ArrayXd grid( numberOfPoints );
+    grid( 0 ) = lowerBound;
+    for ( int i = 1; i < numberOfPoints; i++ )
+    {
+        grid( i ) = grid( i - 1 ) + spacings( i - 1 );
+    }
+
+    grid( numberOfPoints - 1 ) = upperBound;
+    return grid;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE( test_tabulated_quadrature )
+
+//! Test that rules are exact for polynomials of their order.
+BOOST_AUTO_TEST_CASE( testTabulatedQuadratureExactness )
+{
+    // Set non-uniform grid with 101 points on [0, 2].
+    const Eigen::ArrayXd smallGrid = computeNonUniformGrid( 101, 0.0, 2.0 );
+
+    // Test grids with even and odd numbers of intervals.
+    for ( int g = 0; g < 2; g++ )
+    {
+        const Eigen::ArrayXd grid = g == 0 ? smallGrid : Eigen::ArrayXd( smallGrid.head( 100 ) );
+        const double lowerBound = grid( 0 );
+        const double upperBound = grid( grid.size( ) - 1 );
+
+        // Check that trapezoidal rule is exact for linear function, and Simpson's rule for
+        // quadratic function.
+        const Eigen::ArrayXd linearValues = 3.0 - 2.0 * grid;
+        const Eigen::ArrayXd quadraticValues = 1.0 + grid - 4.0 * grid.square( );
+
+        BOOST_CHECK_CLOSE_FRACTION(
+                    mathematics::integrateTrapezoidal( grid, linearValues ),
+                    3.0 * ( upperBound - lowerBound )
+                    - ( upperBound * upperBound - lowerBound * lowerBound ), 1.0e-13 );
+        BOOST_CHECK_CLOSE_FRACTION(
+                    mathematics::integrateSimpson( grid, quadraticValues ),
+                    ( upperBound - lowerBound )
+                    + 0.5 * ( upperBound * upperBound - lowerBound * lowerBound )
+                    - 4.0 / 3.0 * ( upperBound * upperBound * upperBound
+                                    - lowerBound * lowerBound * lowerBound ), 1.0e-13 );
+
+        // Check that cumulative integral of linear function is exact at all points.
+        Eigen::ArrayXd cumulativeIntegral;
+        mathematics::computeCumulativeTrapezoidalIntegral( grid, linearValues,
+                                                           cumulativeIntegral );
+        BOOST_REQUIRE_EQUAL( cumulativeIntegral.size( ), grid.size( ) );
+        BOOST_CHECK_EQUAL( cumulativeIntegral( 0 ), 0.0 );
+        for ( int i = 1; i < grid.size( ); i++ )
+        {
+            BOOST_CHECK_SMALL( cumulativeIntegral( i )
+                               - ( 3.0 * ( grid( i ) - lowerBound )
+                                   - ( grid( i ) * grid( i ) - lowerBound * lowerBound ) ),
+                               1.0e-13 );
+        }
+    }
+
+    // Check that both rules are exact for two points.
+    Eigen::ArrayXd twoPoints( 2 );
+    twoPoints << 1.0, 4.0;
+    const Eigen::ArrayXd twoValues = 2.0 * twoPoints;
+    BOOST_CHECK_EQUAL( mathematics::integrateTrapezoidal( twoPoints, twoValues ), 15.0 );
+    BOOST_CHECK_EQUAL( mathematics::integrateSimpson( twoPoints, twoValues ), 15.0 );
+}
+
+//! Test accuracy and thread independence for large grid.
+BOOST_AUTO_TEST_CASE( testTabulatedQuadratureLargeGrid )
+{
+    // Set non-uniform grid with 300002 points on [-1, 3].
+    const Eigen::ArrayXd largeGrid = computeNonUniformGrid( 300002, -1.0, 3.0 );
+    const Eigen::ArrayXd values = largeGrid.exp( );
+    const double expectedIntegral = std::exp( 3.0 ) - std::exp( -1.0 );
+
+    // Integrate with one and multiple threads.
+    const double trapezoidalIntegral = mathematics::integrateTrapezoidal( largeGrid, values );
+    const double simpsonIntegral = mathematics::integrateSimpson( largeGrid, values );
+    Eigen::ArrayXd cumulativeIntegral;
+    mathematics::computeCumulativeTrapezoidalIntegral( largeGrid, values, cumulativeIntegral );
+
+    Eigen::ArrayXd cumulativeIntegralInParallel;
+    mathematics::computeCumulativeTrapezoidalIntegral( largeGrid, values,
+                                                       cumulativeIntegralInParallel, 4 );
+    BOOST_CHECK_EQUAL( mathematics::integrateTrapezoidal( largeGrid, values, 4 ),
+                       trapezoidalIntegral );
+    BOOST_CHECK_EQUAL( mathematics::integrateSimpson( largeGrid, values, 3 ), simpsonIntegral );
+    BOOST_CHECK( ( cumulativeIntegralInParallel == cumulativeIntegral ).all( ) );
+
+    // Check accuracy, with errors of O(h^2) for trapezoidal rule and O(h^4) for Simpson's rule,
+    // and that the cumulative integral matches the exact integral and the trapezoidal rule.
+    BOOST_CHECK_CLOSE_FRACTION( trapezoidalIntegral, expectedIntegral, 1.0e-10 );
+    BOOST_CHECK_CLOSE_FRACTION( simpsonIntegral, expectedIntegral, 1.0e-14 );
+    BOOST_CHECK_CLOSE_FRACTION( cumulativeIntegral( largeGrid.size( ) - 1 ), trapezoidalIntegral,
+                                1.0e-15 );
+    for ( int i = 0; i < largeGrid.size( ); i += 997 )
+    {
+        BOOST_CHECK_SMALL( cumulativeIntegral( i ) - ( values( i ) - std::exp( -1.0 ) ),
+                           1.0e-9 );
+    }
+}
+
+//! Test integration of series stored in maps.
+BOOST_AUTO_TEST_CASE( testTabulatedQuadratureSeries )
+{
+    // Set series on non-uniform grid with 101 points on [0, 2].
+    const Eigen::ArrayXd smallGrid = computeNonUniformGrid( 101, 0.0, 2.0 );
+    basics::DoubleKeyDoubleValueMap series;
+    basics::DoubleKeyVector3dValueMap vector3dSeries;
+    basics::DoubleKeyVector6dValueMap vector6dSeries;
+    for ( int i = 0; i < smallGrid.size( ); i++ )
+    {
+        const double t = smallGrid( i );
+        series[ t ] = std::cos( t );
+        vector3dSeries[ t ] = Eigen::Vector3d( 1.0, t, t * t );
+
+        tudat::basic_mathematics::Vector6d value;
+        value << std::cos( t ), t, -t, 2.0, 0.0, std::sin( t );
+        vector6dSeries[ t ] = value;
+    }
+
+    // Check that integrals of series match integrals of arrays.
+    const Eigen::ArrayXd cosineValues = smallGrid.cos( );
+    BOOST_CHECK_EQUAL( mathematics::integrateTrapezoidal( series ),
+                       mathematics::integrateTrapezoidal( smallGrid, cosineValues ) );
+    BOOST_CHECK_EQUAL( mathematics::integrateSimpson( series ),
+                       mathematics::integrateSimpson( smallGrid, cosineValues ) );
+
+    // Check that integrals of vector series are computed component-wise.
+    const Eigen::Vector3d vector3dIntegral = mathematics::integrateSimpson( vector3dSeries );
+    BOOST_CHECK_CLOSE_FRACTION( vector3dIntegral( 0 ), 2.0, 1.0e-14 );
+    BOOST_CHECK_CLOSE_FRACTION( vector3dIntegral( 1 ), 2.0, 1.0e-14 );
+    BOOST_CHECK_CLOSE_FRACTION( vector3dIntegral( 2 ), 8.0 / 3.0, 1.0e-13 );
+    BOOST_CHECK_CLOSE_FRACTION( mathematics::integrateTrapezoidal( vector3dSeries )( 1 ), 2.0,
+                                1.0e-14 );
+
+    const tudat::basic_mathematics::Vector6d vector6dIntegral
+            = mathematics::integrateTrapezoidal( vector6dSeries );
+    BOOST_CHECK_EQUAL( vector6dIntegral( 0 ), mathematics::integrateTrapezoidal( series ) );
+    BOOST_CHECK_CLOSE_FRACTION( vector6dIntegral( 1 ), 2.0, 1.0e-14 );
+    BOOST_CHECK_CLOSE_FRACTION( vector6dIntegral( 2 ), -2.0, 1.0e-14 );
+    BOOST_CHECK_CLOSE_FRACTION( vector6dIntegral( 3 ), 4.0, 1.0e-14 );
+    BOOST_CHECK_EQUAL( vector6dIntegral( 4 ), 0.0 );
+    BOOST_CHECK_CLOSE_FRACTION( mathematics::integrateSimpson( vector6dSeries )( 5 ),
+                                1.0 - std::cos( 2.0 ), 1.0e-7 );
+
+    // Check that cumulative integral of series is stored at independent values.
+    const basics::DoubleKeyDoubleValueMap cumulativeIntegral
+            = mathematics::computeCumulativeTrapezoidalIntegral( series );
+    BOOST_REQUIRE_EQUAL( cumulativeIntegral.size( ), series.size( ) );
+    BOOST_CHECK_EQUAL( cumulativeIntegral.begin( )->first, 0.0 );
+    BOOST_CHECK_EQUAL( cumulativeIntegral.begin( )->second, 0.0 );
+    BOOST_CHECK_EQUAL( cumulativeIntegral.rbegin( )->first, 2.0 );
+    BOOST_CHECK_CLOSE_FRACTION( cumulativeIntegral.rbegin( )->second, std::sin( 2.0 ), 1.0e-4 );
+}
+
+//! Test that run-time errors are thrown for invalid input.
+BOOST_AUTO_TEST_CASE( testTabulatedQuadratureErrors )
+{
+    // Declare error flags.
+    bool isErrorThrownForSizes = false;
+    bool isErrorThrownForNumberOfPoints = false;
+
+    // Try to integrate arrays with mismatching sizes.
+    try
+    {
+        mathematics::integrateSimpson( Eigen::ArrayXd::LinSpaced( 101, 0.0, 2.0 ),
+                                       Eigen::ArrayXd::Ones( 100 ) );
+    }
+
+    catch ( std::runtime_error& )
+    {
+        isErrorThrownForSizes = true;
+    }
+
+    // Try to integrate single point.
+    try
+    {
+        Eigen::ArrayXd cumulativeIntegral;
+        mathematics::computeCumulativeTrapezoidalIntegral(
+                    Eigen::ArrayXd::Ones( 1 ), Eigen::ArrayXd::Ones( 1 ), cumulativeIntegral );
+    }
+
+    catch ( std::runtime_error& )
+    {
+        isErrorThrownForNumberOfPoints = true;
+    }
+
+    // Check that errors were thrown.
+    BOOST_CHECK( isErrorThrownForSizes );
+    BOOST_CHECK( isErrorThrownForNumberOfPoints );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace assist
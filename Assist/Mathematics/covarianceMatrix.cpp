@@ -0,0 +1,295 @@
+/*
+ *    Copyright (c) 2010-2014, Delft University of Technology
+ *    Copyright (c) 2010-2014, K. Kumar (me@kartikkumar.com)
+ *    All rights reserved.
+ *    See http://bit.ly/1jern3m for license details.
+ */
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+#include <boost/exception/all.hpp>
+
+#include "Assist/Basics/parallelLoop.h"
+#include "Assist/Mathematics/covarianceMatrix.h"
+
+namespace assist
+{
+namespace mathematics
+{
+
+namespace
+{
+
+//! Number of channels per tile of scatter matrix.
+const Eigen::MatrixXd::Index numberOfChannelsPerTile = 64;
+
+//! Number of samples per block of deviations.
+const Eigen::MatrixXd::Index numberOfSamplesPerBlock = 1024;
+
+//! Typedef for pair of indices of tiles of channels.
+typedef std::pair< Eigen::MatrixXd::Index, Eigen::MatrixXd::Index > TilePair;
+
+//! Loop body to compute tiles of scatter matrix.
+/*!
+ * Loop body to compute tiles of the scatter matrix of samples, on and above the diagonal. Each
+ * tile is accumulated over blocks of samples, as the product of the deviations from the means of
+ * the two tiles of channels, and copied to its mirrored position below the diagonal.
+ */
+struct ComputeScatterTiles
+{
+    //! Compute tiles in range [begin, end).
+    void operator( )( const std::size_t begin, const std::size_t end ) const
+    {
+        const Eigen::MatrixXd::Index numberOfSamples = samples->rows( );
+        const Eigen::MatrixXd::Index numberOfChannels = samples->cols( );
+
+        Eigen::MatrixXd firstDeviations;
+        Eigen::MatrixXd secondDeviations;
+        Eigen::MatrixXd tile;
+        for ( std::size_t t = begin; t < end; t++ )
+        {
+            const Eigen::MatrixXd::Index firstChannel
+                    = ( *tilePairs )[ t ].first * numberOfChannelsPerTile;
+            const Eigen::MatrixXd::Index secondChannel
+                    = ( *tilePairs )[ t ].second * numberOfChannelsPerTile;
+            const Eigen::MatrixXd::Index firstWidth
+                    = std::min( numberOfChannelsPerTile, numberOfChannels - firstChannel );
+            const Eigen::MatrixXd::Index secondWidth
+                    = std::min( numberOfChannelsPerTile, numberOfChannels - secondChannel );
+            const bool isDiagonal = firstChannel == secondChannel;
+
+            tile.setZero( firstWidth, secondWidth );
+            for ( Eigen::MatrixXd::Index first = 0; first < numberOfSamples;
+                  first += numberOfSamplesPerBlock )
+            {
+                const Eigen::MatrixXd::Index size
+                        = std::min( numberOfSamplesPerBlock, numberOfSamples - first );
+                firstDeviations = samples->block( first, firstChannel, size, firstWidth ).rowwise( )
+                        - means->segment( firstChannel, firstWidth ).transpose( );
+                if ( isDiagonal )
+                {
+                    tile.noalias( ) += firstDeviations.transpose( ) * firstDeviations;
+                    continue;
+                }
+
+                secondDeviations
+                        = samples->block( first, secondChannel, size, secondWidth ).rowwise( )
+                        - means->segment( secondChannel, secondWidth ).transpose( );
+                tile.noalias( ) += firstDeviations.transpose( ) * secondDeviations;
+            }
+
+            // Make diagonal tiles exactly symmetric.
+            if ( isDiagonal )
+            {
+                tile.triangularView< Eigen::StrictlyLower >( ) = tile.transpose( );
+            }
+
+            scatterMatrix->block( firstChannel, secondChannel, firstWidth, secondWidth ) = tile;
+            if ( !isDiagonal )
+            {
+                scatterMatrix->block( secondChannel, firstChannel, secondWidth, firstWidth )
+                        = tile.transpose( );
+            }
+        }
+    }
+
+    //! Samples.
+    const Eigen::MatrixXd* samples;
+
+    //! Means of channels.
+    const Eigen::VectorXd* means;
+
+    //! Pairs of indices of tiles of channels, on and above the diagonal.
+    const std::vector< TilePair >* tilePairs;
+
+    //! Scatter matrix.
+    Eigen::MatrixXd* scatterMatrix;
+};
+
+//! Check if keys of points of series are equal.
+bool haveEqualKeys( const basics::DoubleKeyDoubleValueMap::value_type& firstPoint,
+                    const basics::DoubleKeyDoubleValueMap::value_type& secondPoint )
+{
+    return firstPoint.first == secondPoint.first;
+}
+
+//! Check that at least two samples were added.
+void checkNumberOfSamples( const std::size_t numberOfSamples )
+{
+    if ( numberOfSamples < 2 )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Error: at least two samples are required." ) ) );
+    }
+}
+
+} // namespace
+
+//! Constructor taking number of channels and number of threads.
+CovarianceAccumulator::CovarianceAccumulator( const Eigen::MatrixXd::Index aNumberOfChannels,
+                                              const unsigned int aNumberOfThreads )
+    : numberOfThreads( aNumberOfThreads ),
+      numberOfSamples( 0 ),
+      means( Eigen::VectorXd::Zero( aNumberOfChannels ) ),
+      scatterMatrix( Eigen::MatrixXd::Zero( aNumberOfChannels, aNumberOfChannels ) )
+{ }
+
+//! Add chunk of samples.
+void CovarianceAccumulator::addSamples( const Eigen::MatrixXd& samples )
+{
+    if ( samples.cols( ) != means.size( ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Error: number of columns does not match number of channels." ) ) );
+    }
+
+    if ( samples.rows( ) == 0 )
+    {
+        return;
+    }
+
+    // Compute means and scatter matrix of chunk, in parallel over tiles of channels.
+    CovarianceAccumulator chunkAccumulator( means.size( ), numberOfThreads );
+    chunkAccumulator.numberOfSamples = static_cast< std::size_t >( samples.rows( ) );
+    chunkAccumulator.means = samples.colwise( ).mean( ).transpose( );
+
+    const Eigen::MatrixXd::Index numberOfTiles
+            = ( means.size( ) + numberOfChannelsPerTile - 1 ) / numberOfChannelsPerTile;
+    std::vector< TilePair > tilePairs;
+    tilePairs.reserve( numberOfTiles * ( numberOfTiles + 1 ) / 2 );
+    for ( Eigen::MatrixXd::Index i = 0; i < numberOfTiles; i++ )
+    {
+        for ( Eigen::MatrixXd::Index j = i; j < numberOfTiles; j++ )
+        {
+            tilePairs.push_back( std::make_pair( i, j ) );
+        }
+    }
+
+    const ComputeScatterTiles loopBody = { &samples, &chunkAccumulator.means, &tilePairs,
+                                           &chunkAccumulator.scatterMatrix };
+    basics::executeParallelLoop( tilePairs.size( ), loopBody, numberOfThreads, 1 );
+
+    merge( chunkAccumulator );
+}
+
+//! Merge other accumulator.
+void CovarianceAccumulator::merge( const CovarianceAccumulator& otherAccumulator )
+{
+    if ( otherAccumulator.means.size( ) != means.size( ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Error: numbers of channels do not match." ) ) );
+    }
+
+    if ( otherAccumulator.numberOfSamples == 0 )
+    {
+        return;
+    }
+
+    if ( numberOfSamples == 0 )
+    {
+        numberOfSamples = otherAccumulator.numberOfSamples;
+        means = otherAccumulator.means;
+        scatterMatrix = otherAccumulator.scatterMatrix;
+        return;
+    }
+
+    // Combine with pairwise update (Chan et al., 1979).
+    const double firstNumberOfSamples = static_cast< double >( numberOfSamples );
+    const double secondNumberOfSamples = static_cast< double >( otherAccumulator.numberOfSamples );
+    const double totalNumberOfSamples = firstNumberOfSamples + secondNumberOfSamples;
+    const Eigen::VectorXd differenceOfMeans = otherAccumulator.means - means;
+
+    scatterMatrix += otherAccumulator.scatterMatrix;
+    scatterMatrix.noalias( ) += ( firstNumberOfSamples * secondNumberOfSamples
+                                  / totalNumberOfSamples )
+            * differenceOfMeans * differenceOfMeans.transpose( );
+    scatterMatrix.triangularView< Eigen::StrictlyLower >( ) = scatterMatrix.transpose( );
+    means += ( secondNumberOfSamples / totalNumberOfSamples ) * differenceOfMeans;
+    numberOfSamples += otherAccumulator.numberOfSamples;
+}
+
+//! Compute covariance matrix.
+Eigen::MatrixXd CovarianceAccumulator::computeCovarianceMatrix( ) const
+{
+    checkNumberOfSamples( numberOfSamples );
+    return scatterMatrix / static_cast< double >( numberOfSamples - 1 );
+}
+
+//! Compute correlation matrix.
+Eigen::MatrixXd CovarianceAccumulator::computeCorrelationMatrix( ) const
+{
+    checkNumberOfSamples( numberOfSamples );
+    const Eigen::VectorXd inverseScales = scatterMatrix.diagonal( ).cwiseSqrt( ).cwiseInverse( );
+    Eigen::MatrixXd correlationMatrix
+            = inverseScales.asDiagonal( ) * scatterMatrix * inverseScales.asDiagonal( );
+
+    // Set diagonal exactly, for channels with non-zero variance.
+    for ( Eigen::MatrixXd::Index i = 0; i < correlationMatrix.rows( ); i++ )
+    {
+        if ( scatterMatrix( i, i ) > 0.0 )
+        {
+            correlationMatrix( i, i ) = 1.0;
+        }
+    }
+
+    return correlationMatrix;
+}
+
+//! Pack aligned series in matrix.
+void packAlignedSeries( const std::vector< basics::DoubleKeyDoubleValueMap >& series,
+                        Eigen::MatrixXd& samples )
+{
+    if ( series.empty( ) )
+    {
+        samples.resize( 0, 0 );
+        return;
+    }
+
+    samples.resize( series[ 0 ].size( ), series.size( ) );
+    for ( std::size_t j = 0; j < series.size( ); j++ )
+    {
+        if ( series[ j ].size( ) != series[ 0 ].size( )
+             || !std::equal( series[ j ].begin( ), series[ j ].end( ), series[ 0 ].begin( ),
+                             haveEqualKeys ) )
+        {
+            boost::throw_exception(
+                        boost::enable_error_info(
+                            std::runtime_error( "Error: keys of series are not aligned." ) ) );
+        }
+
+        Eigen::MatrixXd::Index i = 0;
+        for ( basics::DoubleKeyDoubleValueMap::const_iterator iteratorPoint = series[ j ].begin( );
+              iteratorPoint != series[ j ].end( ); iteratorPoint++, i++ )
+        {
+            samples( i, j ) = iteratorPoint->second;
+        }
+    }
+}
+
+//! Compute covariance matrix of channels.
+void computeCovarianceMatrix( const Eigen::MatrixXd& samples, Eigen::MatrixXd& covarianceMatrix,
+                              const unsigned int numberOfThreads )
+{
+    CovarianceAccumulator accumulator( samples.cols( ), numberOfThreads );
+    accumulator.addSamples( samples );
+    covarianceMatrix = accumulator.computeCovarianceMatrix( );
+}
+
+//! Compute correlation matrix of channels.
+void computeCorrelationMatrix( const Eigen::MatrixXd& samples, Eigen::MatrixXd& correlationMatrix,
+                               const unsigned int numberOfThreads )
+{
+    CovarianceAccumulator accumulator( samples.cols( ), numberOfThreads );
+    accumulator.addSamples( samples );
+    correlationMatrix = accumulator.computeCorrelationMatrix( );
+}
+
+} // namespace mathematics
+} // namespace assist
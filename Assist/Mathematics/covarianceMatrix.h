@@ -0,0 +1,146 @@
+/*
+ *    Copyright (c) 2010-2014, Delft University of Technology
+ *    Copyright (c) 2010-2014, K. Kumar (me@kartikkumar.com)
+ *    All rights reserved.
+ *    See http://bit.ly/1jern3m for license details.
+ */
+
+#ifndef ASSIST_COVARIANCE_MATRIX_H
+#define ASSIST_COVARIANCE_MATRIX_H
+
+#include <cstddef>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "Assist/Basics/commonTypedefs.h"
+
+namespace assist
+{
+namespace mathematics
+{
+
+//! Accumulator of covariance matrix of channels.
+/*!
+ * Accumulator of the covariance matrix of aligned channels, to which samples are added in chunks,
+ * such that data that does not fit in memory can be streamed, and which can be merged with other
+ * accumulators, e.g., one per thread. Each chunk is stored as a matrix with one row per sample and
+ * one column per channel. The accumulator holds the number of samples, the means of the channels
+ * and the scatter matrix (sum of outer products of deviations from the means); chunks and
+ * accumulators are combined with the pairwise update of Chan et al. (1979), which avoids the
+ * cancellation of sums of products of raw values. The scatter matrix of a chunk is computed with
+ * matrix products of tiles of channels, in parallel over the tiles, so that each tile is a
+ * cache-blocked GEMM of the deviations over the samples; the results are the same for any number
+ * of threads.
+ */
+class CovarianceAccumulator
+{
+public:
+
+    //! Constructor taking number of channels and number of threads.
+    /*!
+     * Constructor taking number of channels and number of threads.
+     * \param aNumberOfChannels Number of channels.
+     * \param aNumberOfThreads Number of threads to use (0 = number of hardware threads;
+     *          default=1).
+     */
+    CovarianceAccumulator( const Eigen::MatrixXd::Index aNumberOfChannels,
+                           const unsigned int aNumberOfThreads = 1 );
+
+    //! Add chunk of samples.
+    /*!
+     * Adds chunk of samples. Throws a run-time error if the number of columns of the chunk does
+     * not match the number of channels.
+     * \param samples Samples, with one row per sample and one column per channel.
+     */
+    void addSamples( const Eigen::MatrixXd& samples );
+
+    //! Merge other accumulator.
+    /*!
+     * Merges other accumulator into this accumulator, as if the samples of both had been added to
+     * this accumulator. Throws a run-time error if the numbers of channels do not match.
+     * \param otherAccumulator Other accumulator.
+     */
+    void merge( const CovarianceAccumulator& otherAccumulator );
+
+    //! Get number of samples.
+    std::size_t getNumberOfSamples( ) const { return numberOfSamples; }
+
+    //! Get means of channels.
+    const Eigen::VectorXd& getMeans( ) const { return means; }
+
+    //! Compute covariance matrix.
+    /*!
+     * Computes (sample) covariance matrix of channels, i.e., the scatter matrix divided by the
+     * number of samples minus one. Throws a run-time error if fewer than two samples were added.
+     * \return Covariance matrix.
+     */
+    Eigen::MatrixXd computeCovarianceMatrix( ) const;
+
+    //! Compute correlation matrix.
+    /*!
+     * Computes correlation matrix of channels, i.e., the covariance matrix scaled by the standard
+     * deviations of the channels. Correlations of channels with zero variance are not a number.
+     * Throws a run-time error if fewer than two samples were added.
+     * \return Correlation matrix.
+     */
+    Eigen::MatrixXd computeCorrelationMatrix( ) const;
+
+protected:
+
+private:
+
+    //! Number of threads.
+    unsigned int numberOfThreads;
+
+    //! Number of samples.
+    std::size_t numberOfSamples;
+
+    //! Means of channels.
+    Eigen::VectorXd means;
+
+    //! Scatter matrix, i.e., sum of outer products of deviations from means.
+    Eigen::MatrixXd scatterMatrix;
+};
+
+//! Pack aligned series in matrix.
+/*!
+ * Packs aligned series, which share the same keys, in a (column-major) matrix with one row per
+ * key and one column per series. Throws a run-time error if the keys of the series differ.
+ * \param series Aligned series, as keys and values.
+ * \param samples Samples, with one row per key and one column per series (resized if needed).
+ */
+void packAlignedSeries( const std::vector< basics::DoubleKeyDoubleValueMap >& series,
+                        Eigen::MatrixXd& samples );
+
+//! Compute covariance matrix of channels.
+/*!
+ * Computes (sample) covariance matrix of channels (see CovarianceAccumulator).
+ * \param samples Samples, with one row per sample and one column per channel.
+ * \param covarianceMatrix Covariance matrix (resized if needed).
+ * \param numberOfThreads Number of threads to use (0 = number of hardware threads; default=1).
+ */
+void computeCovarianceMatrix( const Eigen::MatrixXd& samples, Eigen::MatrixXd& covarianceMatrix,
+                              const unsigned int numberOfThreads = 1 );
+
+//! Compute correlation matrix of channels.
+/*!
+ * Computes correlation matrix of channels (see CovarianceAccumulator).
+ * \param samples Samples, with one row per sample and one column per channel.
+ * \param correlationMatrix Correlation matrix (resized if needed).
+ * \param numberOfThreads Number of threads to use (0 = number of hardware threads; default=1).
+ */
+void computeCorrelationMatrix( const Eigen::MatrixXd& samples, Eigen::MatrixXd& correlationMatrix,
+                               const unsigned int numberOfThreads = 1 );
+
+} // namespace mathematics
+} // namespace assist
+
+#endif // ASSIST_COVARIANCE_MATRIX_H
+
+/*
+ *    References
+ *      Chan, T.F., Golub, G.H., LeVeque, R.J. Updating formulae and a pairwise algorithm for
+ *          computing sample variances, Technical Report STAN-CS-79-773, Stanford University,
+ *          1979.
+ */
@@ -0,0 +1,201 @@
+/*
+ *    Copyright (c) 2010-2014, Delft University of Technology
+ *    Copyright (c) 2010-2014, K. Kumar (me@kartikkumar.com)
+ *    All rights reserved.
+ *    See http://bit.ly/1jern3m for license details.
+ */
+
+#include <stdexcept>
+
+#include <boost/exception/all.hpp>
+#include <boost/math/special_functions/fpclassify.hpp>
+
+#include "Assist/Mathematics/empiricalDistributionSampler.h"
+
+namespace assist
+{
+namespace mathematics
+{
+
+namespace
+{
+
+//! Number of samples per block of vectorized transformation.
+const Eigen::ArrayXd::Index numberOfSamplesPerBlock = 256;
+
+//! Number of samples per chunk of generated uniform samples.
+const std::size_t numberOfSamplesPerChunk = 1048576;
+
+//! Map of every other uniform sample.
+typedef Eigen::Map< const Eigen::ArrayXd, Eigen::Unaligned, Eigen::InnerStride< 2 > >
+StridedUniformSamples;
+
+} // namespace
+
+//! Constructor taking probability density.
+EmpiricalDistributionSampler::EmpiricalDistributionSampler(
+        const basics::DoubleKeyDoubleValueMap& aProbabilityDensity )
+{
+    if ( aProbabilityDensity.size( ) < 2 )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Error: probability density must have at least two keys." ) ) );
+    }
+
+    numberOfBins = aProbabilityDensity.size( ) - 1;
+    numberOfBinsAsDouble = static_cast< double >( numberOfBins );
+    lowerEdges.reserve( numberOfBins );
+    widths.reserve( numberOfBins );
+
+    // Compute probabilities of bins, as density times width.
+    std::vector< double > probabilities;
+    probabilities.reserve( numberOfBins );
+    double totalProbability = 0.0;
+    basics::DoubleKeyDoubleValueMap::const_iterator iteratorPoint = aProbabilityDensity.begin( );
+    for ( std::size_t i = 0; i < numberOfBins; i++ )
+    {
+        const double lowerEdge = iteratorPoint->first;
+        const double density = iteratorPoint->second;
+        iteratorPoint++;
+
+        if ( !( density >= 0.0 ) || !( boost::math::isfinite )( density ) )
+        {
+            boost::throw_exception(
+                        boost::enable_error_info(
+                            std::runtime_error(
+                                "Error: probability density must be non-negative and "
+                                "finite." ) ) );
+        }
+
+        lowerEdges.push_back( lowerEdge );
+        widths.push_back( iteratorPoint->first - lowerEdge );
+        probabilities.push_back( density * widths.back( ) );
+        totalProbability += probabilities.back( );
+    }
+
+    if ( !( totalProbability > 0.0 ) || !( boost::math::isfinite )( totalProbability ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Error: total probability must be positive and finite." ) ) );
+    }
+
+    // Build alias table with Vose's method: scale probabilities to a mean of 1, and pair each
+    // bin with a scaled probability below 1 with a bin with a scaled probability of at least 1,
+    // which takes over the remainder of the slot of the first bin.
+    thresholds.resize( numberOfBins );
+    aliases.resize( numberOfBins );
+    std::vector< std::size_t > smallBins;
+    std::vector< std::size_t > largeBins;
+    for ( std::size_t i = 0; i < numberOfBins; i++ )
+    {
+        thresholds[ i ] = probabilities[ i ] * numberOfBinsAsDouble / totalProbability;
+        aliases[ i ] = i;
+        if ( thresholds[ i ] < 1.0 )
+        {
+            smallBins.push_back( i );
+        }
+
+        else
+        {
+            largeBins.push_back( i );
+        }
+    }
+
+    while ( !smallBins.empty( ) && !largeBins.empty( ) )
+    {
+        const std::size_t smallBin = smallBins.back( );
+        smallBins.pop_back( );
+        const std::size_t largeBin = largeBins.back( );
+
+        aliases[ smallBin ] = largeBin;
+        thresholds[ largeBin ] = ( thresholds[ largeBin ] + thresholds[ smallBin ] ) - 1.0;
+        if ( thresholds[ largeBin ] < 1.0 )
+        {
+            largeBins.pop_back( );
+            smallBins.push_back( largeBin );
+        }
+    }
+
+    // Remaining bins fill their slots, up to round-off errors.
+    for ( std::size_t i = 0; i < largeBins.size( ); i++ )
+    {
+        thresholds[ largeBins[ i ] ] = 1.0;
+    }
+
+    for ( std::size_t i = 0; i < smallBins.size( ); i++ )
+    {
+        thresholds[ smallBins[ i ] ] = 1.0;
+    }
+}
+
+//! Transform uniform samples to samples of distribution.
+void EmpiricalDistributionSampler::transformUniformSamples( const Eigen::ArrayXd& uniformSamples,
+                                                            Eigen::ArrayXd& samples ) const
+{
+    if ( uniformSamples.size( ) % 2 != 0 )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Error: number of uniform samples must be even." ) ) );
+    }
+
+    const Eigen::ArrayXd::Index numberOfSamples = uniformSamples.size( ) / 2;
+    samples.resize( numberOfSamples );
+
+    // Transform samples in blocks: scale uniform samples and compute samples from edges and
+    // widths of bins with vectorized array operations, and select bins from alias table.
+    Eigen::ArrayXd scaledSamples( numberOfSamplesPerBlock );
+    Eigen::ArrayXd blockLowerEdges( numberOfSamplesPerBlock );
+    Eigen::ArrayXd blockWidths( numberOfSamplesPerBlock );
+    for ( Eigen::ArrayXd::Index first = 0; first < numberOfSamples;
+          first += numberOfSamplesPerBlock )
+    {
+        const Eigen::ArrayXd::Index size
+                = std::min( numberOfSamplesPerBlock, numberOfSamples - first );
+        const StridedUniformSamples firstUniformSamples( uniformSamples.data( ) + 2 * first,
+                                                         size );
+        const StridedUniformSamples secondUniformSamples(
+                    uniformSamples.data( ) + 2 * first + 1, size );
+
+        scaledSamples.head( size ) = firstUniformSamples * numberOfBinsAsDouble;
+        for ( Eigen::ArrayXd::Index j = 0; j < size; j++ )
+        {
+            const std::size_t bin = selectBin( scaledSamples( j ) );
+            blockLowerEdges( j ) = lowerEdges[ bin ];
+            blockWidths( j ) = widths[ bin ];
+        }
+
+        samples.segment( first, size )
+                = blockLowerEdges.head( size ) + blockWidths.head( size ) * secondUniformSamples;
+    }
+}
+
+//! Generate samples of distribution.
+void EmpiricalDistributionSampler::generateSamples( const MonteCarloSampler& monteCarloSampler,
+                                                    const std::size_t numberOfSamples,
+                                                    Eigen::ArrayXd& samples,
+                                                    const boost::uint64_t stream,
+                                                    const boost::uint64_t firstSample ) const
+{
+    samples.resize( numberOfSamples );
+
+    // Generate uniform samples in chunks, to bound memory use.
+    Eigen::ArrayXd uniformSamples;
+    Eigen::ArrayXd chunkSamples;
+    for ( std::size_t first = 0; first < numberOfSamples; first += numberOfSamplesPerChunk )
+    {
+        const std::size_t size = std::min( numberOfSamplesPerChunk, numberOfSamples - first );
+        monteCarloSampler.generateUniformSamples( 2 * size, uniformSamples, stream,
+                                                  2 * ( firstSample + first ) );
+        transformUniformSamples( uniformSamples, chunkSamples );
+        samples.segment( first, size ) = chunkSamples;
+    }
+}
+
+} // namespace mathematics
+} // namespace assist
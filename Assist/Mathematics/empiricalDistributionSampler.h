@@ -0,0 +1,139 @@
+/*
+ *    Copyright (c) 2010-2014, Delft University of Technology
+ *    Copyright (c) 2010-2014, K. Kumar (me@kartikkumar.com)
+ *    All rights reserved.
+ *    See http://bit.ly/1jern3m for license details.
+ */
+
+#ifndef ASSIST_EMPIRICAL_DISTRIBUTION_SAMPLER_H
+#define ASSIST_EMPIRICAL_DISTRIBUTION_SAMPLER_H
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include <boost/cstdint.hpp>
+
+#include <Eigen/Core>
+
+#include "Assist/Basics/commonTypedefs.h"
+#include "Assist/Mathematics/monteCarloSampler.h"
+
+namespace assist
+{
+namespace mathematics
+{
+
+//! Sampler for empirical distribution defined by step function.
+/*!
+ * Sampler for an empirical distribution whose probability density is a step function stored as
+ * DoubleKeyDoubleValueMap: the value at key k_i is the density on the bin [k_i, k_i+1), and the
+ * last key is the upper edge of the last bin (its value is ignored). The density need not be
+ * normalized. On construction, an alias table of the bins is built with Vose's method (Vose,
+ * 1991), in O(N) for N bins, so that each sample costs O(1), independent of the number of bins:
+ * a first uniform sample u1 selects bin i = floor( N u1 ), which is kept if the fraction
+ * N u1 - i is below its threshold, and replaced by its alias otherwise; a second uniform sample
+ * selects the position in the bin. Samples can be drawn from given uniform samples, or generated
+ * in batches from a stream of a MonteCarloSampler, with the arithmetic vectorized over blocks of
+ * samples.
+ */
+class EmpiricalDistributionSampler
+{
+public:
+
+    //! Constructor taking probability density.
+    /*!
+     * Constructor taking probability density, as step function. Throws a run-time error if the
+     * step function has fewer than two keys, if a density is negative or not finite, or if the
+     * total probability is zero.
+     * \param aProbabilityDensity Probability density, as keys (edges of bins) and values
+     *          (densities on bins).
+     */
+    EmpiricalDistributionSampler( const basics::DoubleKeyDoubleValueMap& aProbabilityDensity );
+
+    //! Draw sample from given uniform samples.
+    /*!
+     * Draws sample of distribution from two uniform samples in [0, 1).
+     * \param firstUniformSample Uniform sample used to select bin.
+     * \param secondUniformSample Uniform sample used to select position in bin.
+     * \return Sample of distribution.
+     */
+    double drawSample( const double firstUniformSample, const double secondUniformSample ) const
+    {
+        const std::size_t bin = selectBin( firstUniformSample * numberOfBinsAsDouble );
+        return lowerEdges[ bin ] + widths[ bin ] * secondUniformSample;
+    }
+
+    //! Transform uniform samples to samples of distribution.
+    /*!
+     * Transforms pairs of uniform samples in [0, 1) to samples of the distribution: sample i is
+     * drawn from uniform samples 2i and 2i + 1 (see drawSample()). Throws a run-time error if the
+     * number of uniform samples is odd.
+     * \param uniformSamples Uniform samples, two per sample.
+     * \param samples Samples of distribution (resized if needed).
+     */
+    void transformUniformSamples( const Eigen::ArrayXd& uniformSamples,
+                                  Eigen::ArrayXd& samples ) const;
+
+    //! Generate samples of distribution.
+    /*!
+     * Generates consecutive samples of the distribution from a stream of a Monte Carlo sampler:
+     * sample i is drawn from uniform samples 2i and 2i + 1 of the stream (see
+     * transformUniformSamples()), so that, like the uniform samples, each sample is a pure
+     * function of the seed, stream and sample index. The uniform samples are generated in chunks,
+     * in parallel with the threads of the Monte Carlo sampler.
+     * \param monteCarloSampler Monte Carlo sampler.
+     * \param numberOfSamples Number of samples.
+     * \param samples Samples of distribution (resized if needed).
+     * \param stream Index of stream (default=0).
+     * \param firstSample Index of first sample (default=0).
+     */
+    void generateSamples( const MonteCarloSampler& monteCarloSampler,
+                          const std::size_t numberOfSamples, Eigen::ArrayXd& samples,
+                          const boost::uint64_t stream = 0,
+                          const boost::uint64_t firstSample = 0 ) const;
+
+protected:
+
+private:
+
+    //! Select bin for scaled uniform sample, using alias table.
+    std::size_t selectBin( const double scaledUniformSample ) const
+    {
+        const std::size_t bin = std::min( static_cast< std::size_t >( scaledUniformSample ),
+                                          numberOfBins - 1 );
+        return scaledUniformSample - static_cast< double >( bin ) < thresholds[ bin ]
+                ? bin : aliases[ bin ];
+    }
+
+    //! Number of bins.
+    std::size_t numberOfBins;
+
+    //! Number of bins, as double.
+    double numberOfBinsAsDouble;
+
+    //! Lower edges of bins.
+    std::vector< double > lowerEdges;
+
+    //! Widths of bins.
+    std::vector< double > widths;
+
+    //! Thresholds of alias table, below which bins are kept.
+    std::vector< double > thresholds;
+
+    //! Aliases of bins.
+    std::vector< std::size_t > aliases;
+};
+
+} // namespace mathematics
+} // namespace assist
+
+#endif // ASSIST_EMPIRICAL_DISTRIBUTION_SAMPLER_H
+
+/*
+ *    References
+ *      Vose, M.D. A linear algorithm for generating random numbers with a given distribution,
+ *          IEEE Transactions on Software Engineering 17(9), 972-975, 1991.
+ *      Walker, A.J. An efficient method for generating discrete random variables with general
+ *          distributions, ACM Transactions on Mathematical Software 3(3), 253-256, 1977.
+ */
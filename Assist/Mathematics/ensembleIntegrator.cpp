@@ -0,0 +1,456 @@
+/*
+ *    Copyright (c) 2010-2014, Delft University of Technology
+ *    Copyright (c) 2010-2014, K. Kumar (me@kartikkumar.com)
+ *    All rights reserved.
+ *    See http://bit.ly/1jern3m for license details.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+#include <boost/exception/all.hpp>
+
+#include "Assist/Basics/parallelLoop.h"
+#include "Assist/Mathematics/ensembleIntegrator.h"
+
+namespace assist
+{
+namespace mathematics
+{
+
+namespace
+{
+
+//! Butcher tableau of explicit Runge-Kutta method.
+struct ButcherTableau
+{
+    //! Number of stages.
+    int numberOfStages;
+
+    //! Nodes c_i, one per stage.
+    const double* nodes;
+
+    //! Coefficients a_ij, stored row-wise, with one row of numberOfStages entries per stage.
+    const double* coefficients;
+
+    //! Weights b_j of propagated solution, one per stage.
+    const double* weights;
+
+    //! Weights of error estimate, one per stage, or null for fixed-step methods.
+    const double* errorWeights;
+
+    //! Flag that indicates whether last stage is evaluated at propagated solution.
+    bool isFirstSameAsLast;
+};
+
+//! Nodes of classical Runge-Kutta 4 method.
+const double rungeKutta4Nodes[ 4 ] = { 0.0, 0.5, 0.5, 1.0 };
+
+//! Coefficients of classical Runge-Kutta 4 method.
+const double rungeKutta4Coefficients[ 16 ] = { 0.0, 0.0, 0.0, 0.0,
+                                               0.5, 0.0, 0.0, 0.0,
+                                               0.0, 0.5, 0.0, 0.0,
+                                               0.0, 0.0, 1.0, 0.0 };
+
+//! Weights of classical Runge-Kutta 4 method.
+const double rungeKutta4Weights[ 4 ] = { 1.0 / 6.0, 1.0 / 3.0, 1.0 / 3.0, 1.0 / 6.0 };
+
+//! Nodes of Dormand-Prince 4(5) method.
+const double dormandPrinceNodes[ 7 ] = { 0.0, 1.0 / 5.0, 3.0 / 10.0, 4.0 / 5.0, 8.0 / 9.0, 1.0,
+                                         1.0 };
+
+//! Coefficients of Dormand-Prince 4(5) method (Hairer et al., 1993, table 5.2).
+const double dormandPrinceCoefficients[ 49 ] =
+{
+    0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0,
+    1.0 / 5.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0,
+    3.0 / 40.0, 9.0 / 40.0, 0.0, 0.0, 0.0, 0.0, 0.0,
+    44.0 / 45.0, -56.0 / 15.0, 32.0 / 9.0, 0.0, 0.0, 0.0, 0.0,
+    19372.0 / 6561.0, -25360.0 / 2187.0, 64448.0 / 6561.0, -212.0 / 729.0, 0.0, 0.0, 0.0,
+    9017.0 / 3168.0, -355.0 / 33.0, 46732.0 / 5247.0, 49.0 / 176.0, -5103.0 / 18656.0, 0.0, 0.0,
+    35.0 / 384.0, 0.0, 500.0 / 1113.0, 125.0 / 192.0, -2187.0 / 6784.0, 11.0 / 84.0, 0.0
+};
+
+//! Weights of fifth-order solution of Dormand-Prince 4(5) method.
+const double dormandPrinceWeights[ 7 ] = { 35.0 / 384.0, 0.0, 500.0 / 1113.0, 125.0 / 192.0,
+                                           -2187.0 / 6784.0, 11.0 / 84.0, 0.0 };
+
+//! Weights of difference between fifth- and fourth-order solutions of Dormand-Prince 4(5) method.
+const double dormandPrinceErrorWeights[ 7 ] = { 71.0 / 57600.0, 0.0, -71.0 / 16695.0,
+                                                71.0 / 1920.0, -17253.0 / 339200.0,
+                                                22.0 / 525.0, -1.0 / 40.0 };
+
+//! Safety factor of step-size control.
+const double safetyFactor = 0.9;
+
+//! Minimum factor by which step size is changed.
+const double minimumStepSizeFactor = 0.2;
+
+//! Maximum factor by which step size is changed.
+const double maximumStepSizeFactor = 5.0;
+
+//! Minimum step size of adaptive integrator, relative to initial step size.
+const double minimumRelativeStepSize = 1.0e-12;
+
+//! Relative amount by which a step may be lengthened to end at an output epoch.
+const double outputStepSizeSlack = 1.0e-6;
+
+//! Get Butcher tableau of integrator type.
+ButcherTableau getButcherTableau( const EnsembleIntegratorType integratorType )
+{
+    if ( integratorType == rungeKutta4Integrator )
+    {
+        const ButcherTableau tableau = { 4, rungeKutta4Nodes, rungeKutta4Coefficients,
+                                         rungeKutta4Weights, 0, false };
+        return tableau;
+    }
+
+    const ButcherTableau tableau = { 7, dormandPrinceNodes, dormandPrinceCoefficients,
+                                     dormandPrinceWeights, dormandPrinceErrorWeights, true };
+    return tableau;
+}
+
+//! Add weighted stage derivatives to states.
+/*!
+ * Adds weighted sum of stage derivatives, multiplied by step size of each member, to states,
+ * i.e., y += h sum_j w_j k_j, column by column, without temporary arrays.
+ */
+void addStageIncrements( const Eigen::ArrayXd& stepSizes,
+                         const std::vector< Eigen::MatrixXd >& stageDerivatives,
+                         const double* weights, const int numberOfStages,
+                         Eigen::MatrixXd& states )
+{
+    for ( int c = 0; c < 6; c++ )
+    {
+        for ( int j = 0; j < numberOfStages; j++ )
+        {
+            if ( weights[ j ] != 0.0 )
+            {
+                states.col( c ).array( )
+                        += weights[ j ] * stepSizes * stageDerivatives[ j ].col( c ).array( );
+            }
+        }
+    }
+}
+
+//! Task body to integrate batches of ensemble members.
+struct IntegrateBatch
+{
+    //! Integrate batch with given index.
+    void operator( )( const std::size_t batch ) const
+    {
+        const std::size_t firstMember = batch * batchSize;
+        const int numberOfMembers = static_cast< int >(
+                    std::min( batchSize, static_cast< std::size_t >( initialStates->rows( ) )
+                              - firstMember ) );
+        const std::size_t numberOfOutputs = outputEpochs->size( );
+        const int numberOfStages = tableau.numberOfStages;
+        const bool isAdaptive = tableau.errorWeights != 0;
+
+        // Allocate work arrays of batch.
+        Eigen::MatrixXd states = initialStates->middleRows( firstMember, numberOfMembers );
+        Eigen::MatrixXd stageStates( numberOfMembers, 6 );
+        Eigen::MatrixXd newStates( numberOfMembers, 6 );
+        Eigen::MatrixXd errorEstimates( numberOfMembers, 6 );
+        std::vector< Eigen::MatrixXd > stageDerivatives(
+                    numberOfStages, Eigen::MatrixXd( numberOfMembers, 6 ) );
+
+        Eigen::ArrayXd epochs = Eigen::ArrayXd::Constant( numberOfMembers, initialEpoch );
+        Eigen::ArrayXd stepSizes = Eigen::ArrayXd::Constant( numberOfMembers, stepSize );
+        Eigen::ArrayXd currentStepSizes( numberOfMembers );
+        Eigen::ArrayXd stageEpochs( numberOfMembers );
+        Eigen::ArrayXd errorRatios( numberOfMembers );
+        std::vector< std::size_t > nextOutputs( numberOfMembers, 0 );
+        std::vector< char > isOutputReached( numberOfMembers, 0 );
+
+        // Store initial states, if the first output epoch is the initial epoch.
+        int numberOfActiveMembers = numberOfMembers;
+        for ( int i = 0; i < numberOfMembers; i++ )
+        {
+            if ( ( *outputEpochs )[ 0 ] == initialEpoch )
+            {
+                storeState( firstMember + i, initialEpoch, states, i );
+                nextOutputs[ i ]++;
+            }
+
+            if ( nextOutputs[ i ] == numberOfOutputs )
+            {
+                numberOfActiveMembers--;
+            }
+        }
+
+        bool isFirstStageCurrent = false;
+        while ( numberOfActiveMembers > 0 )
+        {
+            // Set step size of each member, shortened to end at its next output epoch, or zero
+            // for members that have finished.
+            for ( int i = 0; i < numberOfMembers; i++ )
+            {
+                isOutputReached[ i ] = 0;
+                currentStepSizes( i ) = 0.0;
+
+                if ( nextOutputs[ i ] < numberOfOutputs )
+                {
+                    const double remainingTime
+                            = ( *outputEpochs )[ nextOutputs[ i ] ] - epochs( i );
+                    currentStepSizes( i ) = stepSizes( i );
+                    if ( remainingTime <= ( 1.0 + outputStepSizeSlack ) * stepSizes( i ) )
+                    {
+                        currentStepSizes( i ) = remainingTime;
+                        isOutputReached[ i ] = 1;
+                    }
+                }
+            }
+
+            // Compute stage derivatives, reusing the first stage of the previous step if the
+            // last stage is evaluated at the propagated solution.
+            if ( !isFirstStageCurrent )
+            {
+                dynamicsModel->computeStateDerivatives( epochs, states, stageDerivatives[ 0 ] );
+            }
+
+            for ( int s = 1; s < numberOfStages; s++ )
+            {
+                stageStates = states;
+                addStageIncrements( currentStepSizes, stageDerivatives,
+                                    tableau.coefficients + s * numberOfStages, s, stageStates );
+                stageEpochs = epochs + tableau.nodes[ s ] * currentStepSizes;
+                dynamicsModel->computeStateDerivatives( stageEpochs, stageStates,
+                                                        stageDerivatives[ s ] );
+            }
+
+            if ( tableau.isFirstSameAsLast )
+            {
+                newStates.swap( stageStates );
+            }
+
+            else
+            {
+                newStates = states;
+                addStageIncrements( currentStepSizes, stageDerivatives, tableau.weights,
+                                    numberOfStages, newStates );
+            }
+
+            // Compute ratio of error estimate and tolerance of each member.
+            if ( isAdaptive )
+            {
+                errorEstimates.setZero( );
+                addStageIncrements( currentStepSizes, stageDerivatives, tableau.errorWeights,
+                                    numberOfStages, errorEstimates );
+
+                // Use root-mean-square of scaled errors, which is not finite if the states
+                // are not finite.
+                errorRatios.setZero( );
+                for ( int c = 0; c < 6; c++ )
+                {
+                    errorRatios += ( errorEstimates.col( c ).array( )
+                                     / ( absoluteTolerance + relativeTolerance
+                                         * states.col( c ).array( ).abs( ).max(
+                                             newStates.col( c ).array( ).abs( ) ) ) ).square( );
+                }
+
+                errorRatios = ( errorRatios / 6.0 ).sqrt( );
+            }
+
+            // Accept or reject step of each active member, and store states at output epochs.
+            for ( int i = 0; i < numberOfMembers; i++ )
+            {
+                if ( nextOutputs[ i ] == numberOfOutputs )
+                {
+                    continue;
+                }
+
+                if ( isAdaptive )
+                {
+                    // Reject step, and reduce step size, if the error is too large, or not
+                    // finite (in which case the step size is reduced by the minimum factor).
+                    if ( !( errorRatios( i ) <= 1.0 ) )
+                    {
+                        stepSizes( i ) = currentStepSizes( i )
+                                * std::max( minimumStepSizeFactor,
+                                            safetyFactor * std::pow( errorRatios( i ), -0.2 ) );
+                        if ( !( stepSizes( i ) > minimumRelativeStepSize * stepSize )
+                             || epochs( i ) + stepSizes( i ) == epochs( i ) )
+                        {
+                            boost::throw_exception(
+                                        boost::enable_error_info(
+                                            std::runtime_error(
+                                                "Error: step size is below minimum step "
+                                                "size." ) ) );
+                        }
+
+                        continue;
+                    }
+
+                    // Accept step, and increase step size. Keep step size of a step that was
+                    // shortened to end at an output epoch, if that is larger.
+                    const double newStepSize = currentStepSizes( i ) * ( errorRatios( i ) > 0.0
+                            ? std::min( maximumStepSizeFactor,
+                                        safetyFactor * std::pow( errorRatios( i ), -0.2 ) )
+                            : maximumStepSizeFactor );
+                    stepSizes( i ) = isOutputReached[ i ]
+                            ? std::max( stepSizes( i ), newStepSize ) : newStepSize;
+                }
+
+                states.row( i ) = newStates.row( i );
+                if ( tableau.isFirstSameAsLast )
+                {
+                    stageDerivatives[ 0 ].row( i )
+                            = stageDerivatives[ numberOfStages - 1 ].row( i );
+                }
+
+                if ( isOutputReached[ i ] )
+                {
+                    epochs( i ) = ( *outputEpochs )[ nextOutputs[ i ] ];
+                    storeState( firstMember + i, epochs( i ), states, i );
+                    nextOutputs[ i ]++;
+
+                    if ( nextOutputs[ i ] == numberOfOutputs )
+                    {
+                        numberOfActiveMembers--;
+                    }
+                }
+
+                else
+                {
+                    epochs( i ) += currentStepSizes( i );
+                }
+            }
+
+            isFirstStageCurrent = tableau.isFirstSameAsLast;
+        }
+    }
+
+    //! Store state of member, given by row of states of batch, at end of its state history.
+    void storeState( const std::size_t member, const double epoch,
+                     const Eigen::MatrixXd& states, const int row ) const
+    {
+        basics::DoubleKeyVector6dValueMap& stateHistory = ( *stateHistories )[ member ];
+        stateHistory.insert( stateHistory.end( ),
+                             std::make_pair( epoch, tudat::basic_mathematics::Vector6d(
+                                                 states.row( row ).transpose( ) ) ) );
+    }
+
+    //! Dynamics model.
+    const EnsembleDynamicsModel* dynamicsModel;
+
+    //! Butcher tableau of integrator.
+    ButcherTableau tableau;
+
+    //! Step size, or initial step size of adaptive integrator [s].
+    double stepSize;
+
+    //! Relative error tolerance of adaptive integrator [-].
+    double relativeTolerance;
+
+    //! Absolute error tolerance of adaptive integrator [m, m s^-1].
+    double absoluteTolerance;
+
+    //! Number of members per batch.
+    std::size_t batchSize;
+
+    //! Initial epoch [s].
+    double initialEpoch;
+
+    //! Initial states, one row per member [m, m s^-1].
+    const Eigen::MatrixXd* initialStates;
+
+    //! Output epochs [s].
+    const std::vector< double >* outputEpochs;
+
+    //! State histories, one per member [s, m, m s^-1].
+    std::vector< basics::DoubleKeyVector6dValueMap >* stateHistories;
+};
+
+} // namespace
+
+//! Constructor taking dynamics model and integrator settings.
+EnsembleIntegrator::EnsembleIntegrator( const EnsembleDynamicsModel& aDynamicsModel,
+                                        const EnsembleIntegratorType anIntegratorType,
+                                        const double aStepSize,
+                                        const double aRelativeTolerance,
+                                        const double anAbsoluteTolerance,
+                                        const std::size_t aBatchSize,
+                                        const unsigned int aNumberOfThreads )
+    : dynamicsModel( aDynamicsModel ),
+      integratorType( anIntegratorType ),
+      stepSize( aStepSize ),
+      relativeTolerance( aRelativeTolerance ),
+      absoluteTolerance( anAbsoluteTolerance ),
+      batchSize( aBatchSize ),
+      numberOfThreads( aNumberOfThreads )
+{
+    if ( !( stepSize > 0.0 ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Error: step size is not positive." ) ) );
+    }
+
+    if ( !( relativeTolerance > 0.0 ) || !( absoluteTolerance > 0.0 ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Error: tolerances are not positive." ) ) );
+    }
+
+    if ( batchSize == 0 )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Error: batch size is zero." ) ) );
+    }
+}
+
+//! Integrate ensemble.
+void EnsembleIntegrator::integrate(
+        const double initialEpoch, const Eigen::MatrixXd& initialStates,
+        const std::vector< double >& outputEpochs,
+        std::vector< basics::DoubleKeyVector6dValueMap >& stateHistories ) const
+{
+    if ( initialStates.cols( ) != 6 )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Error: initial states do not have six columns." ) ) );
+    }
+
+    if ( !outputEpochs.empty( ) && outputEpochs.front( ) < initialEpoch )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Error: first output epoch is before initial epoch." ) ) );
+    }
+
+    for ( std::size_t i = 1; i < outputEpochs.size( ); i++ )
+    {
+        if ( !( outputEpochs[ i ] > outputEpochs[ i - 1 ] ) )
+        {
+            boost::throw_exception(
+                        boost::enable_error_info(
+                            std::runtime_error(
+                                "Error: output epochs are not strictly increasing." ) ) );
+        }
+    }
+
+    const std::size_t numberOfMembers = static_cast< std::size_t >( initialStates.rows( ) );
+    stateHistories.assign( numberOfMembers, basics::DoubleKeyVector6dValueMap( ) );
+    if ( outputEpochs.empty( ) )
+    {
+        return;
+    }
+
+    // Integrate batches in parallel, with dynamic load balancing.
+    const IntegrateBatch taskBody = { &dynamicsModel, getButcherTableau( integratorType ),
+                                      stepSize, relativeTolerance, absoluteTolerance, batchSize,
+                                      initialEpoch, &initialStates, &outputEpochs,
+                                      &stateHistories };
+    basics::executeDynamicParallelLoop( ( numberOfMembers + batchSize - 1 ) / batchSize,
+                                        taskBody, numberOfThreads );
+}
+
+} // namespace mathematics
+} // namespace assist
@@ -0,0 +1,164 @@
+/*
+ *    Copyright (c) 2010-2014, Delft University of Technology
+ *    Copyright (c) 2010-2014, K. Kumar (me@kartikkumar.com)
+ *    All rights reserved.
+ *    See http://bit.ly/1jern3m for license details.
+ */
+
+#ifndef ASSIST_ENSEMBLE_INTEGRATOR_H
+#define ASSIST_ENSEMBLE_INTEGRATOR_H
+
+#include <cstddef>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "Assist/Basics/commonTypedefs.h"
+
+namespace assist
+{
+namespace mathematics
+{
+
+//! Dynamics model for ensemble integration.
+/*!
+ * Base class for dynamics models that compute state derivatives of a batch of ensemble members
+ * at once. The states of a batch are stored in structure-of-arrays layout: one row per member,
+ * and one column per state component (x, y, z, vx, vy, vz), so that each component of all
+ * members is contiguous in memory, and can be processed with vectorized array operations.
+ * Derived classes must be thread-safe, since batches are integrated in parallel.
+ */
+class EnsembleDynamicsModel
+{
+public:
+
+    //! Default destructor.
+    virtual ~EnsembleDynamicsModel( ) { }
+
+    //! Compute state derivatives of batch of ensemble members.
+    /*!
+     * Computes state derivatives of a batch of ensemble members, each at its own epoch. Must not
+     * resize the state derivatives, which have the same size as the states.
+     * \param epochs Epochs of members [s].
+     * \param states States of members, one row per member [m, m s^-1].
+     * \param stateDerivatives State derivatives of members, one row per member
+     *          [m s^-1, m s^-2].
+     */
+    virtual void computeStateDerivatives( const Eigen::ArrayXd& epochs,
+                                          const Eigen::MatrixXd& states,
+                                          Eigen::MatrixXd& stateDerivatives ) const = 0;
+
+protected:
+
+private:
+};
+
+//! Ensemble integrator types.
+enum EnsembleIntegratorType
+{
+    rungeKutta4Integrator,
+    dormandPrince45Integrator
+};
+
+//! Integrator for ensembles of states.
+/*!
+ * Integrator that propagates an ensemble of states (e.g., Monte Carlo samples) with a common
+ * dynamics model, and stores the states at given output epochs. Two integrators are available:
+ *  - Runge-Kutta 4: classical fourth-order Runge-Kutta method, with fixed step size.
+ *  - Dormand-Prince 4(5): embedded Runge-Kutta pair, with adaptive step size, in which the
+ *      fifth-order solution is propagated, and the last stage of a step is reused as the first
+ *      stage of the next step (first same as last).
+ * The ensemble is split into batches of members, which are integrated in parallel, with dynamic
+ * load balancing: each thread takes the next batch as soon as it has finished its previous one,
+ * so that batches that require more adaptive steps do not delay the other threads. Within a
+ * batch, all members are advanced at once, in structure-of-arrays layout (see
+ * EnsembleDynamicsModel), but each member has its own epoch and step size. Steps are shortened to
+ * end exactly at output epochs. A batch is finished when all its members have reached the last
+ * output epoch. The work arrays of a batch are allocated once, so that no memory is allocated per
+ * step, other than the nodes of the output state histories.
+ */
+class EnsembleIntegrator
+{
+public:
+
+    //! Constructor taking dynamics model and integrator settings.
+    /*!
+     * Constructor taking dynamics model and integrator settings. The dynamics model is stored by
+     * reference, and must outlive the integrator. Throws a run-time error if the step size, the
+     * tolerances or the batch size are not positive.
+     * \param aDynamicsModel Dynamics model.
+     * \param anIntegratorType Integrator type (default=dormandPrince45Integrator).
+     * \param aStepSize Step size of Runge-Kutta 4 integrator, or initial step size of adaptive
+     *          integrator [s] (default=10.0).
+     * \param aRelativeTolerance Relative error tolerance of adaptive integrator [-]
+     *          (default=1.0e-10).
+     * \param anAbsoluteTolerance Absolute error tolerance of adaptive integrator [m, m s^-1]
+     *          (default=1.0e-10).
+     * \param aBatchSize Number of members per batch (default=64).
+     * \param aNumberOfThreads Number of threads to use (0 = number of hardware threads;
+     *          default=1).
+     */
+    EnsembleIntegrator( const EnsembleDynamicsModel& aDynamicsModel,
+                        const EnsembleIntegratorType anIntegratorType = dormandPrince45Integrator,
+                        const double aStepSize = 10.0,
+                        const double aRelativeTolerance = 1.0e-10,
+                        const double anAbsoluteTolerance = 1.0e-10,
+                        const std::size_t aBatchSize = 64,
+                        const unsigned int aNumberOfThreads = 1 );
+
+    //! Integrate ensemble.
+    /*!
+     * Integrates ensemble from initial epoch, and stores states at output epochs in one state
+     * history per member. If the first output epoch equals the initial epoch, the initial states
+     * are stored. Throws a run-time error if the output epochs are not sorted in strictly
+     * increasing order, or if the first output epoch is before the initial epoch, and re-throws
+     * run-time errors of the adaptive integrator, if its step size drops below the minimum step
+     * size.
+     * \param initialEpoch Initial epoch [s].
+     * \param initialStates Initial states, one row per member [m, m s^-1].
+     * \param outputEpochs Output epochs [s].
+     * \param stateHistories State histories, one per member [s, m, m s^-1] (resized and
+     *          cleared).
+     */
+    void integrate( const double initialEpoch, const Eigen::MatrixXd& initialStates,
+                    const std::vector< double >& outputEpochs,
+                    std::vector< basics::DoubleKeyVector6dValueMap >& stateHistories ) const;
+
+protected:
+
+private:
+
+    //! Dynamics model.
+    const EnsembleDynamicsModel& dynamicsModel;
+
+    //! Integrator type.
+    const EnsembleIntegratorType integratorType;
+
+    //! Step size, or initial step size of adaptive integrator [s].
+    const double stepSize;
+
+    //! Relative error tolerance of adaptive integrator [-].
+    const double relativeTolerance;
+
+    //! Absolute error tolerance of adaptive integrator [m, m s^-1].
+    const double absoluteTolerance;
+
+    //! Number of members per batch.
+    const std::size_t batchSize;
+
+    //! Number of threads.
+    const unsigned int numberOfThreads;
+};
+
+} // namespace mathematics
+} // namespace assist
+
+#endif // ASSIST_ENSEMBLE_INTEGRATOR_H
+
+/*
+ *    References
+ *      Dormand, J.R., Prince, P.J. A family of embedded Runge-Kutta formulae, Journal of
+ *          Computational and Applied Mathematics 6(1), 19-26, 1980.
+ *      Hairer, E., Norsett, S.P., Wanner, G. Solving Ordinary Differential Equations I: Nonstiff
+ *          Problems, 2nd edition, Springer, 1993.
+ */
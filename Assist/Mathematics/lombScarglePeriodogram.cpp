@@ -0,0 +1,430 @@
+/*
+ *    Copyright (c) 2010-2014, Delft University of Technology
+ *    Copyright (c) 2010-2014, K. Kumar (me@kartikkumar.com)
+ *    All rights reserved.
+ *    See http://bit.ly/1jern3m for license details.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <boost/exception/all.hpp>
+
+#include <TudatCore/Mathematics/BasicMathematics/mathematicalConstants.h>
+
+#include "Assist/Basics/parallelLoop.h"
+#include "Assist/Mathematics/lombScarglePeriodogram.h"
+
+namespace assist
+{
+namespace mathematics
+{
+
+namespace
+{
+
+//! Number of grid points to which each sample is extirpolated.
+const int numberOfExtirpolationPoints = 8;
+
+//! Minimum ratio of size of extirpolation grids to number of frequencies.
+const std::size_t gridOversamplingFactor = 8;
+
+//! Maximum number of terms (samples times frequencies) for which direct evaluation is used.
+const std::size_t maximumNumberOfDirectTerms = 1048576;
+
+//! Complex number.
+typedef std::complex< double > Complex;
+
+//! Check input, and compute deviations of values from mean and twice the sample variance.
+void prepareSamples( const Eigen::ArrayXd& epochs, const Eigen::ArrayXd& values,
+                     const double frequencyStep, Eigen::ArrayXd& shiftedEpochs,
+                     Eigen::ArrayXd& deviations, double& twiceVariance )
+{
+    if ( epochs.size( ) != values.size( ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Error: sizes of epochs and values do not match." ) ) );
+    }
+
+    if ( epochs.size( ) < 2 )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Error: series contains fewer than two samples." ) ) );
+    }
+
+    if ( !( frequencyStep > 0.0 ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Error: frequency step must be positive." ) ) );
+    }
+
+    // Shift epochs to start at zero, to preserve precision of phases.
+    shiftedEpochs = epochs - epochs.minCoeff( );
+    deviations = values - values.mean( );
+    twiceVariance = 2.0 * deviations.square( ).sum( ) / static_cast< double >( values.size( ) - 1 );
+
+    if ( !( twiceVariance > 0.0 ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Error: values have zero variance." ) ) );
+    }
+}
+
+//! Compute normalized power from trigonometric sums.
+/*!
+ * Computes normalized Lomb-Scargle power from the sums of the deviations times the cosines and
+ * sines of the phases, and the sums of the cosines and sines of twice the phases, by eliminating
+ * the time offset tau (Press et al., 1992).
+ */
+double computeNormalizedPower( const double numberOfSamples, const double cosineSum,
+                               const double sineSum, const double doubleCosineSum,
+                               const double doubleSineSum, const double twiceVariance )
+{
+    // Compute cosine and sine of omega * tau, with tan( 2 * omega * tau ) = S2 / C2.
+    const double hypotenuse = std::sqrt( doubleCosineSum * doubleCosineSum
+                                         + doubleSineSum * doubleSineSum );
+    const double cosineOfDoubleOffset = hypotenuse > 0.0 ? doubleCosineSum / hypotenuse : 1.0;
+    const double cosineOfOffset = std::sqrt( 0.5 * ( 1.0 + cosineOfDoubleOffset ) );
+    const double sineOfOffset = ( doubleSineSum < 0.0 ? -1.0 : 1.0 )
+            * std::sqrt( std::max( 0.0, 0.5 * ( 1.0 - cosineOfDoubleOffset ) ) );
+
+    // Sum squared cosines and sines of shifted phases, which vanish for the sines if all shifted
+    // phases are multiples of pi.
+    const double cosineDenominator = 0.5 * ( numberOfSamples + hypotenuse );
+    const double sineDenominator = 0.5 * ( numberOfSamples - hypotenuse );
+
+    const double cosineNumerator = cosineOfOffset * cosineSum + sineOfOffset * sineSum;
+    const double sineNumerator = cosineOfOffset * sineSum - sineOfOffset * cosineSum;
+
+    double power = cosineNumerator * cosineNumerator / cosineDenominator;
+    if ( sineDenominator > 1.0e-12 * numberOfSamples )
+    {
+        power += sineNumerator * sineNumerator / sineDenominator;
+    }
+
+    return power / twiceVariance;
+}
+
+//! Loop body to compute powers by direct evaluation.
+struct ComputeDirectPowers
+{
+    //! Compute powers at frequencies in range [begin, end).
+    void operator( )( const std::size_t begin, const std::size_t end ) const
+    {
+        const Eigen::Map< const Eigen::ArrayXd > epochArray( epochs, numberOfSamples );
+        const Eigen::Map< const Eigen::ArrayXd > deviationArray( deviations, numberOfSamples );
+
+        Eigen::ArrayXd phases( numberOfSamples );
+        Eigen::ArrayXd cosines( numberOfSamples );
+        Eigen::ArrayXd sines( numberOfSamples );
+
+        for ( std::size_t k = begin; k < end; k++ )
+        {
+            phases = ( angularFrequencyStep * static_cast< double >( k + 1 ) ) * epochArray;
+            cosines = phases.cos( );
+            sines = phases.sin( );
+
+            powers[ k ] = computeNormalizedPower(
+                        static_cast< double >( numberOfSamples ),
+                        ( deviationArray * cosines ).sum( ),
+                        ( deviationArray * sines ).sum( ),
+                        ( cosines.square( ) - sines.square( ) ).sum( ),
+                        2.0 * ( cosines * sines ).sum( ), twiceVariance );
+        }
+    }
+
+    //! Epochs, shifted to start at zero.
+    const double* epochs;
+
+    //! Deviations of values from mean.
+    const double* deviations;
+
+    //! Number of samples.
+    Eigen::ArrayXd::Index numberOfSamples;
+
+    //! Step between angular frequencies.
+    double angularFrequencyStep;
+
+    //! Twice the sample variance of values.
+    double twiceVariance;
+
+    //! Powers.
+    double* powers;
+};
+
+//! Compute forward discrete Fourier transform in place, using radix-2 FFT.
+/*!
+ * Computes X_k = sum_j x_j exp( -2 pi i j k / n ) in place, using the iterative radix-2
+ * Cooley-Tukey algorithm. The size of the data must be a power of two.
+ */
+void computeFastFourierTransform( std::vector< Complex >& data )
+{
+    using tudat::basic_mathematics::mathematical_constants::PI;
+
+    const std::size_t size = data.size( );
+
+    // Permute data to bit-reversed order.
+    for ( std::size_t i = 1, j = 0; i < size; i++ )
+    {
+        std::size_t bit = size >> 1;
+        for ( ; j & bit; bit >>= 1 )
+        {
+            j ^= bit;
+        }
+
+        j ^= bit;
+        if ( i < j )
+        {
+            std::swap( data[ i ], data[ j ] );
+        }
+    }
+
+    // Tabulate twiddle factors, each evaluated directly to avoid accumulation of round-off errors.
+    std::vector< Complex > twiddleFactors( size / 2 );
+    for ( std::size_t j = 0; j < size / 2; j++ )
+    {
+        const double angle = -2.0 * PI * static_cast< double >( j ) / static_cast< double >( size );
+        twiddleFactors[ j ] = Complex( std::cos( angle ), std::sin( angle ) );
+    }
+
+    // Combine transforms of increasing length with butterflies.
+    for ( std::size_t length = 2; length <= size; length <<= 1 )
+    {
+        const std::size_t halfLength = length / 2;
+        const std::size_t twiddleStride = size / length;
+        for ( std::size_t start = 0; start < size; start += length )
+        {
+            for ( std::size_t j = 0; j < halfLength; j++ )
+            {
+                const Complex product
+                        = twiddleFactors[ j * twiddleStride ] * data[ start + j + halfLength ];
+                data[ start + j + halfLength ] = data[ start + j ] - product;
+                data[ start + j ] += product;
+            }
+        }
+    }
+}
+
+//! Extirpolate value onto periodic grid.
+/*!
+ * Adds value to the grid points around given position, with Lagrange interpolation weights, such
+ * that sum_j grid_j g( j ) approximates value * g( position ) for any smooth function g that is
+ * periodic over the grid (Press and Rybicki, 1989).
+ */
+void extirpolate( const double value, const double position, const bool isImaginaryPart,
+                  const std::vector< double >& weightDenominators, std::vector< Complex >& grid )
+{
+    const std::ptrdiff_t size = static_cast< std::ptrdiff_t >( grid.size( ) );
+    const double lowerPosition = std::floor( position );
+
+    if ( position == lowerPosition )
+    {
+        const std::ptrdiff_t index = static_cast< std::ptrdiff_t >( lowerPosition ) % size;
+        grid[ index ] += isImaginaryPart ? Complex( 0.0, value ) : Complex( value, 0.0 );
+        return;
+    }
+
+    // Spread value over grid points centred on position.
+    const std::ptrdiff_t firstIndex = static_cast< std::ptrdiff_t >( lowerPosition )
+            - ( numberOfExtirpolationPoints / 2 - 1 );
+
+    double product = 1.0;
+    for ( int j = 0; j < numberOfExtirpolationPoints; j++ )
+    {
+        product *= position - static_cast< double >( firstIndex + j );
+    }
+
+    for ( int j = 0; j < numberOfExtirpolationPoints; j++ )
+    {
+        std::ptrdiff_t index = firstIndex + j;
+        if ( index < 0 )
+        {
+            index += size;
+        }
+
+        else if ( index >= size )
+        {
+            index -= size;
+        }
+
+        const double weightedValue = value * product
+                / ( ( position - static_cast< double >( firstIndex + j ) )
+                    * weightDenominators[ j ] );
+        grid[ index ] += isImaginaryPart ? Complex( 0.0, weightedValue )
+                                         : Complex( weightedValue, 0.0 );
+    }
+}
+
+//! Compute position on periodic grid of given number of cycles.
+double computeGridPosition( const double numberOfCycles, const double gridSize )
+{
+    const double position = ( numberOfCycles - std::floor( numberOfCycles ) ) * gridSize;
+    return position < gridSize ? position : 0.0;
+}
+
+} // namespace
+
+//! Compute Lomb-Scargle periodogram by direct evaluation.
+void computeDirectLombScarglePeriodogram( const Eigen::ArrayXd& epochs,
+                                          const Eigen::ArrayXd& values,
+                                          const double frequencyStep,
+                                          const std::size_t numberOfFrequencies,
+                                          Eigen::ArrayXd& powers,
+                                          const unsigned int numberOfThreads )
+{
+    using tudat::basic_mathematics::mathematical_constants::PI;
+
+    Eigen::ArrayXd shiftedEpochs;
+    Eigen::ArrayXd deviations;
+    double twiceVariance = 0.0;
+    prepareSamples( epochs, values, frequencyStep, shiftedEpochs, deviations, twiceVariance );
+
+    powers.resize( static_cast< Eigen::ArrayXd::Index >( numberOfFrequencies ) );
+
+    // Distribute frequencies over threads, with at least about 2^16 terms per thread.
+    const ComputeDirectPowers loopBody
+            = { shiftedEpochs.data( ), deviations.data( ), shiftedEpochs.size( ),
+                2.0 * PI * frequencyStep, twiceVariance, powers.data( ) };
+    basics::executeParallelLoop(
+                numberOfFrequencies, loopBody, numberOfThreads,
+                std::max< std::size_t >(
+                    1, 65536 / static_cast< std::size_t >( shiftedEpochs.size( ) ) ) );
+}
+
+//! Compute Lomb-Scargle periodogram using extirpolation and FFT.
+void computeFastLombScarglePeriodogram( const Eigen::ArrayXd& epochs,
+                                        const Eigen::ArrayXd& values,
+                                        const double frequencyStep,
+                                        const std::size_t numberOfFrequencies,
+                                        Eigen::ArrayXd& powers )
+{
+    Eigen::ArrayXd shiftedEpochs;
+    Eigen::ArrayXd deviations;
+    double twiceVariance = 0.0;
+    prepareSamples( epochs, values, frequencyStep, shiftedEpochs, deviations, twiceVariance );
+
+    powers.resize( static_cast< Eigen::ArrayXd::Index >( numberOfFrequencies ) );
+    if ( numberOfFrequencies == 0 )
+    {
+        return;
+    }
+
+    // Select grid size as power of two, such that phases of twice the highest frequency are
+    // sampled at least gridOversamplingFactor / 2 times per cycle.
+    std::size_t gridSize = 1;
+    while ( gridSize < gridOversamplingFactor * numberOfFrequencies )
+    {
+        gridSize <<= 1;
+    }
+
+    const double gridSizeAsDouble = static_cast< double >( gridSize );
+
+    // Tabulate denominators of Lagrange weights, prod_{i != j} ( j - i ).
+    std::vector< double > weightDenominators( numberOfExtirpolationPoints );
+    for ( int j = 0; j < numberOfExtirpolationPoints; j++ )
+    {
+        weightDenominators[ j ] = 1.0;
+        for ( int i = 0; i < numberOfExtirpolationPoints; i++ )
+        {
+            if ( i != j )
+            {
+                weightDenominators[ j ] *= static_cast< double >( j - i );
+            }
+        }
+    }
+
+    // Extirpolate deviations at phases, and unit weights at twice the phases, onto the real and
+    // imaginary parts of a single grid, such that one FFT yields both sets of sums. Grid point j
+    // corresponds to a phase of 2 pi j k / gridSize at frequency k * frequencyStep.
+    std::vector< Complex > grid( gridSize, Complex( 0.0, 0.0 ) );
+    for ( Eigen::ArrayXd::Index i = 0; i < shiftedEpochs.size( ); i++ )
+    {
+        const double numberOfCycles = shiftedEpochs( i ) * frequencyStep;
+        extirpolate( deviations( i ), computeGridPosition( numberOfCycles, gridSizeAsDouble ),
+                     false, weightDenominators, grid );
+        extirpolate( 1.0, computeGridPosition( 2.0 * numberOfCycles, gridSizeAsDouble ),
+                     true, weightDenominators, grid );
+    }
+
+    computeFastFourierTransform( grid );
+
+    // Separate transforms of real and imaginary parts, which are sums of exp( -i * phase ), and
+    // compute powers.
+    const double numberOfSamples = static_cast< double >( shiftedEpochs.size( ) );
+    for ( std::size_t k = 1; k <= numberOfFrequencies; k++ )
+    {
+        const Complex transform = grid[ k ];
+        const Complex conjugateMirrorTransform = std::conj( grid[ gridSize - k ] );
+        const Complex deviationSums = 0.5 * ( transform + conjugateMirrorTransform );
+        const Complex doublePhaseSums
+                = Complex( 0.0, -0.5 ) * ( transform - conjugateMirrorTransform );
+
+        powers( static_cast< Eigen::ArrayXd::Index >( k - 1 ) ) = computeNormalizedPower(
+                    numberOfSamples, deviationSums.real( ), -deviationSums.imag( ),
+                    doublePhaseSums.real( ), -doublePhaseSums.imag( ), twiceVariance );
+    }
+}
+
+//! Compute Lomb-Scargle periodogram.
+void computeLombScarglePeriodogram( const Eigen::ArrayXd& epochs, const Eigen::ArrayXd& values,
+                                    const double frequencyStep,
+                                    const std::size_t numberOfFrequencies,
+                                    Eigen::ArrayXd& powers,
+                                    const unsigned int numberOfThreads )
+{
+    if ( static_cast< std::size_t >( epochs.size( ) ) * numberOfFrequencies
+         <= maximumNumberOfDirectTerms )
+    {
+        computeDirectLombScarglePeriodogram( epochs, values, frequencyStep, numberOfFrequencies,
+                                             powers, numberOfThreads );
+    }
+
+    else
+    {
+        computeFastLombScarglePeriodogram( epochs, values, frequencyStep, numberOfFrequencies,
+                                           powers );
+    }
+}
+
+//! Compute Lomb-Scargle periodogram of series.
+basics::DoubleKeyDoubleValueMap computeLombScarglePeriodogram(
+        const basics::DoubleKeyDoubleValueMap& series, const double frequencyStep,
+        const std::size_t numberOfFrequencies, const unsigned int numberOfThreads )
+{
+    Eigen::ArrayXd epochs( static_cast< Eigen::ArrayXd::Index >( series.size( ) ) );
+    Eigen::ArrayXd values( epochs.size( ) );
+
+    Eigen::ArrayXd::Index i = 0;
+    for ( basics::DoubleKeyDoubleValueMap::const_iterator iteratorSample = series.begin( );
+          iteratorSample != series.end( ); iteratorSample++, i++ )
+    {
+        epochs( i ) = iteratorSample->first;
+        values( i ) = iteratorSample->second;
+    }
+
+    Eigen::ArrayXd powers;
+    computeLombScarglePeriodogram( epochs, values, frequencyStep, numberOfFrequencies, powers,
+                                   numberOfThreads );
+
+    basics::DoubleKeyDoubleValueMap periodogram;
+    for ( Eigen::ArrayXd::Index k = 0; k < powers.size( ); k++ )
+    {
+        periodogram.insert( periodogram.end( ),
+                            std::make_pair( static_cast< double >( k + 1 ) * frequencyStep,
+                                            powers( k ) ) );
+    }
+
+    return periodogram;
+}
+
+} // namespace mathematics
+} // namespace assist
@@ -0,0 +1,114 @@
+/*
+ *    Copyright (c) 2010-2014, Delft University of Technology
+ *    Copyright (c) 2010-2014, K. Kumar (me@kartikkumar.com)
+ *    All rights reserved.
+ *    See http://bit.ly/1jern3m for license details.
+ */
+
+#ifndef ASSIST_LOMB_SCARGLE_PERIODOGRAM_H
+#define ASSIST_LOMB_SCARGLE_PERIODOGRAM_H
+
+#include <cstddef>
+
+#include <Eigen/Core>
+
+#include "Assist/Basics/commonTypedefs.h"
+
+namespace assist
+{
+namespace mathematics
+{
+
+//! Compute Lomb-Scargle periodogram by direct evaluation.
+/*!
+ * Computes the normalized Lomb-Scargle periodogram of an unevenly sampled series (Press et al.,
+ * 1992) at the frequencies f_k = k * frequencyStep, k = 1, ..., numberOfFrequencies, by direct
+ * evaluation of the trigonometric sums, i.e., with O(N * F) operations for N samples and F
+ * frequencies. The sums for each frequency are evaluated with vectorized array operations, and the
+ * frequencies are distributed over the threads. The power is normalized by twice the sample
+ * variance of the values, so that it is independent of the scale of the values. Throws a run-time
+ * error if the sizes of the arrays do not match, if there are fewer than two samples, if the
+ * values have zero variance, or if the frequency step is not positive.
+ * \param epochs Epochs of samples (need not be sorted).
+ * \param values Values of samples.
+ * \param frequencyStep Step between frequencies, and lowest frequency [1/unit of epochs].
+ * \param numberOfFrequencies Number of frequencies.
+ * \param powers Normalized powers at frequencies (resized if needed).
+ * \param numberOfThreads Number of threads to use (0 = number of hardware threads; default=1).
+ */
+void computeDirectLombScarglePeriodogram( const Eigen::ArrayXd& epochs,
+                                          const Eigen::ArrayXd& values,
+                                          const double frequencyStep,
+                                          const std::size_t numberOfFrequencies,
+                                          Eigen::ArrayXd& powers,
+                                          const unsigned int numberOfThreads = 1 );
+
+//! Compute Lomb-Scargle periodogram using extirpolation and FFT.
+/*!
+ * Computes the normalized Lomb-Scargle periodogram at the same frequencies as
+ * computeDirectLombScarglePeriodogram(), using the method of Press and Rybicki (1989): the values
+ * and unit weights are extirpolated, i.e., spread with Lagrange interpolation weights, onto
+ * regular grids, such that the trigonometric sums for all frequencies follow from a single FFT,
+ * with O(N + F log F) operations. The FFT is computed with a self-contained radix-2 algorithm.
+ * The result agrees with direct evaluation to within the extirpolation error, which is typically
+ * below 1.0e-5 of the maximum power. Throws a run-time error for the same invalid input as
+ * computeDirectLombScarglePeriodogram().
+ * \param epochs Epochs of samples (need not be sorted).
+ * \param values Values of samples.
+ * \param frequencyStep Step between frequencies, and lowest frequency [1/unit of epochs].
+ * \param numberOfFrequencies Number of frequencies.
+ * \param powers Normalized powers at frequencies (resized if needed).
+ */
+void computeFastLombScarglePeriodogram( const Eigen::ArrayXd& epochs,
+                                        const Eigen::ArrayXd& values,
+                                        const double frequencyStep,
+                                        const std::size_t numberOfFrequencies,
+                                        Eigen::ArrayXd& powers );
+
+//! Compute Lomb-Scargle periodogram.
+/*!
+ * Computes the normalized Lomb-Scargle periodogram at the frequencies f_k = k * frequencyStep,
+ * k = 1, ..., numberOfFrequencies, using direct evaluation for small problems, and extirpolation
+ * and FFT otherwise (see computeDirectLombScarglePeriodogram() and
+ * computeFastLombScarglePeriodogram()).
+ * \param epochs Epochs of samples (need not be sorted).
+ * \param values Values of samples.
+ * \param frequencyStep Step between frequencies, and lowest frequency [1/unit of epochs].
+ * \param numberOfFrequencies Number of frequencies.
+ * \param powers Normalized powers at frequencies (resized if needed).
+ * \param numberOfThreads Number of threads to use for direct evaluation (0 = number of hardware
+ *          threads; default=1).
+ */
+void computeLombScarglePeriodogram( const Eigen::ArrayXd& epochs, const Eigen::ArrayXd& values,
+                                    const double frequencyStep,
+                                    const std::size_t numberOfFrequencies,
+                                    Eigen::ArrayXd& powers,
+                                    const unsigned int numberOfThreads = 1 );
+
+//! Compute Lomb-Scargle periodogram of series.
+/*!
+ * Computes the normalized Lomb-Scargle periodogram of a series of epochs and values (see
+ * computeLombScarglePeriodogram()).
+ * \param series Series of epochs and values.
+ * \param frequencyStep Step between frequencies, and lowest frequency [1/unit of epochs].
+ * \param numberOfFrequencies Number of frequencies.
+ * \param numberOfThreads Number of threads to use for direct evaluation (0 = number of hardware
+ *          threads; default=1).
+ * \return Series of frequencies and normalized powers.
+ */
+basics::DoubleKeyDoubleValueMap computeLombScarglePeriodogram(
+        const basics::DoubleKeyDoubleValueMap& series, const double frequencyStep,
+        const std::size_t numberOfFrequencies, const unsigned int numberOfThreads = 1 );
+
+} // namespace mathematics
+} // namespace assist
+
+#endif // ASSIST_LOMB_SCARGLE_PERIODOGRAM_H
+
+/*
+ *    References
+ *      Press, W.H., Rybicki, G.B. Fast algorithm for spectral analysis of unevenly sampled data,
+ *          The Astrophysical Journal 338, 277-280, 1989.
+ *      Press, W.H., et al. Numerical Recipes in C: The Art of Scientific Computing, Second
+ *          Edition, Cambridge University Press, 1992.
+ */
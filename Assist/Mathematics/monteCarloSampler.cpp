@@ -0,0 +1,275 @@
+/*
+ *    Copyright (c) 2010-2014, Delft University of Technology
+ *    Copyright (c) 2010-2014, K. Kumar (me@kartikkumar.com)
+ *    All rights reserved.
+ *    See http://bit.ly/1jern3m for license details.
+ */
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <boost/exception/all.hpp>
+
+#include <TudatCore/Mathematics/BasicMathematics/mathematicalConstants.h>
+
+#include "Assist/Basics/parallelLoop.h"
+#include "Assist/Mathematics/monteCarloSampler.h"
+
+namespace assist
+{
+namespace mathematics
+{
+
+namespace
+{
+
+//! Number of rounds of Philox-4x32 bijection.
+const int numberOfPhiloxRounds = 10;
+
+//! Multipliers of Philox-4x32 rounds.
+const boost::uint64_t philoxMultiplier0 = 0xD2511F53u;
+const boost::uint64_t philoxMultiplier1 = 0xCD9E8D57u;
+
+//! Increments of key words between Philox-4x32 rounds (golden ratio and sqrt( 3 ) - 1).
+const boost::uint32_t philoxKeyIncrement0 = 0x9E3779B9u;
+const boost::uint32_t philoxKeyIncrement1 = 0xBB67AE85u;
+
+//! Number of blocks generated at once.
+const std::size_t numberOfBlocksPerChunk = 256;
+
+//! Minimum number of samples per thread.
+const std::size_t minimumNumberOfSamplesPerThread = 65536;
+
+//! Compute Philox-4x32-10 blocks for consecutive counters.
+/*!
+ * Computes blocks for counters ( firstBlock + j, stream ), for j in [0, numberOfBlocksPerChunk),
+ * and stores words k of the blocks in words[ k ]. The rounds are applied to all blocks at once, so
+ * that the loops over the blocks can be vectorized.
+ */
+void computePhilox4x32Chunk( const boost::uint64_t firstBlock, const boost::uint64_t stream,
+                             const boost::uint32_t key[ 2 ],
+                             boost::uint32_t words[ 4 ][ numberOfBlocksPerChunk ] )
+{
+    for ( std::size_t j = 0; j < numberOfBlocksPerChunk; j++ )
+    {
+        const boost::uint64_t block = firstBlock + j;
+        words[ 0 ][ j ] = static_cast< boost::uint32_t >( block );
+        words[ 1 ][ j ] = static_cast< boost::uint32_t >( block >> 32 );
+        words[ 2 ][ j ] = static_cast< boost::uint32_t >( stream );
+        words[ 3 ][ j ] = static_cast< boost::uint32_t >( stream >> 32 );
+    }
+
+    boost::uint32_t key0 = key[ 0 ];
+    boost::uint32_t key1 = key[ 1 ];
+    for ( int round = 0; round < numberOfPhiloxRounds; round++ )
+    {
+        for ( std::size_t j = 0; j < numberOfBlocksPerChunk; j++ )
+        {
+            const boost::uint64_t product0 = philoxMultiplier0 * words[ 0 ][ j ];
+            const boost::uint64_t product1 = philoxMultiplier1 * words[ 2 ][ j ];
+            words[ 0 ][ j ] = static_cast< boost::uint32_t >( product1 >> 32 )
+                    ^ words[ 1 ][ j ] ^ key0;
+            words[ 2 ][ j ] = static_cast< boost::uint32_t >( product0 >> 32 )
+                    ^ words[ 3 ][ j ] ^ key1;
+            words[ 1 ][ j ] = static_cast< boost::uint32_t >( product1 );
+            words[ 3 ][ j ] = static_cast< boost::uint32_t >( product0 );
+        }
+
+        key0 += philoxKeyIncrement0;
+        key1 += philoxKeyIncrement1;
+    }
+}
+
+//! Loop body to fill samples of one or more streams.
+/*!
+ * Loop body to fill samples of consecutive streams, stored one stream after the other (i.e., as
+ * columns of a column-major matrix). Each chunk of blocks is converted to samples as a whole,
+ * independently of the range of the loop body, so that the results do not depend on how the
+ * samples are divided over threads.
+ */
+struct FillSamples
+{
+    //! Fill samples in range [begin, end) of samples of all streams.
+    void operator( )( const std::size_t begin, const std::size_t end ) const
+    {
+        boost::uint32_t words[ 4 ][ numberOfBlocksPerChunk ];
+        Eigen::ArrayXd firstSamples( numberOfBlocksPerChunk );
+        Eigen::ArrayXd secondSamples( numberOfBlocksPerChunk );
+        Eigen::ArrayXd radii( numberOfBlocksPerChunk );
+
+        std::size_t index = begin;
+        while ( index < end )
+        {
+            // Find stream, and samples of stream in range.
+            const std::size_t streamOffset = index / numberOfSamplesPerStream;
+            const std::size_t streamEnd
+                    = std::min( end, ( streamOffset + 1 ) * numberOfSamplesPerStream );
+            const boost::uint64_t stream = firstStream + streamOffset;
+            const double mean = means ? means[ streamOffset ] : 0.0;
+            const double standardDeviation
+                    = standardDeviations ? standardDeviations[ streamOffset ] : 1.0;
+
+            while ( index < streamEnd )
+            {
+                // Generate chunk of blocks that contains the sample, and convert it to uniform
+                // samples.
+                const boost::uint64_t sample
+                        = firstSample + ( index - streamOffset * numberOfSamplesPerStream );
+                const boost::uint64_t firstBlock
+                        = sample / 2 / numberOfBlocksPerChunk * numberOfBlocksPerChunk;
+                computePhilox4x32Chunk( firstBlock, stream, key, words );
+
+                for ( std::size_t j = 0; j < numberOfBlocksPerChunk; j++ )
+                {
+                    firstSamples( j ) = convertToUniformRandomNumber( words[ 0 ][ j ],
+                                                                      words[ 1 ][ j ] );
+                    secondSamples( j ) = convertToUniformRandomNumber( words[ 2 ][ j ],
+                                                                       words[ 3 ][ j ] );
+                }
+
+                // Convert uniform samples to normal samples, using Box-Muller transform.
+                if ( isNormal )
+                {
+                    radii = ( -2.0 * firstSamples.log( ) ).sqrt( );
+                    secondSamples *= 2.0 * tudat::basic_mathematics::mathematical_constants::PI;
+                    firstSamples = radii * secondSamples.cos( );
+                    secondSamples = radii * secondSamples.sin( );
+                }
+
+                // Store samples of chunk that are in range.
+                const boost::uint64_t chunkEnd = 2 * ( firstBlock + numberOfBlocksPerChunk );
+                const std::size_t numberOfChunkSamples = static_cast< std::size_t >(
+                            std::min< boost::uint64_t >( chunkEnd - sample, streamEnd - index ) );
+                for ( std::size_t i = 0; i < numberOfChunkSamples; i++ )
+                {
+                    const boost::uint64_t chunkSample = sample + i - 2 * firstBlock;
+                    const double value = chunkSample % 2 == 0
+                            ? firstSamples( chunkSample / 2 ) : secondSamples( chunkSample / 2 );
+                    output[ index + i ] = mean + standardDeviation * value;
+                }
+
+                index += numberOfChunkSamples;
+            }
+        }
+    }
+
+    //! Key of random number generator.
+    boost::uint32_t key[ 2 ];
+
+    //! Flag that indicates whether normal samples are generated, instead of uniform samples.
+    bool isNormal;
+
+    //! Index of first stream.
+    boost::uint64_t firstStream;
+
+    //! Index of first sample in each stream.
+    boost::uint64_t firstSample;
+
+    //! Number of samples per stream.
+    std::size_t numberOfSamplesPerStream;
+
+    //! Means of streams, or null for no offset.
+    const double* means;
+
+    //! Standard deviations of streams, or null for no scaling.
+    const double* standardDeviations;
+
+    //! Samples, one stream after the other.
+    double* output;
+};
+
+//! Fill samples of one or more streams in parallel.
+void fillSamples( const boost::uint64_t seed, const bool isNormal,
+                  const boost::uint64_t firstStream, const std::size_t numberOfStreams,
+                  const boost::uint64_t firstSample, const std::size_t numberOfSamplesPerStream,
+                  const double* means, const double* standardDeviations, double* output,
+                  const unsigned int numberOfThreads )
+{
+    if ( numberOfStreams == 0 || numberOfSamplesPerStream == 0 )
+    {
+        return;
+    }
+
+    const FillSamples loopBody = { { static_cast< boost::uint32_t >( seed ),
+                                     static_cast< boost::uint32_t >( seed >> 32 ) },
+                                   isNormal, firstStream, firstSample, numberOfSamplesPerStream,
+                                   means, standardDeviations, output };
+    basics::executeParallelLoop( numberOfStreams * numberOfSamplesPerStream, loopBody,
+                                 numberOfThreads, minimumNumberOfSamplesPerThread );
+}
+
+} // namespace
+
+//! Compute Philox-4x32-10 block.
+void computePhilox4x32Block( const boost::uint32_t counter[ 4 ], const boost::uint32_t key[ 2 ],
+                             boost::uint32_t block[ 4 ] )
+{
+    std::copy( counter, counter + 4, block );
+
+    boost::uint32_t key0 = key[ 0 ];
+    boost::uint32_t key1 = key[ 1 ];
+    for ( int round = 0; round < numberOfPhiloxRounds; round++ )
+    {
+        const boost::uint64_t product0 = philoxMultiplier0 * block[ 0 ];
+        const boost::uint64_t product1 = philoxMultiplier1 * block[ 2 ];
+        block[ 0 ] = static_cast< boost::uint32_t >( product1 >> 32 ) ^ block[ 1 ] ^ key0;
+        block[ 2 ] = static_cast< boost::uint32_t >( product0 >> 32 ) ^ block[ 3 ] ^ key1;
+        block[ 1 ] = static_cast< boost::uint32_t >( product1 );
+        block[ 3 ] = static_cast< boost::uint32_t >( product0 );
+
+        key0 += philoxKeyIncrement0;
+        key1 += philoxKeyIncrement1;
+    }
+}
+
+//! Generate uniform samples.
+void MonteCarloSampler::generateUniformSamples( const std::size_t numberOfSamples,
+                                                Eigen::ArrayXd& samples,
+                                                const boost::uint64_t stream,
+                                                const boost::uint64_t firstSample ) const
+{
+    samples.resize( numberOfSamples );
+    fillSamples( seed, false, stream, 1, firstSample, numberOfSamples, 0, 0, samples.data( ),
+                 numberOfThreads );
+}
+
+//! Generate standard normal samples.
+void MonteCarloSampler::generateNormalSamples( const std::size_t numberOfSamples,
+                                               Eigen::ArrayXd& samples,
+                                               const boost::uint64_t stream,
+                                               const boost::uint64_t firstSample ) const
+{
+    samples.resize( numberOfSamples );
+    fillSamples( seed, true, stream, 1, firstSample, numberOfSamples, 0, 0, samples.data( ),
+                 numberOfThreads );
+}
+
+//! Generate normal dispersions.
+void MonteCarloSampler::generateNormalDispersions( const Eigen::VectorXd& means,
+                                                   const Eigen::VectorXd& standardDeviations,
+                                                   const std::size_t numberOfSamples,
+                                                   Eigen::MatrixXd& samples,
+                                                   const boost::uint64_t firstSample ) const
+{
+    if ( means.size( ) != standardDeviations.size( ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Error: sizes of means and standard deviations do not match." ) ) );
+    }
+
+    if ( ( standardDeviations.array( ) < 0.0 ).any( ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Error: standard deviation is negative." ) ) );
+    }
+
+    samples.resize( numberOfSamples, means.size( ) );
+    fillSamples( seed, true, 0, means.size( ), firstSample, numberOfSamples, means.data( ),
+                 standardDeviations.data( ), samples.data( ), numberOfThreads );
+}
+
+} // namespace mathematics
+} // namespace assist
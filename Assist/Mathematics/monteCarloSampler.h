@@ -0,0 +1,152 @@
+/*
+ *    Copyright (c) 2010-2014, Delft University of Technology
+ *    Copyright (c) 2010-2014, K. Kumar (me@kartikkumar.com)
+ *    All rights reserved.
+ *    See http://bit.ly/1jern3m for license details.
+ */
+
+#ifndef ASSIST_MONTE_CARLO_SAMPLER_H
+#define ASSIST_MONTE_CARLO_SAMPLER_H
+
+#include <cstddef>
+
+#include <boost/cstdint.hpp>
+
+#include <Eigen/Core>
+
+namespace assist
+{
+namespace mathematics
+{
+
+//! Compute Philox-4x32-10 block.
+/*!
+ * Computes block of four 32-bit random words from a 128-bit counter and a 64-bit key, using the
+ * Philox-4x32 bijection with 10 rounds (Salmon et al., 2011). Each distinct counter gives an
+ * independent block, so that random numbers can be generated in any order.
+ * \param counter Counter, as four 32-bit words.
+ * \param key Key, as two 32-bit words.
+ * \param block Random block, as four 32-bit words.
+ */
+void computePhilox4x32Block( const boost::uint32_t counter[ 4 ], const boost::uint32_t key[ 2 ],
+                             boost::uint32_t block[ 4 ] );
+
+//! Convert two random words to uniform random number in open interval (0, 1).
+/*!
+ * Converts two 32-bit random words to a uniform random number in the open interval (0, 1). The
+ * upper 52 bits of the 64-bit word are used as mantissa, offset by half a step, so that the
+ * result is (k + 0.5) 2^-52 for k in [0, 2^52). Since k + 0.5 has at most 53 significant bits,
+ * each result is represented exactly, and the largest result is 1 - 2^-53 < 1 (with 53 bits,
+ * the largest result would round to 1).
+ * \param lowerWord Lower 32 bits of random word.
+ * \param upperWord Upper 32 bits of random word.
+ * \return Uniform random number in open interval (0, 1).
+ */
+inline double convertToUniformRandomNumber( const boost::uint32_t lowerWord,
+                                            const boost::uint32_t upperWord )
+{
+    const boost::uint64_t word = ( static_cast< boost::uint64_t >( upperWord ) << 32 ) | lowerWord;
+    return ( static_cast< double >( word >> 12 ) + 0.5 ) * ( 1.0 / 4503599627370496.0 );
+}
+
+//! Sampler for Monte Carlo simulations, based on counter-based random number generator.
+/*!
+ * Sampler that generates uniform and normal random samples for Monte Carlo simulations, using the
+ * counter-based Philox-4x32-10 generator (see computePhilox4x32Block()). The seed is used as key,
+ * and sample i of stream s is computed from the counter (i / 2, s), so that each sample is a pure
+ * function of the seed, stream and sample index. Samples can therefore be generated in any order
+ * and on any number of threads, and are bit-identical for any number of threads. Blocks are
+ * generated in chunks of 256, with the rounds vectorized over each chunk, and converted to
+ * samples with vectorized array operations:
+ *  - uniform samples in the open interval (0, 1) use the upper 52 bits of two words (see
+ *      convertToUniformRandomNumber());
+ *  - normal samples use the Box-Muller transform of the two uniform samples of a block, so that
+ *      samples 2k and 2k + 1 of a stream are the cosine and sine branches of block k.
+ * Since uniform and normal samples of the same stream are computed from the same blocks, they
+ * are correlated; separate streams should be used for independent variates. Large arrays of
+ * samples are filled in parallel.
+ */
+class MonteCarloSampler
+{
+public:
+
+    //! Constructor taking seed and number of threads.
+    /*!
+     * Constructor taking seed and number of threads.
+     * \param aSeed Seed, used as key of random number generator.
+     * \param aNumberOfThreads Number of threads to use (0 = number of hardware threads;
+     *          default=1).
+     */
+    MonteCarloSampler( const boost::uint64_t aSeed, const unsigned int aNumberOfThreads = 1 )
+        : seed( aSeed ),
+          numberOfThreads( aNumberOfThreads )
+    { }
+
+    //! Generate uniform samples.
+    /*!
+     * Generates consecutive uniform samples in the open interval (0, 1) of a given stream.
+     * \param numberOfSamples Number of samples.
+     * \param samples Samples (resized if needed).
+     * \param stream Index of stream (default=0).
+     * \param firstSample Index of first sample in stream (default=0).
+     */
+    void generateUniformSamples( const std::size_t numberOfSamples, Eigen::ArrayXd& samples,
+                                 const boost::uint64_t stream = 0,
+                                 const boost::uint64_t firstSample = 0 ) const;
+
+    //! Generate standard normal samples.
+    /*!
+     * Generates consecutive samples of the standard normal distribution of a given stream.
+     * \param numberOfSamples Number of samples.
+     * \param samples Samples (resized if needed).
+     * \param stream Index of stream (default=0).
+     * \param firstSample Index of first sample in stream (default=0).
+     */
+    void generateNormalSamples( const std::size_t numberOfSamples, Eigen::ArrayXd& samples,
+                                const boost::uint64_t stream = 0,
+                                const boost::uint64_t firstSample = 0 ) const;
+
+    //! Generate normal dispersions.
+    /*!
+     * Generates normal dispersions of a number of variables, stored in structure-of-arrays layout
+     * (one column per variable, one row per sample). The samples of variable d are taken from
+     * stream d, and scaled with its mean and standard deviation. Standard deviations can be
+     * computed from full widths at half maximum with
+     * convertFullWidthHalfMaximumToStandardDeviation(). Throws a run-time error if the sizes of
+     * the means and standard deviations do not match, or if a standard deviation is negative.
+     * \param means Means of variables.
+     * \param standardDeviations Standard deviations of variables.
+     * \param numberOfSamples Number of samples.
+     * \param samples Samples, one row per sample and one column per variable (resized if
+     *          needed).
+     * \param firstSample Index of first sample in streams (default=0).
+     */
+    void generateNormalDispersions( const Eigen::VectorXd& means,
+                                    const Eigen::VectorXd& standardDeviations,
+                                    const std::size_t numberOfSamples, Eigen::MatrixXd& samples,
+                                    const boost::uint64_t firstSample = 0 ) const;
+
+protected:
+
+private:
+
+    //! Seed.
+    const boost::uint64_t seed;
+
+    //! Number of threads.
+    const unsigned int numberOfThreads;
+};
+
+} // namespace mathematics
+} // namespace assist
+
+#endif // ASSIST_MONTE_CARLO_SAMPLER_H
+
+/*
+ *    References
+ *      Box, G.E.P., Muller, M.E. A note on the generation of random normal deviates, The Annals of
+ *          Mathematical Statistics 29(2), 610-611, 1958.
+ *      Salmon, J.K., Moraes, M.A., Dror, R.O., Shaw, D.E. Parallel random numbers: as easy as
+ *          1, 2, 3, Proceedings of the International Conference for High Performance Computing,
+ *          Networking, Storage and Analysis (SC11), 2011.
+ */
@@ -0,0 +1,297 @@
+/*
+ *    Copyright (c) 2010-2014, Delft University of Technology
+ *    Copyright (c) 2010-2014, K. Kumar (me@kartikkumar.com)
+ *    All rights reserved.
+ *    See http://bit.ly/1jern3m for license details.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+#include <boost/exception/all.hpp>
+
+#include "Assist/Basics/parallelLoop.h"
+#include "Assist/Mathematics/rollingQuantiles.h"
+
+namespace assist
+{
+namespace mathematics
+{
+
+namespace
+{
+
+//! Minimum number of windows per thread.
+const std::size_t minimumNumberOfWindowsPerThread = 65536;
+
+//! Loop body to compute quantiles of sliding windows.
+/*!
+ * Loop body to compute quantiles of sliding windows, which end at each value. Windows have a
+ * fixed number of values if the abscissae are not given, and a fixed width otherwise.
+ */
+struct ComputeWindowQuantiles
+{
+    //! Compute quantiles of windows in range [begin, end).
+    void operator( )( const std::size_t begin, const std::size_t end ) const
+    {
+        // Fill first window of range.
+        RollingQuantile rollingQuantile( probability );
+        std::size_t first = computeWindowStart( begin, 0 );
+        for ( std::size_t j = first; j < begin; j++ )
+        {
+            rollingQuantile.insert( values[ j ] );
+        }
+
+        // Slide window over range.
+        for ( std::size_t i = begin; i < end; i++ )
+        {
+            rollingQuantile.insert( values[ i ] );
+            const std::size_t nextFirst = computeWindowStart( i, first );
+            for ( ; first < nextFirst; first++ )
+            {
+                rollingQuantile.remove( values[ first ] );
+            }
+
+            quantiles[ i ] = rollingQuantile.getQuantile( );
+        }
+    }
+
+    //! Compute index of first value in window that ends at value i, from given lower bound.
+    std::size_t computeWindowStart( const std::size_t i, const std::size_t lowerBound ) const
+    {
+        if ( abscissae == 0 )
+        {
+            return i + 1 > numberOfValuesInWindow ? i + 1 - numberOfValuesInWindow : 0;
+        }
+
+        return static_cast< std::size_t >(
+                    std::upper_bound( abscissae + lowerBound, abscissae + i,
+                                      abscissae[ i ] - windowWidth ) - abscissae );
+    }
+
+    //! Independent values, or null pointer for windows with fixed number of values.
+    const double* abscissae;
+
+    //! Dependent values.
+    const double* values;
+
+    //! Number of values in window, for windows with fixed number of values.
+    std::size_t numberOfValuesInWindow;
+
+    //! Width of window, for windows with fixed width.
+    double windowWidth;
+
+    //! Probability of quantile.
+    double probability;
+
+    //! Quantiles of windows.
+    double* quantiles;
+};
+
+//! Check that probability is in [0, 1].
+void checkProbability( const double probability )
+{
+    if ( !( probability >= 0.0 && probability <= 1.0 ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Error: probability must be in [0, 1]." ) ) );
+    }
+}
+
+} // namespace
+
+//! Constructor taking probability of quantile.
+RollingQuantile::RollingQuantile( const double aProbability )
+    : probability( aProbability )
+{
+    checkProbability( probability );
+}
+
+//! Insert value in window.
+void RollingQuantile::insert( const double value )
+{
+    if ( lowerValues.empty( ) || value <= *lowerValues.rbegin( ) )
+    {
+        lowerValues.insert( value );
+    }
+
+    else
+    {
+        upperValues.insert( value );
+    }
+
+    rebalance( );
+}
+
+//! Remove value from window.
+void RollingQuantile::remove( const double value )
+{
+    // Values equal to the largest lower value are always in the lower multiset.
+    if ( !lowerValues.empty( ) && value <= *lowerValues.rbegin( ) )
+    {
+        const std::multiset< double >::iterator iteratorValue = lowerValues.find( value );
+        if ( iteratorValue != lowerValues.end( ) )
+        {
+            lowerValues.erase( iteratorValue );
+            rebalance( );
+            return;
+        }
+    }
+
+    else
+    {
+        const std::multiset< double >::iterator iteratorValue = upperValues.find( value );
+        if ( iteratorValue != upperValues.end( ) )
+        {
+            upperValues.erase( iteratorValue );
+            rebalance( );
+            return;
+        }
+    }
+
+    boost::throw_exception(
+                boost::enable_error_info(
+                    std::runtime_error( "Error: value to remove is not in window." ) ) );
+}
+
+//! Get quantile of values in window.
+double RollingQuantile::getQuantile( ) const
+{
+    if ( lowerValues.empty( ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Error: window is empty." ) ) );
+    }
+
+    const double position = static_cast< double >( getNumberOfValues( ) - 1 ) * probability;
+    const double fraction = position - std::floor( position );
+    const double lowerValue = *lowerValues.rbegin( );
+    if ( fraction == 0.0 || upperValues.empty( ) )
+    {
+        return lowerValue;
+    }
+
+    return lowerValue + fraction * ( *upperValues.begin( ) - lowerValue );
+}
+
+//! Move values between multisets, such that lower multiset holds values up to order k.
+void RollingQuantile::rebalance( )
+{
+    const std::size_t numberOfValues = getNumberOfValues( );
+    const std::size_t numberOfLowerValues = numberOfValues == 0
+            ? 0 : static_cast< std::size_t >(
+                  std::floor( static_cast< double >( numberOfValues - 1 ) * probability ) ) + 1;
+
+    while ( lowerValues.size( ) > numberOfLowerValues )
+    {
+        std::multiset< double >::iterator iteratorLargest = lowerValues.end( );
+        iteratorLargest--;
+        upperValues.insert( upperValues.begin( ), *iteratorLargest );
+        lowerValues.erase( iteratorLargest );
+    }
+
+    while ( lowerValues.size( ) < numberOfLowerValues )
+    {
+        lowerValues.insert( lowerValues.end( ), *upperValues.begin( ) );
+        upperValues.erase( upperValues.begin( ) );
+    }
+}
+
+//! Compute quantiles of sliding windows with fixed number of values.
+void computeRollingQuantiles( const Eigen::ArrayXd& values,
+                              const std::size_t numberOfValuesInWindow,
+                              const double probability, Eigen::ArrayXd& quantiles,
+                              const unsigned int numberOfThreads )
+{
+    if ( numberOfValuesInWindow == 0 )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Error: number of values in window must be positive." ) ) );
+    }
+
+    checkProbability( probability );
+
+    quantiles.resize( values.size( ) );
+    const ComputeWindowQuantiles loopBody = { 0, values.data( ), numberOfValuesInWindow, 0.0,
+                                              probability, quantiles.data( ) };
+    basics::executeParallelLoop(
+                static_cast< std::size_t >( values.size( ) ), loopBody, numberOfThreads,
+                std::max( minimumNumberOfWindowsPerThread, 4 * numberOfValuesInWindow ) );
+}
+
+//! Compute quantiles of sliding windows with fixed width.
+void computeRollingQuantiles( const Eigen::ArrayXd& abscissae, const Eigen::ArrayXd& values,
+                              const double windowWidth, const double probability,
+                              Eigen::ArrayXd& quantiles, const unsigned int numberOfThreads )
+{
+    if ( abscissae.size( ) != values.size( ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Error: sizes of abscissae and values do not match." ) ) );
+    }
+
+    if ( abscissae.size( ) > 1
+         && !( abscissae.tail( abscissae.size( ) - 1 )
+               >= abscissae.head( abscissae.size( ) - 1 ) ).all( ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Error: abscissae must be sorted in increasing order." ) ) );
+    }
+
+    if ( !( windowWidth > 0.0 ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Error: width of window must be positive." ) ) );
+    }
+
+    checkProbability( probability );
+
+    quantiles.resize( values.size( ) );
+    const ComputeWindowQuantiles loopBody = { abscissae.data( ), values.data( ), 0,
+                                              windowWidth, probability, quantiles.data( ) };
+    basics::executeParallelLoop( static_cast< std::size_t >( values.size( ) ), loopBody,
+                                 numberOfThreads, minimumNumberOfWindowsPerThread );
+}
+
+//! Compute quantiles of sliding windows with fixed width, of series stored in map.
+basics::DoubleKeyDoubleValueMap computeRollingQuantiles(
+        const basics::DoubleKeyDoubleValueMap& series, const double windowWidth,
+        const double probability, const unsigned int numberOfThreads )
+{
+    Eigen::ArrayXd abscissae( series.size( ) );
+    Eigen::ArrayXd values( series.size( ) );
+    Eigen::ArrayXd::Index i = 0;
+    for ( basics::DoubleKeyDoubleValueMap::const_iterator iteratorPoint = series.begin( );
+          iteratorPoint != series.end( ); iteratorPoint++, i++ )
+    {
+        abscissae( i ) = iteratorPoint->first;
+        values( i ) = iteratorPoint->second;
+    }
+
+    Eigen::ArrayXd quantiles;
+    computeRollingQuantiles( abscissae, values, windowWidth, probability, quantiles,
+                             numberOfThreads );
+
+    basics::DoubleKeyDoubleValueMap quantileSeries;
+    for ( i = 0; i < abscissae.size( ); i++ )
+    {
+        quantileSeries.insert( quantileSeries.end( ), std::make_pair( abscissae( i ),
+                                                                      quantiles( i ) ) );
+    }
+
+    return quantileSeries;
+}
+
+} // namespace mathematics
+} // namespace assist
@@ -0,0 +1,156 @@
+/*
+ *    Copyright (c) 2010-2014, Delft University of Technology
+ *    Copyright (c) 2010-2014, K. Kumar (me@kartikkumar.com)
+ *    All rights reserved.
+ *    See http://bit.ly/1jern3m for license details.
+ */
+
+#ifndef ASSIST_ROLLING_QUANTILES_H
+#define ASSIST_ROLLING_QUANTILES_H
+
+#include <cstddef>
+#include <set>
+
+#include <Eigen/Core>
+
+#include "Assist/Basics/commonTypedefs.h"
+
+namespace assist
+{
+namespace mathematics
+{
+
+//! Quantile of sliding window of values.
+/*!
+ * Quantile of a sliding window of values, to which values are inserted and from which values are
+ * removed in any order. The quantile for probability p of n values x_(0) <= ... <= x_(n-1) is
+ * computed by linear interpolation between order statistics (definition 7 of Hyndman and Fan,
+ * 1996): for h = ( n - 1 ) p, the quantile is x_(k) + ( h - k ) ( x_(k+1) - x_(k) ), with
+ * k = floor( h ); the median is the quantile for p = 0.5. The values are split in two ordered
+ * multisets, the lower one holding x_(0), ..., x_(k) and the upper one holding the others, which
+ * generalizes the two-heap method for the running median to any quantile and to removal of
+ * values. Inserting or removing a value costs O(log W) for W values in the window, moving at most
+ * one value between the multisets, and the quantile follows from the largest value of the lower
+ * multiset and the smallest value of the upper multiset in O(1). Memory is proportional to the
+ * number of values in the window. Values must not be NaN.
+ */
+class RollingQuantile
+{
+public:
+
+    //! Constructor taking probability of quantile.
+    /*!
+     * Constructor taking probability of quantile. Throws a run-time error if the probability is
+     * not in [0, 1].
+     * \param aProbability Probability of quantile (0.5 for median).
+     */
+    RollingQuantile( const double aProbability );
+
+    //! Insert value in window.
+    /*!
+     * Inserts value in window.
+     * \param value Value.
+     */
+    void insert( const double value );
+
+    //! Remove value from window.
+    /*!
+     * Removes one occurrence of value from window. Throws a run-time error if the value is not in
+     * the window.
+     * \param value Value.
+     */
+    void remove( const double value );
+
+    //! Get number of values in window.
+    /*!
+     * Returns number of values in window.
+     * \return Number of values in window.
+     */
+    std::size_t getNumberOfValues( ) const { return lowerValues.size( ) + upperValues.size( ); }
+
+    //! Get quantile of values in window.
+    /*!
+     * Returns quantile of values in window. Throws a run-time error if the window is empty.
+     * \return Quantile of values in window.
+     */
+    double getQuantile( ) const;
+
+protected:
+
+private:
+
+    //! Move values between multisets, such that lower multiset holds values up to order k.
+    void rebalance( );
+
+    //! Probability of quantile.
+    double probability;
+
+    //! Lower values, up to order k.
+    std::multiset< double > lowerValues;
+
+    //! Upper values.
+    std::multiset< double > upperValues;
+};
+
+//! Compute quantiles of sliding windows with fixed number of values.
+/*!
+ * Computes quantile of the values in a sliding window that ends at each value, i.e., quantile i
+ * is that of values max( 0, i - W + 1 ), ..., i, for a window of W values, such that the first
+ * W - 1 windows are partial (see RollingQuantile). The windows are processed in O(N log W) for N
+ * values, in parallel over chunks of windows; each chunk starts by filling its first window, and
+ * the results are the same for any number of threads.
+ * \param values Values.
+ * \param numberOfValuesInWindow Number of values in window, W.
+ * \param probability Probability of quantile (0.5 for rolling median).
+ * \param quantiles Quantiles of windows, one per value (resized if needed).
+ * \param numberOfThreads Number of threads to use (0 = number of hardware threads; default=1).
+ */
+void computeRollingQuantiles( const Eigen::ArrayXd& values,
+                              const std::size_t numberOfValuesInWindow,
+                              const double probability, Eigen::ArrayXd& quantiles,
+                              const unsigned int numberOfThreads = 1 );
+
+//! Compute quantiles of sliding windows with fixed width.
+/*!
+ * Computes quantile of the values in a sliding window of given width that ends at each value,
+ * i.e., quantile i is that of the values j <= i with abscissae in
+ * ( abscissae( i ) - windowWidth, abscissae( i ) ], for unevenly spaced values (see
+ * RollingQuantile). The windows are processed in O(N log W) for N values and at most W values per
+ * window, in parallel over chunks of windows, and the results are the same for any number of
+ * threads. Throws a run-time error if the sizes of the abscissae and values do not match, if the
+ * abscissae are not sorted in increasing order, or if the window width is not positive.
+ * \param abscissae Independent values, sorted in increasing order.
+ * \param values Dependent values.
+ * \param windowWidth Width of window, in units of independent values.
+ * \param probability Probability of quantile (0.5 for rolling median).
+ * \param quantiles Quantiles of windows, one per value (resized if needed).
+ * \param numberOfThreads Number of threads to use (0 = number of hardware threads; default=1).
+ */
+void computeRollingQuantiles( const Eigen::ArrayXd& abscissae, const Eigen::ArrayXd& values,
+                              const double windowWidth, const double probability,
+                              Eigen::ArrayXd& quantiles, const unsigned int numberOfThreads = 1 );
+
+//! Compute quantiles of sliding windows with fixed width, of series stored in map.
+/*!
+ * Computes quantile of the values in a sliding window of given width that ends at each key of a
+ * series stored in a map (see computeRollingQuantiles( ) for arrays).
+ * \param series Series, as independent and dependent values.
+ * \param windowWidth Width of window, in units of independent values.
+ * \param probability Probability of quantile (0.5 for rolling median).
+ * \param numberOfThreads Number of threads to use (0 = number of hardware threads; default=1).
+ * \return Quantiles of windows, at keys of series.
+ */
+basics::DoubleKeyDoubleValueMap computeRollingQuantiles(
+        const basics::DoubleKeyDoubleValueMap& series, const double windowWidth,
+        const double probability, const unsigned int numberOfThreads = 1 );
+
+} // namespace mathematics
+} // namespace assist
+
+#endif // ASSIST_ROLLING_QUANTILES_H
+
+/*
+ *    References
+ *      Hyndman, R.J., Fan, Y. Sample quantiles in statistical packages, The American
+ *          Statistician 50(4), 361-365, 1996.
+ */
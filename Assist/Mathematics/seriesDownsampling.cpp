@@ -0,0 +1,443 @@
+/*
+ *    Copyright (c) 2010-2014, Delft University of Technology
+ *    Copyright (c) 2010-2014, K. Kumar (me@kartikkumar.com)
+ *    All rights reserved.
+ *    See http://bit.ly/1jern3m for license details.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <boost/exception/all.hpp>
+
+#include "Assist/Basics/parallelLoop.h"
+#include "Assist/Mathematics/seriesDownsampling.h"
+
+namespace assist
+{
+namespace mathematics
+{
+
+namespace
+{
+
+//! Minimum number of points processed per thread.
+const std::size_t minimumNumberOfPointsPerThread = 65536;
+
+//! Accessor of points of series stored in arrays.
+struct ArraySeries
+{
+    //! Iterator over points, i.e., index of point.
+    typedef std::size_t Iterator;
+
+    //! Get independent value of point.
+    double getAbscissa( const Iterator point ) const { return abscissae[ point ]; }
+
+    //! Get dependent value of point.
+    double getValue( const Iterator point ) const { return values[ point ]; }
+
+    //! Independent values.
+    const double* abscissae;
+
+    //! Dependent values.
+    const double* values;
+};
+
+//! Accessor of points of series stored in map.
+struct MapSeries
+{
+    //! Iterator over points.
+    typedef basics::DoubleKeyDoubleValueMap::const_iterator Iterator;
+
+    //! Get independent value of point.
+    double getAbscissa( const Iterator& point ) const { return point->first; }
+
+    //! Get dependent value of point.
+    double getValue( const Iterator& point ) const { return point->second; }
+};
+
+//! Compute index of first point of bucket, for buckets with equal numbers of points.
+inline std::size_t computeBucketStart( const std::size_t bucket,
+                                       const std::size_t numberOfPoints,
+                                       const std::size_t numberOfBuckets )
+{
+    return bucket * numberOfPoints / numberOfBuckets;
+}
+
+//! Find extrema of bucket, and advance iterator to first point after bucket.
+template< typename Series >
+void findBucketExtrema( const Series& series, typename Series::Iterator& point,
+                        const std::size_t numberOfPointsInBucket,
+                        typename Series::Iterator& firstExtremum,
+                        typename Series::Iterator& secondExtremum )
+{
+    typename Series::Iterator minimum = point;
+    typename Series::Iterator maximum = point;
+    std::size_t minimumOffset = 0;
+    std::size_t maximumOffset = 0;
+    double minimumValue = series.getValue( point );
+    double maximumValue = minimumValue;
+
+    ++point;
+    for ( std::size_t i = 1; i < numberOfPointsInBucket; i++, ++point )
+    {
+        const double value = series.getValue( point );
+        if ( value < minimumValue )
+        {
+            minimum = point;
+            minimumOffset = i;
+            minimumValue = value;
+        }
+
+        else if ( value > maximumValue )
+        {
+            maximum = point;
+            maximumOffset = i;
+            maximumValue = value;
+        }
+    }
+
+    // Order extrema as in series.
+    firstExtremum = minimumOffset <= maximumOffset ? minimum : maximum;
+    secondExtremum = minimumOffset <= maximumOffset ? maximum : minimum;
+}
+
+//! Compute centroid of bucket, and advance iterator to first point after bucket.
+template< typename Series >
+void computeBucketCentroid( const Series& series, typename Series::Iterator& point,
+                            const std::size_t numberOfPointsInBucket,
+                            double& centroidAbscissa, double& centroidValue )
+{
+    double abscissaSum = 0.0;
+    double valueSum = 0.0;
+    for ( std::size_t i = 0; i < numberOfPointsInBucket; i++, ++point )
+    {
+        abscissaSum += series.getAbscissa( point );
+        valueSum += series.getValue( point );
+    }
+
+    centroidAbscissa = abscissaSum / static_cast< double >( numberOfPointsInBucket );
+    centroidValue = valueSum / static_cast< double >( numberOfPointsInBucket );
+}
+
+//! Select point of bucket that forms largest triangle with given points.
+/*!
+ * Selects the point of a bucket that forms the largest triangle with the previously selected
+ * point and the centroid of the next bucket (the first such point, in case of ties), and advances
+ * the iterator to the first point after the bucket.
+ */
+template< typename Series >
+typename Series::Iterator selectLargestTriangle( const Series& series,
+                                                 typename Series::Iterator& point,
+                                                 const std::size_t numberOfPointsInBucket,
+                                                 const double previousAbscissa,
+                                                 const double previousValue,
+                                                 const double centroidAbscissa,
+                                                 const double centroidValue )
+{
+    typename Series::Iterator selectedPoint = point;
+    double largestDoubleArea = -1.0;
+    for ( std::size_t i = 0; i < numberOfPointsInBucket; i++, ++point )
+    {
+        const double doubleArea = std::fabs(
+                    ( previousAbscissa - centroidAbscissa )
+                    * ( series.getValue( point ) - previousValue )
+                    - ( previousAbscissa - series.getAbscissa( point ) )
+                    * ( centroidValue - previousValue ) );
+        if ( doubleArea > largestDoubleArea )
+        {
+            selectedPoint = point;
+            largestDoubleArea = doubleArea;
+        }
+    }
+
+    return selectedPoint;
+}
+
+//! Loop body to find extrema of buckets of series stored in arrays.
+struct FindExtremaOfBuckets
+{
+    //! Find extrema of buckets in range [begin, end).
+    void operator( )( const std::size_t begin, const std::size_t end ) const
+    {
+        for ( std::size_t b = begin; b < end; b++ )
+        {
+            const std::size_t first = computeBucketStart( b, numberOfPoints, numberOfBuckets );
+            std::size_t point = first;
+            findBucketExtrema( series, point,
+                               computeBucketStart( b + 1, numberOfPoints, numberOfBuckets )
+                               - first, extrema[ 2 * b ], extrema[ 2 * b + 1 ] );
+        }
+    }
+
+    //! Series.
+    ArraySeries series;
+
+    //! Number of points of series.
+    std::size_t numberOfPoints;
+
+    //! Number of buckets.
+    std::size_t numberOfBuckets;
+
+    //! Indices of extrema of buckets, in order of series.
+    std::size_t* extrema;
+};
+
+//! Loop body to compute centroids of buckets of series stored in arrays.
+struct ComputeBucketCentroids
+{
+    //! Compute centroids of buckets in range [begin, end).
+    void operator( )( const std::size_t begin, const std::size_t end ) const
+    {
+        for ( std::size_t b = begin; b < end; b++ )
+        {
+            const std::size_t first
+                    = 1 + computeBucketStart( b, numberOfInnerPoints, numberOfBuckets );
+            std::size_t point = first;
+            computeBucketCentroid(
+                        series, point,
+                        1 + computeBucketStart( b + 1, numberOfInnerPoints, numberOfBuckets )
+                        - first, centroidAbscissae[ b ], centroidValues[ b ] );
+        }
+    }
+
+    //! Series.
+    ArraySeries series;
+
+    //! Number of points of series, excluding first and last points.
+    std::size_t numberOfInnerPoints;
+
+    //! Number of buckets.
+    std::size_t numberOfBuckets;
+
+    //! Independent values of centroids.
+    double* centroidAbscissae;
+
+    //! Dependent values of centroids.
+    double* centroidValues;
+};
+
+//! Check that sizes of abscissae and values match.
+void checkSizes( const Eigen::ArrayXd& abscissae, const Eigen::ArrayXd& values )
+{
+    if ( abscissae.size( ) != values.size( ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Error: sizes of abscissae and values do not match." ) ) );
+    }
+}
+
+//! Check that number of buckets is positive.
+void checkNumberOfBuckets( const std::size_t numberOfBuckets )
+{
+    if ( numberOfBuckets == 0 )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Error: number of buckets must be positive." ) ) );
+    }
+}
+
+//! Check that number of points of downsampled series is at least three.
+void checkNumberOfPoints( const std::size_t numberOfPoints )
+{
+    if ( numberOfPoints < 3 )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Error: number of points must be at least three." ) ) );
+    }
+}
+
+} // namespace
+
+//! Downsample series by extrema of buckets.
+void downsampleMinimumMaximum( const Eigen::ArrayXd& abscissae, const Eigen::ArrayXd& values,
+                               const std::size_t numberOfBuckets,
+                               Eigen::ArrayXd& downsampledAbscissae,
+                               Eigen::ArrayXd& downsampledValues,
+                               const unsigned int numberOfThreads )
+{
+    checkSizes( abscissae, values );
+    checkNumberOfBuckets( numberOfBuckets );
+
+    const std::size_t numberOfPoints = static_cast< std::size_t >( abscissae.size( ) );
+    const std::size_t numberOfNonEmptyBuckets = std::min( numberOfBuckets, numberOfPoints );
+
+    // Find extrema of buckets in parallel.
+    std::vector< std::size_t > extrema( 2 * numberOfNonEmptyBuckets );
+    const ArraySeries series = { abscissae.data( ), values.data( ) };
+    const FindExtremaOfBuckets loopBody
+            = { series, numberOfPoints, numberOfNonEmptyBuckets,
+                extrema.empty( ) ? 0 : &extrema[ 0 ] };
+    basics::executeParallelLoop(
+                numberOfNonEmptyBuckets, loopBody, numberOfThreads,
+                std::max< std::size_t >( 1, minimumNumberOfPointsPerThread * numberOfBuckets
+                                         / std::max< std::size_t >( 1, numberOfPoints ) ) );
+
+    // Remove duplicate extrema, and copy points.
+    std::vector< std::size_t >::iterator extremaEnd
+            = std::unique( extrema.begin( ), extrema.end( ) );
+    extrema.erase( extremaEnd, extrema.end( ) );
+
+    downsampledAbscissae.resize( static_cast< Eigen::ArrayXd::Index >( extrema.size( ) ) );
+    downsampledValues.resize( downsampledAbscissae.size( ) );
+    for ( std::size_t i = 0; i < extrema.size( ); i++ )
+    {
+        downsampledAbscissae( i ) = abscissae( extrema[ i ] );
+        downsampledValues( i ) = values( extrema[ i ] );
+    }
+}
+
+//! Downsample series stored in map by extrema of buckets.
+basics::DoubleKeyDoubleValueMap downsampleMinimumMaximum(
+        const basics::DoubleKeyDoubleValueMap& series, const std::size_t numberOfBuckets )
+{
+    checkNumberOfBuckets( numberOfBuckets );
+
+    const std::size_t numberOfPoints = series.size( );
+    const std::size_t numberOfNonEmptyBuckets = std::min( numberOfBuckets, numberOfPoints );
+
+    const MapSeries mapSeries = MapSeries( );
+    basics::DoubleKeyDoubleValueMap downsampledSeries;
+    MapSeries::Iterator point = series.begin( );
+    for ( std::size_t b = 0; b < numberOfNonEmptyBuckets; b++ )
+    {
+        MapSeries::Iterator firstExtremum;
+        MapSeries::Iterator secondExtremum;
+        findBucketExtrema( mapSeries, point,
+                           computeBucketStart( b + 1, numberOfPoints, numberOfNonEmptyBuckets )
+                           - computeBucketStart( b, numberOfPoints, numberOfNonEmptyBuckets ),
+                           firstExtremum, secondExtremum );
+
+        downsampledSeries.insert( downsampledSeries.end( ), *firstExtremum );
+        downsampledSeries.insert( downsampledSeries.end( ), *secondExtremum );
+    }
+
+    return downsampledSeries;
+}
+
+//! Downsample series using Largest-Triangle-Three-Buckets algorithm.
+void downsampleLargestTriangleThreeBuckets( const Eigen::ArrayXd& abscissae,
+                                            const Eigen::ArrayXd& values,
+                                            const std::size_t numberOfPoints,
+                                            Eigen::ArrayXd& downsampledAbscissae,
+                                            Eigen::ArrayXd& downsampledValues,
+                                            const unsigned int numberOfThreads )
+{
+    checkSizes( abscissae, values );
+    checkNumberOfPoints( numberOfPoints );
+
+    const std::size_t numberOfSeriesPoints = static_cast< std::size_t >( abscissae.size( ) );
+    if ( numberOfPoints >= numberOfSeriesPoints )
+    {
+        downsampledAbscissae = abscissae;
+        downsampledValues = values;
+        return;
+    }
+
+    // Compute centroids of buckets of inner points in parallel.
+    const std::size_t numberOfInnerPoints = numberOfSeriesPoints - 2;
+    const std::size_t numberOfBuckets = numberOfPoints - 2;
+
+    std::vector< double > centroidAbscissae( numberOfBuckets );
+    std::vector< double > centroidValues( numberOfBuckets );
+    const ArraySeries series = { abscissae.data( ), values.data( ) };
+    const ComputeBucketCentroids loopBody
+            = { series, numberOfInnerPoints, numberOfBuckets, &centroidAbscissae[ 0 ],
+                &centroidValues[ 0 ] };
+    basics::executeParallelLoop(
+                numberOfBuckets, loopBody, numberOfThreads,
+                std::max< std::size_t >( 1, minimumNumberOfPointsPerThread * numberOfBuckets
+                                         / numberOfInnerPoints ) );
+
+    // Select point of each bucket, given point selected from previous bucket.
+    downsampledAbscissae.resize( static_cast< Eigen::ArrayXd::Index >( numberOfPoints ) );
+    downsampledValues.resize( downsampledAbscissae.size( ) );
+    downsampledAbscissae( 0 ) = abscissae( 0 );
+    downsampledValues( 0 ) = values( 0 );
+
+    std::size_t point = 1;
+    for ( std::size_t b = 0; b < numberOfBuckets; b++ )
+    {
+        const bool isLastBucket = b + 1 == numberOfBuckets;
+        const std::size_t numberOfPointsInBucket
+                = 1 + computeBucketStart( b + 1, numberOfInnerPoints, numberOfBuckets ) - point;
+        const std::size_t selectedPoint = selectLargestTriangle(
+                    series, point, numberOfPointsInBucket,
+                    downsampledAbscissae( b ), downsampledValues( b ),
+                    isLastBucket ? abscissae( numberOfSeriesPoints - 1 )
+                                 : centroidAbscissae[ b + 1 ],
+                    isLastBucket ? values( numberOfSeriesPoints - 1 ) : centroidValues[ b + 1 ] );
+
+        downsampledAbscissae( b + 1 ) = abscissae( selectedPoint );
+        downsampledValues( b + 1 ) = values( selectedPoint );
+    }
+
+    downsampledAbscissae( numberOfPoints - 1 ) = abscissae( numberOfSeriesPoints - 1 );
+    downsampledValues( numberOfPoints - 1 ) = values( numberOfSeriesPoints - 1 );
+}
+
+//! Downsample series stored in map using Largest-Triangle-Three-Buckets algorithm.
+basics::DoubleKeyDoubleValueMap downsampleLargestTriangleThreeBuckets(
+        const basics::DoubleKeyDoubleValueMap& series, const std::size_t numberOfPoints )
+{
+    checkNumberOfPoints( numberOfPoints );
+
+    if ( numberOfPoints >= series.size( ) )
+    {
+        return series;
+    }
+
+    const std::size_t numberOfInnerPoints = series.size( ) - 2;
+    const std::size_t numberOfBuckets = numberOfPoints - 2;
+
+    const MapSeries mapSeries = MapSeries( );
+    MapSeries::Iterator lastPoint = series.end( );
+    lastPoint--;
+
+    basics::DoubleKeyDoubleValueMap downsampledSeries;
+    MapSeries::Iterator previousPoint = series.begin( );
+    downsampledSeries.insert( downsampledSeries.end( ), *previousPoint );
+
+    // Select point of each bucket, reading one bucket ahead to compute centroid of next bucket.
+    MapSeries::Iterator point = series.begin( );
+    point++;
+    MapSeries::Iterator nextBucketPoint = point;
+    std::advance( nextBucketPoint, computeBucketStart( 1, numberOfInnerPoints, numberOfBuckets ) );
+
+    for ( std::size_t b = 0; b < numberOfBuckets; b++ )
+    {
+        double centroidAbscissa = lastPoint->first;
+        double centroidValue = lastPoint->second;
+        if ( b + 1 < numberOfBuckets )
+        {
+            computeBucketCentroid(
+                        mapSeries, nextBucketPoint,
+                        computeBucketStart( b + 2, numberOfInnerPoints, numberOfBuckets )
+                        - computeBucketStart( b + 1, numberOfInnerPoints, numberOfBuckets ),
+                        centroidAbscissa, centroidValue );
+        }
+
+        previousPoint = selectLargestTriangle(
+                    mapSeries, point,
+                    computeBucketStart( b + 1, numberOfInnerPoints, numberOfBuckets )
+                    - computeBucketStart( b, numberOfInnerPoints, numberOfBuckets ),
+                    previousPoint->first, previousPoint->second,
+                    centroidAbscissa, centroidValue );
+        downsampledSeries.insert( downsampledSeries.end( ), *previousPoint );
+    }
+
+    downsampledSeries.insert( downsampledSeries.end( ), *lastPoint );
+    return downsampledSeries;
+}
+
+} // namespace mathematics
+} // namespace assist
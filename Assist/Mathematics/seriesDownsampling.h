@@ -0,0 +1,105 @@
+/*
+ *    Copyright (c) 2010-2014, Delft University of Technology
+ *    Copyright (c) 2010-2014, K. Kumar (me@kartikkumar.com)
+ *    All rights reserved.
+ *    See http://bit.ly/1jern3m for license details.
+ */
+
+#ifndef ASSIST_SERIES_DOWNSAMPLING_H
+#define ASSIST_SERIES_DOWNSAMPLING_H
+
+#include <cstddef>
+
+#include <Eigen/Core>
+
+#include "Assist/Basics/commonTypedefs.h"
+
+namespace assist
+{
+namespace mathematics
+{
+
+//! Downsample series by extrema of buckets.
+/*!
+ * Downsamples a series by dividing the points into buckets with equal numbers of points, and
+ * keeping the points with the minimum and maximum value in each bucket, in their original order.
+ * If both extrema are the same point, it is kept once. Unlike uniform decimation and window
+ * averaging, this preserves all peaks, so that a plot of the downsampled series has the same
+ * envelope as a plot of the original series. Each bucket is processed in a single pass, and the
+ * buckets are distributed over the threads. Throws a run-time error if the sizes of the arrays do
+ * not match, or if the number of buckets is zero.
+ * \param abscissae Sorted independent values.
+ * \param values Dependent values.
+ * \param numberOfBuckets Number of buckets (reduced to number of points if larger).
+ * \param downsampledAbscissae Independent values of downsampled series, with at most two points
+ *          per bucket (resized if needed).
+ * \param downsampledValues Dependent values of downsampled series (resized if needed).
+ * \param numberOfThreads Number of threads to use (0 = number of hardware threads; default=1).
+ */
+void downsampleMinimumMaximum( const Eigen::ArrayXd& abscissae, const Eigen::ArrayXd& values,
+                               const std::size_t numberOfBuckets,
+                               Eigen::ArrayXd& downsampledAbscissae,
+                               Eigen::ArrayXd& downsampledValues,
+                               const unsigned int numberOfThreads = 1 );
+
+//! Downsample series stored in map by extrema of buckets.
+/*!
+ * Downsamples a series stored in a map by keeping the extrema of buckets (see
+ * downsampleMinimumMaximum()), in a single pass over the map. Throws a run-time error if the
+ * number of buckets is zero.
+ * \param series Series of independent and dependent values.
+ * \param numberOfBuckets Number of buckets (reduced to number of points if larger).
+ * \return Downsampled series, with at most two points per bucket.
+ */
+basics::DoubleKeyDoubleValueMap downsampleMinimumMaximum(
+        const basics::DoubleKeyDoubleValueMap& series, const std::size_t numberOfBuckets );
+
+//! Downsample series using Largest-Triangle-Three-Buckets algorithm.
+/*!
+ * Downsamples a series to a given number of points using the Largest-Triangle-Three-Buckets
+ * (LTTB) algorithm (Steinarsson, 2013). The first and last points are kept, and the other points
+ * are divided into buckets with equal numbers of points. From each bucket, the point is kept that
+ * forms the largest triangle with the point kept from the previous bucket and the centroid of the
+ * next bucket, which preserves the visual shape of the series, including its peaks, better than
+ * the extrema of buckets for the same number of points. The centroids of the buckets are computed
+ * in parallel; the selection depends on the previous selection, and is done in a sequential pass.
+ * If the number of points is not smaller than the number of points of the series, the series is
+ * copied. Throws a run-time error if the sizes of the arrays do not match, or if the number of
+ * points is smaller than three.
+ * \param abscissae Sorted independent values.
+ * \param values Dependent values.
+ * \param numberOfPoints Number of points of downsampled series.
+ * \param downsampledAbscissae Independent values of downsampled series (resized if needed).
+ * \param downsampledValues Dependent values of downsampled series (resized if needed).
+ * \param numberOfThreads Number of threads to use (0 = number of hardware threads; default=1).
+ */
+void downsampleLargestTriangleThreeBuckets( const Eigen::ArrayXd& abscissae,
+                                            const Eigen::ArrayXd& values,
+                                            const std::size_t numberOfPoints,
+                                            Eigen::ArrayXd& downsampledAbscissae,
+                                            Eigen::ArrayXd& downsampledValues,
+                                            const unsigned int numberOfThreads = 1 );
+
+//! Downsample series stored in map using Largest-Triangle-Three-Buckets algorithm.
+/*!
+ * Downsamples a series stored in a map to a given number of points using the
+ * Largest-Triangle-Three-Buckets algorithm (see downsampleLargestTriangleThreeBuckets()), in a
+ * single pass over the map, reading one bucket ahead. Throws a run-time error if the number of
+ * points is smaller than three.
+ * \param series Series of independent and dependent values.
+ * \param numberOfPoints Number of points of downsampled series.
+ * \return Downsampled series.
+ */
+basics::DoubleKeyDoubleValueMap downsampleLargestTriangleThreeBuckets(
+        const basics::DoubleKeyDoubleValueMap& series, const std::size_t numberOfPoints );
+
+} // namespace mathematics
+} // namespace assist
+
+#endif // ASSIST_SERIES_DOWNSAMPLING_H
+
+/*
+ *    References
+ *      Steinarsson, S. Downsampling time series for visual representation, MSc thesis,
+ *          University of Iceland, 2013.
+ */
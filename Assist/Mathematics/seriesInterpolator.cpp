@@ -0,0 +1,240 @@
+/*
+ *    Copyright (c) 2010-2014, Delft University of Technology
+ *    Copyright (c) 2010-2014, K. Kumar (me@kartikkumar.com)
+ *    All rights reserved.
+ *    See http://bit.ly/1jern3m for license details.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include <boost/exception/all.hpp>
+
+#include "Assist/Mathematics/seriesInterpolator.h"
+
+namespace assist
+{
+namespace mathematics
+{
+
+namespace
+{
+
+//! Throw run-time error for abscissa outside range of series.
+void throwAbscissaOutOfRangeError( )
+{
+    boost::throw_exception(
+                boost::enable_error_info(
+                    std::runtime_error( "Error: abscissa is outside range of series." ) ) );
+}
+
+} // namespace
+
+//! Constructor taking series and interpolation method.
+SeriesInterpolator::SeriesInterpolator( const basics::DoubleKeyDoubleValueMap& aSeries,
+                                        const SeriesInterpolationMethod aMethod )
+    : method( aMethod ),
+      cursor( 0 )
+{
+    if ( aSeries.size( ) < 2 )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Error: series contains fewer than two points." ) ) );
+    }
+
+    // Copy series to contiguous storage, and compute widths and slopes of segments.
+    const std::size_t numberOfPoints = aSeries.size( );
+    const std::size_t numberOfSegments = numberOfPoints - 1;
+
+    std::vector< double > values;
+    abscissae.reserve( numberOfPoints );
+    values.reserve( numberOfPoints );
+    for ( basics::DoubleKeyDoubleValueMap::const_iterator iteratorPoint = aSeries.begin( );
+          iteratorPoint != aSeries.end( ); iteratorPoint++ )
+    {
+        abscissae.push_back( iteratorPoint->first );
+        values.push_back( iteratorPoint->second );
+    }
+
+    std::vector< double > widths( numberOfSegments );
+    std::vector< double > slopes( numberOfSegments );
+    for ( std::size_t k = 0; k < numberOfSegments; k++ )
+    {
+        widths[ k ] = abscissae[ k + 1 ] - abscissae[ k ];
+        slopes[ k ] = ( values[ k + 1 ] - values[ k ] ) / widths[ k ];
+    }
+
+    coefficients.setZero( 4, static_cast< Eigen::MatrixXd::Index >( numberOfSegments ) );
+    for ( std::size_t k = 0; k < numberOfSegments; k++ )
+    {
+        coefficients( 0, k ) = values[ k ];
+        coefficients( 1, k ) = slopes[ k ];
+    }
+
+    if ( method == cubicSplineSeriesInterpolation && numberOfPoints > 2 )
+    {
+        // Solve tridiagonal system for second derivatives at interior points, with zero second
+        // derivatives at ends (natural spline), using the Thomas algorithm.
+        std::vector< double > secondDerivatives( numberOfPoints, 0.0 );
+        std::vector< double > modifiedUpperDiagonal( numberOfPoints, 0.0 );
+        for ( std::size_t i = 1; i < numberOfSegments; i++ )
+        {
+            const double diagonal = 2.0 * ( widths[ i - 1 ] + widths[ i ] )
+                    - widths[ i - 1 ] * modifiedUpperDiagonal[ i - 1 ];
+            modifiedUpperDiagonal[ i ] = widths[ i ] / diagonal;
+            secondDerivatives[ i ] = ( 6.0 * ( slopes[ i ] - slopes[ i - 1 ] )
+                                       - widths[ i - 1 ] * secondDerivatives[ i - 1 ] ) / diagonal;
+        }
+
+        for ( std::size_t i = numberOfSegments - 1; i > 0; i-- )
+        {
+            secondDerivatives[ i ] -= modifiedUpperDiagonal[ i ] * secondDerivatives[ i + 1 ];
+        }
+
+        for ( std::size_t k = 0; k < numberOfSegments; k++ )
+        {
+            coefficients( 1, k ) = slopes[ k ] - widths[ k ]
+                    * ( 2.0 * secondDerivatives[ k ] + secondDerivatives[ k + 1 ] ) / 6.0;
+            coefficients( 2, k ) = 0.5 * secondDerivatives[ k ];
+            coefficients( 3, k ) = ( secondDerivatives[ k + 1 ] - secondDerivatives[ k ] )
+                    / ( 6.0 * widths[ k ] );
+        }
+    }
+
+    else if ( method == akimaSeriesInterpolation && numberOfPoints > 2 )
+    {
+        // Extend slopes with two extrapolated slopes at each end (Akima, 1970); slope k of the
+        // series is stored at index k + 2.
+        std::vector< double > extendedSlopes( numberOfSegments + 4 );
+        std::copy( slopes.begin( ), slopes.end( ), extendedSlopes.begin( ) + 2 );
+        extendedSlopes[ 1 ] = 2.0 * extendedSlopes[ 2 ] - extendedSlopes[ 3 ];
+        extendedSlopes[ 0 ] = 2.0 * extendedSlopes[ 1 ] - extendedSlopes[ 2 ];
+        extendedSlopes[ numberOfSegments + 2 ] = 2.0 * extendedSlopes[ numberOfSegments + 1 ]
+                - extendedSlopes[ numberOfSegments ];
+        extendedSlopes[ numberOfSegments + 3 ] = 2.0 * extendedSlopes[ numberOfSegments + 2 ]
+                - extendedSlopes[ numberOfSegments + 1 ];
+
+        // Compute derivatives at points, as weighted averages of the slopes of the adjacent
+        // segments, or their mean if the weights vanish.
+        std::vector< double > derivatives( numberOfPoints );
+        for ( std::size_t i = 0; i < numberOfPoints; i++ )
+        {
+            const double* neighbourSlopes = &extendedSlopes[ i ];
+            const double leftWeight = std::fabs( neighbourSlopes[ 3 ] - neighbourSlopes[ 2 ] );
+            const double rightWeight = std::fabs( neighbourSlopes[ 1 ] - neighbourSlopes[ 0 ] );
+
+            derivatives[ i ] = leftWeight + rightWeight > 0.0
+                    ? ( leftWeight * neighbourSlopes[ 1 ] + rightWeight * neighbourSlopes[ 2 ] )
+                      / ( leftWeight + rightWeight )
+                    : 0.5 * ( neighbourSlopes[ 1 ] + neighbourSlopes[ 2 ] );
+        }
+
+        for ( std::size_t k = 0; k < numberOfSegments; k++ )
+        {
+            coefficients( 1, k ) = derivatives[ k ];
+            coefficients( 2, k ) = ( 3.0 * slopes[ k ] - 2.0 * derivatives[ k ]
+                                     - derivatives[ k + 1 ] ) / widths[ k ];
+            coefficients( 3, k ) = ( derivatives[ k ] + derivatives[ k + 1 ] - 2.0 * slopes[ k ] )
+                    / ( widths[ k ] * widths[ k ] );
+        }
+    }
+}
+
+//! Interpolate value at given abscissa.
+double SeriesInterpolator::interpolate( const double abscissa )
+{
+    return evaluateSegment( findSegment( abscissa ), abscissa );
+}
+
+//! Interpolate values at given abscissae.
+void SeriesInterpolator::interpolate( const std::vector< double >& someAbscissae,
+                                      std::vector< double >& someValues ) const
+{
+    someValues.resize( someAbscissae.size( ) );
+
+    const std::size_t lastSegment = abscissae.size( ) - 2;
+    std::size_t segment = 0;
+    for ( std::size_t i = 0; i < someAbscissae.size( ); i++ )
+    {
+        const double abscissa = someAbscissae[ i ];
+        if ( !( abscissa >= abscissae.front( ) && abscissa <= abscissae.back( ) ) )
+        {
+            throwAbscissaOutOfRangeError( );
+        }
+
+        // Walk forward over segments, or search from the start if the abscissa is smaller than
+        // its predecessor.
+        if ( abscissa < abscissae[ segment ] )
+        {
+            segment = std::min( static_cast< std::size_t >(
+                                    std::upper_bound( abscissae.begin( ), abscissae.end( ),
+                                                      abscissa ) - abscissae.begin( ) ) - 1,
+                                lastSegment );
+        }
+
+        while ( segment < lastSegment && abscissae[ segment + 1 ] <= abscissa )
+        {
+            segment++;
+        }
+
+        someValues[ i ] = evaluateSegment( segment, abscissa );
+    }
+}
+
+//! Find segment containing given abscissa, and move cursor to it.
+std::size_t SeriesInterpolator::findSegment( const double abscissa )
+{
+    const std::size_t lastSegment = abscissae.size( ) - 2;
+
+    // Return cursor if abscissa is in current segment, which is the most common case.
+    if ( abscissa >= abscissae[ cursor ] && abscissa <= abscissae[ cursor + 1 ] )
+    {
+        return cursor;
+    }
+
+    if ( !( abscissa >= abscissae.front( ) && abscissa <= abscissae.back( ) ) )
+    {
+        throwAbscissaOutOfRangeError( );
+    }
+
+    // Gallop from cursor, with doubling steps, to bracket the abscissa by abscissae[ low ] <=
+    // abscissa and abscissa < abscissae[ high ] (or high is the last point).
+    std::size_t low = cursor;
+    std::size_t high = cursor + 1;
+    std::size_t step = 1;
+
+    if ( abscissa > abscissae[ cursor ] )
+    {
+        while ( high < lastSegment + 1 && abscissae[ high ] <= abscissa )
+        {
+            low = high;
+            step *= 2;
+            high = std::min( low + step, lastSegment + 1 );
+        }
+    }
+
+    else
+    {
+        high = cursor;
+        low = cursor - 1;
+        while ( abscissae[ low ] > abscissa )
+        {
+            high = low;
+            step *= 2;
+            low = high > step ? high - step : 0;
+        }
+    }
+
+    // Find last point in bracket that does not exceed the abscissa.
+    const std::size_t segment = static_cast< std::size_t >(
+                std::upper_bound( abscissae.begin( ) + low, abscissae.begin( ) + high, abscissa )
+                - abscissae.begin( ) ) - 1;
+
+    cursor = std::min( segment, lastSegment );
+    return cursor;
+}
+
+} // namespace mathematics
+} // namespace assist
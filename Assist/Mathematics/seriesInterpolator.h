@@ -0,0 +1,139 @@
+/*
+ *    Copyright (c) 2010-2014, Delft University of Technology
+ *    Copyright (c) 2010-2014, K. Kumar (me@kartikkumar.com)
+ *    All rights reserved.
+ *    See http://bit.ly/1jern3m for license details.
+ */
+
+#ifndef ASSIST_SERIES_INTERPOLATOR_H
+#define ASSIST_SERIES_INTERPOLATOR_H
+
+#include <cstddef>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "Assist/Basics/commonTypedefs.h"
+
+namespace assist
+{
+namespace mathematics
+{
+
+//! Series interpolation methods.
+enum SeriesInterpolationMethod
+{
+    linearSeriesInterpolation,
+    cubicSplineSeriesInterpolation,
+    akimaSeriesInterpolation
+};
+
+//! Interpolator for series of independent and dependent values.
+/*!
+ * Interpolator for series stored as DoubleKeyDoubleValueMap, i.e., dependent values (values) as a
+ * function of independent values (abscissae). Three methods are available:
+ *  - linear: piecewise-linear interpolation between consecutive points;
+ *  - cubic spline: natural cubic spline, with continuous first and second derivatives, and zero
+ *      second derivatives at the ends of the series;
+ *  - Akima: piecewise-cubic Hermite interpolation, with derivatives at the points computed from
+ *      the slopes of the neighbouring segments (Akima, 1970), which does not overshoot near
+ *      outliers and steps as cubic splines do.
+ * The interpolant in each segment [x_k, x_k+1] is stored as a cubic polynomial
+ * a + b dx + c dx^2 + d dx^3 in dx = x - x_k, with the coefficients of all segments computed once,
+ * on construction, and stored contiguously. Single queries use a cursor that stores the last
+ * segment that was used, so that queries in increasing or decreasing order cost O(1) amortized;
+ * other queries are found by a galloping search from the cursor. Because of the cursor, single
+ * queries should not be made on an interpolator that is shared between threads. Batch queries
+ * do not use the cursor; sorted abscissae are located by a merge-walk over the segments.
+ */
+class SeriesInterpolator
+{
+public:
+
+    //! Constructor taking series and interpolation method.
+    /*!
+     * Constructor taking series and interpolation method. Throws a run-time error if the series
+     * contains fewer than two points.
+     * \param aSeries Series of independent and dependent values.
+     * \param aMethod Interpolation method (default=cubicSplineSeriesInterpolation).
+     */
+    SeriesInterpolator( const basics::DoubleKeyDoubleValueMap& aSeries,
+                        const SeriesInterpolationMethod aMethod = cubicSplineSeriesInterpolation );
+
+    //! Interpolate value at given abscissa.
+    /*!
+     * Interpolates value at a given abscissa, starting the search for its segment from the
+     * cursor. Throws a run-time error if the abscissa is outside the range of the series.
+     * \param abscissa Independent value.
+     * \return Interpolated dependent value.
+     */
+    double interpolate( const double abscissa );
+
+    //! Interpolate values at given abscissae.
+    /*!
+     * Interpolates values at given abscissae, which are preferably sorted in increasing order,
+     * in which case the segments are found by a single merge-walk over the series, at a total
+     * cost of O(N + M) for N points and M abscissae. An abscissa that is smaller than its
+     * predecessor is found by binary search. Throws a run-time error if an abscissa is outside
+     * the range of the series.
+     * \param someAbscissae Independent values.
+     * \param someValues Interpolated dependent values (resized if needed).
+     */
+    void interpolate( const std::vector< double >& someAbscissae,
+                      std::vector< double >& someValues ) const;
+
+    //! Get abscissae of series.
+    /*!
+     * Returns abscissae of series.
+     * \return Independent values.
+     */
+    const std::vector< double >& getAbscissae( ) const { return abscissae; }
+
+protected:
+
+private:
+
+    //! Find segment containing given abscissa, and move cursor to it.
+    /*!
+     * Finds index of segment [x_k, x_k+1] that contains a given abscissa, starting from the
+     * cursor. Throws a run-time error if the abscissa is outside the range of the series.
+     * \param abscissa Independent value.
+     * \return Index of segment.
+     */
+    std::size_t findSegment( const double abscissa );
+
+    //! Evaluate polynomial of given segment.
+    double evaluateSegment( const std::size_t segment, const double abscissa ) const
+    {
+        const double* segmentCoefficients = coefficients.data( ) + 4 * segment;
+        const double offset = abscissa - abscissae[ segment ];
+        return segmentCoefficients[ 0 ] + offset
+                * ( segmentCoefficients[ 1 ] + offset
+                    * ( segmentCoefficients[ 2 ] + offset * segmentCoefficients[ 3 ] ) );
+    }
+
+    //! Interpolation method.
+    const SeriesInterpolationMethod method;
+
+    //! Independent values of series.
+    std::vector< double > abscissae;
+
+    //! Coefficients of cubic polynomials, one column (a, b, c, d) per segment.
+    Eigen::Matrix< double, 4, Eigen::Dynamic > coefficients;
+
+    //! Index of last segment that was used.
+    std::size_t cursor;
+};
+
+} // namespace mathematics
+} // namespace assist
+
+#endif // ASSIST_SERIES_INTERPOLATOR_H
+
+/*
+ *    References
+ *      Akima, H. A new method of interpolation and smooth curve fitting based on local procedures,
+ *          Journal of the ACM 17(4), 589-602, 1970.
+ *      Press, W.H., et al. Numerical Recipes in C++: The Art of Scientific Computing, 2nd edition,
+ *          Cambridge University Press, 2002.
+ */
@@ -0,0 +1,475 @@
+/*
+ *    Copyright (c) 2010-2014, Delft University of Technology
+ *    Copyright (c) 2010-2014, K. Kumar (me@kartikkumar.com)
+ *    All rights reserved.
+ *    See http://bit.ly/1jern3m for license details.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include <boost/exception/all.hpp>
+#include <boost/math/special_functions/fpclassify.hpp>
+
+#include "Assist/Basics/parallelLoop.h"
+#include "Assist/Mathematics/sigmaClipping.h"
+
+namespace assist
+{
+namespace mathematics
+{
+
+namespace
+{
+
+//! Number of values per block, of which statistics are accumulated separately.
+const std::size_t numberOfValuesPerBlock = 4096;
+
+//! Minimum number of blocks per thread.
+const std::size_t minimumNumberOfBlocksPerThread = 16;
+
+//! Minimum number of words of rejection mask per chunk of histogram.
+const std::size_t minimumNumberOfWordsPerChunk = 1024;
+
+//! Number of bins of histograms used to select order statistics.
+const std::size_t numberOfHistogramBins = 4096;
+
+//! Factor to scale MAD to standard deviation of normal distribution, i.e., 1 / Phi^-1( 3 / 4 ).
+const double medianAbsoluteDeviationScaleFactor = 1.482602218505602;
+
+//! Statistics of remaining values of block, with deviations from centre of pass.
+struct BlockStatistics
+{
+    //! Number of values rejected in pass.
+    std::size_t numberOfRejectedValues;
+
+    //! Number of remaining values.
+    std::size_t numberOfValues;
+
+    //! Sum of deviations of remaining values.
+    double sumOfDeviations;
+
+    //! Sum of squared deviations of remaining values.
+    double sumOfSquaredDeviations;
+
+    //! Minimum of remaining values.
+    double minimum;
+
+    //! Maximum of remaining values.
+    double maximum;
+};
+
+//! Loop body to reject values of blocks and compute statistics of remaining values.
+/*!
+ * Loop body to reject values of blocks that deviate from the centre by more than a limit, and
+ * compute statistics of the remaining values. If the limit is not checked, only values that are
+ * not finite are rejected. Each block holds a whole number of words of the rejection mask, so
+ * that blocks can be processed in parallel.
+ */
+struct ClipBlocks
+{
+    //! Clip blocks in range [begin, end).
+    void operator( )( const std::size_t begin, const std::size_t end ) const
+    {
+        for ( std::size_t b = begin; b < end; b++ )
+        {
+            BlockStatistics statistics = { 0, 0, 0.0, 0.0,
+                                           std::numeric_limits< double >::infinity( ),
+                                           -std::numeric_limits< double >::infinity( ) };
+            const std::size_t last
+                    = std::min( numberOfValues, ( b + 1 ) * numberOfValuesPerBlock );
+            for ( std::size_t i = b * numberOfValuesPerBlock; i < last; i++ )
+            {
+                boost::uint64_t& word = rejectionMask[ i / 64 ];
+                const boost::uint64_t bit = static_cast< boost::uint64_t >( 1 ) << ( i % 64 );
+                if ( ( word & bit ) != 0 )
+                {
+                    continue;
+                }
+
+                // Reject value if deviation exceeds limit, or is not a number. Without limit,
+                // reject value if it is not finite, since the deviation of a finite value can
+                // overflow.
+                const double deviation = values[ i ] - centre;
+                if ( isLimitChecked ? !( std::fabs( deviation ) <= limit )
+                                    : !( boost::math::isfinite )( values[ i ] ) )
+                {
+                    word |= bit;
+                    statistics.numberOfRejectedValues++;
+                    continue;
+                }
+
+                statistics.numberOfValues++;
+                statistics.sumOfDeviations += deviation;
+                statistics.sumOfSquaredDeviations += deviation * deviation;
+                statistics.minimum = std::min( statistics.minimum, values[ i ] );
+                statistics.maximum = std::max( statistics.maximum, values[ i ] );
+            }
+
+            blockStatistics[ b ] = statistics;
+        }
+    }
+
+    //! Values.
+    const double* values;
+
+    //! Rejection mask.
+    boost::uint64_t* rejectionMask;
+
+    //! Number of values.
+    std::size_t numberOfValues;
+
+    //! Centre from which deviations are computed.
+    double centre;
+
+    //! Flag that indicates whether the limit is checked.
+    bool isLimitChecked;
+
+    //! Limit of absolute deviations of remaining values.
+    double limit;
+
+    //! Statistics of blocks.
+    BlockStatistics* blockStatistics;
+};
+
+//! Histogram of (transformed) remaining values in range.
+struct Histogram
+{
+    //! Number of values below range.
+    std::size_t numberOfValuesBelow;
+
+    //! Numbers of values in bins.
+    std::vector< std::size_t > counts;
+
+    //! Minima of values in bins.
+    std::vector< double > minimums;
+
+    //! Maxima of values in bins.
+    std::vector< double > maximums;
+};
+
+//! Loop body to compute histograms of (transformed) remaining values of chunks.
+/*!
+ * Loop body to compute histograms of remaining values, or of their absolute deviations from a
+ * centre, in a range [lower, upper], for chunks of the rejection mask.
+ */
+struct ComputeHistograms
+{
+    //! Compute histograms of chunks in range [begin, end).
+    void operator( )( const std::size_t begin, const std::size_t end ) const
+    {
+        const std::size_t numberOfWords = ( numberOfValues + 63 ) / 64;
+        const double width = upper - lower;
+        for ( std::size_t c = begin; c < end; c++ )
+        {
+            Histogram& histogram = histograms[ c ];
+            histogram.numberOfValuesBelow = 0;
+            std::fill( histogram.counts.begin( ), histogram.counts.end( ), 0 );
+            std::fill( histogram.minimums.begin( ), histogram.minimums.end( ),
+                       std::numeric_limits< double >::infinity( ) );
+            std::fill( histogram.maximums.begin( ), histogram.maximums.end( ),
+                       -std::numeric_limits< double >::infinity( ) );
+
+            const std::size_t last = std::min(
+                        numberOfValues, 64 * ( ( c + 1 ) * numberOfWords / numberOfChunks ) );
+            for ( std::size_t i = 64 * ( c * numberOfWords / numberOfChunks ); i < last; i++ )
+            {
+                if ( isRejected( *rejectionMask, i ) )
+                {
+                    continue;
+                }
+
+                const double value = isAbsoluteDeviation ? std::fabs( values[ i ] - centre )
+                                                         : values[ i ];
+                if ( value < lower )
+                {
+                    histogram.numberOfValuesBelow++;
+                    continue;
+                }
+
+                if ( value > upper )
+                {
+                    continue;
+                }
+
+                // The bin is a non-decreasing function of the value, so that values in a bin lie
+                // between its minimum and maximum, and other values lie outside them.
+                const std::size_t bin = std::min(
+                            numberOfHistogramBins - 1,
+                            static_cast< std::size_t >( ( value - lower ) / width
+                                                        * numberOfHistogramBins ) );
+                histogram.counts[ bin ]++;
+                histogram.minimums[ bin ] = std::min( histogram.minimums[ bin ], value );
+                histogram.maximums[ bin ] = std::max( histogram.maximums[ bin ], value );
+            }
+        }
+    }
+
+    //! Values.
+    const double* values;
+
+    //! Rejection mask.
+    const std::vector< boost::uint64_t >* rejectionMask;
+
+    //! Number of values.
+    std::size_t numberOfValues;
+
+    //! Number of chunks.
+    std::size_t numberOfChunks;
+
+    //! Flag that indicates whether absolute deviations from centre are used, instead of values.
+    bool isAbsoluteDeviation;
+
+    //! Centre of absolute deviations.
+    double centre;
+
+    //! Lower bound of range.
+    double lower;
+
+    //! Upper bound of range.
+    double upper;
+
+    //! Histograms of chunks.
+    Histogram* histograms;
+};
+
+//! Reject values and compute statistics of remaining values, in parallel over blocks.
+BlockStatistics clipValues( const Eigen::ArrayXd& values,
+                            std::vector< boost::uint64_t >& rejectionMask, const double centre,
+                            const bool isLimitChecked, const double limit,
+                            std::vector< BlockStatistics >& blockStatistics,
+                            const unsigned int numberOfThreads )
+{
+    const ClipBlocks loopBody = { values.data( ), &rejectionMask[ 0 ],
+                                  static_cast< std::size_t >( values.size( ) ), centre,
+                                  isLimitChecked, limit, &blockStatistics[ 0 ] };
+    basics::executeParallelLoop( blockStatistics.size( ), loopBody, numberOfThreads,
+                                 minimumNumberOfBlocksPerThread );
+
+    // Merge statistics of blocks in order, so that results do not depend on threads.
+    BlockStatistics statistics = blockStatistics[ 0 ];
+    for ( std::size_t b = 1; b < blockStatistics.size( ); b++ )
+    {
+        statistics.numberOfRejectedValues += blockStatistics[ b ].numberOfRejectedValues;
+        statistics.numberOfValues += blockStatistics[ b ].numberOfValues;
+        statistics.sumOfDeviations += blockStatistics[ b ].sumOfDeviations;
+        statistics.sumOfSquaredDeviations += blockStatistics[ b ].sumOfSquaredDeviations;
+        statistics.minimum = std::min( statistics.minimum, blockStatistics[ b ].minimum );
+        statistics.maximum = std::max( statistics.maximum, blockStatistics[ b ].maximum );
+    }
+
+    return statistics;
+}
+
+//! Select order statistics k and k + 1 of (transformed) remaining values.
+/*!
+ * Selects order statistics k and k + 1 of the remaining values, or of their absolute deviations
+ * from a centre, which lie in a range [lower, upper], without copying them: each pass computes a
+ * histogram of the values in the range, after which the range is narrowed to the minimum and
+ * maximum of the bin that holds order statistic k, until that bin holds a single distinct value.
+ * Order statistic k + 1 is infinite if k + 1 is not smaller than the number of remaining values.
+ */
+void selectOrderStatistics( const Eigen::ArrayXd& values,
+                            const std::vector< boost::uint64_t >& rejectionMask,
+                            const bool isAbsoluteDeviation, const double centre,
+                            const std::size_t k, double lower, double upper,
+                            const unsigned int numberOfThreads,
+                            double& orderStatistic, double& nextOrderStatistic )
+{
+    if ( lower == upper )
+    {
+        orderStatistic = lower;
+        nextOrderStatistic = lower;
+        return;
+    }
+
+    // Set up histograms of chunks, of which the number does not depend on threads, since chunks
+    // are merged exactly.
+    const std::size_t numberOfChunks = std::max< std::size_t >(
+                1, std::min< std::size_t >( basics::getNumberOfThreads( numberOfThreads ),
+                                            rejectionMask.size( )
+                                            / minimumNumberOfWordsPerChunk ) );
+    Histogram emptyHistogram = { 0, std::vector< std::size_t >( numberOfHistogramBins ),
+                                 std::vector< double >( numberOfHistogramBins ),
+                                 std::vector< double >( numberOfHistogramBins ) };
+    std::vector< Histogram > histograms( numberOfChunks, emptyHistogram );
+    Histogram& histogram = histograms[ 0 ];
+
+    double minimumAboveRange = std::numeric_limits< double >::infinity( );
+    while ( true )
+    {
+        const ComputeHistograms loopBody = { values.data( ), &rejectionMask,
+                                             static_cast< std::size_t >( values.size( ) ),
+                                             numberOfChunks, isAbsoluteDeviation, centre, lower,
+                                             upper, &histograms[ 0 ] };
+        basics::executeParallelLoop( numberOfChunks, loopBody, numberOfThreads, 1 );
+
+        for ( std::size_t c = 1; c < numberOfChunks; c++ )
+        {
+            histogram.numberOfValuesBelow += histograms[ c ].numberOfValuesBelow;
+            for ( std::size_t j = 0; j < numberOfHistogramBins; j++ )
+            {
+                histogram.counts[ j ] += histograms[ c ].counts[ j ];
+                histogram.minimums[ j ] = std::min( histogram.minimums[ j ],
+                                                    histograms[ c ].minimums[ j ] );
+                histogram.maximums[ j ] = std::max( histogram.maximums[ j ],
+                                                    histograms[ c ].maximums[ j ] );
+            }
+        }
+
+        // Find bin that holds order statistic k, and smallest value above it.
+        std::size_t numberOfValuesBelowBin = histogram.numberOfValuesBelow;
+        std::size_t bin = 0;
+        while ( numberOfValuesBelowBin + histogram.counts[ bin ] <= k )
+        {
+            numberOfValuesBelowBin += histogram.counts[ bin ];
+            bin++;
+        }
+
+        std::size_t nextBin = bin + 1;
+        while ( nextBin < numberOfHistogramBins && histogram.counts[ nextBin ] == 0 )
+        {
+            nextBin++;
+        }
+
+        if ( nextBin < numberOfHistogramBins )
+        {
+            minimumAboveRange = histogram.minimums[ nextBin ];
+        }
+
+        if ( histogram.minimums[ bin ] == histogram.maximums[ bin ] )
+        {
+            orderStatistic = histogram.minimums[ bin ];
+            nextOrderStatistic = numberOfValuesBelowBin + histogram.counts[ bin ] > k + 1
+                    ? orderStatistic : minimumAboveRange;
+            return;
+        }
+
+        lower = histogram.minimums[ bin ];
+        upper = histogram.maximums[ bin ];
+    }
+}
+
+//! Compute median of (transformed) remaining values.
+double computeMedian( const Eigen::ArrayXd& values,
+                      const std::vector< boost::uint64_t >& rejectionMask,
+                      const bool isAbsoluteDeviation, const double centre,
+                      const std::size_t numberOfValues, const double lower, const double upper,
+                      const unsigned int numberOfThreads )
+{
+    double orderStatistic = 0.0;
+    double nextOrderStatistic = 0.0;
+    selectOrderStatistics( values, rejectionMask, isAbsoluteDeviation, centre,
+                           ( numberOfValues - 1 ) / 2, lower, upper, numberOfThreads,
+                           orderStatistic, nextOrderStatistic );
+
+    return numberOfValues % 2 == 1 ? orderStatistic
+                                   : 0.5 * ( orderStatistic + nextOrderStatistic );
+}
+
+//! Compute centre and standard deviation of remaining values.
+void computeStatistics( const Eigen::ArrayXd& values,
+                        const std::vector< boost::uint64_t >& rejectionMask,
+                        const SigmaClippingMethod method, const BlockStatistics& statistics,
+                        const double shift, const unsigned int numberOfThreads, double& centre,
+                        double& standardDeviation )
+{
+    const double numberOfValues = static_cast< double >( statistics.numberOfValues );
+    if ( method == meanSigmaClipping )
+    {
+        // Use deviations from shift, which is close to the mean, to avoid cancellation.
+        const double meanDeviation = statistics.sumOfDeviations / numberOfValues;
+        centre = shift + meanDeviation;
+        standardDeviation = std::sqrt(
+                    std::max( 0.0, statistics.sumOfSquaredDeviations / numberOfValues
+                              - meanDeviation * meanDeviation ) );
+        return;
+    }
+
+    centre = computeMedian( values, rejectionMask, false, 0.0, statistics.numberOfValues,
+                            statistics.minimum, statistics.maximum, numberOfThreads );
+    standardDeviation = medianAbsoluteDeviationScaleFactor
+            * computeMedian( values, rejectionMask, true, centre, statistics.numberOfValues, 0.0,
+                             std::max( std::fabs( statistics.minimum - centre ),
+                                       std::fabs( statistics.maximum - centre ) ),
+                             numberOfThreads );
+}
+
+} // namespace
+
+//! Clip outliers of values.
+std::size_t clipOutliers( const Eigen::ArrayXd& values, const double numberOfStandardDeviations,
+                          std::vector< boost::uint64_t >& rejectionMask, double& centre,
+                          double& standardDeviation, const SigmaClippingMethod method,
+                          const unsigned int maximumNumberOfIterations,
+                          const unsigned int numberOfThreads )
+{
+    if ( !( numberOfStandardDeviations > 0.0 ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Error: number of standard deviations must be positive." ) ) );
+    }
+
+    // Find first finite value.
+    const std::size_t numberOfValues = static_cast< std::size_t >( values.size( ) );
+    std::size_t firstFiniteValue = 0;
+    while ( firstFiniteValue < numberOfValues
+            && !( boost::math::isfinite )( values( firstFiniteValue ) ) )
+    {
+        firstFiniteValue++;
+    }
+
+    if ( firstFiniteValue == numberOfValues )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Error: none of the values is finite." ) ) );
+    }
+
+    rejectionMask.assign( ( numberOfValues + 63 ) / 64, 0 );
+    std::vector< BlockStatistics > blockStatistics(
+                ( numberOfValues + numberOfValuesPerBlock - 1 ) / numberOfValuesPerBlock );
+
+    // Reject values that are not finite, with deviations from first finite value.
+    double shift = values( firstFiniteValue );
+    BlockStatistics statistics = clipValues( values, rejectionMask, shift, false, 0.0,
+                                             blockStatistics, numberOfThreads );
+    std::size_t numberOfRejectedValues = statistics.numberOfRejectedValues;
+    computeStatistics( values, rejectionMask, method, statistics, shift, numberOfThreads, centre,
+                       standardDeviation );
+
+    // Clip values until no values are rejected; statistics of the mean are accumulated in the
+    // same pass, with deviations from the previous mean.
+    for ( unsigned int iteration = 0; iteration < maximumNumberOfIterations; iteration++ )
+    {
+        shift = centre;
+        statistics = clipValues( values, rejectionMask, shift, true,
+                                 numberOfStandardDeviations * standardDeviation, blockStatistics,
+                                 numberOfThreads );
+        if ( statistics.numberOfRejectedValues == 0 )
+        {
+            break;
+        }
+
+        // Stop if no values remain, for which the statistics are undefined.
+        if ( statistics.numberOfValues == 0 )
+        {
+            boost::throw_exception(
+                        boost::enable_error_info(
+                            std::runtime_error( "Error: all values rejected." ) ) );
+        }
+
+        numberOfRejectedValues += statistics.numberOfRejectedValues;
+        computeStatistics( values, rejectionMask, method, statistics, shift, numberOfThreads,
+                           centre, standardDeviation );
+    }
+
+    return numberOfRejectedValues;
+}
+
+} // namespace mathematics
+} // namespace assist
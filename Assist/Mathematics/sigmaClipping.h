@@ -0,0 +1,92 @@
+/*
+ *    Copyright (c) 2010-2014, Delft University of Technology
+ *    Copyright (c) 2010-2014, K. Kumar (me@kartikkumar.com)
+ *    All rights reserved.
+ *    See http://bit.ly/1jern3m for license details.
+ */
+
+#ifndef ASSIST_SIGMA_CLIPPING_H
+#define ASSIST_SIGMA_CLIPPING_H
+
+#include <cstddef>
+#include <vector>
+
+#include <boost/cstdint.hpp>
+
+#include <Eigen/Core>
+
+namespace assist
+{
+namespace mathematics
+{
+
+//! Sigma-clipping methods, which set the statistics used as centre and standard deviation.
+enum SigmaClippingMethod
+{
+    medianSigmaClipping,
+    meanSigmaClipping
+};
+
+//! Check if value is rejected in rejection mask.
+/*!
+ * Checks if value is rejected in rejection mask, which stores one bit per value: bit i % 64 of
+ * word i / 64 is set if value i is rejected.
+ * \param rejectionMask Rejection mask.
+ * \param index Index of value.
+ * \return Flag that indicates whether value is rejected.
+ */
+inline bool isRejected( const std::vector< boost::uint64_t >& rejectionMask,
+                        const std::size_t index )
+{
+    return ( ( rejectionMask[ index / 64 ] >> ( index % 64 ) ) & 1 ) != 0;
+}
+
+//! Clip outliers of values.
+/*!
+ * Clips outliers of values with iterative sigma clipping: each iteration rejects the remaining
+ * values that deviate from the centre by more than a given number of standard deviations, after
+ * which the centre and standard deviation are recomputed from the remaining values, until no
+ * values are rejected or the maximum number of iterations is reached. Values that are not finite
+ * are rejected beforehand. For a threshold given as FWHM, the number of standard deviations
+ * follows from convertFullWidthHalfMaximumToStandardDeviation(). The statistics depend on the
+ * method:
+ *  - medianSigmaClipping: median, and median absolute deviation (MAD) scaled by 1.4826 to the
+ *      standard deviation of a normal distribution (robust against the outliers themselves);
+ *  - meanSigmaClipping: mean and standard deviation.
+ * Rejected values are marked in a rejection mask (see isRejected()), instead of copying the
+ * remaining values, so that the memory overhead is one bit per value. Each iteration scans the
+ * values in parallel: the mean and standard deviation are accumulated in the same pass in which
+ * values are rejected, so that an iteration costs one pass, and the median and MAD are selected
+ * exactly with histograms of the remaining values over a narrowing range, which typically costs
+ * two to three passes per statistic. The results are the same for any number of threads.
+ * Throws a run-time error if the number of standard deviations is not positive, if none of the
+ * values is finite, or if an iteration rejects all remaining values (e.g., for a threshold well
+ * below one standard deviation).
+ * \param values Values.
+ * \param numberOfStandardDeviations Clipping threshold, in standard deviations.
+ * \param rejectionMask Rejection mask, with one bit per value (resized if needed).
+ * \param centre Centre of remaining values (median or mean).
+ * \param standardDeviation Standard deviation of remaining values (scaled MAD or standard
+ *          deviation).
+ * \param method Sigma-clipping method (default=medianSigmaClipping).
+ * \param maximumNumberOfIterations Maximum number of clipping iterations (default=10).
+ * \param numberOfThreads Number of threads to use (0 = number of hardware threads; default=1).
+ * \return Number of rejected values.
+ */
+std::size_t clipOutliers( const Eigen::ArrayXd& values, const double numberOfStandardDeviations,
+                          std::vector< boost::uint64_t >& rejectionMask, double& centre,
+                          double& standardDeviation,
+                          const SigmaClippingMethod method = medianSigmaClipping,
+                          const unsigned int maximumNumberOfIterations = 10,
+                          const unsigned int numberOfThreads = 1 );
+
+} // namespace mathematics
+} // namespace assist
+
+#endif // ASSIST_SIGMA_CLIPPING_H
+
+/*
+ *    References
+ *      Rousseeuw, P.J., Croux, C. Alternatives to the median absolute deviation, Journal of the
+ *          American Statistical Association 88(424), 1273-1283, 1993.
+ */
@@ -0,0 +1,246 @@
+/*
+ *    Copyright (c) 2010-2014, Delft University of Technology
+ *    Copyright (c) 2010-2014, K. Kumar (me@kartikkumar.com)
+ *    All rights reserved.
+ *    See http://bit.ly/1jern3m for license details.
+ */
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <boost/exception/all.hpp>
+
+#include "Assist/Mathematics/stateHistoryInterpolator.h"
+
+namespace assist
+{
+namespace mathematics
+{
+
+namespace
+{
+
+//! Compute index of first epoch in window used for Lagrange interpolation in given segment.
+inline std::size_t computeLagrangeWindowStart( const std::size_t segment,
+                                               const std::size_t numberOfLagrangeEpochs,
+                                               const std::size_t numberOfEpochs )
+{
+    const std::size_t halfWindow = numberOfLagrangeEpochs / 2;
+    const std::size_t windowStart = segment + 1 >= halfWindow ? segment + 1 - halfWindow : 0;
+    return std::min( windowStart, numberOfEpochs - numberOfLagrangeEpochs );
+}
+
+} // namespace
+
+//! Constructor taking state history and interpolation method.
+StateHistoryInterpolator::StateHistoryInterpolator(
+        const basics::DoubleKeyVector6dValueMap& aStateHistory,
+        const StateInterpolationMethod aMethod, const std::size_t aNumberOfLagrangeEpochs )
+    : method( aMethod ),
+      numberOfLagrangeEpochs( aNumberOfLagrangeEpochs ),
+      cursor( 0 )
+{
+    if ( aStateHistory.size( ) < 2 )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Error: state history contains fewer than two "
+                                            "states." ) ) );
+    }
+
+    if ( method == lagrangeStateInterpolation
+         && ( numberOfLagrangeEpochs < 2 || numberOfLagrangeEpochs > aStateHistory.size( ) ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Error: number of epochs for Lagrange interpolation "
+                                            "is less than two or exceeds number of states." ) ) );
+    }
+
+    // Copy state history to contiguous storage.
+    const std::size_t numberOfEpochs = aStateHistory.size( );
+    const std::size_t numberOfSegments = numberOfEpochs - 1;
+
+    epochs.reserve( numberOfEpochs );
+    states.resize( 6, static_cast< Eigen::MatrixXd::Index >( numberOfEpochs ) );
+    for ( basics::DoubleKeyVector6dValueMap::const_iterator iteratorState = aStateHistory.begin( );
+          iteratorState != aStateHistory.end( ); iteratorState++ )
+    {
+        states.col( epochs.size( ) ) = iteratorState->second;
+        epochs.push_back( iteratorState->first );
+    }
+
+    inverseSegmentDurations.resize( numberOfSegments );
+    for ( std::size_t k = 0; k < numberOfSegments; k++ )
+    {
+        inverseSegmentDurations[ k ] = 1.0 / ( epochs[ k + 1 ] - epochs[ k ] );
+    }
+
+    if ( method == hermiteStateInterpolation )
+    {
+        // Compute coefficients of cubic Hermite polynomials in normalized time, for which the
+        // velocities are scaled by the duration of the segment.
+        hermiteCoefficients.resize( 12, static_cast< Eigen::MatrixXd::Index >( numberOfSegments ) );
+        for ( std::size_t k = 0; k < numberOfSegments; k++ )
+        {
+            const double duration = epochs[ k + 1 ] - epochs[ k ];
+            const Eigen::Vector3d startPosition = states.block< 3, 1 >( 0, k );
+            const Eigen::Vector3d endPosition = states.block< 3, 1 >( 0, k + 1 );
+            const Eigen::Vector3d startVelocity = duration * states.block< 3, 1 >( 3, k );
+            const Eigen::Vector3d endVelocity = duration * states.block< 3, 1 >( 3, k + 1 );
+
+            hermiteCoefficients.block< 3, 1 >( 0, k ) = startPosition;
+            hermiteCoefficients.block< 3, 1 >( 3, k ) = startVelocity;
+            hermiteCoefficients.block< 3, 1 >( 6, k )
+                    = 3.0 * ( endPosition - startPosition ) - 2.0 * startVelocity - endVelocity;
+            hermiteCoefficients.block< 3, 1 >( 9, k )
+                    = 2.0 * ( startPosition - endPosition ) + startVelocity + endVelocity;
+        }
+    }
+
+    else
+    {
+        // Compute barycentric weights of window of each segment.
+        lagrangeWeights.resize( static_cast< Eigen::MatrixXd::Index >( numberOfLagrangeEpochs ),
+                                static_cast< Eigen::MatrixXd::Index >( numberOfSegments ) );
+        for ( std::size_t k = 0; k < numberOfSegments; k++ )
+        {
+            const std::size_t windowStart
+                    = computeLagrangeWindowStart( k, numberOfLagrangeEpochs, numberOfEpochs );
+
+            for ( std::size_t j = 0; j < numberOfLagrangeEpochs; j++ )
+            {
+                double product = 1.0;
+                for ( std::size_t m = 0; m < numberOfLagrangeEpochs; m++ )
+                {
+                    if ( m != j )
+                    {
+                        product *= ( epochs[ windowStart + j ] - epochs[ windowStart + m ] )
+                                * inverseSegmentDurations[ k ];
+                    }
+                }
+
+                lagrangeWeights( j, k ) = 1.0 / product;
+            }
+        }
+    }
+}
+
+//! Interpolate states at given epochs.
+void StateHistoryInterpolator::interpolate( const std::vector< double >& someEpochs,
+                                            Eigen::MatrixXd& someStates )
+{
+    someStates.resize( static_cast< Eigen::MatrixXd::Index >( someEpochs.size( ) ), 6 );
+
+    if ( method == hermiteStateInterpolation )
+    {
+        // Write states directly into the rows of the (column-major) matrix.
+        const Eigen::Index stride = someStates.rows( );
+        for ( std::size_t i = 0; i < someEpochs.size( ); i++ )
+        {
+            evaluateHermite( findSegment( someEpochs[ i ] ), someEpochs[ i ],
+                             someStates.data( ) + i, stride );
+        }
+    }
+
+    else
+    {
+        for ( std::size_t i = 0; i < someEpochs.size( ); i++ )
+        {
+            someStates.row( i )
+                    = interpolateLagrange( findSegment( someEpochs[ i ] ), someEpochs[ i ] );
+        }
+    }
+}
+
+//! Find segment containing given epoch, and move cursor to it.
+std::size_t StateHistoryInterpolator::findSegment( const double epoch )
+{
+    const std::size_t lastSegment = epochs.size( ) - 2;
+
+    // Return cursor if epoch is in current segment, which is the most common case, or move it
+    // to the next segment, which is the next most common case for a sequential sweep.
+    if ( epoch >= epochs[ cursor ] && epoch <= epochs[ cursor + 1 ] )
+    {
+        return cursor;
+    }
+
+    if ( epoch > epochs[ cursor + 1 ] && cursor < lastSegment && epoch <= epochs[ cursor + 2 ] )
+    {
+        return ++cursor;
+    }
+
+    if ( !( epoch >= epochs.front( ) && epoch <= epochs.back( ) ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Error: epoch is outside range of state "
+                                            "history." ) ) );
+    }
+
+    // Gallop from cursor, with doubling steps, to bracket the epoch by epochs[ low ] <= epoch and
+    // epoch < epochs[ high ] (or high is the last epoch).
+    std::size_t low = cursor;
+    std::size_t high = cursor + 1;
+    std::size_t step = 1;
+
+    if ( epoch > epochs[ cursor ] )
+    {
+        while ( high < lastSegment + 1 && epochs[ high ] <= epoch )
+        {
+            low = high;
+            step *= 2;
+            high = std::min( low + step, lastSegment + 1 );
+        }
+    }
+
+    else
+    {
+        high = cursor;
+        low = cursor - 1;
+        while ( epochs[ low ] > epoch )
+        {
+            high = low;
+            step *= 2;
+            low = high > step ? high - step : 0;
+        }
+    }
+
+    // Find last epoch in bracket that does not exceed the epoch.
+    const std::size_t segment = static_cast< std::size_t >(
+                std::upper_bound( epochs.begin( ) + low, epochs.begin( ) + high, epoch )
+                - epochs.begin( ) ) - 1;
+
+    cursor = std::min( segment, lastSegment );
+    return cursor;
+}
+
+//! Interpolate state in given segment using Lagrange interpolation.
+tudat::basic_mathematics::Vector6d StateHistoryInterpolator::interpolateLagrange(
+        const std::size_t segment, const double epoch ) const
+{
+    const std::size_t windowStart
+            = computeLagrangeWindowStart( segment, numberOfLagrangeEpochs, epochs.size( ) );
+
+    // Evaluate barycentric formula (Berrut and Trefethen, 2004), in normalized time.
+    tudat::basic_mathematics::Vector6d numerator = tudat::basic_mathematics::Vector6d::Zero( );
+    double denominator = 0.0;
+    for ( std::size_t j = 0; j < numberOfLagrangeEpochs; j++ )
+    {
+        const double difference = ( epoch - epochs[ windowStart + j ] )
+                * inverseSegmentDurations[ segment ];
+        if ( difference == 0.0 )
+        {
+            return states.col( windowStart + j );
+        }
+
+        const double factor = lagrangeWeights( j, segment ) / difference;
+        numerator += factor * states.col( windowStart + j );
+        denominator += factor;
+    }
+
+    return numerator / denominator;
+}
+
+} // namespace mathematics
+} // namespace assist
@@ -0,0 +1,321 @@
+/*
+ *    Copyright (c) 2010-2014, Delft University of Technology
+ *    Copyright (c) 2010-2014, K. Kumar (me@kartikkumar.com)
+ *    All rights reserved.
+ *    See http://bit.ly/1jern3m for license details.
+ */
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#include <boost/exception/all.hpp>
+
+#include "Assist/Mathematics/stepFunctionExpression.h"
+
+namespace assist
+{
+namespace mathematics
+{
+
+//! Sweep over keys of inputs.
+/*!
+ * Sweep over the union of the keys of the inputs of an expression, in increasing order. The
+ * inputs are merged with a binary heap of their next keys, so that advancing to the next key
+ * costs O(log K) for K inputs, plus O(log K) per input that has a key there.
+ */
+class StepFunctionExpression::Sweep
+{
+public:
+
+    //! Constructor taking inputs and abscissa at which to start.
+    Sweep( const std::vector< const basics::DoubleKeyDoubleValueMap* >& someInputs,
+           const double abscissa )
+        : inputValues( someInputs.size( ) ),
+          nextPoints( someInputs.size( ) )
+    {
+        ends.reserve( someInputs.size( ) );
+        heap.reserve( someInputs.size( ) );
+        for ( std::size_t i = 0; i < someInputs.size( ); i++ )
+        {
+            // Find first key after abscissa; the value at the abscissa is that of the previous
+            // key, or the first value if there is no previous key.
+            nextPoints[ i ] = someInputs[ i ]->upper_bound( abscissa );
+            ends.push_back( someInputs[ i ]->end( ) );
+            basics::DoubleKeyDoubleValueMap::const_iterator currentPoint = nextPoints[ i ];
+            if ( currentPoint != someInputs[ i ]->begin( ) )
+            {
+                currentPoint--;
+            }
+
+            inputValues[ i ] = currentPoint->second;
+
+            if ( nextPoints[ i ] != someInputs[ i ]->end( ) )
+            {
+                heap.push_back( std::make_pair( nextPoints[ i ]->first, i ) );
+            }
+        }
+
+        std::make_heap( heap.begin( ), heap.end( ), std::greater< HeapEntry >( ) );
+    }
+
+    //! Get next key of inputs, or infinity if there is none.
+    double getNextKey( ) const
+    {
+        return heap.empty( ) ? std::numeric_limits< double >::infinity( ) : heap.front( ).first;
+    }
+
+    //! Advance to next key, updating values of all inputs with that key.
+    void advance( )
+    {
+        const double key = heap.front( ).first;
+        while ( !heap.empty( ) && heap.front( ).first == key )
+        {
+            std::pop_heap( heap.begin( ), heap.end( ), std::greater< HeapEntry >( ) );
+            const std::size_t i = heap.back( ).second;
+            heap.pop_back( );
+
+            inputValues[ i ] = nextPoints[ i ]->second;
+            nextPoints[ i ]++;
+            if ( nextPoints[ i ] != ends[ i ] )
+            {
+                heap.push_back( std::make_pair( nextPoints[ i ]->first, i ) );
+                std::push_heap( heap.begin( ), heap.end( ), std::greater< HeapEntry >( ) );
+            }
+        }
+    }
+
+    //! Get current values of inputs.
+    const std::vector< double >& getInputValues( ) const { return inputValues; }
+
+protected:
+
+private:
+
+    //! Entry of heap, with next key and index of input.
+    typedef std::pair< double, std::size_t > HeapEntry;
+
+    //! Current values of inputs.
+    std::vector< double > inputValues;
+
+    //! Next points of inputs.
+    std::vector< basics::DoubleKeyDoubleValueMap::const_iterator > nextPoints;
+
+    //! Ends of inputs.
+    std::vector< basics::DoubleKeyDoubleValueMap::const_iterator > ends;
+
+    //! Min-heap of next keys of inputs.
+    std::vector< HeapEntry > heap;
+};
+
+//! Constructor taking step function.
+StepFunctionExpression::StepFunctionExpression(
+        const basics::DoubleKeyDoubleValueMap& aStepFunction )
+{
+    if ( aStepFunction.empty( ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Error: step function is empty." ) ) );
+    }
+
+    const Instruction instruction = { inputOperation, 0, 0.0 };
+    instructions.push_back( instruction );
+    inputs.push_back( &aStepFunction );
+}
+
+//! Constructor taking constant.
+StepFunctionExpression::StepFunctionExpression( const double aConstant )
+{
+    const Instruction instruction = { constantOperation, 0, aConstant };
+    instructions.push_back( instruction );
+}
+
+//! Evaluate expression at given abscissa.
+double StepFunctionExpression::evaluate( const double abscissa ) const
+{
+    const Sweep sweep( inputs, abscissa );
+    std::vector< double > stack( instructions.size( ) );
+    return evaluateInstructions( sweep.getInputValues( ), stack );
+}
+
+//! Compute average of expression over window.
+double StepFunctionExpression::computeWindowAverage( const double lowerBound,
+                                                     const double upperBound ) const
+{
+    if ( !( upperBound > lowerBound ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Error: upper bound of window must be larger than lower bound." ) ) );
+    }
+
+    Sweep sweep( inputs, lowerBound );
+    std::vector< double > stack( instructions.size( ) );
+
+    // Integrate expression over steps in window.
+    double abscissa = lowerBound;
+    double value = evaluateInstructions( sweep.getInputValues( ), stack );
+    double integral = 0.0;
+    while ( sweep.getNextKey( ) < upperBound )
+    {
+        const double nextKey = sweep.getNextKey( );
+        integral += value * ( nextKey - abscissa );
+
+        abscissa = nextKey;
+        sweep.advance( );
+        value = evaluateInstructions( sweep.getInputValues( ), stack );
+    }
+
+    integral += value * ( upperBound - abscissa );
+    return integral / ( upperBound - lowerBound );
+}
+
+//! Compute step function of expression.
+basics::DoubleKeyDoubleValueMap StepFunctionExpression::computeStepFunction( ) const
+{
+    if ( inputs.empty( ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Error: expression has no step-function inputs." ) ) );
+    }
+
+    // Start sweep at first key of inputs.
+    double firstKey = inputs[ 0 ]->begin( )->first;
+    for ( std::size_t i = 1; i < inputs.size( ); i++ )
+    {
+        firstKey = std::min( firstKey, inputs[ i ]->begin( )->first );
+    }
+
+    Sweep sweep( inputs, firstKey );
+    std::vector< double > stack( instructions.size( ) );
+
+    basics::DoubleKeyDoubleValueMap stepFunction;
+    double value = evaluateInstructions( sweep.getInputValues( ), stack );
+    stepFunction.insert( stepFunction.end( ), std::make_pair( firstKey, value ) );
+
+    // Add keys at which value changes.
+    while ( sweep.getNextKey( ) < std::numeric_limits< double >::infinity( ) )
+    {
+        const double key = sweep.getNextKey( );
+        sweep.advance( );
+
+        const double nextValue = evaluateInstructions( sweep.getInputValues( ), stack );
+        if ( nextValue != value )
+        {
+            stepFunction.insert( stepFunction.end( ), std::make_pair( key, nextValue ) );
+            value = nextValue;
+        }
+    }
+
+    return stepFunction;
+}
+
+//! Append other expression and binary operation, combining both expressions.
+void StepFunctionExpression::appendOperation( const StepFunctionExpression& otherExpression,
+                                              const Operation operation )
+{
+    // Copy other expression first, since it may be this expression.
+    const std::vector< Instruction > otherInstructions = otherExpression.instructions;
+    const std::vector< const basics::DoubleKeyDoubleValueMap* > otherInputs
+            = otherExpression.inputs;
+
+    const std::size_t inputOffset = inputs.size( );
+    for ( std::size_t i = 0; i < otherInstructions.size( ); i++ )
+    {
+        instructions.push_back( otherInstructions[ i ] );
+        if ( otherInstructions[ i ].operation == inputOperation )
+        {
+            instructions.back( ).inputIndex += inputOffset;
+        }
+    }
+
+    inputs.insert( inputs.end( ), otherInputs.begin( ), otherInputs.end( ) );
+
+    const Instruction instruction = { operation, 0, 0.0 };
+    instructions.push_back( instruction );
+}
+
+//! Evaluate expression for given values of inputs.
+double StepFunctionExpression::evaluateInstructions( const std::vector< double >& inputValues,
+                                                     std::vector< double >& stack ) const
+{
+    // Execute instructions with stack of intermediate values, of which size is the number of
+    // values on the stack.
+    std::size_t size = 0;
+    for ( std::size_t i = 0; i < instructions.size( ); i++ )
+    {
+        const Instruction& instruction = instructions[ i ];
+        if ( instruction.operation == inputOperation )
+        {
+            stack[ size++ ] = inputValues[ instruction.inputIndex ];
+            continue;
+        }
+
+        if ( instruction.operation == constantOperation )
+        {
+            stack[ size++ ] = instruction.constant;
+            continue;
+        }
+
+        // Apply binary operation to top two values.
+        size--;
+        const double secondValue = stack[ size ];
+        double& firstValue = stack[ size - 1 ];
+        switch ( instruction.operation )
+        {
+        case addOperation:
+            firstValue += secondValue;
+            break;
+
+        case subtractOperation:
+            firstValue -= secondValue;
+            break;
+
+        case multiplyOperation:
+            firstValue *= secondValue;
+            break;
+
+        case divideOperation:
+            firstValue /= secondValue;
+            break;
+
+        case minimumOperation:
+            firstValue = std::min( firstValue, secondValue );
+            break;
+
+        case maximumOperation:
+            firstValue = std::max( firstValue, secondValue );
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    return stack[ 0 ];
+}
+
+//! Compute pointwise minimum of expressions.
+StepFunctionExpression pointwiseMinimum( StepFunctionExpression firstExpression,
+                                         const StepFunctionExpression& secondExpression )
+{
+    firstExpression.appendOperation( secondExpression, StepFunctionExpression::minimumOperation );
+    return firstExpression;
+}
+
+//! Compute pointwise maximum of expressions.
+StepFunctionExpression pointwiseMaximum( StepFunctionExpression firstExpression,
+                                         const StepFunctionExpression& secondExpression )
+{
+    firstExpression.appendOperation( secondExpression, StepFunctionExpression::maximumOperation );
+    return firstExpression;
+}
+
+} // namespace mathematics
+} // namespace assist
@@ -0,0 +1,271 @@
+/*
+ *    Copyright (c) 2010-2014, Delft University of Technology
+ *    Copyright (c) 2010-2014, K. Kumar (me@kartikkumar.com)
+ *    All rights reserved.
+ *    See http://bit.ly/1jern3m for license details.
+ */
+
+#ifndef ASSIST_STEP_FUNCTION_EXPRESSION_H
+#define ASSIST_STEP_FUNCTION_EXPRESSION_H
+
+#include <cstddef>
+#include <vector>
+
+#include "Assist/Basics/commonTypedefs.h"
+
+namespace assist
+{
+namespace mathematics
+{
+
+//! Lazy expression over step functions.
+/*!
+ * Expression over step functions stored as DoubleKeyDoubleValueMap, built with the arithmetic
+ * operators, pointwiseMinimum() and pointwiseMaximum(), e.g., pointwiseMinimum( power1 + power2,
+ * limit ) * dutyCycle. As for computeStepFunctionWindowAverage(), the value of a step function at
+ * key k_i holds on [k_i, k_i+1), the first value holds before the first key, and the last value
+ * holds after the last key. Building an expression does not evaluate it: the expression tree is
+ * stored in postfix order, with references to its input step functions, which must outlive the
+ * expression. The expression is evaluated by a single sweep over the union of the keys of its
+ * inputs, in which the inputs are merged with a heap ordered by their next keys, and the value of
+ * the expression is updated at each key, with a stack that holds the intermediate values; no
+ * intermediate step functions are stored. The expression can be evaluated at a single abscissa,
+ * averaged over a window, or stored as a step function.
+ */
+class StepFunctionExpression
+{
+public:
+
+    //! Constructor taking step function.
+    /*!
+     * Constructor taking step function, which is stored by reference. Throws a run-time error if
+     * the step function is empty.
+     * \param aStepFunction Step function, as keys and values.
+     */
+    explicit StepFunctionExpression( const basics::DoubleKeyDoubleValueMap& aStepFunction );
+
+    //! Constructor taking constant.
+    /*!
+     * Constructor taking constant, i.e., a step function without keys.
+     * \param aConstant Constant value.
+     */
+    explicit StepFunctionExpression( const double aConstant );
+
+    //! Add expression to this expression.
+    StepFunctionExpression& operator+=( const StepFunctionExpression& otherExpression )
+    {
+        appendOperation( otherExpression, addOperation );
+        return *this;
+    }
+
+    //! Subtract expression from this expression.
+    StepFunctionExpression& operator-=( const StepFunctionExpression& otherExpression )
+    {
+        appendOperation( otherExpression, subtractOperation );
+        return *this;
+    }
+
+    //! Multiply this expression by expression.
+    StepFunctionExpression& operator*=( const StepFunctionExpression& otherExpression )
+    {
+        appendOperation( otherExpression, multiplyOperation );
+        return *this;
+    }
+
+    //! Divide this expression by expression.
+    StepFunctionExpression& operator/=( const StepFunctionExpression& otherExpression )
+    {
+        appendOperation( otherExpression, divideOperation );
+        return *this;
+    }
+
+    //! Evaluate expression at given abscissa.
+    /*!
+     * Evaluates expression at a given abscissa, with a binary search in each input.
+     * \param abscissa Independent value.
+     * \return Value of expression.
+     */
+    double evaluate( const double abscissa ) const;
+
+    //! Compute average of expression over window.
+    /*!
+     * Computes average of expression over window [lowerBound, upperBound], in a single sweep
+     * over the keys of the inputs in the window, which gives the same result as
+     * computeStepFunctionWindowAverage() applied to the step function of the expression. Throws a
+     * run-time error if the upper bound is not larger than the lower bound.
+     * \param lowerBound Lower bound of window.
+     * \param upperBound Upper bound of window.
+     * \return Average of expression over window.
+     */
+    double computeWindowAverage( const double lowerBound, const double upperBound ) const;
+
+    //! Compute step function of expression.
+    /*!
+     * Computes step function of expression, in a single sweep over the keys of the inputs. Keys
+     * at which the value of the expression does not change are omitted. Throws a run-time error
+     * if the expression has no step-function inputs, i.e., if it is constant.
+     * \return Step function, as keys and values.
+     */
+    basics::DoubleKeyDoubleValueMap computeStepFunction( ) const;
+
+    //! Compute pointwise minimum of expressions.
+    friend StepFunctionExpression pointwiseMinimum(
+            StepFunctionExpression firstExpression,
+            const StepFunctionExpression& secondExpression );
+
+    //! Compute pointwise maximum of expressions.
+    friend StepFunctionExpression pointwiseMaximum(
+            StepFunctionExpression firstExpression,
+            const StepFunctionExpression& secondExpression );
+
+protected:
+
+private:
+
+    //! Operations of expression.
+    enum Operation
+    {
+        inputOperation,
+        constantOperation,
+        addOperation,
+        subtractOperation,
+        multiplyOperation,
+        divideOperation,
+        minimumOperation,
+        maximumOperation
+    };
+
+    //! Instruction of expression in postfix order.
+    struct Instruction
+    {
+        //! Operation.
+        Operation operation;
+
+        //! Index of input, for input operation.
+        std::size_t inputIndex;
+
+        //! Value, for constant operation.
+        double constant;
+    };
+
+    //! Sweep over keys of inputs.
+    class Sweep;
+
+    //! Append other expression and binary operation, combining both expressions.
+    void appendOperation( const StepFunctionExpression& otherExpression,
+                          const Operation operation );
+
+    //! Evaluate expression for given values of inputs.
+    double evaluateInstructions( const std::vector< double >& inputValues,
+                                 std::vector< double >& stack ) const;
+
+    //! Instructions in postfix order.
+    std::vector< Instruction > instructions;
+
+    //! Input step functions.
+    std::vector< const basics::DoubleKeyDoubleValueMap* > inputs;
+};
+
+//! Compute pointwise minimum of expressions.
+/*!
+ * Builds expression of the pointwise minimum of two expressions (without evaluating it).
+ * \param firstExpression First expression.
+ * \param secondExpression Second expression.
+ * \return Expression of pointwise minimum.
+ */
+StepFunctionExpression pointwiseMinimum( StepFunctionExpression firstExpression,
+                                         const StepFunctionExpression& secondExpression );
+
+//! Compute pointwise maximum of expressions.
+/*!
+ * Builds expression of the pointwise maximum of two expressions (without evaluating it).
+ * \param firstExpression First expression.
+ * \param secondExpression Second expression.
+ * \return Expression of pointwise maximum.
+ */
+StepFunctionExpression pointwiseMaximum( StepFunctionExpression firstExpression,
+                                         const StepFunctionExpression& secondExpression );
+
+//! Add expressions.
+inline StepFunctionExpression operator+( StepFunctionExpression firstExpression,
+                                         const StepFunctionExpression& secondExpression )
+{
+    return firstExpression += secondExpression;
+}
+
+//! Subtract expressions.
+inline StepFunctionExpression operator-( StepFunctionExpression firstExpression,
+                                         const StepFunctionExpression& secondExpression )
+{
+    return firstExpression -= secondExpression;
+}
+
+//! Multiply expressions.
+inline StepFunctionExpression operator*( StepFunctionExpression firstExpression,
+                                         const StepFunctionExpression& secondExpression )
+{
+    return firstExpression *= secondExpression;
+}
+
+//! Divide expressions.
+inline StepFunctionExpression operator/( StepFunctionExpression firstExpression,
+                                         const StepFunctionExpression& secondExpression )
+{
+    return firstExpression /= secondExpression;
+}
+
+//! Add constant to expression.
+inline StepFunctionExpression operator+( StepFunctionExpression expression, const double scalar )
+{
+    return expression += StepFunctionExpression( scalar );
+}
+
+//! Add expression to constant.
+inline StepFunctionExpression operator+( const double scalar,
+                                         const StepFunctionExpression& expression )
+{
+    return StepFunctionExpression( scalar ) += expression;
+}
+
+//! Subtract constant from expression.
+inline StepFunctionExpression operator-( StepFunctionExpression expression, const double scalar )
+{
+    return expression -= StepFunctionExpression( scalar );
+}
+
+//! Subtract expression from constant.
+inline StepFunctionExpression operator-( const double scalar,
+                                         const StepFunctionExpression& expression )
+{
+    return StepFunctionExpression( scalar ) -= expression;
+}
+
+//! Negate expression.
+inline StepFunctionExpression operator-( const StepFunctionExpression& expression )
+{
+    return StepFunctionExpression( -1.0 ) *= expression;
+}
+
+//! Multiply expression by scalar.
+inline StepFunctionExpression operator*( StepFunctionExpression expression, const double scalar )
+{
+    return expression *= StepFunctionExpression( scalar );
+}
+
+//! Multiply scalar by expression.
+inline StepFunctionExpression operator*( const double scalar,
+                                         const StepFunctionExpression& expression )
+{
+    return StepFunctionExpression( scalar ) *= expression;
+}
+
+//! Divide expression by scalar.
+inline StepFunctionExpression operator/( StepFunctionExpression expression, const double scalar )
+{
+    return expression /= StepFunctionExpression( scalar );
+}
+
+} // namespace mathematics
+} // namespace assist
+
+#endif // ASSIST_STEP_FUNCTION_EXPRESSION_H
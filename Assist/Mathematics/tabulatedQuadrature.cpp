@@ -0,0 +1,440 @@
+/*
+ *    Copyright (c) 2010-2014, Delft University of Technology
+ *    Copyright (c) 2010-2014, K. Kumar (me@kartikkumar.com)
+ *    All rights reserved.
+ *    See http://bit.ly/1jern3m for license details.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <map>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <boost/exception/all.hpp>
+
+#include "Assist/Basics/parallelLoop.h"
+#include "Assist/Mathematics/tabulatedQuadrature.h"
+
+namespace assist
+{
+namespace mathematics
+{
+
+namespace
+{
+
+//! Number of intervals (or pairs of intervals, for Simpson's rule) per block.
+const std::size_t blockSize = 1024;
+
+//! Minimum number of blocks per thread.
+const std::size_t minimumNumberOfBlocksPerThread = 16;
+
+//! Map of contiguous array.
+typedef Eigen::Map< const Eigen::ArrayXd > ArrayMap;
+
+//! Map of array with every second element.
+typedef Eigen::Map< const Eigen::ArrayXd, 0, Eigen::InnerStride< 2 > > StridedArrayMap;
+
+//! Compute number of blocks for given number of terms.
+inline std::size_t computeNumberOfBlocks( const std::size_t numberOfTerms )
+{
+    return ( numberOfTerms + blockSize - 1 ) / blockSize;
+}
+
+//! Add term to compensated sum (Kahan-Babuska summation).
+inline void addCompensated( const double term, double& sum, double& compensation )
+{
+    const double newSum = sum + term;
+    if ( std::fabs( sum ) >= std::fabs( term ) )
+    {
+        compensation += ( sum - newSum ) + term;
+    }
+
+    else
+    {
+        compensation += ( term - newSum ) + sum;
+    }
+
+    sum = newSum;
+}
+
+//! Compute compensated sum of terms.
+double computeCompensatedSum( const std::vector< double >& terms )
+{
+    double sum = 0.0;
+    double compensation = 0.0;
+    for ( std::size_t i = 0; i < terms.size( ); i++ )
+    {
+        addCompensated( terms[ i ], sum, compensation );
+    }
+
+    return sum + compensation;
+}
+
+//! Loop body to sum trapezoidal rule over blocks of intervals.
+struct SumTrapezoidalBlocks
+{
+    //! Sum blocks in range [begin, end).
+    void operator( )( const std::size_t begin, const std::size_t end ) const
+    {
+        for ( std::size_t b = begin; b < end; b++ )
+        {
+            const std::size_t first = b * blockSize;
+            const Eigen::ArrayXd::Index size = static_cast< Eigen::ArrayXd::Index >(
+                        std::min( blockSize, numberOfIntervals - first ) );
+
+            const ArrayMap lowerAbscissae( abscissae + first, size );
+            const ArrayMap upperAbscissae( abscissae + first + 1, size );
+            const ArrayMap lowerValues( values + first, size );
+            const ArrayMap upperValues( values + first + 1, size );
+            blockSums[ b ] = 0.5 * ( ( upperAbscissae - lowerAbscissae )
+                                     * ( lowerValues + upperValues ) ).sum( );
+        }
+    }
+
+    //! Independent values.
+    const double* abscissae;
+
+    //! Dependent values.
+    const double* values;
+
+    //! Number of intervals.
+    std::size_t numberOfIntervals;
+
+    //! Sums of blocks.
+    double* blockSums;
+};
+
+//! Loop body to sum Simpson's rule over blocks of pairs of intervals.
+struct SumSimpsonBlocks
+{
+    //! Sum blocks in range [begin, end).
+    void operator( )( const std::size_t begin, const std::size_t end ) const
+    {
+        Eigen::ArrayXd lowerWidthBuffer( blockSize );
+        Eigen::ArrayXd upperWidthBuffer( blockSize );
+
+        for ( std::size_t b = begin; b < end; b++ )
+        {
+            const std::size_t first = 2 * b * blockSize;
+            const Eigen::ArrayXd::Index size = static_cast< Eigen::ArrayXd::Index >(
+                        std::min( blockSize, numberOfPairs - b * blockSize ) );
+
+            const StridedArrayMap values0( values + first, size );
+            const StridedArrayMap values1( values + first + 1, size );
+            const StridedArrayMap values2( values + first + 2, size );
+
+            Eigen::ArrayXd::SegmentReturnType h0 = lowerWidthBuffer.head( size );
+            Eigen::ArrayXd::SegmentReturnType h1 = upperWidthBuffer.head( size );
+            h0 = StridedArrayMap( abscissae + first + 1, size )
+                    - StridedArrayMap( abscissae + first, size );
+            h1 = StridedArrayMap( abscissae + first + 2, size )
+                    - StridedArrayMap( abscissae + first + 1, size );
+
+            // Integrate quadratic through three points, with widths h0 and h1 of the intervals.
+            blockSums[ b ] = ( ( h0 + h1 ) * ( ( 2.0 - h1 / h0 ) * values0
+                                               + ( h0 + h1 ).square( ) / ( h0 * h1 ) * values1
+                                               + ( 2.0 - h0 / h1 ) * values2 ) ).sum( ) / 6.0;
+        }
+    }
+
+    //! Independent values.
+    const double* abscissae;
+
+    //! Dependent values.
+    const double* values;
+
+    //! Number of pairs of intervals.
+    std::size_t numberOfPairs;
+
+    //! Sums of blocks.
+    double* blockSums;
+};
+
+//! Loop body to compute cumulative trapezoidal integral over blocks of intervals.
+struct ComputeCumulativeBlocks
+{
+    //! Compute cumulative integral of blocks in range [begin, end).
+    void operator( )( const std::size_t begin, const std::size_t end ) const
+    {
+        for ( std::size_t b = begin; b < end; b++ )
+        {
+            const std::size_t first = b * blockSize;
+            const std::size_t last = std::min( first + blockSize, numberOfIntervals );
+
+            double sum = blockOffsets[ b ];
+            double compensation = 0.0;
+            for ( std::size_t i = first; i < last; i++ )
+            {
+                addCompensated( 0.5 * ( abscissae[ i + 1 ] - abscissae[ i ] )
+                                * ( values[ i ] + values[ i + 1 ] ), sum, compensation );
+                cumulativeIntegral[ i + 1 ] = sum + compensation;
+            }
+        }
+    }
+
+    //! Independent values.
+    const double* abscissae;
+
+    //! Dependent values.
+    const double* values;
+
+    //! Number of intervals.
+    std::size_t numberOfIntervals;
+
+    //! Cumulative integral at start of each block.
+    const double* blockOffsets;
+
+    //! Cumulative integral.
+    double* cumulativeIntegral;
+};
+
+//! Check that sizes of tabulated data match, and that there are at least two points.
+void checkTabulatedData( const Eigen::ArrayXd& abscissae, const Eigen::ArrayXd& values )
+{
+    if ( abscissae.size( ) != values.size( ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Error: sizes of abscissae and values do not match." ) ) );
+    }
+
+    if ( abscissae.size( ) < 2 )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Error: data contains fewer than two points." ) ) );
+    }
+}
+
+//! Compute sums of blocks of intervals using trapezoidal rule.
+std::vector< double > sumTrapezoidalBlocks( const Eigen::ArrayXd& abscissae,
+                                            const Eigen::ArrayXd& values,
+                                            const unsigned int numberOfThreads )
+{
+    const std::size_t numberOfIntervals = static_cast< std::size_t >( abscissae.size( ) ) - 1;
+    std::vector< double > blockSums( computeNumberOfBlocks( numberOfIntervals ) );
+
+    const SumTrapezoidalBlocks loopBody
+            = { abscissae.data( ), values.data( ), numberOfIntervals, &blockSums[ 0 ] };
+    basics::executeParallelLoop( blockSums.size( ), loopBody, numberOfThreads,
+                                 minimumNumberOfBlocksPerThread );
+    return blockSums;
+}
+
+//! Copy series to tabulated data, with one column of values per component.
+template< typename ValueType >
+void copySeries( const std::map< double, ValueType >& series, Eigen::ArrayXd& abscissae,
+                 Eigen::MatrixXd& values )
+{
+    abscissae.resize( static_cast< Eigen::ArrayXd::Index >( series.size( ) ) );
+    values.resize( static_cast< Eigen::ArrayXd::Index >( series.size( ) ),
+                   ValueType::RowsAtCompileTime );
+
+    Eigen::ArrayXd::Index i = 0;
+    for ( typename std::map< double, ValueType >::const_iterator iteratorPoint = series.begin( );
+          iteratorPoint != series.end( ); iteratorPoint++, i++ )
+    {
+        abscissae( i ) = iteratorPoint->first;
+        values.row( i ) = iteratorPoint->second.transpose( );
+    }
+}
+
+//! Copy series to tabulated data.
+void copySeries( const basics::DoubleKeyDoubleValueMap& series, Eigen::ArrayXd& abscissae,
+                 Eigen::ArrayXd& values )
+{
+    abscissae.resize( static_cast< Eigen::ArrayXd::Index >( series.size( ) ) );
+    values.resize( static_cast< Eigen::ArrayXd::Index >( series.size( ) ) );
+
+    Eigen::ArrayXd::Index i = 0;
+    for ( basics::DoubleKeyDoubleValueMap::const_iterator iteratorPoint = series.begin( );
+          iteratorPoint != series.end( ); iteratorPoint++, i++ )
+    {
+        abscissae( i ) = iteratorPoint->first;
+        values( i ) = iteratorPoint->second;
+    }
+}
+
+//! Integrate series of vectors component-wise, using given rule for tabulated data.
+template< typename ValueType >
+ValueType integrateVectorSeries( const std::map< double, ValueType >& series,
+                                 double ( *integrate )( const Eigen::ArrayXd&,
+                                                        const Eigen::ArrayXd&,
+                                                        const unsigned int ),
+                                 const unsigned int numberOfThreads )
+{
+    Eigen::ArrayXd abscissae;
+    Eigen::MatrixXd values;
+    copySeries( series, abscissae, values );
+
+    ValueType integral;
+    for ( int c = 0; c < ValueType::RowsAtCompileTime; c++ )
+    {
+        integral( c ) = integrate( abscissae, values.col( c ).array( ), numberOfThreads );
+    }
+
+    return integral;
+}
+
+} // namespace
+
+//! Integrate tabulated data using trapezoidal rule.
+double integrateTrapezoidal( const Eigen::ArrayXd& abscissae, const Eigen::ArrayXd& values,
+                             const unsigned int numberOfThreads )
+{
+    checkTabulatedData( abscissae, values );
+    return computeCompensatedSum( sumTrapezoidalBlocks( abscissae, values, numberOfThreads ) );
+}
+
+//! Integrate tabulated data using Simpson's rule.
+double integrateSimpson( const Eigen::ArrayXd& abscissae, const Eigen::ArrayXd& values,
+                         const unsigned int numberOfThreads )
+{
+    checkTabulatedData( abscissae, values );
+
+    const std::size_t numberOfPoints = static_cast< std::size_t >( abscissae.size( ) );
+    if ( numberOfPoints == 2 )
+    {
+        return 0.5 * ( abscissae( 1 ) - abscissae( 0 ) ) * ( values( 0 ) + values( 1 ) );
+    }
+
+    // Sum pairs of intervals.
+    const std::size_t numberOfPairs = ( numberOfPoints - 1 ) / 2;
+    std::vector< double > blockSums( computeNumberOfBlocks( numberOfPairs ) );
+
+    const SumSimpsonBlocks loopBody
+            = { abscissae.data( ), values.data( ), numberOfPairs, &blockSums[ 0 ] };
+    basics::executeParallelLoop( blockSums.size( ), loopBody, numberOfThreads,
+                                 minimumNumberOfBlocksPerThread );
+
+    // Integrate last interval, if the number of intervals is odd, using quadratic through last
+    // three points (Shklov, 1960).
+    if ( numberOfPoints % 2 == 0 )
+    {
+        const std::size_t n = numberOfPoints - 1;
+        const double lastWidth = abscissae( n ) - abscissae( n - 1 );
+        const double previousWidth = abscissae( n - 1 ) - abscissae( n - 2 );
+
+        blockSums.push_back(
+                    ( 2.0 * lastWidth * lastWidth + 3.0 * lastWidth * previousWidth )
+                    / ( 6.0 * ( previousWidth + lastWidth ) ) * values( n )
+                    + ( lastWidth * lastWidth + 3.0 * lastWidth * previousWidth )
+                    / ( 6.0 * previousWidth ) * values( n - 1 )
+                    - lastWidth * lastWidth * lastWidth
+                    / ( 6.0 * previousWidth * ( previousWidth + lastWidth ) ) * values( n - 2 ) );
+    }
+
+    return computeCompensatedSum( blockSums );
+}
+
+//! Compute cumulative integral of tabulated data using trapezoidal rule.
+void computeCumulativeTrapezoidalIntegral( const Eigen::ArrayXd& abscissae,
+                                           const Eigen::ArrayXd& values,
+                                           Eigen::ArrayXd& cumulativeIntegral,
+                                           const unsigned int numberOfThreads )
+{
+    checkTabulatedData( abscissae, values );
+
+    // Compute sums of blocks, and their compensated prefix sums.
+    const std::vector< double > blockSums
+            = sumTrapezoidalBlocks( abscissae, values, numberOfThreads );
+
+    std::vector< double > blockOffsets( blockSums.size( ) );
+    double sum = 0.0;
+    double compensation = 0.0;
+    for ( std::size_t b = 0; b < blockSums.size( ); b++ )
+    {
+        blockOffsets[ b ] = sum + compensation;
+        addCompensated( blockSums[ b ], sum, compensation );
+    }
+
+    // Compute prefix sums within blocks.
+    cumulativeIntegral.resize( abscissae.size( ) );
+    cumulativeIntegral( 0 ) = 0.0;
+
+    const ComputeCumulativeBlocks loopBody
+            = { abscissae.data( ), values.data( ),
+                static_cast< std::size_t >( abscissae.size( ) ) - 1, &blockOffsets[ 0 ],
+                cumulativeIntegral.data( ) };
+    basics::executeParallelLoop( blockOffsets.size( ), loopBody, numberOfThreads,
+                                 minimumNumberOfBlocksPerThread );
+}
+
+//! Integrate series using trapezoidal rule.
+double integrateTrapezoidal( const basics::DoubleKeyDoubleValueMap& series,
+                             const unsigned int numberOfThreads )
+{
+    Eigen::ArrayXd abscissae;
+    Eigen::ArrayXd values;
+    copySeries( series, abscissae, values );
+    return integrateTrapezoidal( abscissae, values, numberOfThreads );
+}
+
+//! Integrate series of 3-vectors using trapezoidal rule.
+Eigen::Vector3d integrateTrapezoidal( const basics::DoubleKeyVector3dValueMap& series,
+                                      const unsigned int numberOfThreads )
+{
+    return integrateVectorSeries( series, &integrateTrapezoidal, numberOfThreads );
+}
+
+//! Integrate series of 6-vectors using trapezoidal rule.
+tudat::basic_mathematics::Vector6d integrateTrapezoidal(
+        const basics::DoubleKeyVector6dValueMap& series, const unsigned int numberOfThreads )
+{
+    return integrateVectorSeries( series, &integrateTrapezoidal, numberOfThreads );
+}
+
+//! Integrate series using Simpson's rule.
+double integrateSimpson( const basics::DoubleKeyDoubleValueMap& series,
+                         const unsigned int numberOfThreads )
+{
+    Eigen::ArrayXd abscissae;
+    Eigen::ArrayXd values;
+    copySeries( series, abscissae, values );
+    return integrateSimpson( abscissae, values, numberOfThreads );
+}
+
+//! Integrate series of 3-vectors using Simpson's rule.
+Eigen::Vector3d integrateSimpson( const basics::DoubleKeyVector3dValueMap& series,
+                                  const unsigned int numberOfThreads )
+{
+    return integrateVectorSeries( series, &integrateSimpson, numberOfThreads );
+}
+
+//! Integrate series of 6-vectors using Simpson's rule.
+tudat::basic_mathematics::Vector6d integrateSimpson(
+        const basics::DoubleKeyVector6dValueMap& series, const unsigned int numberOfThreads )
+{
+    return integrateVectorSeries( series, &integrateSimpson, numberOfThreads );
+}
+
+//! Compute cumulative integral of series using trapezoidal rule.
+basics::DoubleKeyDoubleValueMap computeCumulativeTrapezoidalIntegral(
+        const basics::DoubleKeyDoubleValueMap& series, const unsigned int numberOfThreads )
+{
+    Eigen::ArrayXd abscissae;
+    Eigen::ArrayXd values;
+    copySeries( series, abscissae, values );
+
+    Eigen::ArrayXd cumulativeIntegral;
+    computeCumulativeTrapezoidalIntegral( abscissae, values, cumulativeIntegral,
+                                          numberOfThreads );
+
+    basics::DoubleKeyDoubleValueMap cumulativeIntegralSeries;
+    for ( Eigen::ArrayXd::Index i = 0; i < abscissae.size( ); i++ )
+    {
+        cumulativeIntegralSeries.insert( cumulativeIntegralSeries.end( ),
+                                         std::make_pair( abscissae( i ),
+                                                         cumulativeIntegral( i ) ) );
+    }
+
+    return cumulativeIntegralSeries;
+}
+
+} // namespace mathematics
+} // namespace assist
@@ -0,0 +1,157 @@
+/*
+ *    Copyright (c) 2010-2014, Delft University of Technology
+ *    Copyright (c) 2010-2014, K. Kumar (me@kartikkumar.com)
+ *    All rights reserved.
+ *    See http://bit.ly/1jern3m for license details.
+ */
+
+#ifndef ASSIST_TABULATED_QUADRATURE_H
+#define ASSIST_TABULATED_QUADRATURE_H
+
+#include <Eigen/Core>
+
+#include "Assist/Basics/commonTypedefs.h"
+
+namespace assist
+{
+namespace mathematics
+{
+
+//! Integrate tabulated data using trapezoidal rule.
+/*!
+ * Integrates tabulated data, i.e., values at sorted abscissae, using the trapezoidal rule, which
+ * is exact for piecewise-linear data. The contributions of the intervals are summed in blocks of
+ * fixed size, with vectorized array operations, and the block sums are added with compensated
+ * (Kahan-Babuska) summation. Blocks are processed in parallel; since the blocks do not depend on
+ * the number of threads, the result is identical for any number of threads. Throws a run-time
+ * error if the sizes of the arrays do not match, or if there are fewer than two points.
+ * \param abscissae Sorted independent values.
+ * \param values Dependent values.
+ * \param numberOfThreads Number of threads to use (0 = number of hardware threads; default=1).
+ * \return Integral of values over range of abscissae.
+ */
+double integrateTrapezoidal( const Eigen::ArrayXd& abscissae, const Eigen::ArrayXd& values,
+                             const unsigned int numberOfThreads = 1 );
+
+//! Integrate tabulated data using Simpson's rule.
+/*!
+ * Integrates tabulated data using composite Simpson's rule for non-uniform spacing, which fits a
+ * quadratic polynomial through each pair of consecutive intervals, and is exact for piecewise-
+ * quadratic data. If the number of intervals is odd, the last interval is integrated using the
+ * quadratic through the last three points. If there are only two points, the trapezoidal rule is
+ * used. Summation and parallelization are as for integrateTrapezoidal(). Throws a run-time error
+ * if the sizes of the arrays do not match, or if there are fewer than two points.
+ * \param abscissae Sorted independent values.
+ * \param values Dependent values.
+ * \param numberOfThreads Number of threads to use (0 = number of hardware threads; default=1).
+ * \return Integral of values over range of abscissae.
+ */
+double integrateSimpson( const Eigen::ArrayXd& abscissae, const Eigen::ArrayXd& values,
+                         const unsigned int numberOfThreads = 1 );
+
+//! Compute cumulative integral of tabulated data using trapezoidal rule.
+/*!
+ * Computes cumulative integral of tabulated data, i.e., the integral from the first abscissa to
+ * each abscissa, using the trapezoidal rule. The prefix sums are computed in two parallel passes
+ * over blocks of fixed size (sums of blocks, and prefix sums within blocks, offset by the
+ * compensated prefix sums of the blocks), so that the result is identical for any number of
+ * threads. Throws a run-time error if the sizes of the arrays do not match, or if there are
+ * fewer than two points.
+ * \param abscissae Sorted independent values.
+ * \param values Dependent values.
+ * \param cumulativeIntegral Cumulative integral at abscissae, starting at zero (resized if
+ *          needed).
+ * \param numberOfThreads Number of threads to use (0 = number of hardware threads; default=1).
+ */
+void computeCumulativeTrapezoidalIntegral( const Eigen::ArrayXd& abscissae,
+                                           const Eigen::ArrayXd& values,
+                                           Eigen::ArrayXd& cumulativeIntegral,
+                                           const unsigned int numberOfThreads = 1 );
+
+//! Integrate series using trapezoidal rule.
+/*!
+ * Integrates series of independent and dependent values using the trapezoidal rule (see
+ * integrateTrapezoidal()).
+ * \param series Series of independent and dependent values.
+ * \param numberOfThreads Number of threads to use (0 = number of hardware threads; default=1).
+ * \return Integral of dependent values over range of independent values.
+ */
+double integrateTrapezoidal( const basics::DoubleKeyDoubleValueMap& series,
+                             const unsigned int numberOfThreads = 1 );
+
+//! Integrate series of 3-vectors using trapezoidal rule.
+/*!
+ * Integrates series of 3-vectors (e.g., accelerations) component-wise using the trapezoidal rule
+ * (see integrateTrapezoidal()).
+ * \param series Series of independent values and 3-vectors.
+ * \param numberOfThreads Number of threads to use (0 = number of hardware threads; default=1).
+ * \return Integral of 3-vectors over range of independent values.
+ */
+Eigen::Vector3d integrateTrapezoidal( const basics::DoubleKeyVector3dValueMap& series,
+                                      const unsigned int numberOfThreads = 1 );
+
+//! Integrate series of 6-vectors using trapezoidal rule.
+/*!
+ * Integrates series of 6-vectors (e.g., state derivatives) component-wise using the trapezoidal
+ * rule (see integrateTrapezoidal()).
+ * \param series Series of independent values and 6-vectors.
+ * \param numberOfThreads Number of threads to use (0 = number of hardware threads; default=1).
+ * \return Integral of 6-vectors over range of independent values.
+ */
+tudat::basic_mathematics::Vector6d integrateTrapezoidal(
+        const basics::DoubleKeyVector6dValueMap& series, const unsigned int numberOfThreads = 1 );
+
+//! Integrate series using Simpson's rule.
+/*!
+ * Integrates series of independent and dependent values using Simpson's rule (see
+ * integrateSimpson()).
+ * \param series Series of independent and dependent values.
+ * \param numberOfThreads Number of threads to use (0 = number of hardware threads; default=1).
+ * \return Integral of dependent values over range of independent values.
+ */
+double integrateSimpson( const basics::DoubleKeyDoubleValueMap& series,
+                         const unsigned int numberOfThreads = 1 );
+
+//! Integrate series of 3-vectors using Simpson's rule.
+/*!
+ * Integrates series of 3-vectors component-wise using Simpson's rule (see integrateSimpson()).
+ * \param series Series of independent values and 3-vectors.
+ * \param numberOfThreads Number of threads to use (0 = number of hardware threads; default=1).
+ * \return Integral of 3-vectors over range of independent values.
+ */
+Eigen::Vector3d integrateSimpson( const basics::DoubleKeyVector3dValueMap& series,
+                                  const unsigned int numberOfThreads = 1 );
+
+//! Integrate series of 6-vectors using Simpson's rule.
+/*!
+ * Integrates series of 6-vectors component-wise using Simpson's rule (see integrateSimpson()).
+ * \param series Series of independent values and 6-vectors.
+ * \param numberOfThreads Number of threads to use (0 = number of hardware threads; default=1).
+ * \return Integral of 6-vectors over range of independent values.
+ */
+tudat::basic_mathematics::Vector6d integrateSimpson(
+        const basics::DoubleKeyVector6dValueMap& series, const unsigned int numberOfThreads = 1 );
+
+//! Compute cumulative integral of series using trapezoidal rule.
+/*!
+ * Computes cumulative integral of series of independent and dependent values using the
+ * trapezoidal rule (see computeCumulativeTrapezoidalIntegral()).
+ * \param series Series of independent and dependent values.
+ * \param numberOfThreads Number of threads to use (0 = number of hardware threads; default=1).
+ * \return Series of independent values and cumulative integral, starting at zero.
+ */
+basics::DoubleKeyDoubleValueMap computeCumulativeTrapezoidalIntegral(
+        const basics::DoubleKeyDoubleValueMap& series, const unsigned int numberOfThreads = 1 );
+
+} // namespace mathematics
+} // namespace assist
+
+#endif // ASSIST_TABULATED_QUADRATURE_H
+
+/*
+ *    References
+ *      Higham, N.J. The accuracy of floating point summation, SIAM Journal on Scientific
+ *          Computing 14(4), 783-799, 1993.
+ *      Shklov, N. Simpson's rule for unequally spaced ordinates, The American Mathematical
+ *          Monthly 67(10), 1022-1023, 1960.
+ */